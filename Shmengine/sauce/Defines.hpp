@@ -72,6 +72,7 @@ namespace Constants
 	inline constexpr uint32 max_render_view_name_length = 64;
 
 	inline constexpr uint32 max_terrain_materials_count = 4;
+	inline constexpr uint32 max_geometry_lod_count = 4;
 
 	inline constexpr float32 PI = 3.14159265358979323846f;
 	inline constexpr float32 DOUBLE_PI = (2.0f * PI);
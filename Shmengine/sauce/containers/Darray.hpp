@@ -358,20 +358,19 @@ SHMINLINE T* Darray<T>::insert_at(const T& obj, uint32 index)
 {
 
 	SHMASSERT_MSG(index <= count, "ERROR: Index is out of darray's scope!");
-	if (count + 1 > data->size)
+	if (count + 1 > capacity)
 	{
 		resize();
 	}
 
-	uint32 copy_block_size = (count - index) * sizeof(T);
-	T* insert_ptr = data + index;
+	// NOTE: Shifting back to front, since source and destination overlap.
+	for (uint32 i = count; i > index; i--)
+		Memory::copy_memory(data + i - 1, data + i, sizeof(T));
 
-	T* copy_source = insert_ptr;
-	T* copy_dest = insert_ptr + 1;
-	Memory::copy_memory(copy_source, copy_dest, copy_block_size);
-	*copy_source = obj;
+	T* insert_ptr = data + index;
+	*insert_ptr = obj;
 	count++;
-	return copy_source;
+	return insert_ptr;
 
 }
 
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Defines.hpp"
+
+namespace Threading
+{
+
+	// NOTE: All operations act as full memory barriers.
+	SHMAPI uint32 atomic_load(volatile uint32* value);
+	SHMAPI void atomic_store(volatile uint32* value, uint32 new_value);
+	SHMAPI uint32 atomic_increment(volatile uint32* value);
+	SHMAPI uint32 atomic_decrement(volatile uint32* value);
+	// NOTE: Returns the value held before the exchange. The exchange happened if it equals the comparand.
+	SHMAPI uint32 atomic_compare_exchange(volatile uint32* value, uint32 new_value, uint32 comparand);
+
+	// NOTE: Blocks while the value equals undesired_value, until another thread wakes it up. May return spuriously, callers check the value again.
+	SHMAPI void atomic_wait(volatile uint32* value, uint32 undesired_value);
+	SHMAPI void atomic_wake_all(volatile uint32* value);
+
+}
@@ -54,6 +54,7 @@ void TimerPool::timer_stop()
 
 struct MetricsState {
 	static const uint32 avg_count = 30;
+	static const uint32 max_subsystem_count = 32;
 
 	float64 frame_start_timestamp;
 	float64 logic_finish_timestamp;
@@ -69,6 +70,10 @@ struct MetricsState {
 	float64 last_frametime;
 	float64 logic_time;
 	float64 render_time;
+
+	uint32 subsystem_count;
+	const char* subsystem_names[max_subsystem_count];
+	float64 subsystem_update_times[max_subsystem_count];
 };
 
 static MetricsState metrics_state = {};
@@ -151,4 +156,30 @@ SHMINLINE void metrics_frame_time(float64* out_fps, float64* out_frametime)
 SHMINLINE float64 metrics_frame_start_time()
 {
 	return metrics_state.frame_start_timestamp;
+}
+
+void metrics_update_subsystem(uint32 subsystem_index, const char* name, float64 update_time)
+{
+	if (subsystem_index >= MetricsState::max_subsystem_count)
+		return;
+
+	metrics_state.subsystem_names[subsystem_index] = name;
+	metrics_state.subsystem_update_times[subsystem_index] = update_time;
+	if (subsystem_index >= metrics_state.subsystem_count)
+		metrics_state.subsystem_count = subsystem_index + 1;
+}
+
+SHMINLINE uint32 metrics_subsystem_count()
+{
+	return metrics_state.subsystem_count;
+}
+
+SHMINLINE float64 metrics_subsystem_update_time(uint32 subsystem_index, const char** out_name)
+{
+	if (subsystem_index >= metrics_state.subsystem_count)
+		return 0.0;
+
+	if (out_name)
+		*out_name = metrics_state.subsystem_names[subsystem_index];
+	return metrics_state.subsystem_update_times[subsystem_index];
 }
\ No newline at end of file
@@ -38,3 +38,7 @@ SHMAPI float64 metrics_logic_time();
 SHMAPI float64 metrics_render_time();
 SHMAPI void metrics_frame_time(float64* out_fps, float64* out_frametime);
 SHMAPI float64 metrics_frame_start_time();
+
+SHMAPI void metrics_update_subsystem(uint32 subsystem_index, const char* name, float64 update_time);
+SHMAPI uint32 metrics_subsystem_count();
+SHMAPI float64 metrics_subsystem_update_time(uint32 subsystem_index, const char** out_name = 0);
@@ -12,6 +12,7 @@
 #include "utility/CString.hpp"
 
 #include "renderer/RendererFrontend.hpp"
+#include "renderer/MeshOptimizer.hpp"
 #include "systems/RenderViewSystem.hpp"
 
 #include "core/Subsystems.hpp"
@@ -31,6 +32,8 @@ namespace Engine
 		bool8 is_running;
 		//Clock clock;
 
+		float64 init_start_time;
+
 		char assets_base_path[Constants::max_filepath_length];
 		Memory::LinearAllocator systems_allocator;
 		FrameData frame_data;
@@ -57,6 +60,7 @@ namespace Engine
 		if (initialized)
 			return false;
 
+		engine_state.init_start_time = Platform::get_absolute_time();
 		engine_state.app_inst = app_inst;
 		CString::copy(Platform::get_root_dir(), engine_state.assets_base_path, Constants::max_filepath_length);
 		CString::append(engine_state.assets_base_path, Constants::max_filepath_length, "../../../assets/");
@@ -71,6 +75,14 @@ namespace Engine
 			return false;
 		}
 
+#ifdef DEBUG
+		// NOTE: Regression checks for code whose mistakes would otherwise only show up as subtly wrong assets.
+		if (!CString::float_parse_self_check())
+			SHMERROR("Float parser self check failed.");
+		if (!Renderer::mesh_optimizer_self_check())
+			SHMERROR("Mesh optimizer self check failed.");
+#endif
+
 		app_inst->stage = ApplicationStage::BOOTING;
 		ApplicationConfig app_config = {};
 		if (!boot_application(&app_config))
@@ -144,6 +156,8 @@ namespace Engine
 				timer = 0.0;
 			}
 
+			Event::dispatch_posted_events();
+
 			Input::frame_start();
 
 			if (!app_inst->is_suspended)
@@ -173,6 +187,9 @@ namespace Engine
 
 			Input::frame_end(&engine_state.frame_data);
 
+			if (!frame_count)
+				SHMINFOV("Cold start to first frame took %lf3 ms.", (Platform::get_absolute_time() - engine_state.init_start_time) * 1000.0);
+
 			float64 frame_elapsed_time = Platform::get_absolute_time() - metrics_frame_start_time();
 			static float64 remaining_s = target_frame_seconds - frame_elapsed_time;
 
@@ -1,6 +1,7 @@
 #include "Event.hpp"
 #include "core/Memory.hpp"
-#include "containers/Darray.hpp"
+#include "core/Mutex.hpp"
+#include "core/Atomic.hpp"
 #include "Logging.hpp"
 #include "memory/LinearAllocator.hpp"
 #include "Engine.hpp"
@@ -14,16 +15,41 @@ namespace Event
 		FP_OnEvent callback;
 	};
 
-	struct EventCodeEntry
+	// NOTE: Listeners of one code occupy a contiguous range of the shared listener table.
+	struct ListenerRange
 	{
-		Darray<Listener> listeners = {};
+		uint16 first;
+		uint16 count;
+	};
+
+	struct PostedEvent
+	{
+		volatile uint32 sequence;
+		uint16 code;
+		EventPostFlags::Value flags;
+		void* sender;
+		EventData data;
 	};
 
 #define MAX_MESSAGE_CODES 4096
+#define MAX_LISTENER_COUNT 1024
+#define MAX_POSTED_EVENT_COUNT 1024
 
 	struct SystemState
 	{
-		EventCodeEntry registered[MAX_MESSAGE_CODES];
+		Threading::Mutex listener_mutex;
+		uint32 listener_count;
+		ListenerRange ranges[MAX_MESSAGE_CODES];
+		Listener listeners[MAX_LISTENER_COUNT];
+
+		// NOTE: Bounded multi-producer queue. Each slot's sequence tells producers and the consumer whether it is free or filled for the current lap.
+		volatile uint32 post_write_pos;
+		uint32 post_read_pos;
+		PostedEvent posted[MAX_POSTED_EVENT_COUNT];
+		volatile uint32 posted_dropped_count;
+
+		PostedEvent dispatch_batch[MAX_POSTED_EVENT_COUNT];
+		uint16 coalesce_last_index[MAX_MESSAGE_CODES];
 	};
 
 	static SystemState* system_state;
@@ -31,6 +57,16 @@ namespace Event
 	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config)
 	{
 		system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+		Memory::zero_memory(system_state, sizeof(SystemState));
+
+		if (!Threading::mutex_create(&system_state->listener_mutex))
+		{
+			SHMFATAL("Failed to create event listener mutex!");
+			return false;
+		}
+
+		for (uint32 i = 0; i < MAX_POSTED_EVENT_COUNT; i++)
+			system_state->posted[i].sequence = i;
 
 		SHMINFO("Event subsystem initialized!");
 
@@ -39,13 +75,11 @@ namespace Event
 
 	void system_shutdown(void* state)
 	{
-		for (uint32 i = 0; i < MAX_MESSAGE_CODES; i++)
-		{
-			if (system_state->registered[i].listeners.data != 0)
-			{
-				system_state->registered[i].listeners.free_data();
-			}
-		}
+		if (system_state->posted_dropped_count)
+			SHMWARNV("Event queue dropped %u posted events since startup.", system_state->posted_dropped_count);
+
+		Threading::mutex_destroy(&system_state->listener_mutex);
+		system_state = 0;
 	}
 
 	bool8 event_register(uint16 code, void* listener, FP_OnEvent on_event)
@@ -53,23 +87,47 @@ namespace Event
 		if (!system_state)
 			return false;
 
-		if (system_state->registered[code].listeners.data == 0)
-			system_state->registered[code].listeners.init(1, 0);
+		Threading::mutex_lock(system_state->listener_mutex);
 
-		Darray<Listener>& e_listeners = system_state->registered[code].listeners;
+		ListenerRange* range = &system_state->ranges[code];
+		Listener* listeners = system_state->listeners;
 
 		// NOTE: Check if listener is already registered for event
-		for (uint32 i = 0; i < e_listeners.count; i++)
+		for (uint32 i = range->first; i < (uint32)(range->first + range->count); i++)
 		{
-			if (e_listeners[i].ptr == listener && e_listeners[i].callback == on_event)
+			if (listeners[i].ptr == listener && listeners[i].callback == on_event)
+			{
+				Threading::mutex_unlock(system_state->listener_mutex);
 				return false;
+			}
 		}
 
-		Listener l1;
-		l1.ptr = listener;
-		l1.callback = on_event;
-		e_listeners.emplace(l1);
+		if (system_state->listener_count >= MAX_LISTENER_COUNT)
+		{
+			Threading::mutex_unlock(system_state->listener_mutex);
+			SHMERRORV("Failed to register listener for event code %u. Listener table is full.", code);
+			return false;
+		}
+
+		if (!range->count)
+			range->first = (uint16)system_state->listener_count;
+
+		uint32 insert_index = range->first + range->count;
+		for (uint32 i = system_state->listener_count; i > insert_index; i--)
+			listeners[i] = listeners[i - 1];
+
+		for (uint32 i = 0; i < MAX_MESSAGE_CODES; i++)
+		{
+			if (i != code && system_state->ranges[i].count && system_state->ranges[i].first >= insert_index)
+				system_state->ranges[i].first++;
+		}
+
+		listeners[insert_index].ptr = listener;
+		listeners[insert_index].callback = on_event;
+		range->count++;
+		system_state->listener_count++;
 
+		Threading::mutex_unlock(system_state->listener_mutex);
 		return true;
 	}
 
@@ -78,18 +136,32 @@ namespace Event
 		if (!system_state)
 			return false;
 
-		Darray<Listener>& e_listeners = system_state->registered[code].listeners;
+		Threading::mutex_lock(system_state->listener_mutex);
 
-		// NOTE: Check if listener is already registered for event
-		for (uint32 i = 0; i < e_listeners.count; i++)
+		ListenerRange* range = &system_state->ranges[code];
+		Listener* listeners = system_state->listeners;
+
+		for (uint32 i = range->first; i < (uint32)(range->first + range->count); i++)
 		{
-			if (e_listeners[i].ptr == listener && e_listeners[i].callback == on_event)
+			if (listeners[i].ptr != listener || listeners[i].callback != on_event)
+				continue;
+
+			system_state->listener_count--;
+			for (uint32 j = i; j < system_state->listener_count; j++)
+				listeners[j] = listeners[j + 1];
+
+			range->count--;
+			for (uint32 c = 0; c < MAX_MESSAGE_CODES; c++)
 			{
-				e_listeners.remove_at(i);
-				return true;
+				if (system_state->ranges[c].count && system_state->ranges[c].first > i)
+					system_state->ranges[c].first--;
 			}
+
+			Threading::mutex_unlock(system_state->listener_mutex);
+			return true;
 		}
 
+		Threading::mutex_unlock(system_state->listener_mutex);
 		return false;
 	}
 
@@ -98,20 +170,127 @@ namespace Event
 		if (!system_state)
 			return false;
 
-		Darray<Listener>& e_listeners = system_state->registered[code].listeners;
-
-		// NOTE: Check if listener is already registered for event
-		for (uint32 i = 0; i < e_listeners.count; i++)
+		// NOTE: Range is re-read every iteration, since listeners may (un)register from inside their callback and shift the table.
+		// The index only moves on while the slot still holds the listener just called, otherwise the one that slid into it would be skipped.
+		ListenerRange* range = &system_state->ranges[code];
+		for (uint32 i = 0; i < range->count;)
 		{
-			if (e_listeners[i].callback(code, sender, e_listeners[i].ptr, data))
+			Listener listener = system_state->listeners[range->first + i];
+			if (listener.callback(code, sender, listener.ptr, data))
 			{
 				// NOTE: return if the message has been handled fully
 				return true;
 			}
+
+			Listener* current = &system_state->listeners[range->first + i];
+			if (i < range->count && current->ptr == listener.ptr && current->callback == listener.callback)
+				i++;
 		}
 
 		return false;
 	}
 
+	bool8 event_post(uint16 code, void* sender, EventData data, EventPostFlags::Value flags)
+	{
+		if (!system_state)
+			return false;
+
+		uint32 pos = Threading::atomic_load(&system_state->post_write_pos);
+		PostedEvent* slot;
+		while (true)
+		{
+			slot = &system_state->posted[pos % MAX_POSTED_EVENT_COUNT];
+			int32 diff = (int32)(Threading::atomic_load(&slot->sequence) - pos);
+			if (diff == 0)
+			{
+				uint32 prev = Threading::atomic_compare_exchange(&system_state->post_write_pos, pos + 1, pos);
+				if (prev == pos)
+					break;
+				pos = prev;
+			}
+			else if (diff < 0)
+			{
+				// NOTE: Queue is full until the main thread dispatches again.
+				Threading::atomic_increment(&system_state->posted_dropped_count);
+				return false;
+			}
+			else
+			{
+				pos = Threading::atomic_load(&system_state->post_write_pos);
+			}
+		}
+
+		slot->code = code;
+		slot->flags = flags;
+		slot->sender = sender;
+		slot->data = data;
+		Threading::atomic_store(&slot->sequence, pos + 1);
+
+		return true;
+	}
+
+	void dispatch_posted_events()
+	{
+		if (!system_state)
+			return;
+
+		// NOTE: Pull everything that is ready into a local batch first, so that events posted by listeners during dispatch wait for the next frame.
+		uint32 batch_count = 0;
+		while (batch_count < MAX_POSTED_EVENT_COUNT)
+		{
+			uint32 pos = system_state->post_read_pos;
+			PostedEvent* slot = &system_state->posted[pos % MAX_POSTED_EVENT_COUNT];
+			if (Threading::atomic_load(&slot->sequence) != pos + 1)
+				break;
+
+			PostedEvent* e = &system_state->dispatch_batch[batch_count++];
+			e->code = slot->code;
+			e->flags = slot->flags;
+			e->sender = slot->sender;
+			e->data = slot->data;
+
+			Threading::atomic_store(&slot->sequence, pos + MAX_POSTED_EVENT_COUNT);
+			system_state->post_read_pos = pos + 1;
+		}
+
+		if (!batch_count)
+			return;
+
+		uint16* last_index = system_state->coalesce_last_index;
+		for (uint32 i = 0; i < batch_count; i++)
+		{
+			PostedEvent* e = &system_state->dispatch_batch[i];
+			if (e->flags & EventPostFlags::CoalesceCode)
+				last_index[e->code] = (uint16)(i + 1);
+		}
+
+		for (uint32 i = 0; i < batch_count; i++)
+		{
+			PostedEvent* e = &system_state->dispatch_batch[i];
+
+			if ((e->flags & EventPostFlags::CoalesceCode) && last_index[e->code] != i + 1)
+				continue;
+
+			if (e->flags & EventPostFlags::CoalesceIdentical)
+			{
+				bool8 duplicate = false;
+				for (uint32 j = 0; j < i && !duplicate; j++)
+				{
+					PostedEvent* prev = &system_state->dispatch_batch[j];
+					duplicate = prev->code == e->code && prev->sender == e->sender &&
+						prev->data.i64[0] == e->data.i64[0] && prev->data.i64[1] == e->data.i64[1];
+				}
+
+				if (duplicate)
+					continue;
+			}
+
+			event_fire(e->code, e->sender, e->data);
+		}
+
+		for (uint32 i = 0; i < batch_count; i++)
+			last_index[system_state->dispatch_batch[i].code] = 0;
+	}
+
 }
 
@@ -61,6 +61,18 @@ namespace SystemEventCode
 	typedef uint8 Value;
 };
 
+namespace EventPostFlags
+{
+	enum : uint8
+	{
+		// NOTE: Only the last posted event of this code is dispatched per frame.
+		CoalesceCode = 1 << 0,
+		// NOTE: Events with the same code, sender and data as an earlier posted one are dropped for this frame.
+		CoalesceIdentical = 1 << 1
+	};
+	typedef uint8 Value;
+}
+
 namespace Event
 {
 
@@ -72,7 +84,12 @@ namespace Event
 	SHMAPI bool8 event_register(uint16 code, void* listener, FP_OnEvent on_event);
 	SHMAPI bool8 event_unregister(uint16 code, void* listener, FP_OnEvent on_event);
 
+	// NOTE: Dispatches to listeners immediately. Main thread only.
 	SHMAPI bool8 event_fire(uint16 code, void* sender, EventData data);
+	// NOTE: Queues the event for dispatch on the main thread at the next frame's dispatch point. Safe to call from any thread.
+	SHMAPI bool8 event_post(uint16 code, void* sender, EventData data, EventPostFlags::Value flags = 0);
+
+	void dispatch_posted_events();
 
 }
 
@@ -2,6 +2,10 @@
 #include "Logging.hpp"
 #include "Assert.hpp"
 #include "Console.hpp"
+#include "Memory.hpp"
+#include "Thread.hpp"
+#include "Mutex.hpp"
+#include "Atomic.hpp"
 #include "platform/Platform.hpp"
 #include "platform/FileSystem.hpp"
 
@@ -13,84 +17,389 @@
 namespace Log
 {
 
+#define LOG_RING_COUNT 16
+#define LOG_RING_SIZE (1 << 16)
+#define LOG_FILE_BATCH_SIZE (1 << 16)
+#define LOG_MESSAGE_MAX_LENGTH 4096
+#define LOG_WRITER_SLEEP_MS 2
+
+    struct RecordHeader
+    {
+        uint16 length;
+        uint8 level;
+        uint8 reserved;
+    };
+
+    // NOTE: Single producer (the owning thread), single consumer (whoever holds the drain mutex).
+    struct LogRing
+    {
+        volatile uint32 owner_thread_id;
+        volatile uint32 write_pos;
+        volatile uint32 read_pos;
+        uint8* data;
+    };
+
     struct SystemState
     {
         FileSystem::FileHandle log_file;
+        LogLevel max_level;
+
+        volatile uint32 writer_running;
+        Threading::Thread writer_thread;
+        Threading::Mutex drain_mutex;
+
+        // NOTE: Messages that went through the drain mutex instead of a ring, either because every ring was owned or because the thread's ring was full.
+        volatile uint32 ringless_write_count;
+        volatile uint32 full_ring_stall_count;
+
+        uint32 file_batch_size;
+        char file_batch[LOG_FILE_BATCH_SIZE];
+
+        LogRing rings[LOG_RING_COUNT];
     };
 
     static const char* level_strings[6] = { "[FATAL]: ", "[ERROR]: ", "[WARN]: ", "[INFO]: ", "[DEBUG]: ", "[TRACE]: " };
     static SystemState* system_state = 0;
 
+    static uint32 writer_thread_run(void* params);
+    static void drain_rings();
+    static void drain_rings_locked();
+    static void command_log_level(Console::CommandContext context);
+    static void command_log_stats(Console::CommandContext context);
+    static void log_stats(LogLevel level);
+
     bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config)
     {
-        system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+        SystemState* state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+        Memory::zero_memory(state, sizeof(SystemState));
+        state->max_level = LOG_LEVEL_TRACE;
 
         char dir[Constants::max_filepath_length];
         CString::copy(Platform::get_root_dir(), dir, Constants::max_filepath_length);
         CString::append(dir, Constants::max_filepath_length, "console.log");
-        if (!FileSystem::file_open(dir, FILE_MODE_WRITE, &system_state->log_file))
+        if (!FileSystem::file_open(dir, FILE_MODE_WRITE, &state->log_file))
         {
             Platform::console_write_error("Error: Unable to open console.log file for writing", LOG_LEVEL_ERROR);
             return false;
         }
 
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+            state->rings[i].data = (uint8*)allocator_callback(allocator, LOG_RING_SIZE);
+
+        if (!Threading::mutex_create(&state->drain_mutex))
+        {
+            Platform::console_write_error("Error: Unable to create log drain mutex", LOG_LEVEL_ERROR);
+            return false;
+        }
+
+        system_state = state;
+
+        system_state->writer_running = true;
+        if (!Threading::thread_create(writer_thread_run, 0, false, &system_state->writer_thread))
+        {
+            Platform::console_write_error("Error: Unable to create log writer thread", LOG_LEVEL_ERROR);
+            system_state->writer_running = false;
+        }
+
+        Console::register_command("log_level", 1, command_log_level);
+        Console::register_command("log_stats", 0, command_log_stats);
+
         return true;
     }
 
-    void system_shutdown(void* state) 
+    void system_shutdown(void* state)
     {
-        // TODO: cleanup logging/write queued entries.
+        Console::unregister_command("log_level");
+        Console::unregister_command("log_stats");
+
+        if (system_state->writer_running)
+        {
+            Threading::atomic_store(&system_state->writer_running, false);
+            while (Threading::thread_is_active(&system_state->writer_thread))
+                Platform::sleep(1);
+            Threading::thread_destroy(&system_state->writer_thread);
+        }
 
+        if (system_state->ringless_write_count || system_state->full_ring_stall_count)
+            log_stats(LOG_LEVEL_WARN);
+
+        drain_rings();
+
+        Threading::mutex_destroy(&system_state->drain_mutex);
         FileSystem::file_close(&system_state->log_file);
 
         system_state = 0;
     }
 
-    static void append_to_log_file(const char* message)
+    void set_level(LogLevel max_level)
+    {
+        if (system_state)
+            system_state->max_level = max_level;
+    }
+
+    LogLevel get_level()
     {
+        return system_state ? system_state->max_level : LOG_LEVEL_TRACE;
+    }
+
+    static void write_direct(LogLevel level, const char* message)
+    {
+        if (level < LOG_LEVEL_WARN)
+            Platform::console_write_error(message, (uint8)level);
+        else
+            Platform::console_write(message, (uint8)level);
+    }
+
+    static void flush_file_batch()
+    {
+        if (!system_state->file_batch_size)
+            return;
 
-        uint32 length = CString::length(message);
         uint32 written = 0;
+        if (!FileSystem::write(&system_state->log_file, system_state->file_batch_size, system_state->file_batch, &written))
+            Platform::console_write_error("Error: Unable to write to console.log file", LOG_LEVEL_ERROR);
+
+        system_state->file_batch_size = 0;
+    }
 
-        if (!FileSystem::write(&system_state->log_file, length, message, &written))
+    static void append_to_log_file(const char* message, uint32 length)
+    {
+        if (system_state->file_batch_size + length > LOG_FILE_BATCH_SIZE)
+            flush_file_batch();
+
+        if (length > LOG_FILE_BATCH_SIZE)
         {
-            Platform::console_write_error("Error: Unable to write to console.log file", LOG_LEVEL_ERROR);
+            uint32 written = 0;
+            FileSystem::write(&system_state->log_file, length, message, &written);
+            return;
+        }
+
+        Memory::copy_memory(message, system_state->file_batch + system_state->file_batch_size, length);
+        system_state->file_batch_size += length;
+    }
+
+    static void ring_read(LogRing* ring, uint32 pos, void* dest, uint32 size)
+    {
+        uint32 offset = pos & (LOG_RING_SIZE - 1);
+        uint32 first_part = LOG_RING_SIZE - offset;
+        if (first_part >= size)
+        {
+            Memory::copy_memory(ring->data + offset, dest, size);
+            return;
+        }
+
+        Memory::copy_memory(ring->data + offset, dest, first_part);
+        Memory::copy_memory(ring->data, (uint8*)dest + first_part, size - first_part);
+    }
+
+    static void ring_write(LogRing* ring, uint32 pos, const void* source, uint32 size)
+    {
+        uint32 offset = pos & (LOG_RING_SIZE - 1);
+        uint32 first_part = LOG_RING_SIZE - offset;
+        if (first_part >= size)
+        {
+            Memory::copy_memory(source, ring->data + offset, size);
+            return;
+        }
+
+        Memory::copy_memory(source, ring->data + offset, first_part);
+        Memory::copy_memory((uint8*)source + first_part, ring->data, size - first_part);
+    }
+
+    static LogRing* get_thread_ring()
+    {
+        uint32 thread_id = (uint32)Threading::get_thread_id();
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+        {
+            if (system_state->rings[i].owner_thread_id == thread_id)
+                return &system_state->rings[i];
+        }
+
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+        {
+            if (Threading::atomic_compare_exchange(&system_state->rings[i].owner_thread_id, thread_id, 0) == 0)
+                return &system_state->rings[i];
         }
 
+        return 0;
+    }
+
+    void release_thread_ring()
+    {
+        if (!system_state)
+            return;
+
+        uint32 thread_id = (uint32)Threading::get_thread_id();
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+        {
+            LogRing* ring = &system_state->rings[i];
+            if (ring->owner_thread_id != thread_id)
+                continue;
+
+            // NOTE: Drained before it is handed back, so the next owner starts out with an empty ring.
+            Threading::mutex_lock(system_state->drain_mutex);
+            drain_rings_locked();
+            Threading::atomic_store(&ring->owner_thread_id, 0);
+            Threading::mutex_unlock(system_state->drain_mutex);
+            return;
+        }
+    }
+
+    static bool8 ring_push(LogRing* ring, LogLevel level, const char* message, uint32 length)
+    {
+        RecordHeader header = { (uint16)length, (uint8)level, 0 };
+        uint32 record_size = (sizeof(RecordHeader) + length + 3) & ~3U;
+
+        uint32 write_pos = ring->write_pos;
+        uint32 read_pos = Threading::atomic_load(&ring->read_pos);
+        if (LOG_RING_SIZE - (write_pos - read_pos) < record_size)
+            return false;
+
+        ring_write(ring, write_pos, &header, sizeof(RecordHeader));
+        ring_write(ring, write_pos + sizeof(RecordHeader), message, length);
+        Threading::atomic_store(&ring->write_pos, write_pos + record_size);
+
+        return true;
+    }
+
+    static void drain_rings()
+    {
+        Threading::mutex_lock(system_state->drain_mutex);
+        drain_rings_locked();
+        flush_file_batch();
+        Threading::mutex_unlock(system_state->drain_mutex);
+    }
+
+    static void drain_rings_locked()
+    {
+        char message[LOG_MESSAGE_MAX_LENGTH + 1];
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+        {
+            LogRing* ring = &system_state->rings[i];
+            if (!ring->owner_thread_id)
+                continue;
+
+            uint32 read_pos = ring->read_pos;
+            uint32 write_pos = Threading::atomic_load(&ring->write_pos);
+            while (read_pos != write_pos)
+            {
+                RecordHeader header;
+                ring_read(ring, read_pos, &header, sizeof(RecordHeader));
+                ring_read(ring, read_pos + sizeof(RecordHeader), message, header.length);
+                message[header.length] = 0;
+
+                write_direct((LogLevel)header.level, message);
+                append_to_log_file(message, header.length);
+
+                read_pos += (sizeof(RecordHeader) + header.length + 3) & ~3U;
+            }
+            Threading::atomic_store(&ring->read_pos, read_pos);
+        }
+    }
+
+    // NOTE: Used when the ring is full or every ring is owned by another thread. Earlier ring records go out first, so the order per thread holds.
+    static void write_locked(LogLevel level, const char* message, uint32 length)
+    {
+        Threading::mutex_lock(system_state->drain_mutex);
+        drain_rings_locked();
+        write_direct(level, message);
+        append_to_log_file(message, length);
+        flush_file_batch();
+        Threading::mutex_unlock(system_state->drain_mutex);
+    }
+
+    static uint32 writer_thread_run(void* params)
+    {
+        while (Threading::atomic_load(&system_state->writer_running))
+        {
+            drain_rings();
+            Platform::sleep(LOG_WRITER_SLEEP_MS);
+        }
+
+        return 0;
+    }
+
+    static void command_log_level(Console::CommandContext context)
+    {
+        uint32 level = 0;
+        if (!CString::parse(context.arguments[0].value, &level) || level > LOG_LEVEL_TRACE)
+        {
+            SHMERRORV("Invalid log level '%s'. Expected 0 (fatal) to 5 (trace).", context.arguments[0].value);
+            return;
+        }
+
+        set_level((LogLevel)level);
+    }
+
+    static void command_log_stats(Console::CommandContext context)
+    {
+        log_stats(LOG_LEVEL_INFO);
+    }
+
+    static void log_stats(LogLevel level)
+    {
+        uint32 owned_ring_count = 0;
+        for (uint32 i = 0; i < LOG_RING_COUNT; i++)
+        {
+            if (Threading::atomic_load(&system_state->rings[i].owner_thread_id))
+                owned_ring_count++;
+        }
+
+        log_output(level, "Logging: %u/%u rings owned, %u messages written without a ring, %u stalls on a full ring.", owned_ring_count, LOG_RING_COUNT,
+            Threading::atomic_load(&system_state->ringless_write_count), Threading::atomic_load(&system_state->full_ring_stall_count));
+    }
+
+    void flush()
+    {
+        if (system_state)
+            drain_rings();
     }
 
     void log_output(LogLevel level, const char* message, ...) {
-        // TODO: Execute all of the logging stuff on another thread
 
-        bool8 is_error = level < LOG_LEVEL_WARN;
+        if (system_state && level > system_state->max_level)
+            return;
 
-        const uint32 msg_length = 4096;
-        char out_message[msg_length] = {};
+        char out_message[LOG_MESSAGE_MAX_LENGTH] = {};
 
-        CString::append(out_message, msg_length, level_strings[level]);
+        uint32 prefix_length = CString::length(level_strings[level]);
+        CString::copy(level_strings[level], out_message, LOG_MESSAGE_MAX_LENGTH);
 
         va_list arg_ptr;
         va_start(arg_ptr, message);
-        CString::print_s(out_message + (sizeof(level_strings[level])), msg_length - (sizeof(level_strings[level])), message, arg_ptr);
+        CString::print_s(out_message + prefix_length, LOG_MESSAGE_MAX_LENGTH - prefix_length, message, arg_ptr);
         va_end(arg_ptr);
 
-        CString::append(out_message, msg_length, "\n");
+        CString::append(out_message, LOG_MESSAGE_MAX_LENGTH, "\n");
+
+        // NOTE: Console consumers are called on the logging thread, same as before.
         Console::write_line(level, out_message);
 
-        // Platform-specific output.
-        if (is_error)
-            Platform::console_write_error(out_message, (uint8)level);
-        else
-            Platform::console_write(out_message, (uint8)level);
+        if (!system_state)
+        {
+            write_direct(level, out_message);
+            return;
+        }
 
-        if (system_state)
-            append_to_log_file(out_message);
+        uint32 length = CString::length(out_message);
+        LogRing* ring = get_thread_ring();
+        if (!ring)
+        {
+            Threading::atomic_increment(&system_state->ringless_write_count);
+            write_locked(level, out_message, length);
+        }
+        else if (!ring_push(ring, level, out_message, length))
+        {
+            Threading::atomic_increment(&system_state->full_ring_stall_count);
+            write_locked(level, out_message, length);
+        }
+        else if (level == LOG_LEVEL_FATAL || !system_state->writer_running)
+            drain_rings();
     }
 
 }
 
-void report_assertion_failure(const char* expression, const char* message, const char* file, int32 line) 
+void report_assertion_failure(const char* expression, const char* message, const char* file, int32 line)
 {
     Log::log_output(Log::LOG_LEVEL_FATAL, "Assertion Failure: %s, message: '%s', in file: %s, line: %d\n", expression, message, file, line);
 }
-
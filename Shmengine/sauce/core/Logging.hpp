@@ -32,6 +32,14 @@ namespace Log
     SHMAPI void log_output(LogLevel level, const char* message, ...);
     //SHMAPI void log_output(LogLevel level, const char* message);
 
+    // NOTE: Messages above this level are discarded before formatting.
+    SHMAPI void set_level(LogLevel max_level);
+    SHMAPI LogLevel get_level();
+    // NOTE: Blocks until every queued message has been written to the console and log file.
+    SHMAPI void flush();
+    // NOTE: Hands the calling thread's message ring back once its queued messages are written. Threads that log call this right before they exit.
+    SHMAPI void release_thread_ring();
+
 }
 
 // Logs a fatal-level message.
@@ -3,13 +3,21 @@
 #include "Logging.hpp"
 
 #include "Memory.hpp"
+#include "Atomic.hpp"
+#include "Mutex.hpp"
+#include "Thread.hpp"
 #include "ApplicationTypes.hpp"
 #include "Console.hpp"
 #include "Event.hpp"
 #include "Input.hpp"
 #include "FrameData.hpp"
+#include "Clock.hpp"
 #include "platform/Platform.hpp"
+#include "platform/AsyncIO.hpp"
+#include "platform/FileSystem.hpp"
+#include "Engine.hpp"
 #include "renderer/RendererFrontend.hpp"
+#include "systems/CookSystem.hpp"
 #include "systems/FontSystem.hpp"
 #include "systems/JobSystem.hpp"
 #include "systems/MaterialSystem.hpp"
@@ -22,15 +30,47 @@
 namespace SubsystemManager
 {
 
-	struct Subsystem
+	namespace SubsystemFlags
 	{
-		uint64 state_size;
-		void* state;
+		enum : uint8
+		{
+			// NOTE: Init only touches the system's own state, so it may run on a job thread next to other systems being initialized.
+			ParallelInit = 1 << 0,
+			// NOTE: Update may run on a job thread next to other updates of the same batch that do not touch the same data.
+			ParallelUpdate = 1 << 1
+		};
+		typedef uint8 Value;
+	}
 
-		FP_system_init init;
-		FP_system_shutdown shutdown;
-		FP_system_update update;
-	};
+	namespace UpdatePhase
+	{
+		enum : uint8
+		{
+			Early,
+			Default,
+			Late,
+
+			PhaseCount
+		};
+		typedef uint8 Value;
+	}
+
+	// NOTE: Coarse engine data domains a system update reads from or writes to. Updates sharing written domains never run in the same batch.
+	namespace SubsystemData
+	{
+		enum : uint32
+		{
+			Jobs = 1 << 0,
+			Input = 1 << 1,
+			Events = 1 << 2,
+			Platform = 1 << 3,
+			RenderState = 1 << 4,
+			Resources = 1 << 5,
+
+			All = 0xFFFFFFFF
+		};
+		typedef uint32 Value;
+	}
 
 	namespace SubsystemType
 	{
@@ -42,6 +82,8 @@ namespace SubsystemManager
 			Input,
 			Event,
 			Platform,
+			FileSystem,
+			CookSystem,
 
 			Renderer,
 			ShaderSystem,
@@ -50,6 +92,7 @@ namespace SubsystemManager
 			TextureSystem,
 			FontSystem,	
 			MaterialSystem,
+			AsyncIO,
 			KnownTypesCount,
 
 			MaxTypesCount = 128
@@ -57,22 +100,122 @@ namespace SubsystemManager
 		typedef uint8 Value;
 	}
 
+	struct Subsystem
+	{
+		static const uint32 max_dependency_count = 4;
+
+		const char* name;
+		uint64 state_size;
+		void* state;
+
+		FP_system_init init;
+		FP_system_shutdown shutdown;
+		FP_system_update update;
+
+		void* config;
+		SubsystemFlags::Value flags;
+		UpdatePhase::Value update_phase;
+		SubsystemData::Value update_reads;
+		SubsystemData::Value update_writes;
+		uint8 dependency_count;
+		SubsystemType::Value dependencies[max_dependency_count];
+
+		bool8 registered;
+		bool8 initialized;
+
+		// NOTE: Set by whichever thread claims a dispatched init first, the job thread or the main thread.
+		volatile uint32 init_claimed;
+		volatile uint32 init_finished;
+		bool8 init_succeeded;
+
+		float64 init_start_time;
+		float64 init_duration;
+		uint64 init_thread_id;
+	};
+
+	struct UpdateBatch
+	{
+		uint8 first_entry;
+		uint8 entry_count;
+	};
+
+	struct UpdateBatchContext
+	{
+		const FrameData* frame_data;
+		uint32 parallel_count;
+		uint32 parallel_entries[SubsystemType::MaxTypesCount];
+
+		volatile uint32 next_entry;
+		volatile uint32 completed_count;
+		volatile uint32 ref_count;
+	};
+
+	struct UpdateJobParams
+	{
+		UpdateBatchContext* context;
+	};
+
 	struct ManagerState
 	{
 		Memory::LinearAllocator allocator;
+		Threading::Mutex allocator_mutex;
+
+		float64 startup_time;
+
+		volatile uint32 finished_parallel_inits;
+
+		uint32 init_order_count;
+		uint32 basic_init_order_count;
+		SubsystemType::Value init_order[SubsystemType::MaxTypesCount];
+
+		bool8 update_schedule_built;
+		uint32 update_entry_count;
+		uint32 update_batch_count;
+		SubsystemType::Value update_entries[SubsystemType::MaxTypesCount];
+		UpdateBatch update_batches[SubsystemType::MaxTypesCount];
+
+		// NOTE: Written by whichever thread ran the update, read back on the main thread once the batch is done.
+		bool8 update_results[SubsystemType::MaxTypesCount];
+		float64 update_durations[SubsystemType::MaxTypesCount];
+
 		Subsystem subsystems[SubsystemType::MaxTypesCount];
 	};
 
 	static ManagerState manager_state = {};
 
-	static bool8 register_system(SubsystemType::Value type, FP_system_init init_callback, FP_system_shutdown shutdown_callback, FP_system_update update_callback, void* config);
+	static void register_system(SubsystemType::Value type, const char* name, FP_system_init init_callback, FP_system_shutdown shutdown_callback, FP_system_update update_callback, void* config, 
+		SubsystemFlags::Value flags = 0, uint32 dependency_count = 0, const SubsystemType::Value* dependencies = 0);
+	static void declare_update(SubsystemType::Value type, UpdatePhase::Value phase, SubsystemData::Value reads, SubsystemData::Value writes, bool8 parallel);
+	static bool8 init_registered_systems();
+	static void build_update_schedule();
+	static void update_system(uint32 entry_index, const FrameData* frame_data);
+	static bool8 init_system(SubsystemType::Value type);
+	static void mark_initialized(SubsystemType::Value type);
+	static void log_init_timeline();
+
 	static bool8 register_known_systems_pre_boot();
 	static bool8 register_known_systems_post_boot(const ApplicationConfig* app_config);
 
+	static bool8 init_system_job(uint32 thread_index, void* user_data);
+	static bool8 claim_init(SubsystemType::Value type);
+	static void run_claimed_init(SubsystemType::Value type);
+
+	static bool8 update_system_job(uint32 thread_index, void* user_data);
+	static void run_claimed_updates(UpdateBatchContext* context);
+	static void update_batch_context_release(UpdateBatchContext* context);
+
 	static void* allocate_system(void* allocator, uint64 size)
 	{
 		Memory::LinearAllocator* lin_allocator = (Memory::LinearAllocator*)allocator;
-		return lin_allocator->allocate(size);
+
+		// NOTE: Systems flagged for parallel init share the allocator with the systems initialized on the main thread.
+		if (manager_state.allocator_mutex)
+			Threading::mutex_lock(manager_state.allocator_mutex);
+		void* ret = lin_allocator->allocate(size);
+		if (manager_state.allocator_mutex)
+			Threading::mutex_unlock(manager_state.allocator_mutex);
+
+		return ret;
 	}
 
 	bool8 init_basic()
@@ -80,67 +223,313 @@ namespace SubsystemManager
 		Memory::SystemConfig mem_config;
 		mem_config.total_allocation_size = gibibytes(1);
 
-		if (!register_system(SubsystemType::Memory, Memory::system_init, Memory::system_shutdown, 0, &mem_config))
+		manager_state.startup_time = Platform::get_absolute_time();
+
+		register_system(SubsystemType::Memory, "Memory", Memory::system_init, Memory::system_shutdown, 0, &mem_config);
+		if (!init_system(SubsystemType::Memory))
 		{
 			SHMFATAL("Failed to register memory subsystem!");
 			return false;
 		}
+		mark_initialized(SubsystemType::Memory);
 
 		uint64 allocator_size = mebibytes(64);
 		manager_state.allocator.init(allocator_size);
 
-		return register_known_systems_pre_boot();
+		if (!Threading::mutex_create(&manager_state.allocator_mutex))
+		{
+			SHMFATAL("Failed to create subsystem allocator mutex!");
+			return false;
+		}
+
+		if (!register_known_systems_pre_boot())
+			return false;
+
+		manager_state.basic_init_order_count = manager_state.init_order_count;
+		return true;
 	}
 
 	bool8 init_advanced(const ApplicationConfig* app_config)
 	{
-		return register_known_systems_post_boot(app_config);
+		if (!register_known_systems_post_boot(app_config))
+			return false;
+
+		log_init_timeline();
+		build_update_schedule();
+		return true;
 	}
 
 	void shutdown_advanced()
 	{
-		for (int32 i = SubsystemType::MaterialSystem; i > SubsystemType::Event; i--)
-			manager_state.subsystems[i].shutdown(manager_state.subsystems[i].state);
+		manager_state.update_schedule_built = false;
+		manager_state.update_entry_count = 0;
+		manager_state.update_batch_count = 0;
+
+		for (int32 i = (int32)manager_state.init_order_count - 1; i >= (int32)manager_state.basic_init_order_count; i--)
+		{
+			Subsystem* s = &manager_state.subsystems[manager_state.init_order[i]];
+			s->shutdown(s->state);
+			s->initialized = false;
+		}
+		manager_state.init_order_count = manager_state.basic_init_order_count;
 	}
 
 	void shutdown_basic()
 	{
-		for (int32 i = SubsystemType::Event; i >= 0; i--)
-			manager_state.subsystems[i].shutdown(manager_state.subsystems[i].state);
+		for (int32 i = (int32)manager_state.basic_init_order_count - 1; i > 0; i--)
+		{
+			Subsystem* s = &manager_state.subsystems[manager_state.init_order[i]];
+			s->shutdown(s->state);
+			s->initialized = false;
+		}
+		manager_state.init_order_count = 1;
+		manager_state.basic_init_order_count = 1;
 
+		Threading::mutex_destroy(&manager_state.allocator_mutex);
 		manager_state.allocator.destroy();
+
+		// NOTE: Memory goes last, since the allocator mutex and the manager allocator live inside of it.
+		Subsystem* memory = &manager_state.subsystems[SubsystemType::Memory];
+		memory->shutdown(memory->state);
+		memory->initialized = false;
+		manager_state.init_order_count = 0;
+		manager_state.basic_init_order_count = 0;
 	}
 
 	bool8 update(const FrameData* frame_data)
 	{
 		OPTICK_EVENT();
-		for (uint32 i = 0; i < SubsystemType::MaxTypesCount; ++i) 
+
+		if (!manager_state.update_schedule_built)
+			build_update_schedule();
+
+		bool8 jobs_available = manager_state.subsystems[SubsystemType::JobSystem].initialized;
+
+		for (uint32 batch_i = 0; batch_i < manager_state.update_batch_count; batch_i++)
 		{
-			Subsystem* s = &manager_state.subsystems[i];
-			if (s->update) 
+			UpdateBatch* batch = &manager_state.update_batches[batch_i];
+			uint32 batch_end = batch->first_entry + batch->entry_count;
+
+			UpdateBatchContext* context = 0;
+			if (jobs_available && batch->entry_count > 1)
+			{
+				context = (UpdateBatchContext*)Memory::allocate(sizeof(UpdateBatchContext), AllocationTag::Job);
+				context->frame_data = frame_data;
+				context->parallel_count = 0;
+				context->next_entry = 0;
+				context->completed_count = 0;
+
+				for (uint32 i = batch->first_entry; i < batch_end; i++)
+				{
+					if (manager_state.subsystems[manager_state.update_entries[i]].flags & SubsystemFlags::ParallelUpdate)
+						context->parallel_entries[context->parallel_count++] = i;
+				}
+			}
+
+			// NOTE: Same scheme as the cook system. Helpers go straight to idle threads, the main thread runs the serial updates of the batch, 
+			// then works through whatever parallel updates nobody picked up and sleeps until the last one wakes it.
+			uint32 helper_count = context ? SHMIN(context->parallel_count, JobSystem::get_thread_count()) : 0;
+			if (context)
 			{
-				if (!s->update(s->state, frame_data)) 
+				context->ref_count = helper_count + 1;
+				for (uint32 i = 0; i < helper_count; i++)
 				{
-					SHMERRORV("System update failed for type: %u", i);
+					JobSystem::JobInfo job = JobSystem::job_create(update_system_job, 0, 0, sizeof(UpdateJobParams), JobSystem::JobTypeFlags::General, JobSystem::JobPriority::High);
+					UpdateJobParams* params = (UpdateJobParams*)job.user_data;
+					params->context = context;
+					JobSystem::submit(job);
 				}
 			}
+
+			for (uint32 i = batch->first_entry; i < batch_end; i++)
+			{
+				Subsystem* s = &manager_state.subsystems[manager_state.update_entries[i]];
+				if (context && (s->flags & SubsystemFlags::ParallelUpdate))
+					continue;
+
+				update_system(i, frame_data);
+			}
+
+			if (context)
+			{
+				run_claimed_updates(context);
+
+				uint32 completed_count;
+				while ((completed_count = Threading::atomic_load(&context->completed_count)) < context->parallel_count)
+					Threading::atomic_wait(&context->completed_count, completed_count);
+
+				update_batch_context_release(context);
+			}
+
+			// NOTE: Metrics and errors get reported from the main thread only, after the whole batch is done.
+			for (uint32 i = batch->first_entry; i < batch_end; i++)
+			{
+				SubsystemType::Value type = manager_state.update_entries[i];
+				metrics_update_subsystem(i, manager_state.subsystems[type].name, manager_state.update_durations[i]);
+				if (!manager_state.update_results[i])
+					SHMERRORV("System update failed for type: %u", type);
+			}
 		}
+
 		return true;
 	}
 
-	static bool8 register_system(SubsystemType::Value type, FP_system_init init_callback, FP_system_shutdown shutdown_callback, FP_system_update update_callback, void* config)
+	static void update_system(uint32 entry_index, const FrameData* frame_data)
+	{
+		SubsystemType::Value type = manager_state.update_entries[entry_index];
+		Subsystem* s = &manager_state.subsystems[type];
+
+		float64 start_time = Platform::get_absolute_time();
+		manager_state.update_results[entry_index] = s->update(s->state, frame_data);
+		manager_state.update_durations[entry_index] = Platform::get_absolute_time() - start_time;
+	}
+
+	static void run_claimed_updates(UpdateBatchContext* context)
+	{
+		while (true)
+		{
+			uint32 claim_index = Threading::atomic_increment(&context->next_entry) - 1;
+			if (claim_index >= context->parallel_count)
+				break;
+
+			update_system(context->parallel_entries[claim_index], context->frame_data);
+			if (Threading::atomic_increment(&context->completed_count) == context->parallel_count)
+				Threading::atomic_wake_all(&context->completed_count);
+		}
+	}
+
+	static void update_batch_context_release(UpdateBatchContext* context)
+	{
+		if (!Threading::atomic_decrement(&context->ref_count))
+			Memory::free_memory(context);
+	}
+
+	static bool8 update_system_job(uint32 thread_index, void* user_data)
+	{
+		UpdateJobParams* params = (UpdateJobParams*)user_data;
+		run_claimed_updates(params->context);
+		update_batch_context_release(params->context);
+		return true;
+	}
+
+	// NOTE: Collects the systems that actually have an update function, ordered by phase, and groups them into batches.
+	// A system lands in the batch after the last one containing a conflicting system, so declared data dependencies keep registration order.
+	static void build_update_schedule()
+	{
+		manager_state.update_entry_count = 0;
+		manager_state.update_batch_count = 0;
+
+		SubsystemData::Value batch_reads[SubsystemType::MaxTypesCount];
+		SubsystemData::Value batch_writes[SubsystemType::MaxTypesCount];
+		uint8 batch_counts[SubsystemType::MaxTypesCount];
+		SubsystemType::Value members[SubsystemType::MaxTypesCount];
+		uint8 member_batches[SubsystemType::MaxTypesCount];
+		uint32 batch_count = 0;
+		uint32 member_count = 0;
+
+		for (uint32 phase = 0; phase < UpdatePhase::PhaseCount; phase++)
+		{
+			uint32 phase_first_batch = batch_count;
+
+			for (uint32 i = 0; i < SubsystemType::MaxTypesCount; i++)
+			{
+				Subsystem* s = &manager_state.subsystems[i];
+				if (!s->initialized || !s->update || s->update_phase != phase)
+					continue;
+
+				uint32 target_batch = phase_first_batch;
+				for (uint32 b = phase_first_batch; b < batch_count; b++)
+				{
+					bool8 conflict = (s->update_writes & (batch_reads[b] | batch_writes[b])) || (s->update_reads & batch_writes[b]);
+					if (conflict || !(s->flags & SubsystemFlags::ParallelUpdate))
+						target_batch = b + 1;
+				}
+
+				if (target_batch == batch_count)
+				{
+					batch_reads[batch_count] = 0;
+					batch_writes[batch_count] = 0;
+					batch_counts[batch_count] = 0;
+					batch_count++;
+				}
+
+				batch_reads[target_batch] |= s->update_reads;
+				batch_writes[target_batch] |= s->update_writes;
+				batch_counts[target_batch]++;
+				members[member_count] = (SubsystemType::Value)i;
+				member_batches[member_count] = (uint8)target_batch;
+				member_count++;
+			}
+		}
+
+		for (uint32 b = 0; b < batch_count; b++)
+		{
+			UpdateBatch* batch = &manager_state.update_batches[manager_state.update_batch_count++];
+			batch->first_entry = (uint8)manager_state.update_entry_count;
+			batch->entry_count = batch_counts[b];
+
+			for (uint32 m = 0; m < member_count; m++)
+			{
+				if (member_batches[m] == b)
+					manager_state.update_entries[manager_state.update_entry_count++] = members[m];
+			}
+		}
+
+		manager_state.update_schedule_built = true;
+		SHMDEBUGV("Built subsystem update schedule: %u systems in %u batches.", manager_state.update_entry_count, manager_state.update_batch_count);
+	}
+
+	static void register_system(SubsystemType::Value type, const char* name, FP_system_init init_callback, FP_system_shutdown shutdown_callback, FP_system_update update_callback, void* config, 
+		SubsystemFlags::Value flags, uint32 dependency_count, const SubsystemType::Value* dependencies)
 	{
+		SHMASSERT_MSG(dependency_count <= Subsystem::max_dependency_count, "Subsystem dependency count exceeds limit!");
 
-		Subsystem sys;
+		Subsystem sys = {};
+		sys.name = name;
 		sys.init = init_callback;
 		sys.shutdown = shutdown_callback;
 		sys.update = update_callback;
+		sys.config = config;
+		sys.flags = flags;
+		sys.dependency_count = (uint8)dependency_count;
+		for (uint32 i = 0; i < dependency_count; i++)
+			sys.dependencies[i] = dependencies[i];
+		sys.registered = true;
+		sys.initialized = false;
+
+		// NOTE: Undeclared updates are assumed to touch everything and run serially.
+		sys.update_phase = UpdatePhase::Default;
+		sys.update_reads = SubsystemData::All;
+		sys.update_writes = SubsystemData::All;
 
-		if (sys.init)
+		manager_state.subsystems[type] = sys;
+	}
+
+	static void declare_update(SubsystemType::Value type, UpdatePhase::Value phase, SubsystemData::Value reads, SubsystemData::Value writes, bool8 parallel)
+	{
+		Subsystem* sys = &manager_state.subsystems[type];
+		sys->update_phase = phase;
+		sys->update_reads = reads;
+		sys->update_writes = writes;
+		if (parallel)
+			sys->flags |= SubsystemFlags::ParallelUpdate;
+		else
+			sys->flags &= ~SubsystemFlags::ParallelUpdate;
+
+		manager_state.update_schedule_built = false;
+	}
+
+	static bool8 init_system(SubsystemType::Value type)
+	{
+		Subsystem* sys = &manager_state.subsystems[type];
+		sys->init_start_time = Platform::get_absolute_time();
+		sys->init_thread_id = Threading::get_thread_id();
+
+		if (sys->init)
 		{
-			if (!sys.init(allocate_system, &manager_state.allocator, config))
+			if (!sys->init(allocate_system, &manager_state.allocator, sys->config))
 			{
-				SHMERROR("Failed to register system - init call failed.");
+				SHMERRORV("Failed to initialize system '%s' - init call failed.", sys->name);
 				return false;
 			}
 		}
@@ -150,40 +539,230 @@ namespace SubsystemManager
 			return false;
 		}
 
-		manager_state.subsystems[type] = sys;
+		sys->init_duration = Platform::get_absolute_time() - sys->init_start_time;
 		return true;
-
 	}
 
-	static bool8 register_known_systems_pre_boot()
+	static bool8 dependencies_initialized(const Subsystem* sys)
 	{
-		if (!register_system(SubsystemType::Console, Console::system_init, Console::system_shutdown, 0, 0))
+		for (uint32 i = 0; i < sys->dependency_count; i++)
 		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
+			if (!manager_state.subsystems[sys->dependencies[i]].initialized)
+				return false;
 		}
+		return true;
+	}
 
-		if (!register_system(SubsystemType::Logging, Log::system_init, Log::system_shutdown, 0, 0))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+	static void mark_initialized(SubsystemType::Value type)
+	{
+		manager_state.subsystems[type].initialized = true;
+		manager_state.init_order[manager_state.init_order_count++] = type;
+	}
 
-		if (!register_system(SubsystemType::Input, Input::system_init, Input::system_shutdown, 0, 0))
+	// NOTE: Initializes all registered but not yet initialized systems as soon as their dependencies are met. Once the job system is up, 
+	// systems flagged for parallel init get dispatched to it right away, while the main thread keeps initializing the other ready systems.
+	static bool8 init_registered_systems()
+	{
+		OPTICK_EVENT();
+
+		bool8 dispatched[SubsystemType::MaxTypesCount] = {};
+		uint32 pending_parallel_inits = 0;
+		bool8 parallel_init_failed = false;
+
+		while (true)
 		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
+			// NOTE: Loaded before collecting, so a job finishing in between makes the wait below return right away.
+			uint32 finished_parallel_inits = Threading::atomic_load(&manager_state.finished_parallel_inits);
+
+			// NOTE: Finished inits only get marked here, since the init order is owned by the main thread.
+			for (uint32 i = 0; i < SubsystemType::MaxTypesCount; i++)
+			{
+				Subsystem* sys = &manager_state.subsystems[i];
+				if (!dispatched[i] || sys->initialized || !Threading::atomic_load(&sys->init_finished))
+					continue;
+
+				Threading::atomic_store(&sys->init_finished, 0);
+				pending_parallel_inits--;
+				if (sys->init_succeeded)
+				{
+					mark_initialized((SubsystemType::Value)i);
+				}
+				else
+				{
+					SHMERRORV("Failed to initialize %s subsystem on job thread!", sys->name);
+					parallel_init_failed = true;
+				}
+			}
+
+			bool8 jobs_available = manager_state.subsystems[SubsystemType::JobSystem].initialized;
+			uint32 pending_count = 0;
+			int32 main_thread_type = -1;
+			int32 parallel_fallback_type = -1;
+
+			for (uint32 i = 0; i < SubsystemType::MaxTypesCount; i++)
+			{
+				Subsystem* sys = &manager_state.subsystems[i];
+				if (!sys->registered || sys->initialized)
+					continue;
+
+				pending_count++;
+				if (dispatched[i] || parallel_init_failed || !dependencies_initialized(sys))
+					continue;
+
+				if (!(sys->flags & SubsystemFlags::ParallelInit))
+				{
+					if (main_thread_type < 0)
+						main_thread_type = (int32)i;
+					continue;
+				}
+
+				if (!jobs_available)
+				{
+					// NOTE: Only initialized on the main thread if nothing else is ready, one of the other systems might be the one bringing up the job system.
+					if (parallel_fallback_type < 0)
+						parallel_fallback_type = (int32)i;
+					continue;
+				}
+
+				// NOTE: High priority hands the job straight to an idle thread instead of waiting for the next job system update.
+				dispatched[i] = true;
+				pending_parallel_inits++;
+				sys->init_claimed = 0;
+				sys->init_finished = 0;
+				JobSystem::JobInfo job = JobSystem::job_create(init_system_job, 0, 0, sizeof(SubsystemType::Value), JobSystem::JobTypeFlags::General, JobSystem::JobPriority::High);
+				*(SubsystemType::Value*)job.user_data = (SubsystemType::Value)i;
+				JobSystem::submit(job);
+			}
+
+			if (!pending_count)
+				return true;
+
+			int32 type = main_thread_type >= 0 ? main_thread_type : parallel_fallback_type;
+			if (type >= 0)
+			{
+				if (!init_system((SubsystemType::Value)type))
+				{
+					SHMFATALV("Failed to initialize %s subsystem!", manager_state.subsystems[type].name);
+					return false;
+				}
+				mark_initialized((SubsystemType::Value)type);
+				continue;
+			}
+
+			if (!pending_parallel_inits)
+			{
+				if (parallel_init_failed)
+					SHMFATAL("Failed to initialize subsystem on job thread!");
+				else
+					SHMFATAL("Failed to resolve subsystem dependencies - circular or missing dependency detected!");
+				return false;
+			}
+
+			// NOTE: Jobs that did not find an idle thread only get dispatched by the job system update, so the main thread initializes those itself 
+			// instead of pumping the update. Once every dispatched system is claimed, it sleeps until the next one finishes.
+			bool8 claimed = false;
+			for (uint32 i = 0; i < SubsystemType::MaxTypesCount && !claimed; i++)
+			{
+				if (dispatched[i] && !manager_state.subsystems[i].initialized && claim_init((SubsystemType::Value)i))
+				{
+					run_claimed_init((SubsystemType::Value)i);
+					claimed = true;
+				}
+			}
+
+			if (!claimed)
+				Threading::atomic_wait(&manager_state.finished_parallel_inits, finished_parallel_inits);
 		}
+	}
+
+	static bool8 claim_init(SubsystemType::Value type)
+	{
+		return Threading::atomic_compare_exchange(&manager_state.subsystems[type].init_claimed, 1, 0) == 0;
+	}
+
+	static void run_claimed_init(SubsystemType::Value type)
+	{
+		Subsystem* sys = &manager_state.subsystems[type];
+		sys->init_succeeded = init_system(type);
+		Threading::atomic_store(&sys->init_finished, 1);
+
+		Threading::atomic_increment(&manager_state.finished_parallel_inits);
+		Threading::atomic_wake_all(&manager_state.finished_parallel_inits);
+	}
+
+	static bool8 init_system_job(uint32 thread_index, void* user_data)
+	{
+		SubsystemType::Value type = *(SubsystemType::Value*)user_data;
+		if (claim_init(type))
+			run_claimed_init(type);
+		return true;
+	}
 
-		if (!register_system(SubsystemType::Event, Event::system_init, Event::system_shutdown, 0, 0))
+	static void log_init_timeline()
+	{
+		const uint32 bar_width = 40;
+		float64 total_time = Platform::get_absolute_time() - manager_state.startup_time;
+		if (total_time <= 0.0)
+			return;
+
+		SHMINFOV("Subsystem startup timeline (%lf3 ms total):", total_time * 1000.0);
+		for (uint32 i = 0; i < manager_state.init_order_count; i++)
 		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
+			Subsystem* sys = &manager_state.subsystems[manager_state.init_order[i]];
+			float64 start_offset = sys->init_start_time - manager_state.startup_time;
+
+			char bar[bar_width + 1];
+			uint32 bar_start = (uint32)((start_offset / total_time) * bar_width);
+			uint32 bar_end = (uint32)(((start_offset + sys->init_duration) / total_time) * bar_width);
+			for (uint32 c = 0; c < bar_width; c++)
+				bar[c] = (c >= bar_start && (c <= bar_end || c == bar_start)) ? '#' : '.';
+			bar[bar_width] = 0;
+
+			SHMINFOV("  [%s] %s: start %lf3 ms, duration %lf3 ms, thread %lu", bar, sys->name, start_offset * 1000.0, sys->init_duration * 1000.0, sys->init_thread_id);
 		}
+	}
 
-		if (!register_system(SubsystemType::Platform, Platform::system_init, Platform::system_shutdown, 0, 0))
+	static bool8 register_known_systems_pre_boot()
+	{
+		SubsystemType::Value logging_deps[] = { SubsystemType::Console };
+		SubsystemType::Value platform_deps[] = { SubsystemType::Logging, SubsystemType::Input, SubsystemType::Event };
+
+		register_system(SubsystemType::Console, "Console", Console::system_init, Console::system_shutdown, 0, 0);
+		register_system(SubsystemType::Logging, "Logging", Log::system_init, Log::system_shutdown, 0, 0, 0, 1, logging_deps);
+		register_system(SubsystemType::Input, "Input", Input::system_init, Input::system_shutdown, 0, 0);
+		register_system(SubsystemType::Event, "Event", Event::system_init, Event::system_shutdown, 0, 0);
+		register_system(SubsystemType::Platform, "Platform", Platform::system_init, Platform::system_shutdown, 0, 0, 0, 3, platform_deps);
+
+		char pack_filepath[Constants::max_filepath_length];
+		CString::safe_print_s<const char*, const char*>(pack_filepath, Constants::max_filepath_length, "%s%s", Engine::get_assets_base_path(), "assets.shmpak");
+
+		FileSystem::SystemConfig file_system_config;
+		file_system_config.root_path = Engine::get_assets_base_path();
+		file_system_config.pack_filepath = pack_filepath;
+#ifdef DEBUG
+		// NOTE: Development builds read edited loose files over their packed copies. Release builds read the pack and only go to disk for files it does not contain.
+		file_system_config.prefer_loose_files = true;
+#else
+		file_system_config.prefer_loose_files = false;
+#endif
+
+		SubsystemType::Value file_system_deps[] = { SubsystemType::Logging };
+		register_system(SubsystemType::FileSystem, "FileSystem", FileSystem::system_init, FileSystem::system_shutdown, 0, &file_system_config, 0, 1, file_system_deps);
+
+		char cook_manifest_filepath[Constants::max_filepath_length];
+		CString::safe_print_s<const char*, const char*>(cook_manifest_filepath, Constants::max_filepath_length, "%s%s", Engine::get_assets_base_path(), "assets.shmcook");
+
+		CookSystem::SystemConfig cook_sys_config;
+		cook_sys_config.root_path = Engine::get_assets_base_path();
+		cook_sys_config.manifest_filepath = cook_manifest_filepath;
+
+		// NOTE: Only reads the manifest here. Cooks get started from the console later on and pick up the job system if it is running by then.
+		SubsystemType::Value cook_sys_deps[] = { SubsystemType::FileSystem };
+		register_system(SubsystemType::CookSystem, "CookSystem", CookSystem::system_init, CookSystem::system_shutdown, 0, &cook_sys_config, 0, 1, cook_sys_deps);
+
+		if (!init_registered_systems())
 		{
-			SHMFATAL("Failed to register console subsystem!");
+			SHMFATAL("Failed to initialize basic subsystems!");
 			return false;
 		}
 
@@ -199,21 +778,16 @@ namespace SubsystemManager
 		renderer_sys_config.max_shader_uniform_count = 128;
 		renderer_sys_config.max_shader_global_textures = 8;
 		renderer_sys_config.max_shader_instance_textures = 16;
+		renderer_sys_config.texture_residency_budget = mebibytes(512);
 
-		if (!register_system(SubsystemType::Renderer, Renderer::system_init, Renderer::system_shutdown, 0, &renderer_sys_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		SubsystemType::Value renderer_deps[] = { SubsystemType::Platform };
+		register_system(SubsystemType::Renderer, "Renderer", Renderer::system_init, Renderer::system_shutdown, 0, &renderer_sys_config, 0, 1, renderer_deps);
 
 		ShaderSystem::SystemConfig shader_sys_config;
 		shader_sys_config.max_shader_count = 1024;
 
-		if (!register_system(SubsystemType::ShaderSystem, ShaderSystem::system_init, ShaderSystem::system_shutdown, 0, &shader_sys_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		SubsystemType::Value shader_sys_deps[] = { SubsystemType::Renderer };
+		register_system(SubsystemType::ShaderSystem, "ShaderSystem", ShaderSystem::system_init, ShaderSystem::system_shutdown, 0, &shader_sys_config, SubsystemFlags::ParallelInit, 1, shader_sys_deps);
 
 		const int32 max_thread_count = 15;
 		int32 thread_count = Platform::get_processor_count() - 1;
@@ -242,45 +816,48 @@ namespace SubsystemManager
 		job_system_config.job_thread_count = thread_count;
 		job_system_config.type_flags = job_thread_types;
 
-		if (!register_system(SubsystemType::JobSystem, JobSystem::system_init, JobSystem::system_shutdown, JobSystem::update, &job_system_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		// NOTE: Thread type assignment above already queries the renderer, so the job system has to wait for it as well.
+		SubsystemType::Value job_sys_deps[] = { SubsystemType::Renderer };
+		register_system(SubsystemType::JobSystem, "JobSystem", JobSystem::system_init, JobSystem::system_shutdown, JobSystem::update, &job_system_config, 0, 1, job_sys_deps);
+		// NOTE: Job results fire their completion callbacks from inside the update, so it has to stay on the main thread and run before everything else.
+		declare_update(SubsystemType::JobSystem, UpdatePhase::Early, SubsystemData::Jobs, SubsystemData::All, false);
+
+		AsyncIO::SystemConfig async_io_config;
+		async_io_config.max_in_flight_reads = 32;
+		async_io_config.max_pending_reads = 1024;
+
+		SubsystemType::Value async_io_deps[] = { SubsystemType::JobSystem };
+		register_system(SubsystemType::AsyncIO, "AsyncIO", AsyncIO::system_init, AsyncIO::system_shutdown, AsyncIO::update, &async_io_config, SubsystemFlags::ParallelInit, 1, async_io_deps);
+		// NOTE: Finished reads fire their callbacks and submit jobs, which keeps the update on the main thread.
+		declare_update(SubsystemType::AsyncIO, UpdatePhase::Early, SubsystemData::Resources, SubsystemData::Jobs, false);
 
 		RenderViewSystem::SystemConfig render_view_sys_config;
 		render_view_sys_config.max_view_count = 251;
 
-		if (!register_system(SubsystemType::RenderViewSystem, RenderViewSystem::system_init, RenderViewSystem::system_shutdown, 0, &render_view_sys_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		SubsystemType::Value render_view_sys_deps[] = { SubsystemType::ShaderSystem, SubsystemType::JobSystem };
+		register_system(SubsystemType::RenderViewSystem, "RenderViewSystem", RenderViewSystem::system_init, RenderViewSystem::system_shutdown, 0, &render_view_sys_config, 0, 2, render_view_sys_deps);
 
 		TextureSystem::SystemConfig texture_sys_config;
 		texture_sys_config.max_texture_count = 512;
 
-		if (!register_system(SubsystemType::TextureSystem, TextureSystem::system_init, TextureSystem::system_shutdown, 0, &texture_sys_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		SubsystemType::Value texture_sys_deps[] = { SubsystemType::Renderer, SubsystemType::JobSystem };
+		register_system(SubsystemType::TextureSystem, "TextureSystem", TextureSystem::system_init, TextureSystem::system_shutdown, 0, &texture_sys_config, 0, 2, texture_sys_deps);
 
 		FontSystem::SystemConfig font_sys_config;
 		font_sys_config.max_font_count = 31;
 
-		if (!register_system(SubsystemType::FontSystem, FontSystem::system_init, FontSystem::system_shutdown, 0, &font_sys_config))
-		{
-			SHMFATAL("Failed to register console subsystem!");
-			return false;
-		}
+		SubsystemType::Value font_sys_deps[] = { SubsystemType::TextureSystem };
+		register_system(SubsystemType::FontSystem, "FontSystem", FontSystem::system_init, FontSystem::system_shutdown, 0, &font_sys_config, SubsystemFlags::ParallelInit, 1, font_sys_deps);
 
 		MaterialSystem::SystemConfig material_sys_config;
 		material_sys_config.max_material_count = 0x1000;
 
-		if (!register_system(SubsystemType::MaterialSystem, MaterialSystem::system_init, MaterialSystem::system_shutdown, 0, &material_sys_config))
+		SubsystemType::Value material_sys_deps[] = { SubsystemType::ShaderSystem, SubsystemType::TextureSystem };
+		register_system(SubsystemType::MaterialSystem, "MaterialSystem", MaterialSystem::system_init, MaterialSystem::system_shutdown, 0, &material_sys_config, 0, 2, material_sys_deps);
+
+		if (!init_registered_systems())
 		{
-			SHMFATAL("Failed to register console subsystem!");
+			SHMFATAL("Failed to initialize advanced subsystems!");
 			return false;
 		}
 
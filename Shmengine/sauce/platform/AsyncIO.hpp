@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "core/Subsystems.hpp"
+#include "systems/JobSystem.hpp"
+
+struct FrameData;
+
+namespace AsyncIO
+{
+
+	// NOTE: Finished reads are only handed to the job system from update on the main thread, so code that blocks the main thread until its data is loaded
+	// (font batches, scenes, shader stages) can not wait on these reads and keeps using FileSystem directly. Plane and streamed textures read through here.
+	// NOTE: Jobs handed to read_file need their user data to start with this struct. It is filled in right before the job gets submitted.
+	// The job takes ownership of data and releases it with Memory::free_memory.
+	struct ReadResult
+	{
+		void* data;
+		uint64 size;
+		bool8 success;
+	};
+
+	struct SystemConfig
+	{
+		uint32 max_in_flight_reads;
+		uint32 max_pending_reads;
+	};
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config);
+	void system_shutdown(void* state);
+
+	bool8 update(void* state, const FrameData* frame_data);
+
+	// NOTE: Reads the whole file without blocking the caller and submits the job once the data is there, whether the read succeeded or not.
+	// Reads beyond the in-flight limit wait in a queue. Without the system running or for files inside the mounted pack, the file is read in place and the job submitted right away.
+	SHMAPI bool8 read_file(const char* path, JobSystem::JobInfo job);
+	// NOTE: Same as read_file, but only reads size bytes starting at offset. Fails if the range reaches past the end of the file.
+	SHMAPI bool8 read_file_range(const char* path, uint64 offset, uint64 size, JobSystem::JobInfo job);
+
+	SHMAPI uint32 get_in_flight_count();
+
+}
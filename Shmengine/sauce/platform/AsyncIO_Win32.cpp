@@ -0,0 +1,421 @@
+#include "AsyncIO.hpp"
+
+#include "core/Logging.hpp"
+#include "core/Memory.hpp"
+#include "core/Mutex.hpp"
+#include "core/Thread.hpp"
+#include "core/Atomic.hpp"
+#include "containers/RingQueue.hpp"
+#include "platform/FileSystem.hpp"
+#include "platform/Platform.hpp"
+#include "utility/CString.hpp"
+
+#if _WIN32
+
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+namespace AsyncIO
+{
+
+	// NOTE: ReadFile takes 32-bit sizes, larger files are read in chunks of this size.
+	static const uint32 max_read_chunk_size = 1 << 30;
+	static const ULONG_PTR shutdown_completion_key = (ULONG_PTR)-1;
+	static const uint32 max_finished_reads_per_update = 64;
+	static const uint64 whole_file_size = Constants::max_u64;
+
+	struct PendingRead
+	{
+		char path[Constants::max_filepath_length];
+		uint64 offset;
+		uint64 size;
+		JobSystem::JobInfo job;
+	};
+
+	struct ReadSlot
+	{
+		// NOTE: Must stay the first member, completion packets hand back a pointer to it.
+		OVERLAPPED overlapped;
+		HANDLE file;
+		uint8* data;
+		uint64 offset;
+		uint64 size;
+		uint64 bytes_read;
+		bool8 in_use;
+		bool8 success;
+		JobSystem::JobInfo job;
+	};
+
+	struct FinishedRead
+	{
+		JobSystem::JobInfo job;
+		void* data;
+		uint64 size;
+		bool8 success;
+	};
+
+	struct SystemState
+	{
+		HANDLE completion_port;
+		Threading::Thread completion_thread;
+		Threading::Mutex mutex;
+
+		volatile uint32 in_flight_count;
+
+		uint32 slot_count;
+		ReadSlot* slots;
+
+		// NOTE: Indices of slots whose reads finished on the completion thread, handed over to the main thread's update.
+		uint32 completed_count;
+		uint32* completed_slots;
+
+		RingQueue<PendingRead> pending_reads;
+	};
+
+	static SystemState* system_state = 0;
+
+	static uint32 completion_thread_run(void* params);
+	static bool8 read_range(const char* path, uint64 offset, uint64 size, JobSystem::JobInfo job);
+	static bool8 start_read(ReadSlot* slot, const char* path, uint64 offset, uint64 size);
+	static bool8 issue_read_chunk(ReadSlot* slot);
+	static void finish_read(ReadSlot* slot, bool8 success);
+	static void submit_result(JobSystem::JobInfo job, void* data, uint64 size, bool8 success);
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config)
+	{
+		SystemConfig* sys_config = (SystemConfig*)config;
+
+		system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+		Memory::zero_memory(system_state, sizeof(SystemState));
+
+		system_state->slot_count = sys_config->max_in_flight_reads;
+		system_state->slots = (ReadSlot*)allocator_callback(allocator, sizeof(ReadSlot) * system_state->slot_count);
+		Memory::zero_memory(system_state->slots, sizeof(ReadSlot) * system_state->slot_count);
+		system_state->completed_slots = (uint32*)allocator_callback(allocator, sizeof(uint32) * system_state->slot_count);
+
+		uint64 pending_size = system_state->pending_reads.get_external_size_requirement(sys_config->max_pending_reads);
+		system_state->pending_reads.init(sys_config->max_pending_reads, 0, AllocationTag::RingQueue, allocator_callback(allocator, pending_size));
+
+		if (!Threading::mutex_create(&system_state->mutex))
+		{
+			SHMFATAL("Failed to create async io mutex!");
+			return false;
+		}
+
+		system_state->completion_port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, 0, 0, 1);
+		if (!system_state->completion_port)
+		{
+			SHMFATAL("Failed to create io completion port!");
+			return false;
+		}
+
+		if (!Threading::thread_create(completion_thread_run, 0, false, &system_state->completion_thread))
+		{
+			SHMFATAL("Failed to create async io completion thread!");
+			return false;
+		}
+
+		return true;
+	}
+
+	void system_shutdown(void* state)
+	{
+		// NOTE: Wait for reads still in flight, their buffers are written to by the kernel.
+		while (Threading::atomic_load(&system_state->in_flight_count))
+			update(state, 0);
+
+		PostQueuedCompletionStatus(system_state->completion_port, 0, shutdown_completion_key, 0);
+		while (Threading::thread_is_active(&system_state->completion_thread))
+			Platform::sleep(1);
+		Threading::thread_destroy(&system_state->completion_thread);
+
+		while (system_state->pending_reads.count)
+		{
+			PendingRead* pending = system_state->pending_reads.dequeue();
+			submit_result(pending->job, 0, 0, false);
+		}
+
+		CloseHandle(system_state->completion_port);
+		Threading::mutex_destroy(&system_state->mutex);
+		system_state = 0;
+	}
+
+	bool8 update(void* state, const FrameData* frame_data)
+	{
+		FinishedRead finished[max_finished_reads_per_update];
+		uint32 finished_count = 0;
+
+		Threading::mutex_lock(system_state->mutex);
+
+		while (system_state->completed_count && finished_count < max_finished_reads_per_update)
+		{
+			ReadSlot* slot = &system_state->slots[system_state->completed_slots[--system_state->completed_count]];
+			finished[finished_count++] = { slot->job, slot->data, slot->size, slot->success };
+			slot->in_use = false;
+			slot->data = 0;
+		}
+
+		for (uint32 i = 0; i < system_state->slot_count && system_state->pending_reads.count && finished_count < max_finished_reads_per_update; i++)
+		{
+			ReadSlot* slot = &system_state->slots[i];
+			if (slot->in_use)
+				continue;
+
+			PendingRead* pending = system_state->pending_reads.dequeue();
+			slot->job = pending->job;
+			if (!start_read(slot, pending->path, pending->offset, pending->size))
+				finished[finished_count++] = { pending->job, 0, 0, false };
+		}
+
+		Threading::mutex_unlock(system_state->mutex);
+
+		// NOTE: Jobs get submitted outside the lock, since submission may run them right away.
+		for (uint32 i = 0; i < finished_count; i++)
+			submit_result(finished[i].job, finished[i].data, finished[i].size, finished[i].success);
+
+		return true;
+	}
+
+	bool8 read_file(const char* path, JobSystem::JobInfo job)
+	{
+		return read_range(path, 0, whole_file_size, job);
+	}
+
+	bool8 read_file_range(const char* path, uint64 offset, uint64 size, JobSystem::JobInfo job)
+	{
+		return read_range(path, offset, size, job);
+	}
+
+	uint32 get_in_flight_count()
+	{
+		return system_state ? Threading::atomic_load(&system_state->in_flight_count) : 0;
+	}
+
+	static bool8 read_range(const char* path, uint64 offset, uint64 size, JobSystem::JobInfo job)
+	{
+		// NOTE: Packed files are already mapped, reading them is a copy (or decompression) and not worth a trip through the completion port.
+		if (!system_state || FileSystem::is_packed(path))
+		{
+			FileSystem::FileHandle f;
+			if (!FileSystem::file_open(path, FILE_MODE_READ, &f))
+			{
+				submit_result(job, 0, 0, false);
+				return false;
+			}
+
+			uint8* data = 0;
+			bool8 success = false;
+			if (size == whole_file_size)
+			{
+				size = FileSystem::get_file_size64(&f);
+				data = (uint8*)Memory::allocate(size + 1, AllocationTag::Resource);
+				uint32 bytes_read = 0;
+				success = size <= Constants::max_u32 && FileSystem::read_all_bytes(&f, data, (uint32)size, &bytes_read);
+			}
+			else
+			{
+				// NOTE: File handles can not seek, ranges get copied out of a mapping instead.
+				FileSystem::FileMapping mapping;
+				success = FileSystem::map_file(&f, &mapping) && offset <= mapping.size && size <= mapping.size - offset;
+				if (success)
+				{
+					data = (uint8*)Memory::allocate(size + 1, AllocationTag::Resource);
+					Memory::copy_memory((uint8*)mapping.data + offset, data, size);
+				}
+
+				if (mapping.data)
+					FileSystem::unmap_file(&mapping);
+			}
+			FileSystem::file_close(&f);
+
+			if (!success)
+			{
+				if (data)
+					Memory::free_memory(data);
+				data = 0;
+				size = 0;
+			}
+
+			submit_result(job, data, size, success);
+			return success;
+		}
+
+		Threading::mutex_lock(system_state->mutex);
+
+		ReadSlot* free_slot = 0;
+		for (uint32 i = 0; i < system_state->slot_count; i++)
+		{
+			if (!system_state->slots[i].in_use)
+			{
+				free_slot = &system_state->slots[i];
+				break;
+			}
+		}
+
+		if (!free_slot)
+		{
+			if (system_state->pending_reads.count >= system_state->pending_reads.arr.capacity)
+			{
+				Threading::mutex_unlock(system_state->mutex);
+				SHMERRORV("Async read queue is full. Failed to queue read of file '%s'.", path);
+				submit_result(job, 0, 0, false);
+				return false;
+			}
+
+			PendingRead pending;
+			CString::copy(path, pending.path, Constants::max_filepath_length);
+			pending.offset = offset;
+			pending.size = size;
+			pending.job = job;
+			system_state->pending_reads.enqueue(pending);
+
+			Threading::mutex_unlock(system_state->mutex);
+			return true;
+		}
+
+		free_slot->job = job;
+		bool8 started = start_read(free_slot, path, offset, size);
+		ReadSlot failed_slot = *free_slot;
+
+		Threading::mutex_unlock(system_state->mutex);
+
+		if (!started)
+			submit_result(failed_slot.job, 0, 0, false);
+
+		return started;
+	}
+
+	// NOTE: Expects the state mutex to be held. Failed slots are left free again.
+	static bool8 start_read(ReadSlot* slot, const char* path, uint64 offset, uint64 size)
+	{
+		slot->data = 0;
+		slot->offset = offset;
+		slot->size = 0;
+		slot->bytes_read = 0;
+		slot->success = false;
+
+		slot->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+		if (slot->file == INVALID_HANDLE_VALUE)
+		{
+			SHMERRORV("Failed to open file for async reading: '%s'", path);
+			return false;
+		}
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(slot->file, &file_size) || !CreateIoCompletionPort(slot->file, system_state->completion_port, 0, 0))
+		{
+			SHMERRORV("Failed to prepare async read of file: '%s'", path);
+			CloseHandle(slot->file);
+			return false;
+		}
+
+		if (size == whole_file_size)
+			size = (uint64)file_size.QuadPart - offset;
+
+		if (offset > (uint64)file_size.QuadPart || size > (uint64)file_size.QuadPart - offset)
+		{
+			SHMERRORV("Async read range reaches past the end of file: '%s'", path);
+			CloseHandle(slot->file);
+			return false;
+		}
+
+		slot->size = size;
+		// NOTE: One extra byte so text consumers can terminate the data in place.
+		slot->data = (uint8*)Memory::allocate(slot->size + 1, AllocationTag::Resource);
+		slot->in_use = true;
+		Threading::atomic_increment(&system_state->in_flight_count);
+
+		if (!slot->size)
+		{
+			finish_read(slot, true);
+			return true;
+		}
+
+		if (!issue_read_chunk(slot))
+		{
+			SHMERRORV("Failed to issue async read of file: '%s'", path);
+			finish_read(slot, false);
+		}
+
+		return true;
+	}
+
+	static bool8 issue_read_chunk(ReadSlot* slot)
+	{
+		uint64 remaining = slot->size - slot->bytes_read;
+		DWORD chunk_size = (DWORD)(remaining < max_read_chunk_size ? remaining : max_read_chunk_size);
+
+		Memory::zero_memory(&slot->overlapped, sizeof(OVERLAPPED));
+		uint64 file_offset = slot->offset + slot->bytes_read;
+		slot->overlapped.Offset = (DWORD)(file_offset & 0xFFFFFFFF);
+		slot->overlapped.OffsetHigh = (DWORD)(file_offset >> 32);
+
+		// NOTE: Completion packets get queued even if ReadFile finishes synchronously.
+		if (!ReadFile(slot->file, slot->data + slot->bytes_read, chunk_size, 0, &slot->overlapped) && GetLastError() != ERROR_IO_PENDING)
+			return false;
+
+		return true;
+	}
+
+	static void finish_read(ReadSlot* slot, bool8 success)
+	{
+		CloseHandle(slot->file);
+		slot->file = 0;
+		slot->success = success;
+		if (!success)
+		{
+			Memory::free_memory(slot->data);
+			slot->data = 0;
+			slot->size = 0;
+		}
+
+		system_state->completed_slots[system_state->completed_count++] = (uint32)(slot - system_state->slots);
+		Threading::atomic_decrement(&system_state->in_flight_count);
+	}
+
+	static void submit_result(JobSystem::JobInfo job, void* data, uint64 size, bool8 success)
+	{
+		ReadResult* result = (ReadResult*)job.user_data;
+		result->data = data;
+		result->size = size;
+		result->success = success;
+		JobSystem::submit(job);
+	}
+
+	static uint32 completion_thread_run(void* params)
+	{
+		while (true)
+		{
+			DWORD bytes_transferred = 0;
+			ULONG_PTR completion_key = 0;
+			OVERLAPPED* overlapped = 0;
+			BOOL ok = GetQueuedCompletionStatus(system_state->completion_port, &bytes_transferred, &completion_key, &overlapped, INFINITE);
+
+			if (completion_key == shutdown_completion_key)
+				break;
+
+			if (!overlapped)
+				continue;
+
+			ReadSlot* slot = (ReadSlot*)overlapped;
+
+			Threading::mutex_lock(system_state->mutex);
+
+			slot->bytes_read += bytes_transferred;
+			if (!ok || !bytes_transferred)
+				finish_read(slot, false);
+			else if (slot->bytes_read >= slot->size)
+				finish_read(slot, true);
+			else if (!issue_read_chunk(slot))
+				finish_read(slot, false);
+
+			Threading::mutex_unlock(system_state->mutex);
+		}
+
+		Log::release_thread_ring();
+		return 0;
+	}
+
+}
+
+#endif
@@ -0,0 +1,526 @@
+#include "FileSystem.hpp"
+
+#include "core/Logging.hpp"
+#include "core/Memory.hpp"
+#include "core/Console.hpp"
+#include "containers/Darray.hpp"
+#include "containers/Sarray.hpp"
+#include "utility/CString.hpp"
+#include "utility/Compression.hpp"
+#include "utility/Utility.hpp"
+
+namespace FileSystem
+{
+
+	namespace PackCompression
+	{
+		enum : uint8
+		{
+			None,
+			Lz
+		};
+		typedef uint8 Value;
+	}
+
+	// NOTE: Pack layout: entry data (every entry aligned), the entries, the hash slots, the normalized path names and this footer at the very end.
+	struct PackFooter
+	{
+		uint64 entries_offset;
+		uint64 slots_offset;
+		uint64 names_offset;
+		uint64 names_size;
+		uint32 entry_count;
+		uint32 slot_count;
+		uint16 version;
+		uint16 reserved;
+		uint32 magic;
+	};
+
+	struct PackEntry
+	{
+		uint64 path_hash;
+		uint64 data_offset;
+		uint64 stored_size;
+		uint64 size;
+		uint32 name_offset;
+		uint16 name_length;
+		PackCompression::Value compression;
+		uint8 reserved;
+	};
+
+	struct PackSourceFile
+	{
+		char relative_path[Constants::max_filepath_length];
+	};
+
+	struct PackWriteContext
+	{
+		const PackWriteConfig* config;
+		Darray<PackSourceFile> files;
+	};
+
+	struct SystemState
+	{
+		char root_path[Constants::max_filepath_length];
+		uint32 root_path_length;
+		char pack_filepath[Constants::max_filepath_length];
+		bool8 prefer_loose_files;
+
+		FileHandle pack_file;
+		FileMapping pack_mapping;
+		const PackFooter* footer;
+		const PackEntry* entries;
+		const uint32* slots;
+		const char* names;
+	};
+
+	static const uint32 pack_magic = 0x4B415053; // "SPAK"
+	static const uint16 pack_version = 1;
+	// NOTE: Keeps entries cache line aligned inside the mapping, so loaders can read them in place.
+	static const uint32 pack_entry_alignment = 64;
+	static const uint32 pack_empty_slot = Constants::max_u32;
+	static const char* pack_extension = ".shmpak";
+
+	static SystemState* system_state = 0;
+
+	static bool8 _mount_pack(const char* pack_filepath);
+	static void _unmount_pack();
+	static void command_pack_assets(Console::CommandContext context);
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config)
+	{
+		SystemConfig* sys_config = (SystemConfig*)config;
+
+		system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+		Memory::zero_memory(system_state, sizeof(SystemState));
+
+		system_state->root_path_length = CString::copy(sys_config->root_path, system_state->root_path, Constants::max_filepath_length);
+		system_state->prefer_loose_files = sys_config->prefer_loose_files;
+		if (sys_config->pack_filepath)
+			CString::copy(sys_config->pack_filepath, system_state->pack_filepath, Constants::max_filepath_length);
+
+		Console::register_command("pack_assets", 0, command_pack_assets);
+
+		// NOTE: Without a mounted pack every lookup hits the disk.
+		if (!system_state->pack_filepath[0] || !file_exists(system_state->pack_filepath))
+			return true;
+
+		if (!_mount_pack(system_state->pack_filepath))
+			SHMWARNV("Failed to mount asset pack '%s'. Falling back to loose files.", system_state->pack_filepath);
+
+		return true;
+	}
+
+	void system_shutdown(void* state)
+	{
+		Console::unregister_command("pack_assets");
+		_unmount_pack();
+		system_state = 0;
+	}
+
+	static SHMINLINE char _normalize_path_char(char c)
+	{
+		if (c == '\\')
+			return '/';
+		if (c >= 'A' && c <= 'Z')
+			return c + ('a' - 'A');
+		return c;
+	}
+
+	// NOTE: 64-bit FNV-1a over the normalized path, so lookups do not care about case or slash direction.
+	uint64 hash_path(const char* path)
+	{
+		// NOTE: Normalized in blocks, chaining the seed gives the same result as hashing the whole normalized path at once.
+		char block[64];
+		uint64 hash = hash_fnv1a64(0, 0);
+		while (*path)
+		{
+			uint32 length = 0;
+			while (*path && length < sizeof(block))
+				block[length++] = _normalize_path_char(*path++);
+			hash = hash_fnv1a64(block, length, hash);
+		}
+		return hash;
+	}
+
+	static bool8 _path_has_prefix(const char* path, const char* prefix, uint32 prefix_length)
+	{
+		for (uint32 i = 0; i < prefix_length; i++)
+		{
+			if (!path[i] || _normalize_path_char(path[i]) != _normalize_path_char(prefix[i]))
+				return false;
+		}
+		return true;
+	}
+
+	static bool8 _path_equal(const char* path, const char* packed_name, uint32 packed_name_length)
+	{
+		for (uint32 i = 0; i < packed_name_length; i++)
+		{
+			if (!path[i] || _normalize_path_char(path[i]) != packed_name[i])
+				return false;
+		}
+		return !path[packed_name_length];
+	}
+
+	static const PackEntry* _find_entry(const char* path)
+	{
+		if (!system_state || !system_state->footer || !_path_has_prefix(path, system_state->root_path, system_state->root_path_length))
+			return 0;
+
+		const char* relative_path = path + system_state->root_path_length;
+		uint64 hash = hash_path(relative_path);
+		uint32 slot_mask = system_state->footer->slot_count - 1;
+		for (uint32 i = 0; i < system_state->footer->slot_count; i++)
+		{
+			uint32 entry_index = system_state->slots[(hash + i) & slot_mask];
+			if (entry_index == pack_empty_slot)
+				return 0;
+
+			const PackEntry* entry = &system_state->entries[entry_index];
+			if (entry->path_hash == hash && _path_equal(relative_path, &system_state->names[entry->name_offset], entry->name_length))
+				return entry;
+		}
+
+		return 0;
+	}
+
+	bool8 prefers_loose_files()
+	{
+		return system_state && system_state->prefer_loose_files;
+	}
+
+	bool8 pack_file_exists(const char* path)
+	{
+		return _find_entry(path) != 0;
+	}
+
+	bool8 pack_file_open(const char* path, FileHandle* out_file, bool8* out_loose_allowed)
+	{
+		*out_loose_allowed = true;
+		const PackEntry* entry = _find_entry(path);
+		if (!entry)
+			return false;
+
+		const uint8* stored_data = (const uint8*)system_state->pack_mapping.data + entry->data_offset;
+		if (entry->compression == PackCompression::Lz)
+		{
+			void* data = Memory::allocate(entry->size, AllocationTag::Resource);
+			if (!Compression::lz_decompress(stored_data, entry->stored_size, data, entry->size))
+			{
+				SHMERRORV("Failed to decompress packed file '%s'.", path);
+				Memory::free_memory(data);
+				// NOTE: A corrupted pack should not silently pick up stale loose files.
+				*out_loose_allowed = false;
+				return false;
+			}
+
+			out_file->pack_allocation = data;
+			out_file->pack_data = (const uint8*)data;
+		}
+		else
+		{
+			out_file->pack_allocation = 0;
+			out_file->pack_data = stored_data;
+		}
+
+		out_file->handle = 0;
+		out_file->pack_size = entry->size;
+		out_file->pack_read_offset = 0;
+		out_file->is_valid = true;
+		return true;
+	}
+
+	bool8 is_packed(const char* path)
+	{
+		if (!_find_entry(path))
+			return false;
+
+		return !system_state->prefer_loose_files || !loose_file_exists(path);
+	}
+
+	bool8 is_pack_mounted()
+	{
+		return system_state && system_state->footer;
+	}
+
+	static bool8 _mount_pack(const char* pack_filepath)
+	{
+		if (!file_open(pack_filepath, FILE_MODE_READ, &system_state->pack_file))
+			return false;
+
+		// NOTE: The whole pack stays mapped, every packed file gets served from this one handle.
+		if (!map_file(&system_state->pack_file, &system_state->pack_mapping) || system_state->pack_mapping.size < sizeof(PackFooter))
+		{
+			_unmount_pack();
+			return false;
+		}
+
+		const uint8* pack_data = (const uint8*)system_state->pack_mapping.data;
+		uint64 pack_size = system_state->pack_mapping.size;
+		const PackFooter* footer = (const PackFooter*)(pack_data + pack_size - sizeof(PackFooter));
+
+		bool8 valid =
+			footer->magic == pack_magic &&
+			footer->version == pack_version &&
+			footer->slot_count && !(footer->slot_count & (footer->slot_count - 1)) &&
+			footer->entries_offset + (uint64)footer->entry_count * sizeof(PackEntry) <= pack_size &&
+			footer->slots_offset + (uint64)footer->slot_count * sizeof(uint32) <= pack_size &&
+			footer->names_offset + footer->names_size <= pack_size;
+
+		if (!valid)
+		{
+			SHMERRORV("Asset pack '%s' has an invalid or outdated table of contents.", pack_filepath);
+			_unmount_pack();
+			return false;
+		}
+
+		const PackEntry* entries = (const PackEntry*)(pack_data + footer->entries_offset);
+		for (uint32 i = 0; i < footer->entry_count; i++)
+		{
+			if (entries[i].data_offset + entries[i].stored_size > pack_size || (uint64)entries[i].name_offset + entries[i].name_length > footer->names_size)
+			{
+				SHMERRORV("Asset pack '%s' has entries pointing outside of the file.", pack_filepath);
+				_unmount_pack();
+				return false;
+			}
+		}
+
+		system_state->entries = entries;
+		system_state->slots = (const uint32*)(pack_data + footer->slots_offset);
+		system_state->names = (const char*)(pack_data + footer->names_offset);
+		system_state->footer = footer;
+
+		SHMINFOV("Mounted asset pack '%s' with %u files.", pack_filepath, footer->entry_count);
+		return true;
+	}
+
+	static void _unmount_pack()
+	{
+		system_state->footer = 0;
+		system_state->entries = 0;
+		system_state->slots = 0;
+		system_state->names = 0;
+		unmap_file(&system_state->pack_mapping);
+		file_close(&system_state->pack_file);
+	}
+
+	static bool8 _has_extension(const char* path, const char* extension)
+	{
+		uint32 path_length = CString::length(path);
+		uint32 extension_length = CString::length(extension);
+		return path_length >= extension_length && CString::equal_i(&path[path_length - extension_length], extension);
+	}
+
+	static void _collect_pack_file(const char* relative_path, void* user_data)
+	{
+		PackWriteContext* context = (PackWriteContext*)user_data;
+		if (_has_extension(relative_path, pack_extension))
+			return;
+
+		for (uint32 i = 0; i < context->config->excluded_extension_count; i++)
+		{
+			if (_has_extension(relative_path, context->config->excluded_extensions[i]))
+				return;
+		}
+
+		PackSourceFile* file = &context->files[context->files.emplace()];
+		CString::copy(relative_path, file->relative_path, Constants::max_filepath_length);
+	}
+
+	static bool8 _pack_write_bytes(FileHandle* file, const void* data, uint64 size, uint64* write_offset)
+	{
+		uint32 written = 0;
+		if (size && (!write(file, (uint32)size, data, &written) || written != size))
+			return false;
+
+		*write_offset += size;
+		return true;
+	}
+
+	static bool8 _pack_write_padding(FileHandle* file, uint64 alignment, uint64* write_offset)
+	{
+		static const uint8 zeros[pack_entry_alignment] = {};
+		uint64 padding = (alignment - (*write_offset % alignment)) % alignment;
+		return _pack_write_bytes(file, zeros, padding, write_offset);
+	}
+
+	bool8 pack_write(const PackWriteConfig* config)
+	{
+		// NOTE: Sources get read through file_open, which would resolve them through a mounted pack instead of the disk.
+		if (system_state && system_state->footer)
+		{
+			SHMERROR("Cannot write an asset pack while one is mounted. Remove the pack and restart to repack from loose files.");
+			return false;
+		}
+
+		PackWriteContext context = {};
+		context.config = config;
+		context.files.init(256, 0, AllocationTag::Resource);
+		iterate_directory(config->root_path, _collect_pack_file, &context);
+
+		if (!context.files.count)
+		{
+			SHMERRORV("No files found to pack below '%s'.", config->root_path);
+			context.files.free_data();
+			return false;
+		}
+
+		FileHandle pack_file;
+		if (!file_open(config->pack_filepath, FILE_MODE_WRITE, &pack_file))
+		{
+			context.files.free_data();
+			return false;
+		}
+
+		SHMINFOV("Writing asset pack '%s' with %u files...", config->pack_filepath, context.files.count);
+
+		Darray<PackEntry> entries(context.files.count, 0, AllocationTag::Resource);
+		Darray<uint32> entry_file_indices(context.files.count, 0, AllocationTag::Resource);
+		uint64 write_offset = 0;
+		uint64 names_size = 0;
+		uint64 total_size = 0;
+		bool8 success = true;
+
+		for (uint32 i = 0; i < context.files.count && success; i++)
+		{
+			const char* relative_path = context.files[i].relative_path;
+			char full_path[Constants::max_filepath_length];
+			CString::safe_print_s<const char*, const char*>(full_path, Constants::max_filepath_length, "%s%s", config->root_path, relative_path);
+
+			FileHandle source_file;
+			if (!file_open(full_path, FILE_MODE_READ, &source_file))
+			{
+				success = false;
+				break;
+			}
+
+			uint64 size = get_file_size64(&source_file);
+			if (size > Constants::max_u32)
+			{
+				SHMWARNV("Skipping '%s', files above 4GiB cannot be packed.", full_path);
+				file_close(&source_file);
+				continue;
+			}
+
+			void* data = size ? Memory::allocate(size, AllocationTag::Resource) : 0;
+			uint32 bytes_read = 0;
+			if (size && !read_all_bytes(&source_file, data, (uint32)size, &bytes_read))
+			{
+				SHMERRORV("Failed to read '%s' for packing.", full_path);
+				Memory::free_memory(data);
+				file_close(&source_file);
+				success = false;
+				break;
+			}
+			file_close(&source_file);
+
+			PackEntry entry = {};
+			entry.path_hash = hash_path(relative_path);
+			entry.size = size;
+			entry.stored_size = size;
+			entry.compression = PackCompression::None;
+			entry.name_offset = (uint32)names_size;
+			entry.name_length = (uint16)CString::length(relative_path);
+			names_size += entry.name_length;
+
+			const void* stored_data = data;
+			void* compressed_data = 0;
+			if (config->compress && size)
+			{
+				uint64 compressed_capacity = size - size / 8;
+				compressed_data = Memory::allocate(compressed_capacity, AllocationTag::Resource);
+				uint64 compressed_size = Compression::lz_compress(data, size, compressed_data, compressed_capacity);
+				if (compressed_size)
+				{
+					entry.compression = PackCompression::Lz;
+					entry.stored_size = compressed_size;
+					stored_data = compressed_data;
+				}
+			}
+
+			success = _pack_write_padding(&pack_file, pack_entry_alignment, &write_offset);
+			entry.data_offset = write_offset;
+			success = success && _pack_write_bytes(&pack_file, stored_data, entry.stored_size, &write_offset);
+
+			total_size += size;
+			entries.push(entry);
+			entry_file_indices.push(i);
+
+			if (compressed_data)
+				Memory::free_memory(compressed_data);
+			if (data)
+				Memory::free_memory(data);
+		}
+
+		// NOTE: Open addressing with linear probing, kept at most half full.
+		uint32 slot_count = 16;
+		while (slot_count < entries.count * 2)
+			slot_count *= 2;
+
+		Sarray<uint32> slots(slot_count, 0, AllocationTag::Resource);
+		for (uint32 i = 0; i < slot_count; i++)
+			slots[i] = pack_empty_slot;
+		for (uint32 i = 0; i < entries.count; i++)
+		{
+			uint32 slot = (uint32)(entries[i].path_hash & (slot_count - 1));
+			while (slots[slot] != pack_empty_slot)
+				slot = (slot + 1) & (slot_count - 1);
+			slots[slot] = i;
+		}
+
+		PackFooter footer = {};
+		footer.magic = pack_magic;
+		footer.version = pack_version;
+		footer.entry_count = entries.count;
+		footer.slot_count = slot_count;
+		footer.names_size = names_size;
+
+		success = success && _pack_write_padding(&pack_file, sizeof(uint64), &write_offset);
+		footer.entries_offset = write_offset;
+		success = success && _pack_write_bytes(&pack_file, entries.data, entries.count * sizeof(PackEntry), &write_offset);
+		footer.slots_offset = write_offset;
+		success = success && _pack_write_bytes(&pack_file, slots.data, slot_count * sizeof(uint32), &write_offset);
+		footer.names_offset = write_offset;
+
+		// NOTE: Names get stored normalized, in the same order their offsets were handed out.
+		for (uint32 i = 0; i < entries.count && success; i++)
+		{
+			const char* relative_path = context.files[entry_file_indices[i]].relative_path;
+			char normalized_name[Constants::max_filepath_length];
+			for (uint32 c = 0; c < entries[i].name_length; c++)
+				normalized_name[c] = _normalize_path_char(relative_path[c]);
+			success = _pack_write_bytes(&pack_file, normalized_name, entries[i].name_length, &write_offset);
+		}
+
+		success = success && _pack_write_bytes(&pack_file, &footer, sizeof(footer), &write_offset);
+		file_close(&pack_file);
+
+		if (success)
+			SHMINFOV("Packed %u files, %lu bytes into %lu bytes.", entries.count, total_size, write_offset);
+		else
+			SHMERRORV("Failed to write asset pack '%s'.", config->pack_filepath);
+
+		slots.free_data();
+		entry_file_indices.free_data();
+		entries.free_data();
+		context.files.free_data();
+		return success;
+	}
+
+	static void command_pack_assets(Console::CommandContext context)
+	{
+		// NOTE: Shader sources only matter to the shader compiler, the engine loads the compiled spir-v.
+		const char* excluded_extensions[] = { ".glsl" };
+
+		PackWriteConfig config = {};
+		config.root_path = system_state->root_path;
+		config.pack_filepath = system_state->pack_filepath;
+		config.compress = true;
+		config.excluded_extension_count = sizeof(excluded_extensions) / sizeof(excluded_extensions[0]);
+		config.excluded_extensions = excluded_extensions;
+
+		pack_write(&config);
+	}
+
+}
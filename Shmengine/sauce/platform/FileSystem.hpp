@@ -4,6 +4,7 @@
 
 #include "platform/Platform.hpp"
 #include "utility/String.hpp"
+#include "core/Subsystems.hpp"
 
 enum FileMode
 {
@@ -18,20 +19,82 @@ namespace FileSystem
 	{
 		bool8 is_valid;
 		void* handle;
+
+		// NOTE: Set for files resolved through the mounted pack. Reads get served from the pack's mapping (or the decompressed copy) instead of the os handle.
+		const uint8* pack_data;
+		uint64 pack_size;
+		uint64 pack_read_offset;
+		void* pack_allocation;
+	};
+
+	// NOTE: Read-only view of a whole file. Stays valid after the file handle it was created from is closed.
+	struct FileMapping
+	{
+		void* data;
+		uint64 size;
+		void* handle;
+		// NOTE: Owned copy for compressed pack entries, released on unmap.
+		void* allocation;
+	};
+
+	struct SystemConfig
+	{
+		// NOTE: Paths starting with root_path get looked up in the pack, paths missing from it go to disk. Without a pack file every path goes to disk.
+		const char* root_path;
+		const char* pack_filepath;
+		// NOTE: Loose files on disk take precedence over their packed copies, so edits show up without repacking.
+		bool8 prefer_loose_files;
 	};
 
+	struct PackWriteConfig
+	{
+		const char* root_path;
+		const char* pack_filepath;
+		// NOTE: Entries only get stored compressed if that saves at least an eighth of their size.
+		bool8 compress;
+		uint32 excluded_extension_count;
+		const char** excluded_extensions;
+	};
+
+	typedef void (*FP_file_found)(const char* relative_path, void* user_data);
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config);
+	void system_shutdown(void* state);
+
+	// NOTE: Packs every file below root_path into a single archive with a hashed table of contents.
+	SHMAPI bool8 pack_write(const PackWriteConfig* config);
+	// NOTE: Case and slash insensitive FNV-1a of a path. The pack table of contents and the cook manifest key their entries by it.
+	SHMAPI uint64 hash_path(const char* path);
+	SHMAPI bool8 is_packed(const char* path);
+	SHMAPI bool8 is_pack_mounted();
+	// NOTE: Only loose files on disk, does not look at the mounted pack.
+	SHMAPI bool8 iterate_directory(const char* directory, FP_file_found callback, void* user_data);
+
+	// NOTE: Resolve the path through the mounted pack. Used by the platform layer, which asks prefers_loose_files whether to touch the disk first.
+	bool8 prefers_loose_files();
+	bool8 pack_file_exists(const char* path);
+	bool8 pack_file_open(const char* path, FileHandle* out_file, bool8* out_loose_allowed);
+	// NOTE: Only the disk, does not look at the mounted pack.
+	bool8 loose_file_exists(const char* path);
+
 	SHMAPI bool8 file_exists(const char* path);
 	SHMAPI uint32 get_file_size32(FileHandle* file);
+	SHMAPI uint64 get_file_size64(FileHandle* file);
 
 	SHMAPI bool8 file_open(const char* path, FileMode mode, FileHandle* out_file);
 	SHMAPI void file_close(FileHandle* file);
 
 	SHMAPI Platform::ReturnCode file_copy(const char* source, const char* dest, bool8 overwrite);
+	// NOTE: Succeeds if the directory exists already. Parent directories have to exist.
+	SHMAPI bool8 create_directory(const char* path);
 
 	SHMAPI bool8 read_bytes(FileHandle* file, uint32 size, void* out_buffer, uint32 out_buffer_size, uint32* out_bytes_read);
 	SHMAPI bool8 read_all_bytes(FileHandle* file, void* out_buffer, uint32 out_buffer_size, uint32* out_bytes_read);
 	SHMAPI int32 read_line(const char* file_buffer, char* line_buffer, uint32 line_buffer_size, const char** out_continue_ptr = 0);
 
+	SHMAPI bool8 map_file(FileHandle* file, FileMapping* out_mapping);
+	SHMAPI void unmap_file(FileMapping* mapping);
+
 	SHMAPI bool8 write(FileHandle* file, uint32 size, const void* data, uint32* out_bytes_written);
 
 	SHMAPI bool8 read_bytes(FileHandle* file, uint32 size, String& out_buffer, uint32* out_bytes_read);
@@ -13,7 +13,13 @@
 namespace FileSystem
 {
 
-	bool8 file_exists(const char* path)
+	// NOTE: Pack entries carry no os handle, their reads are served from memory.
+	static SHMINLINE bool8 is_pack_handle(const FileHandle* file)
+	{
+		return file->is_valid && !file->handle;
+	}
+
+	bool8 loose_file_exists(const char* path)
 	{
 		DWORD dwAttrib = GetFileAttributesA(path);
 
@@ -21,8 +27,19 @@ namespace FileSystem
 			!(dwAttrib & FILE_ATTRIBUTE_DIRECTORY));
 	}
 
+	bool8 file_exists(const char* path)
+	{
+		if (prefers_loose_files())
+			return loose_file_exists(path) || pack_file_exists(path);
+
+		return pack_file_exists(path) || loose_file_exists(path);
+	}
+
 	static int64 get_file_size(FileHandle* file)
 	{
+		if (is_pack_handle(file))
+			return (int64)file->pack_size;
+
 		LARGE_INTEGER file_size;
 		if (!GetFileSizeEx(file->handle, &file_size))
 		{
@@ -45,11 +62,40 @@ namespace FileSystem
 
 	}
 
+	uint64 get_file_size64(FileHandle* file)
+	{
+
+		int64 file_size = get_file_size(file);
+		if (file_size < 0)
+		{
+			SHMERROR("Failed to get file size for reading file");
+			return 0;
+		}
+
+		return (uint64)file_size;
+
+	}
+
 	bool8 file_open(const char* path, FileMode mode, FileHandle* out_file)
 	{
 
 		out_file->handle = 0;
 		out_file->is_valid = false;
+		out_file->pack_data = 0;
+		out_file->pack_size = 0;
+		out_file->pack_read_offset = 0;
+		out_file->pack_allocation = 0;
+
+		// NOTE: Files missing from the pack, like caches written at runtime, still get read from disk.
+		if (mode == FILE_MODE_READ && (!prefers_loose_files() || !loose_file_exists(path)))
+		{
+			bool8 loose_allowed = true;
+			if (pack_file_open(path, out_file, &loose_allowed))
+				return true;
+
+			if (!loose_allowed)
+				return false;
+		}
 
 		HANDLE file_handle;
 
@@ -86,10 +132,21 @@ namespace FileSystem
 
 	void file_close(FileHandle* file_handle)
 	{		
-		if (file_handle->is_valid)
+		if (is_pack_handle(file_handle))
+		{
+			if (file_handle->pack_allocation)
+				Memory::free_memory(file_handle->pack_allocation);
+		}
+		else if (file_handle->is_valid)
+		{
 			CloseHandle(file_handle->handle);
+		}
 		file_handle->handle = 0;
 		file_handle->is_valid = false;
+		file_handle->pack_data = 0;
+		file_handle->pack_size = 0;
+		file_handle->pack_read_offset = 0;
+		file_handle->pack_allocation = 0;
 	}
 
 	Platform::ReturnCode file_copy(const char* source, const char* dest, bool8 overwrite)
@@ -101,9 +158,105 @@ namespace FileSystem
 			return Platform::get_last_error();	
 	}
 
+	bool8 create_directory(const char* path)
+	{
+		return CreateDirectoryA(path, 0) || GetLastError() == ERROR_ALREADY_EXISTS;
+	}
+
+	bool8 map_file(FileHandle* file, FileMapping* out_mapping)
+	{
+
+		out_mapping->data = 0;
+		out_mapping->size = 0;
+		out_mapping->handle = 0;
+		out_mapping->allocation = 0;
+
+		if (!file->is_valid)
+			return false;
+
+		// NOTE: Uncompressed pack entries point straight into the pack's mapping. Decompressed copies get handed over to the mapping.
+		if (is_pack_handle(file))
+		{
+			if (!file->pack_size)
+				return false;
+
+			out_mapping->data = (void*)file->pack_data;
+			out_mapping->size = file->pack_size;
+			out_mapping->allocation = file->pack_allocation;
+			file->pack_allocation = 0;
+			return true;
+		}
+
+		// NOTE: Empty files cannot be mapped.
+		uint64 file_size = get_file_size64(file);
+		if (!file_size)
+			return false;
+
+		HANDLE mapping_handle = CreateFileMappingA(file->handle, 0, PAGE_READONLY, 0, 0, 0);
+		if (!mapping_handle)
+		{
+			SHMERROR("Failed to create file mapping.");
+			return false;
+		}
+
+		void* view = MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+		{
+			CloseHandle(mapping_handle);
+			SHMERROR("Failed to map view of file.");
+			return false;
+		}
+
+		out_mapping->data = view;
+		out_mapping->size = file_size;
+		out_mapping->handle = mapping_handle;
+
+		return true;
+
+	}
+
+	void unmap_file(FileMapping* mapping)
+	{
+
+		if (mapping->allocation)
+		{
+			Memory::free_memory(mapping->allocation);
+		}
+		else if (mapping->handle)
+		{
+			if (mapping->data)
+				UnmapViewOfFile(mapping->data);
+			CloseHandle(mapping->handle);
+		}
+
+		mapping->data = 0;
+		mapping->size = 0;
+		mapping->handle = 0;
+		mapping->allocation = 0;
+
+	}
+
+	static uint32 read_pack_bytes(FileHandle* file, uint32 size, void* out_buffer)
+	{
+		uint64 remaining = file->pack_size - file->pack_read_offset;
+		uint32 read_size = (uint32)(remaining < size ? remaining : size);
+		Memory::copy_memory(file->pack_data + file->pack_read_offset, out_buffer, read_size);
+		file->pack_read_offset += read_size;
+		return read_size;
+	}
+
 	bool8 read_bytes(FileHandle* file, uint32 size, void* out_buffer, uint32 out_buffer_size, uint32* out_bytes_read)
 	{
 
+		if (is_pack_handle(file))
+		{
+			if (!out_buffer || out_buffer_size < size)
+				return false;
+
+			*out_bytes_read = read_pack_bytes(file, size, out_buffer);
+			return true;
+		}
+
 		if (file->handle) {
 
 			if (!out_buffer || out_buffer_size < size)
@@ -169,6 +322,12 @@ namespace FileSystem
 		if (!file)
 			return true;
 
+		if (is_pack_handle(file))
+		{
+			SHMERROR("Cannot write to a file inside of the mounted pack.");
+			return false;
+		}
+
 		if (!WriteFile(file->handle, data, size, (DWORD*)out_bytes_written, 0))
 		{
 			SHMERROR("Failed to write to file.");
@@ -184,6 +343,13 @@ namespace FileSystem
 
 	bool8 read_bytes(FileHandle* file, uint32 size, String& out_buffer, uint32* out_bytes_read)
 	{
+		if (is_pack_handle(file))
+		{
+			out_buffer.reserve(size);
+			*out_bytes_read = read_pack_bytes(file, size, out_buffer.c_str_vulnerable());
+			return true;
+		}
+
 		if (!file->handle)
 			return false;
 	
@@ -232,6 +398,45 @@ namespace FileSystem
 
 	}	
 
+	static bool8 iterate_directory_recursive(const char* directory, const char* relative_directory, FP_file_found callback, void* user_data)
+	{
+		char search_path[Constants::max_filepath_length];
+		CString::safe_print_s<const char*, const char*>(search_path, Constants::max_filepath_length, "%s%s*", directory, relative_directory);
+
+		WIN32_FIND_DATAA find_data;
+		HANDLE find_handle = FindFirstFileA(search_path, &find_data);
+		if (find_handle == INVALID_HANDLE_VALUE)
+			return false;
+
+		bool8 success = true;
+		do
+		{
+			if (CString::equal(find_data.cFileName, ".") || CString::equal(find_data.cFileName, ".."))
+				continue;
+
+			char relative_path[Constants::max_filepath_length];
+			CString::safe_print_s<const char*, const char*>(relative_path, Constants::max_filepath_length, "%s%s", relative_directory, find_data.cFileName);
+
+			if (find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			{
+				CString::append(relative_path, Constants::max_filepath_length, '/');
+				success &= iterate_directory_recursive(directory, relative_path, callback, user_data);
+			}
+			else
+			{
+				callback(relative_path, user_data);
+			}
+		} while (FindNextFileA(find_handle, &find_data));
+
+		FindClose(find_handle);
+		return success;
+	}
+
+	bool8 iterate_directory(const char* directory, FP_file_found callback, void* user_data)
+	{
+		return iterate_directory_recursive(directory, "", callback, user_data);
+	}
+
 }
 
 #endif
\ No newline at end of file
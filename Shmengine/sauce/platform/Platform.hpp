@@ -105,6 +105,9 @@ namespace Platform
 	SHMAPI bool8 unload_dynamic_library(DynamicLibrary* lib);
 	SHMAPI bool8 load_dynamic_library_function(DynamicLibrary* lib, const char* name, void** out_function);
 
+	// NOTE: Runs the command line to completion. Environment variables in it get expanded first.
+	SHMAPI bool8 execute_process(const char* command_line, int32* out_exit_code);
+
 	SHMAPI void message_box(const char* prompt, const char* message);
 	SHMAPI void set_window_text(WindowHandle window_handle, const char* s);
 
@@ -361,7 +361,7 @@ namespace Platform
                 watch->last_write_timestamp = find_data.ftLastWriteTime;
                 EventData e_data = {};
                 e_data.ui32[0] = i;
-                Event::event_fire(SystemEventCode::WATCHED_FILE_WRITTEN, 0, e_data);
+                Event::event_post(SystemEventCode::WATCHED_FILE_WRITTEN, 0, e_data, EventPostFlags::CoalesceIdentical);
             }
         }
 
@@ -406,6 +406,14 @@ enum LogLevel
 
     float64 get_absolute_time() 
     {
+        // NOTE: Subsystem startup timing queries the clock before the platform system is up.
+        if (!clock_frequency)
+        {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            clock_frequency = 1.0 / (float64)frequency.QuadPart;
+        }
+
         LARGE_INTEGER now_time;
         QueryPerformanceCounter(&now_time);
         return (float64)now_time.QuadPart * clock_frequency;
@@ -495,6 +503,30 @@ enum LogLevel
         return true;
     }
 
+    bool8 execute_process(const char* command_line, int32* out_exit_code)
+    {
+        char expanded_command_line[Constants::max_filepath_length * 4];
+        DWORD expanded_length = ExpandEnvironmentStringsA(command_line, expanded_command_line, sizeof(expanded_command_line));
+        if (!expanded_length || expanded_length > sizeof(expanded_command_line))
+            return false;
+
+        STARTUPINFOA startup_info = {};
+        startup_info.cb = sizeof(startup_info);
+        PROCESS_INFORMATION process_info = {};
+        if (!CreateProcessA(0, expanded_command_line, 0, 0, FALSE, CREATE_NO_WINDOW, 0, 0, &startup_info, &process_info))
+            return false;
+
+        WaitForSingleObject(process_info.hProcess, INFINITE);
+
+        DWORD exit_code = 0;
+        GetExitCodeProcess(process_info.hProcess, &exit_code);
+        *out_exit_code = (int32)exit_code;
+
+        CloseHandle(process_info.hThread);
+        CloseHandle(process_info.hProcess);
+        return true;
+    }
+
     void message_box(const char* prompt, const char* message)
     {
         MessageBoxA(NULL, message, prompt, MB_OK);
@@ -654,6 +686,7 @@ enum LogLevel
             EventData e = {};
             e.ui32[0] = window->client_width;
             e.ui32[1] = window->client_height;
+            // NOTE: Fired right away instead of posted. Win32 keeps the message loop inside its modal size/move loop while the border is dragged, posted events would wait for the mouse release.
             Event::event_fire(SystemEventCode::WINDOW_RESIZED, 0, e);
             break;
         }
@@ -1,5 +1,6 @@
 #include "core/Thread.hpp"
 #include "core/Mutex.hpp"
+#include "core/Atomic.hpp"
 #include "core/Logging.hpp"
 #include "platform/Platform.hpp"
 
@@ -125,6 +126,41 @@ namespace Threading
 		return result != 0;
 	}
 
+	uint32 atomic_load(volatile uint32* value)
+	{
+		return (uint32)InterlockedOr((volatile LONG*)value, 0);
+	}
+
+	void atomic_store(volatile uint32* value, uint32 new_value)
+	{
+		InterlockedExchange((volatile LONG*)value, (LONG)new_value);
+	}
+
+	uint32 atomic_increment(volatile uint32* value)
+	{
+		return (uint32)InterlockedIncrement((volatile LONG*)value);
+	}
+
+	uint32 atomic_decrement(volatile uint32* value)
+	{
+		return (uint32)InterlockedDecrement((volatile LONG*)value);
+	}
+
+	uint32 atomic_compare_exchange(volatile uint32* value, uint32 new_value, uint32 comparand)
+	{
+		return (uint32)InterlockedCompareExchange((volatile LONG*)value, (LONG)new_value, (LONG)comparand);
+	}
+
+	void atomic_wait(volatile uint32* value, uint32 undesired_value)
+	{
+		WaitOnAddress(value, &undesired_value, sizeof(uint32), INFINITE);
+	}
+
+	void atomic_wake_all(volatile uint32* value)
+	{
+		WakeByAddressAll((void*)value);
+	}
+
 }
 
 #endif
\ No newline at end of file
@@ -12,12 +12,24 @@ namespace Renderer
 		out_geometry->vertex_size = config->vertex_size;
 		out_geometry->vertex_count = config->vertex_count;
 		out_geometry->index_count = config->index_count;
-		out_geometry->vertices.init(out_geometry->vertex_count * out_geometry->vertex_size, 0);
-		out_geometry->indices.init(out_geometry->index_count, 0);
-		if (config->vertices)
-			out_geometry->vertices.copy_memory(config->vertices, out_geometry->vertex_count * out_geometry->vertex_size, 0);
-		if (config->indices)
-			out_geometry->indices.copy_memory(config->indices, out_geometry->index_count, 0);
+		out_geometry->lod_count = config->lod_count;
+		for (uint32 i = 0; i < config->lod_count; i++)
+			out_geometry->lods[i] = config->lods[i];
+
+		if (config->reference_data)
+		{
+			out_geometry->vertices.init(out_geometry->vertex_count * out_geometry->vertex_size, 0, AllocationTag::Array, config->vertices);
+			out_geometry->indices.init(out_geometry->index_count, 0, AllocationTag::Array, config->indices);
+		}
+		else
+		{
+			out_geometry->vertices.init(out_geometry->vertex_count * out_geometry->vertex_size, 0);
+			out_geometry->indices.init(out_geometry->index_count, 0);
+			if (config->vertices)
+				out_geometry->vertices.copy_memory(config->vertices, out_geometry->vertex_count * out_geometry->vertex_size, 0);
+			if (config->indices)
+				out_geometry->indices.copy_memory(config->indices, out_geometry->index_count, 0);
+		}
 
 		out_geometry->vertex_buffer_alloc_ref = {};
 		out_geometry->index_buffer_alloc_ref = {};
@@ -36,6 +48,7 @@ namespace Renderer
 		g->vertex_size = 0;
 		g->vertex_count = 0;
 		g->index_count = 0;
+		g->lod_count = 0;
 		g->vertex_buffer_alloc_ref = {};
 		g->index_buffer_alloc_ref = {};
 		g->loaded = false;
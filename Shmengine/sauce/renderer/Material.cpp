@@ -34,7 +34,7 @@ namespace Renderer
             if (!config->texture_names[i] || !config->texture_names[i][0])
                 continue;
 
-			out_material->maps[i].texture = TextureSystem::acquire(config->texture_names[i], TextureType::Plane, true);
+			out_material->maps[i].texture = TextureSystem::acquire(config->texture_names[i], TextureType::Plane, true, config->type != MaterialType::UI);
         }
 
 		out_material->state = ResourceState::Initialized;
@@ -83,6 +83,7 @@ namespace Renderer
         out_material->shader_instance_id.invalidate();
         out_material->shader_id.invalidate();
         out_material->type = config->type;
+        out_material->pending_texture_count = 0;
 
 		TextureMapConfig default_map_config = { 0 };
 		default_map_config.filter_magnify = default_map_config.filter_minify = TextureFilter::LINEAR;
@@ -199,17 +200,42 @@ namespace Renderer
         Shader* shader = ShaderSystem::get_shader(material->shader_id);
         material->shader_instance_id = Renderer::shader_acquire_instance(shader);
 
+        // NOTE: All texture loads get queued before waiting on any of them, so they decode in parallel.
+        // Textures shared with other materials are already loading or loaded and only get attached to.
+        material->pending_texture_count = 0;
         for (uint32 i = 0; i < material->maps.capacity && i < config.texture_count; i++)
         {
             if (!config.texture_names[i] || !config.texture_names[i][0])
                 continue;
 
-			material->maps[i].texture = TextureSystem::acquire(config.texture_names[i], TextureType::Plane, true);
+            Texture* texture = TextureSystem::acquire(config.texture_names[i], TextureType::Plane, true, config.type != MaterialType::UI);
+			material->maps[i].texture = texture;
+            if (texture && texture->state == ResourceState::Initializing && resource_load_attach(ResourceLoadType::Texture, texture->name, material))
+                material->pending_texture_count++;
         }
-        
-		load_params->out_material->state = ResourceState::Initialized;
 
 		ResourceSystem::material_loader_unload(&load_params->resource);
+
+        if (material->pending_texture_count)
+        {
+            SHMTRACEV("Material '%s' waits on %u texture loads.", material->name, material->pending_texture_count);
+            return;
+        }
+        
+		material->state = ResourceState::Initialized;
+		SHMTRACEV("Successfully loaded material '%s'.", material->name);
+	}
+
+	void material_on_texture_loaded(Material* material)
+	{
+        if (material->state != ResourceState::Initializing || !material->pending_texture_count)
+            return;
+
+        material->pending_texture_count--;
+        if (material->pending_texture_count)
+            return;
+
+		material->state = ResourceState::Initialized;
 		SHMTRACEV("Successfully loaded material '%s'.", material->name);
 	}
 
@@ -13,6 +13,7 @@ namespace Renderer
 {
 	static bool8 _mesh_init(MeshConfig* config, Mesh* out_mesh);
 	static void _mesh_destroy(Mesh* mesh);
+	static void _mesh_load_geometries(MeshConfig* config, Mesh* mesh);
 
 	static void _mesh_init_from_resource_job_success(void* params);
 	static void _mesh_init_from_resource_job_fail(void* params);
@@ -24,18 +25,9 @@ namespace Renderer
 			return false;
 
 		out_mesh->state = ResourceState::Initializing;
+		out_mesh->transform = Math::transform_create();
 		_mesh_init(config, out_mesh);
-		for (uint32 i = 0; i < out_mesh->geometries.capacity; i++)
-		{
-			MeshGeometry* g = &out_mesh->geometries[i];
-			Renderer::geometry_load(&g->geometry_data);
-			const char* material_name = config->g_configs[i].material_name;
-
-			Material* material;
-			g->material_id = MaterialSystem::acquire_material_id(material_name, &material);
-			if (material)
-				Renderer::material_init_from_resource_async(material_name, material);
-		}
+		_mesh_load_geometries(config, out_mesh);
 
 		out_mesh->state = ResourceState::Initialized;
 
@@ -55,6 +47,14 @@ namespace Renderer
 			return false;
 
 		out_mesh->state = ResourceState::Initializing;
+		out_mesh->transform = Math::transform_create();
+
+		// NOTE: Meshes placed repeatedly attach to the load already in flight and get built from its resource once it finished.
+		if (!resource_load_begin(ResourceLoadType::Mesh, name, out_mesh))
+		{
+			resource_load_attach(ResourceLoadType::Mesh, name, out_mesh);
+			return true;
+		}
 
 		JobSystem::JobInfo job = JobSystem::job_create(_mesh_init_from_resource_job, _mesh_init_from_resource_job_success, _mesh_init_from_resource_job_fail, sizeof(MeshLoadParams));
 		MeshLoadParams* params = (MeshLoadParams*)job.user_data;
@@ -82,7 +82,9 @@ namespace Renderer
 		out_mesh->name = config->name;
 		out_mesh->extents = {};
 		out_mesh->center = {};
-		out_mesh->transform = Math::transform_create();
+		out_mesh->lod_count = 1;
+		out_mesh->current_lod = 0;
+		Memory::zero_memory(out_mesh->lod_errors, sizeof(out_mesh->lod_errors));
 		out_mesh->geometries.init(config->g_configs_count, 0);
 		for (uint32 i = 0; i < config->g_configs_count; i++)
 		{
@@ -91,6 +93,9 @@ namespace Renderer
 			g->material_id.invalidate();
 
 			GeometryData* g_data = &g->geometry_data;
+			if (g_data->lod_count > out_mesh->lod_count)
+				out_mesh->lod_count = g_data->lod_count;
+
 			if (g_data->extents.max.x > out_mesh->extents.max.x)
 				out_mesh->extents.max.x = g_data->extents.max.x;
 			if (g_data->extents.max.y > out_mesh->extents.max.y)
@@ -108,6 +113,21 @@ namespace Renderer
 
 		out_mesh->center = (out_mesh->extents.min + out_mesh->extents.max) * 0.5f;
 
+		// NOTE: Geometries with fewer lods keep drawing their last one, so its error counts for the remaining mesh lods.
+		for (uint32 i = 0; i < out_mesh->geometries.capacity; i++)
+		{
+			GeometryData* g_data = &out_mesh->geometries[i].geometry_data;
+			if (!g_data->lod_count)
+				continue;
+
+			for (uint32 lod = 0; lod < out_mesh->lod_count; lod++)
+			{
+				float32 error = g_data->lods[lod < g_data->lod_count ? lod : g_data->lod_count - 1].error;
+				if (error > out_mesh->lod_errors[lod])
+					out_mesh->lod_errors[lod] = error;
+			}
+		}
+
 		out_mesh->unique_id = identifier_acquire_new_id(out_mesh);
 		return true;
 	}
@@ -132,28 +152,52 @@ namespace Renderer
 		mesh->name.free_data();
 	}
 
-	static void _mesh_init_from_resource_job_success(void* params) 
+	static void _mesh_load_geometries(MeshConfig* config, Mesh* mesh)
 	{
-		MeshLoadParams* load_params = (MeshLoadParams*)params;
-		Mesh* mesh = load_params->out_mesh;  
-
-		MeshConfig config = ResourceSystem::mesh_loader_get_config_from_resource(load_params->resource_name, &load_params->resource);
 		for (uint32 i = 0; i < mesh->geometries.capacity; i++)
 		{
 			MeshGeometry* g = &mesh->geometries[i];
 			Renderer::geometry_load(&g->geometry_data);
-			const char* material_name = config.g_configs[i].material_name;
+			const char* material_name = config->g_configs[i].material_name;
 
 			Material* material;
 			g->material_id = MaterialSystem::acquire_material_id(material_name, &material);
 			if (material)
 				Renderer::material_init_from_resource_async(material_name, material);
 		}
+	}
 
-		load_params->out_mesh->state = ResourceState::Initialized;
+	static void _mesh_init_from_resource_job_success(void* params) 
+	{
+		MeshLoadParams* load_params = (MeshLoadParams*)params;
+		Mesh* mesh = load_params->out_mesh;  
+
+		MeshConfig config = ResourceSystem::mesh_loader_get_config_from_resource(load_params->resource_name, &load_params->resource);
+		_mesh_load_geometries(&config, mesh);
+		// NOTE: Geometry data points into the loader's file mapping, which gets released below.
+		for (uint32 i = 0; i < mesh->geometries.capacity; i++)
+		{
+			mesh->geometries[i].geometry_data.vertices.free_data();
+			mesh->geometries[i].geometry_data.indices.free_data();
+		}
+		mesh->state = ResourceState::Initialized;
+
+		uint32 waiter_count = 0;
+		while (Mesh* waiter = (Mesh*)resource_load_next_waiter(ResourceLoadType::Mesh, mesh))
+		{
+			_mesh_init(&config, waiter);
+			_mesh_load_geometries(&config, waiter);
+			for (uint32 i = 0; i < waiter->geometries.capacity; i++)
+			{
+				waiter->geometries[i].geometry_data.vertices.free_data();
+				waiter->geometries[i].geometry_data.indices.free_data();
+			}
+			waiter->state = ResourceState::Initialized;
+			waiter_count++;
+		}
 
 		ResourceSystem::mesh_loader_unload(&load_params->resource);
-		SHMTRACEV("Successfully loaded mesh '%s'.", mesh->name.c_str());
+		SHMTRACEV("Successfully loaded mesh '%s' for %u meshes.", mesh->name.c_str(), waiter_count + 1);
 	}
 
 	static void _mesh_init_from_resource_job_fail(void* params) 
@@ -164,7 +208,10 @@ namespace Renderer
 		ResourceSystem::mesh_loader_unload(&load_params->resource);
 		_mesh_destroy(mesh);
 		mesh->state = ResourceState::Destroyed;
-		SHMERRORV("Failed to load mesh '%s'.", mesh->name.c_str());
+		SHMERRORV("Failed to load mesh '%s'.", load_params->resource_name);
+
+		while (Mesh* waiter = (Mesh*)resource_load_next_waiter(ResourceLoadType::Mesh, mesh))
+			waiter->state = ResourceState::Destroyed;
 	}
 
 	static bool8 _mesh_init_from_resource_job(uint32 thread_index, void* user_data) 
@@ -0,0 +1,413 @@
+#include "MeshCodec.hpp"
+
+#include "core/Memory.hpp"
+#include "utility/Math.hpp"
+
+namespace Renderer
+{
+
+	static const uint8 vertex_codec_tag = 0xA1;
+	static const uint8 index_codec_tag = 0xE1;
+
+	// NOTE: Vertices get encoded in blocks, every byte lane of a block is split into groups of 16 deltas sharing one bit width.
+	static const uint32 vertex_block_size = 256;
+	static const uint32 vertex_group_size = 16;
+	static const uint32 vertex_max_size = 256;
+	static const uint32 group_mode_bits[4] = { 0, 2, 4, 8 };
+
+	union FloatBits
+	{
+		float32 f;
+		uint32 u;
+	};
+
+	static uint16 float_to_half(float32 value)
+	{
+		FloatBits bits = { value };
+		uint32 sign = (bits.u >> 16) & 0x8000;
+		uint32 float_exp = (bits.u >> 23) & 0xFF;
+		uint32 mantissa = bits.u & 0x7FFFFF;
+		int32 exp = (int32)float_exp - 127 + 15;
+
+		if (float_exp == 0xFF)
+			return (uint16)(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+		if (exp >= 31)
+			return (uint16)(sign | 0x7C00);
+
+		if (exp <= 0)
+		{
+			if (exp < -10)
+				return (uint16)sign;
+
+			mantissa |= 0x800000;
+			uint32 shift = (uint32)(14 - exp);
+			uint32 half = mantissa >> shift;
+			uint32 remainder = mantissa & ((1 << shift) - 1);
+			uint32 halfway = 1 << (shift - 1);
+			if (remainder > halfway || (remainder == halfway && (half & 1)))
+				half++;
+			return (uint16)(sign | half);
+		}
+
+		// NOTE: Rounding may carry into the exponent, which still yields the correctly rounded value.
+		uint32 half = sign | ((uint32)exp << 10) | (mantissa >> 13);
+		uint32 remainder = mantissa & 0x1FFF;
+		if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+			half++;
+		return (uint16)half;
+	}
+
+	static float32 half_to_float(uint16 half)
+	{
+		uint32 sign = (uint32)(half & 0x8000) << 16;
+		uint32 exp = (half >> 10) & 0x1F;
+		uint32 mantissa = half & 0x3FF;
+
+		FloatBits bits;
+		if (exp == 0)
+		{
+			float32 value = (float32)mantissa * (1.0f / 16777216.0f);
+			return sign ? -value : value;
+		}
+		else if (exp == 31)
+		{
+			bits.u = sign | 0x7F800000 | (mantissa << 13);
+		}
+		else
+		{
+			bits.u = sign | ((exp + 112) << 23) | (mantissa << 13);
+		}
+
+		return bits.f;
+	}
+
+	static int16 quantize_snorm16(float32 value)
+	{
+		value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+		return (int16)Math::round_f_to_i(value * 32767.0f);
+	}
+
+	static uint8 quantize_unorm8(float32 value)
+	{
+		value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+		return (uint8)Math::round_f_to_i(value * 255.0f);
+	}
+
+	static void octahedral_encode(Math::Vec3f v, int16* out)
+	{
+		float32 l1 = Math::abs(v.x) + Math::abs(v.y) + Math::abs(v.z);
+		if (l1 == 0.0f)
+		{
+			out[0] = 0;
+			out[1] = 0;
+			return;
+		}
+
+		float32 x = v.x / l1;
+		float32 y = v.y / l1;
+		if (v.z < 0.0f)
+		{
+			float32 folded_x = (1.0f - Math::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+			float32 folded_y = (1.0f - Math::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+			x = folded_x;
+			y = folded_y;
+		}
+
+		out[0] = quantize_snorm16(x);
+		out[1] = quantize_snorm16(y);
+	}
+
+	static Math::Vec3f octahedral_decode(const int16* in)
+	{
+		float32 x = (float32)in[0] / 32767.0f;
+		float32 y = (float32)in[1] / 32767.0f;
+		float32 z = 1.0f - Math::abs(x) - Math::abs(y);
+		float32 t = z < 0.0f ? -z : 0.0f;
+		x += x >= 0.0f ? -t : t;
+		y += y >= 0.0f ? -t : t;
+
+		return Math::normalized(Math::Vec3f{ x, y, z });
+	}
+
+	void vertex3d_quantize(const Vertex3D* vertices, uint32 vertex_count, Math::Extents3D extents, QuantizedVertex3D* out_vertices)
+	{
+		float32 scale[3];
+		for (uint32 c = 0; c < 3; c++)
+		{
+			float32 range = extents.max.e[c] - extents.min.e[c];
+			scale[c] = range > 0.0f ? 65535.0f / range : 0.0f;
+		}
+
+		for (uint32 i = 0; i < vertex_count; i++)
+		{
+			const Vertex3D* v = &vertices[i];
+			QuantizedVertex3D* q = &out_vertices[i];
+
+			for (uint32 c = 0; c < 3; c++)
+			{
+				int32 p = Math::round_f_to_i((v->position.e[c] - extents.min.e[c]) * scale[c]);
+				q->position[c] = (uint16)(p < 0 ? 0 : (p > 0xFFFF ? 0xFFFF : p));
+			}
+
+			octahedral_encode(v->normal, q->normal);
+			q->tex_coords[0] = float_to_half(v->tex_coords.x);
+			q->tex_coords[1] = float_to_half(v->tex_coords.y);
+			for (uint32 c = 0; c < 4; c++)
+				q->color[c] = quantize_unorm8(v->color.e[c]);
+			octahedral_encode(v->tangent, q->tangent);
+		}
+	}
+
+	void vertex3d_dequantize(const QuantizedVertex3D* vertices, uint32 vertex_count, Math::Extents3D extents, Vertex3D* out_vertices)
+	{
+		float32 scale[3];
+		for (uint32 c = 0; c < 3; c++)
+			scale[c] = (extents.max.e[c] - extents.min.e[c]) / 65535.0f;
+
+		for (uint32 i = 0; i < vertex_count; i++)
+		{
+			const QuantizedVertex3D* q = &vertices[i];
+			Vertex3D* v = &out_vertices[i];
+
+			for (uint32 c = 0; c < 3; c++)
+				v->position.e[c] = extents.min.e[c] + (float32)q->position[c] * scale[c];
+
+			v->normal = octahedral_decode(q->normal);
+			v->tex_coords.x = half_to_float(q->tex_coords[0]);
+			v->tex_coords.y = half_to_float(q->tex_coords[1]);
+			for (uint32 c = 0; c < 4; c++)
+				v->color.e[c] = (float32)q->color[c] / 255.0f;
+			v->tangent = octahedral_decode(q->tangent);
+		}
+	}
+
+	SHMINLINE uint8 zigzag8(uint8 delta)
+	{
+		return (uint8)((delta << 1) ^ (uint8)((int8)delta >> 7));
+	}
+
+	SHMINLINE uint8 unzigzag8(uint8 value)
+	{
+		return (uint8)((value >> 1) ^ (uint8)(-(int32)(value & 1)));
+	}
+
+	uint64 vertex_buffer_encode_bound(uint32 vertex_count, uint32 vertex_size)
+	{
+		uint64 block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+		uint64 lane_bound = (vertex_block_size / vertex_group_size + 3) / 4 + vertex_block_size;
+		return 1 + block_count * vertex_size * lane_bound;
+	}
+
+	uint64 vertex_buffer_encode(const void* vertices, uint32 vertex_count, uint32 vertex_size, uint8* out_buffer, uint64 out_buffer_size)
+	{
+		if (vertex_size > vertex_max_size || out_buffer_size < 1)
+			return 0;
+
+		const uint8* src = (const uint8*)vertices;
+		uint8* out = out_buffer;
+		uint8* out_end = out_buffer + out_buffer_size;
+		*out++ = vertex_codec_tag;
+
+		uint8 last_vertex[vertex_max_size] = {};
+		uint8 deltas[vertex_block_size];
+
+		for (uint32 block_start = 0; block_start < vertex_count; block_start += vertex_block_size)
+		{
+			uint32 block_count = vertex_count - block_start < vertex_block_size ? vertex_count - block_start : vertex_block_size;
+			uint32 group_count = (block_count + vertex_group_size - 1) / vertex_group_size;
+			uint32 header_size = (group_count + 3) / 4;
+
+			for (uint32 k = 0; k < vertex_size; k++)
+			{
+				uint8 prev = last_vertex[k];
+				for (uint32 i = 0; i < block_count; i++)
+				{
+					uint8 value = src[(uint64)(block_start + i) * vertex_size + k];
+					deltas[i] = zigzag8((uint8)(value - prev));
+					prev = value;
+				}
+				for (uint32 i = block_count; i < group_count * vertex_group_size; i++)
+					deltas[i] = 0;
+				last_vertex[k] = prev;
+
+				if ((uint64)(out_end - out) < header_size)
+					return 0;
+
+				uint8* header = out;
+				Memory::zero_memory(header, header_size);
+				out += header_size;
+
+				for (uint32 g = 0; g < group_count; g++)
+				{
+					const uint8* group = &deltas[g * vertex_group_size];
+					uint8 combined = 0;
+					for (uint32 i = 0; i < vertex_group_size; i++)
+						combined |= group[i];
+
+					uint32 mode = combined == 0 ? 0 : (combined < 4 ? 1 : (combined < 16 ? 2 : 3));
+					header[g >> 2] |= (uint8)(mode << ((g & 3) * 2));
+
+					uint32 bits = group_mode_bits[mode];
+					uint32 group_bytes = bits * vertex_group_size / 8;
+					if ((uint64)(out_end - out) < group_bytes)
+						return 0;
+
+					uint32 per_byte = bits ? 8 / bits : 0;
+					for (uint32 b = 0; b < group_bytes; b++)
+					{
+						uint8 packed = 0;
+						for (uint32 j = 0; j < per_byte; j++)
+							packed |= (uint8)(group[b * per_byte + j] << (j * bits));
+						out[b] = packed;
+					}
+					out += group_bytes;
+				}
+			}
+		}
+
+		return (uint64)(out - out_buffer);
+	}
+
+	bool8 vertex_buffer_decode(const uint8* buffer, uint64 buffer_size, uint32 vertex_count, uint32 vertex_size, void* out_vertices)
+	{
+		if (vertex_size > vertex_max_size || buffer_size < 1 || buffer[0] != vertex_codec_tag)
+			return false;
+
+		uint8* dest = (uint8*)out_vertices;
+		const uint8* in = buffer + 1;
+		const uint8* in_end = buffer + buffer_size;
+
+		uint8 last_vertex[vertex_max_size] = {};
+		uint8 deltas[vertex_block_size];
+
+		for (uint32 block_start = 0; block_start < vertex_count; block_start += vertex_block_size)
+		{
+			uint32 block_count = vertex_count - block_start < vertex_block_size ? vertex_count - block_start : vertex_block_size;
+			uint32 group_count = (block_count + vertex_group_size - 1) / vertex_group_size;
+			uint32 header_size = (group_count + 3) / 4;
+
+			for (uint32 k = 0; k < vertex_size; k++)
+			{
+				if ((uint64)(in_end - in) < header_size)
+					return false;
+
+				const uint8* header = in;
+				in += header_size;
+
+				for (uint32 g = 0; g < group_count; g++)
+				{
+					uint8* group = &deltas[g * vertex_group_size];
+					uint32 bits = group_mode_bits[(header[g >> 2] >> ((g & 3) * 2)) & 3];
+					uint32 group_bytes = bits * vertex_group_size / 8;
+					if ((uint64)(in_end - in) < group_bytes)
+						return false;
+
+					switch (bits)
+					{
+					case 0:
+					{
+						Memory::zero_memory(group, vertex_group_size);
+						break;
+					}
+					case 8:
+					{
+						Memory::copy_memory(in, group, vertex_group_size);
+						break;
+					}
+					default:
+					{
+						uint32 per_byte = 8 / bits;
+						uint8 mask = (uint8)((1 << bits) - 1);
+						for (uint32 b = 0; b < group_bytes; b++)
+						{
+							for (uint32 j = 0; j < per_byte; j++)
+								group[b * per_byte + j] = (in[b] >> (j * bits)) & mask;
+						}
+						break;
+					}
+					}
+					in += group_bytes;
+				}
+
+				uint8 prev = last_vertex[k];
+				for (uint32 i = 0; i < block_count; i++)
+				{
+					prev = (uint8)(prev + unzigzag8(deltas[i]));
+					dest[(uint64)(block_start + i) * vertex_size + k] = prev;
+				}
+				last_vertex[k] = prev;
+			}
+		}
+
+		return true;
+	}
+
+	uint64 index_buffer_encode_bound(uint32 index_count)
+	{
+		return 1 + (uint64)index_count * 5;
+	}
+
+	uint64 index_buffer_encode(const uint32* indices, uint32 index_count, uint8* out_buffer, uint64 out_buffer_size)
+	{
+		if (out_buffer_size < index_buffer_encode_bound(index_count))
+			return 0;
+
+		uint8* out = out_buffer;
+		*out++ = index_codec_tag;
+
+		// NOTE: Each index is stored as the zigzagged delta to its predecessor in LEB128 form, so locally ordered meshes need one byte per index.
+		uint32 last_index = 0;
+		for (uint32 i = 0; i < index_count; i++)
+		{
+			int32 delta = (int32)(indices[i] - last_index);
+			uint32 value = ((uint32)delta << 1) ^ (uint32)(delta >> 31);
+			last_index = indices[i];
+
+			while (value >= 0x80)
+			{
+				*out++ = (uint8)(value | 0x80);
+				value >>= 7;
+			}
+			*out++ = (uint8)value;
+		}
+
+		return (uint64)(out - out_buffer);
+	}
+
+	bool8 index_buffer_decode(const uint8* buffer, uint64 buffer_size, uint32 index_count, uint32 vertex_count, uint32* out_indices)
+	{
+		if (buffer_size < 1 || buffer[0] != index_codec_tag)
+			return false;
+
+		const uint8* in = buffer + 1;
+		const uint8* in_end = buffer + buffer_size;
+
+		uint32 last_index = 0;
+		for (uint32 i = 0; i < index_count; i++)
+		{
+			uint32 value = 0;
+			uint32 shift = 0;
+			while (true)
+			{
+				if (in == in_end || shift > 28)
+					return false;
+
+				uint8 b = *in++;
+				value |= (uint32)(b & 0x7F) << shift;
+				if (!(b & 0x80))
+					break;
+				shift += 7;
+			}
+
+			int32 delta = (int32)(value >> 1) ^ -(int32)(value & 1);
+			last_index += (uint32)delta;
+			if (last_index >= vertex_count)
+				return false;
+
+			out_indices[i] = last_index;
+		}
+
+		return true;
+	}
+
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "RendererTypes.hpp"
+
+namespace Renderer
+{
+
+	// NOTE: Storage format of Vertex3D. Positions are quantized relative to the geometry's extents, normals and tangents are octahedral encoded.
+	struct QuantizedVertex3D
+	{
+		uint16 position[3];
+		int16 normal[2];
+		uint16 tex_coords[2];
+		uint8 color[4];
+		int16 tangent[2];
+	};
+
+	SHMAPI void vertex3d_quantize(const Vertex3D* vertices, uint32 vertex_count, Math::Extents3D extents, QuantizedVertex3D* out_vertices);
+	SHMAPI void vertex3d_dequantize(const QuantizedVertex3D* vertices, uint32 vertex_count, Math::Extents3D extents, Vertex3D* out_vertices);
+
+	// NOTE: Byte-oriented codecs for vertex and index streams. Encoders return the encoded size or 0 if the output buffer was too small.
+	SHMAPI uint64 vertex_buffer_encode_bound(uint32 vertex_count, uint32 vertex_size);
+	SHMAPI uint64 vertex_buffer_encode(const void* vertices, uint32 vertex_count, uint32 vertex_size, uint8* out_buffer, uint64 out_buffer_size);
+	SHMAPI bool8 vertex_buffer_decode(const uint8* buffer, uint64 buffer_size, uint32 vertex_count, uint32 vertex_size, void* out_vertices);
+
+	SHMAPI uint64 index_buffer_encode_bound(uint32 index_count);
+	SHMAPI uint64 index_buffer_encode(const uint32* indices, uint32 index_count, uint8* out_buffer, uint64 out_buffer_size);
+	SHMAPI bool8 index_buffer_decode(const uint8* buffer, uint64 buffer_size, uint32 index_count, uint32 vertex_count, uint32* out_indices);
+
+}
@@ -0,0 +1,744 @@
+#include "MeshOptimizer.hpp"
+
+#include "core/Memory.hpp"
+#include "core/Logging.hpp"
+#include "utility/Math.hpp"
+#include "utility/Sort.hpp"
+#include "utility/Utility.hpp"
+
+namespace Renderer
+{
+
+	struct ClusterSortKey
+	{
+		float32 key;
+		uint32 cluster;
+
+		SHMINLINE bool8 operator<=(const ClusterSortKey& other) const { return key <= other.key; }
+		SHMINLINE bool8 operator>=(const ClusterSortKey& other) const { return key >= other.key; }
+	};
+
+	struct PositionSortKey
+	{
+		Math::Vec3f position;
+		uint32 vertex;
+
+		SHMINLINE bool8 operator<=(const PositionSortKey& other) const
+		{
+			if (position.x != other.position.x)
+				return position.x < other.position.x;
+			if (position.y != other.position.y)
+				return position.y < other.position.y;
+			if (position.z != other.position.z)
+				return position.z < other.position.z;
+			return vertex <= other.vertex;
+		}
+
+		SHMINLINE bool8 operator>=(const PositionSortKey& other) const
+		{
+			return other <= *this;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32 from;
+		uint32 to;
+		float32 cost;
+
+		SHMINLINE bool8 operator<=(const Collapse& other) const { return cost <= other.cost; }
+		SHMINLINE bool8 operator>=(const Collapse& other) const { return cost >= other.cost; }
+	};
+
+	// NOTE: Symmetric 3x3 matrix, vector and constant of the summed squared plane distances, weighted by triangle area.
+	struct Quadric
+	{
+		float32 a00, a11, a22;
+		float32 a10, a20, a21;
+		float32 b0, b1, b2;
+		float32 c;
+		float32 weight;
+	};
+
+	// NOTE: A vertex counts as cached as long as fewer than cache_size misses happened since it was last loaded, which models a FIFO cache.
+	SHMINLINE uint32 fifo_cache_access(uint32 vertex, uint32* timestamps, uint32* timestamp, uint32 cache_size)
+	{
+		if (*timestamp - timestamps[vertex] <= cache_size)
+			return 0;
+
+		timestamps[vertex] = (*timestamp)++;
+		return 1;
+	}
+
+	float32 mesh_analyze_vertex_cache(const uint32* indices, uint32 index_count, uint32 vertex_count, uint32 cache_size)
+	{
+		uint32 triangle_count = index_count / 3;
+		if (!triangle_count)
+			return 0.0f;
+
+		Sarray<uint32> timestamps(vertex_count, 0);
+		timestamps.zero_memory();
+		uint32 timestamp = cache_size + 1;
+
+		uint32 misses = 0;
+		for (uint32 i = 0; i < triangle_count * 3; i++)
+			misses += fifo_cache_access(indices[i], timestamps.data, &timestamp, cache_size);
+
+		return (float32)misses / (float32)triangle_count;
+	}
+
+	void mesh_optimize_vertex_cache(uint32* out_indices, const uint32* indices, uint32 index_count, uint32 vertex_count, uint32 cache_size)
+	{
+		uint32 triangle_count = index_count / 3;
+		if (!triangle_count || !vertex_count)
+			return;
+
+		Sarray<uint32> live_counts(vertex_count, 0);
+		live_counts.zero_memory();
+		for (uint32 i = 0; i < triangle_count * 3; i++)
+			live_counts[indices[i]]++;
+
+		Sarray<uint32> adjacency_offsets(vertex_count + 1, 0);
+		Sarray<uint32> adjacency_fill(vertex_count, 0);
+		adjacency_offsets[0] = 0;
+		for (uint32 v = 0; v < vertex_count; v++)
+		{
+			adjacency_fill[v] = adjacency_offsets[v];
+			adjacency_offsets[v + 1] = adjacency_offsets[v] + live_counts[v];
+		}
+
+		Sarray<uint32> adjacency(triangle_count * 3, 0);
+		for (uint32 t = 0; t < triangle_count; t++)
+		{
+			for (uint32 k = 0; k < 3; k++)
+				adjacency[adjacency_fill[indices[t * 3 + k]]++] = t;
+		}
+		adjacency_fill.free_data();
+
+		Sarray<uint32> timestamps(vertex_count, 0);
+		timestamps.zero_memory();
+		Sarray<uint8> emitted(triangle_count, 0);
+		emitted.zero_memory();
+		Sarray<uint32> dead_end(triangle_count * 3, 0);
+		uint32 dead_end_top = 0;
+
+		uint32 timestamp = cache_size + 1;
+		uint32 scan_cursor = 0;
+		uint32 output_count = 0;
+
+		uint32 current = indices[0];
+		while (current != Constants::max_u32)
+		{
+			// NOTE: Emit all remaining triangles of the current fanning vertex. Their vertices become the candidates for the next one.
+			uint32 candidates_start = dead_end_top;
+			for (uint32 a = adjacency_offsets[current]; a < adjacency_offsets[current + 1]; a++)
+			{
+				uint32 t = adjacency[a];
+				if (emitted[t])
+					continue;
+
+				for (uint32 k = 0; k < 3; k++)
+				{
+					uint32 v = indices[t * 3 + k];
+					out_indices[output_count++] = v;
+					dead_end[dead_end_top++] = v;
+					live_counts[v]--;
+					fifo_cache_access(v, timestamps.data, &timestamp, cache_size);
+				}
+				emitted[t] = true;
+			}
+
+			uint32 best = Constants::max_u32;
+			int32 best_priority = -1;
+			for (uint32 c = candidates_start; c < dead_end_top; c++)
+			{
+				uint32 v = dead_end[c];
+				if (!live_counts[v])
+					continue;
+
+				// NOTE: Prefer the oldest candidate that will still be in the cache after fanning out all of its triangles.
+				int32 priority = 0;
+				uint32 age = timestamp - timestamps[v];
+				if (age + 2 * live_counts[v] <= cache_size)
+					priority = (int32)age;
+
+				if (priority > best_priority)
+				{
+					best_priority = priority;
+					best = v;
+				}
+			}
+
+			while (best == Constants::max_u32 && dead_end_top)
+			{
+				uint32 v = dead_end[--dead_end_top];
+				if (live_counts[v])
+					best = v;
+			}
+
+			while (best == Constants::max_u32 && scan_cursor < vertex_count)
+			{
+				if (live_counts[scan_cursor])
+					best = scan_cursor;
+				scan_cursor++;
+			}
+
+			current = best;
+		}
+
+		for (uint32 i = triangle_count * 3; i < index_count; i++)
+			out_indices[i] = indices[i];
+	}
+
+	void mesh_optimize_overdraw(uint32* indices, uint32 index_count, const void* vertices, uint32 vertex_count, uint32 vertex_size, float32 threshold)
+	{
+		uint32 triangle_count = index_count / 3;
+		if (triangle_count < 2)
+			return;
+
+		auto get_position = [vertices, vertex_size](uint32 v) -> Math::Vec3f
+			{
+				return *(const Math::Vec3f*)((const uint8*)vertices + (uint64)v * vertex_size);
+			};
+
+		// NOTE: Clusters start at triangles missing the cache with all three vertices, which is where the cache optimizer restarted.
+		Darray<uint32> cluster_starts(triangle_count / 16 + 1, 0);
+		{
+			Sarray<uint32> timestamps(vertex_count, 0);
+			timestamps.zero_memory();
+			uint32 timestamp = mesh_vertex_cache_size + 1;
+
+			for (uint32 t = 0; t < triangle_count; t++)
+			{
+				uint32 misses = 0;
+				for (uint32 k = 0; k < 3; k++)
+					misses += fifo_cache_access(indices[t * 3 + k], timestamps.data, &timestamp, mesh_vertex_cache_size);
+
+				if (t == 0 || misses == 3)
+					cluster_starts.push(t);
+			}
+		}
+
+		uint32 cluster_count = cluster_starts.count;
+		if (cluster_count < 2)
+			return;
+
+		cluster_starts.push(triangle_count);
+
+		Sarray<Math::Vec3f> cluster_centroids(cluster_count, 0);
+		Sarray<Math::Vec3f> cluster_normals(cluster_count, 0);
+		Math::Vec3f mesh_centroid = {};
+		float32 mesh_area = 0.0f;
+
+		for (uint32 c = 0; c < cluster_count; c++)
+		{
+			Math::Vec3f centroid = {};
+			Math::Vec3f normal = {};
+			float32 cluster_area = 0.0f;
+
+			for (uint32 t = cluster_starts[c]; t < cluster_starts[c + 1]; t++)
+			{
+				Math::Vec3f p0 = get_position(indices[t * 3 + 0]);
+				Math::Vec3f p1 = get_position(indices[t * 3 + 1]);
+				Math::Vec3f p2 = get_position(indices[t * 3 + 2]);
+
+				Math::Vec3f cross = Math::cross_product(p1 - p0, p2 - p0);
+				float32 area = Math::length(cross);
+
+				centroid += (p0 + p1 + p2) * (area / 3.0f);
+				normal += cross;
+				cluster_area += area;
+			}
+
+			mesh_centroid += centroid;
+			mesh_area += cluster_area;
+
+			cluster_centroids[c] = cluster_area > 0.0f ? centroid / cluster_area : get_position(indices[cluster_starts[c] * 3]);
+			cluster_normals[c] = Math::length(normal) > 0.0f ? Math::normalized(normal) : normal;
+		}
+
+		if (mesh_area > 0.0f)
+			mesh_centroid = mesh_centroid / mesh_area;
+
+		// NOTE: Clusters facing away from the mesh center are likely to occlude the others, so they get drawn first.
+		Sarray<ClusterSortKey> sort_keys(cluster_count, 0);
+		for (uint32 c = 0; c < cluster_count; c++)
+		{
+			sort_keys[c].key = Math::inner_product(cluster_centroids[c] - mesh_centroid, cluster_normals[c]);
+			sort_keys[c].cluster = c;
+		}
+		quick_sort(sort_keys.data, 0, (int32)cluster_count - 1, false);
+
+		Sarray<uint32> sorted_indices(index_count, 0);
+		uint32 write_index = 0;
+		for (uint32 s = 0; s < cluster_count; s++)
+		{
+			uint32 c = sort_keys[s].cluster;
+			uint32 first_index = cluster_starts[c] * 3;
+			uint32 cluster_index_count = cluster_starts[c + 1] * 3 - first_index;
+			Memory::copy_memory(&indices[first_index], &sorted_indices[write_index], cluster_index_count * sizeof(uint32));
+			write_index += cluster_index_count;
+		}
+
+		for (uint32 i = triangle_count * 3; i < index_count; i++)
+			sorted_indices[i] = indices[i];
+
+		float32 acmr_before = mesh_analyze_vertex_cache(indices, index_count, vertex_count);
+		float32 acmr_after = mesh_analyze_vertex_cache(sorted_indices.data, index_count, vertex_count);
+		if (acmr_after <= acmr_before * threshold)
+			Memory::copy_memory(sorted_indices.data, indices, index_count * sizeof(uint32));
+	}
+
+	static void quadric_add(Quadric* q, const Quadric* other)
+	{
+		q->a00 += other->a00;
+		q->a11 += other->a11;
+		q->a22 += other->a22;
+		q->a10 += other->a10;
+		q->a20 += other->a20;
+		q->a21 += other->a21;
+		q->b0 += other->b0;
+		q->b1 += other->b1;
+		q->b2 += other->b2;
+		q->c += other->c;
+		q->weight += other->weight;
+	}
+
+	static Quadric quadric_from_triangle(Math::Vec3f p0, Math::Vec3f p1, Math::Vec3f p2)
+	{
+		Math::Vec3f normal = Math::cross_product(p1 - p0, p2 - p0);
+		float32 area = Math::length(normal);
+		if (area > 0.0f)
+			normal = normal / area;
+
+		float32 d = -Math::inner_product(normal, p0);
+		float32 w = area * 0.5f;
+
+		Quadric q;
+		q.a00 = normal.x * normal.x * w;
+		q.a11 = normal.y * normal.y * w;
+		q.a22 = normal.z * normal.z * w;
+		q.a10 = normal.y * normal.x * w;
+		q.a20 = normal.z * normal.x * w;
+		q.a21 = normal.z * normal.y * w;
+		q.b0 = normal.x * d * w;
+		q.b1 = normal.y * d * w;
+		q.b2 = normal.z * d * w;
+		q.c = d * d * w;
+		q.weight = w;
+		return q;
+	}
+
+	static float32 quadric_error(const Quadric* q, Math::Vec3f p)
+	{
+		float32 rx = q->a00 * p.x + q->a10 * p.y + q->a20 * p.z;
+		float32 ry = q->a10 * p.x + q->a11 * p.y + q->a21 * p.z;
+		float32 rz = q->a20 * p.x + q->a21 * p.y + q->a22 * p.z;
+
+		float32 error = rx * p.x + ry * p.y + rz * p.z + 2.0f * (q->b0 * p.x + q->b1 * p.y + q->b2 * p.z) + q->c;
+		error = Math::abs(error);
+
+		return q->weight > 0.0f ? error / q->weight : error;
+	}
+
+	uint32 mesh_simplify(uint32* out_indices, const uint32* indices, uint32 index_count, const void* vertices, uint32 vertex_count, uint32 vertex_size,
+		uint32 target_index_count, float32 target_error, uint32 attribute_offset, uint32 attribute_count, const float32* attribute_weights, float32* out_error)
+	{
+		*out_error = 0.0f;
+
+		uint32 triangle_count = index_count / 3;
+		Memory::copy_memory(indices, out_indices, triangle_count * 3 * sizeof(uint32));
+		if (triangle_count * 3 <= target_index_count || !vertex_count)
+			return triangle_count * 3;
+
+		const uint8* vertex_bytes = (const uint8*)vertices;
+		auto get_attributes = [vertex_bytes, vertex_size, attribute_offset](uint32 v) -> const float32*
+			{
+				return (const float32*)(vertex_bytes + (uint64)v * vertex_size + attribute_offset);
+			};
+
+		// NOTE: Positions get normalized to the unit cube, so errors are relative to the mesh extents.
+		Math::Vec3f min = *(const Math::Vec3f*)vertex_bytes;
+		Math::Vec3f max = min;
+		for (uint32 v = 1; v < vertex_count; v++)
+		{
+			Math::Vec3f p = *(const Math::Vec3f*)(vertex_bytes + (uint64)v * vertex_size);
+			for (uint32 c = 0; c < 3; c++)
+			{
+				min.e[c] = p.e[c] < min.e[c] ? p.e[c] : min.e[c];
+				max.e[c] = p.e[c] > max.e[c] ? p.e[c] : max.e[c];
+			}
+		}
+
+		float32 extent = max.x - min.x;
+		extent = max.y - min.y > extent ? max.y - min.y : extent;
+		extent = max.z - min.z > extent ? max.z - min.z : extent;
+		float32 inv_extent = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+		Sarray<Math::Vec3f> positions(vertex_count, 0);
+		for (uint32 v = 0; v < vertex_count; v++)
+			positions[v] = (*(const Math::Vec3f*)(vertex_bytes + (uint64)v * vertex_size) - min) * inv_extent;
+
+		// NOTE: Vertices sharing a position are welded for the topology checks. Split vertices (attribute seams) get locked.
+		Sarray<uint32> welded(vertex_count, 0);
+		Sarray<uint8> locked(vertex_count, 0);
+		locked.zero_memory();
+		{
+			Sarray<PositionSortKey> sort_keys(vertex_count, 0);
+			for (uint32 v = 0; v < vertex_count; v++)
+				sort_keys[v] = { positions[v], v };
+			quick_sort(sort_keys.data, 0, (int32)vertex_count - 1);
+
+			uint32 group_start = 0;
+			for (uint32 i = 0; i <= vertex_count; i++)
+			{
+				if (i < vertex_count && Math::vec_compare(sort_keys[i].position, sort_keys[group_start].position, 0.0f))
+					continue;
+
+				for (uint32 j = group_start; j < i; j++)
+				{
+					welded[sort_keys[j].vertex] = sort_keys[group_start].vertex;
+					if (i - group_start > 1)
+						locked[sort_keys[j].vertex] = true;
+				}
+				group_start = i;
+			}
+		}
+
+		// NOTE: Edges without a twin in the opposite direction lie on an open border, their vertices get locked as well.
+		{
+			Sarray<uint32> edge_offsets(vertex_count + 1, 0);
+			edge_offsets.zero_memory();
+			for (uint32 i = 0; i < triangle_count * 3; i++)
+				edge_offsets[welded[indices[i]] + 1]++;
+			for (uint32 v = 0; v < vertex_count; v++)
+				edge_offsets[v + 1] += edge_offsets[v];
+
+			Sarray<uint32> edge_fill(vertex_count, 0);
+			edge_fill.copy_memory(edge_offsets.data, vertex_count, 0);
+			Sarray<uint32> edge_targets(triangle_count * 3, 0);
+			for (uint32 t = 0; t < triangle_count; t++)
+			{
+				for (uint32 k = 0; k < 3; k++)
+				{
+					uint32 a = welded[indices[t * 3 + k]];
+					uint32 b = welded[indices[t * 3 + (k + 1) % 3]];
+					edge_targets[edge_fill[a]++] = b;
+				}
+			}
+
+			for (uint32 a = 0; a < vertex_count; a++)
+			{
+				for (uint32 e = edge_offsets[a]; e < edge_offsets[a + 1]; e++)
+				{
+					uint32 b = edge_targets[e];
+					bool8 has_twin = false;
+					for (uint32 r = edge_offsets[b]; r < edge_offsets[b + 1] && !has_twin; r++)
+						has_twin = edge_targets[r] == a;
+
+					if (!has_twin)
+					{
+						locked[a] = true;
+						locked[b] = true;
+					}
+				}
+			}
+
+			for (uint32 v = 0; v < vertex_count; v++)
+			{
+				if (locked[welded[v]])
+					locked[v] = true;
+			}
+		}
+
+		Sarray<Quadric> quadrics(vertex_count, 0);
+		quadrics.zero_memory();
+		for (uint32 t = 0; t < triangle_count; t++)
+		{
+			uint32 i0 = indices[t * 3 + 0];
+			uint32 i1 = indices[t * 3 + 1];
+			uint32 i2 = indices[t * 3 + 2];
+			Quadric q = quadric_from_triangle(positions[i0], positions[i1], positions[i2]);
+			quadric_add(&quadrics[i0], &q);
+			quadric_add(&quadrics[i1], &q);
+			quadric_add(&quadrics[i2], &q);
+		}
+
+		uint32 result_count = triangle_count * 3;
+		float32 error_limit = target_error * target_error;
+		float32 max_cost = 0.0f;
+
+		Sarray<uint32> adjacency_offsets(vertex_count + 1, 0);
+		Sarray<uint32> adjacency_fill(vertex_count, 0);
+		Sarray<uint32> adjacency(triangle_count * 3, 0);
+		Sarray<uint8> touched(vertex_count, 0);
+		Darray<Collapse> collapses(triangle_count * 3, 0);
+
+		while (result_count > target_index_count)
+		{
+			uint32 result_triangle_count = result_count / 3;
+
+			adjacency_offsets.zero_memory();
+			for (uint32 i = 0; i < result_count; i++)
+				adjacency_offsets[out_indices[i] + 1]++;
+			for (uint32 v = 0; v < vertex_count; v++)
+				adjacency_offsets[v + 1] += adjacency_offsets[v];
+			adjacency_fill.copy_memory(adjacency_offsets.data, vertex_count, 0);
+			for (uint32 t = 0; t < result_triangle_count; t++)
+			{
+				for (uint32 k = 0; k < 3; k++)
+					adjacency[adjacency_fill[out_indices[t * 3 + k]]++] = t;
+			}
+
+			collapses.clear();
+			for (uint32 t = 0; t < result_triangle_count; t++)
+			{
+				for (uint32 k = 0; k < 3; k++)
+				{
+					uint32 edge[2] = { out_indices[t * 3 + k], out_indices[t * 3 + (k + 1) % 3] };
+					for (uint32 d = 0; d < 2; d++)
+					{
+						uint32 from = edge[d];
+						uint32 to = edge[1 - d];
+						if (locked[from])
+							continue;
+
+						float32 cost = quadric_error(&quadrics[from], positions[to]);
+						const float32* from_attributes = get_attributes(from);
+						const float32* to_attributes = get_attributes(to);
+						for (uint32 a = 0; a < attribute_count; a++)
+						{
+							float32 diff = from_attributes[a] - to_attributes[a];
+							cost += attribute_weights[a] * diff * diff;
+						}
+
+						if (cost <= error_limit)
+							collapses.push({ from, to, cost });
+					}
+				}
+			}
+
+			if (!collapses.count)
+				break;
+
+			quick_sort(collapses.data, 0, (int32)collapses.count - 1);
+
+			// NOTE: Collapses within one pass must not share any triangles, so the adjacency stays valid for the flip checks.
+			touched.zero_memory();
+			uint32 triangles_to_remove = (result_count - target_index_count) / 3;
+			uint32 applied_count = 0;
+			for (uint32 c = 0; c < collapses.count; c++)
+			{
+				const Collapse* collapse = &collapses[c];
+				if (touched[collapse->from] || touched[collapse->to])
+					continue;
+
+				bool8 flipped = false;
+				for (uint32 a = adjacency_offsets[collapse->from]; a < adjacency_offsets[collapse->from + 1] && !flipped; a++)
+				{
+					const uint32* tri = &out_indices[adjacency[a] * 3];
+					if (tri[0] == collapse->to || tri[1] == collapse->to || tri[2] == collapse->to)
+						continue;
+
+					Math::Vec3f p[3];
+					for (uint32 k = 0; k < 3; k++)
+						p[k] = positions[tri[k]];
+					Math::Vec3f old_normal = Math::cross_product(p[1] - p[0], p[2] - p[0]);
+
+					for (uint32 k = 0; k < 3; k++)
+					{
+						if (tri[k] == collapse->from)
+							p[k] = positions[collapse->to];
+					}
+					Math::Vec3f new_normal = Math::cross_product(p[1] - p[0], p[2] - p[0]);
+
+					flipped = Math::inner_product(old_normal, new_normal) < 0.25f * Math::length(old_normal) * Math::length(new_normal);
+				}
+
+				if (flipped)
+					continue;
+
+				for (uint32 a = adjacency_offsets[collapse->from]; a < adjacency_offsets[collapse->from + 1]; a++)
+				{
+					const uint32* tri = &out_indices[adjacency[a] * 3];
+					touched[tri[0]] = true;
+					touched[tri[1]] = true;
+					touched[tri[2]] = true;
+				}
+				touched[collapse->to] = true;
+
+				for (uint32 a = adjacency_offsets[collapse->from]; a < adjacency_offsets[collapse->from + 1]; a++)
+				{
+					uint32* tri = &out_indices[adjacency[a] * 3];
+					for (uint32 k = 0; k < 3; k++)
+					{
+						if (tri[k] == collapse->from)
+							tri[k] = collapse->to;
+					}
+				}
+				quadric_add(&quadrics[collapse->to], &quadrics[collapse->from]);
+
+				max_cost = collapse->cost > max_cost ? collapse->cost : max_cost;
+				applied_count++;
+				if (applied_count * 2 >= triangles_to_remove)
+					break;
+			}
+
+			if (!applied_count)
+				break;
+
+			uint32 write_count = 0;
+			for (uint32 t = 0; t < result_triangle_count; t++)
+			{
+				uint32 i0 = out_indices[t * 3 + 0];
+				uint32 i1 = out_indices[t * 3 + 1];
+				uint32 i2 = out_indices[t * 3 + 2];
+				if (i0 == i1 || i1 == i2 || i2 == i0)
+					continue;
+
+				out_indices[write_count++] = i0;
+				out_indices[write_count++] = i1;
+				out_indices[write_count++] = i2;
+			}
+			result_count = write_count;
+		}
+
+		*out_error = Math::sqrt(max_cost) * extent;
+		return result_count;
+	}
+
+	uint32 mesh_optimize_vertex_fetch(void* vertices, uint32* indices, uint32 index_count, uint32 vertex_count, uint32 vertex_size)
+	{
+		Sarray<uint32> remap(vertex_count, 0);
+		Memory::set_memory(remap.data, 0xFF, remap.size());
+
+		uint32 new_vertex_count = 0;
+		for (uint32 i = 0; i < index_count; i++)
+		{
+			uint32 v = indices[i];
+			if (remap[v] == Constants::max_u32)
+				remap[v] = new_vertex_count++;
+			indices[i] = remap[v];
+		}
+
+		Sarray<uint8> old_vertices(vertex_count * vertex_size, 0);
+		old_vertices.copy_memory(vertices, vertex_count * vertex_size, 0);
+
+		uint8* dest = (uint8*)vertices;
+		for (uint32 v = 0; v < vertex_count; v++)
+		{
+			if (remap[v] != Constants::max_u32)
+				Memory::copy_memory(&old_vertices[v * vertex_size], dest + (uint64)remap[v] * vertex_size, vertex_size);
+		}
+
+		return new_vertex_count;
+	}
+
+#ifdef DEBUG
+	// NOTE: Triangles get rotated so the smallest index comes first, which keeps the winding. Summing the hashes makes the checksum independent of triangle order.
+	static uint64 triangle_set_checksum(const uint32* indices, uint32 index_count)
+	{
+		uint64 checksum = 0;
+		for (uint32 i = 0; i + 2 < index_count; i += 3)
+		{
+			const uint32* t = &indices[i];
+			uint32 first = t[0] < t[1] ? (t[0] < t[2] ? 0 : 2) : (t[1] < t[2] ? 1 : 2);
+			uint32 rotated[3] = { t[first], t[(first + 1) % 3], t[(first + 2) % 3] };
+			checksum += hash_fnv1a64(rotated, sizeof(rotated));
+		}
+		return checksum;
+	}
+
+	bool8 mesh_optimizer_self_check()
+	{
+		const uint32 grid_size = 100;
+		const uint32 row_vertex_count = grid_size + 1;
+		const uint32 vertex_count = row_vertex_count * row_vertex_count;
+		const uint32 index_count = grid_size * grid_size * 6;
+
+		// NOTE: Bounds around the numbers the passes reach on this grid (3.0 shuffled, 0.62 optimized), a regression shows up as a miss.
+		const float32 min_shuffled_acmr = 2.5f;
+		const float32 max_optimized_acmr = 0.7f;
+
+		Sarray<Math::Vec3f> vertices(vertex_count, 0);
+		for (uint32 y = 0; y < row_vertex_count; y++)
+		{
+			for (uint32 x = 0; x < row_vertex_count; x++)
+				vertices[y * row_vertex_count + x] = { (float32)x, (float32)y, (float32)((x * 7 + y * 3) % 5) * 0.1f };
+		}
+
+		Sarray<uint32> indices(index_count, 0);
+		uint32 index = 0;
+		for (uint32 y = 0; y < grid_size; y++)
+		{
+			for (uint32 x = 0; x < grid_size; x++)
+			{
+				uint32 v0 = y * row_vertex_count + x;
+				uint32 v1 = v0 + 1;
+				uint32 v2 = v0 + row_vertex_count;
+				uint32 v3 = v2 + 1;
+
+				indices[index++] = v0; indices[index++] = v2; indices[index++] = v1;
+				indices[index++] = v1; indices[index++] = v2; indices[index++] = v3;
+			}
+		}
+
+		// NOTE: Fixed seed, so every run checks the same triangle order.
+		uint32 random_state = 0x9E3779B9;
+		uint32 triangle_count = index_count / 3;
+		for (uint32 i = triangle_count - 1; i > 0; i--)
+		{
+			random_state = random_state * 1664525 + 1013904223;
+			uint32 j = (random_state >> 8) % (i + 1);
+			for (uint32 k = 0; k < 3; k++)
+			{
+				uint32 temp = indices[i * 3 + k];
+				indices[i * 3 + k] = indices[j * 3 + k];
+				indices[j * 3 + k] = temp;
+			}
+		}
+
+		bool8 success = true;
+
+		float32 shuffled_acmr = mesh_analyze_vertex_cache(indices.data, index_count, vertex_count);
+		if (shuffled_acmr < min_shuffled_acmr)
+		{
+			SHMERRORV("mesh_optimizer_self_check - Shuffled grid has an ACMR of %f3, the cache simulator is expected to report at least %f3.", shuffled_acmr, min_shuffled_acmr);
+			success = false;
+		}
+
+		Sarray<uint32> optimized(index_count, 0);
+		mesh_optimize_vertex_cache(optimized.data, indices.data, index_count, vertex_count);
+		mesh_optimize_overdraw(optimized.data, index_count, vertices.data, vertex_count, sizeof(Math::Vec3f));
+
+		float32 optimized_acmr = mesh_analyze_vertex_cache(optimized.data, index_count, vertex_count);
+		if (optimized_acmr > max_optimized_acmr)
+		{
+			SHMERRORV("mesh_optimizer_self_check - Optimized grid has an ACMR of %f3, expected at most %f3.", optimized_acmr, max_optimized_acmr);
+			success = false;
+		}
+
+		// NOTE: The passes only reorder, so every triangle has to be there exactly once with its winding intact.
+		if (triangle_set_checksum(indices.data, index_count) != triangle_set_checksum(optimized.data, index_count))
+		{
+			SHMERROR("mesh_optimizer_self_check - Optimized index buffer does not contain the same triangles as the input.");
+			success = false;
+		}
+
+		uint32 fetch_vertex_count = mesh_optimize_vertex_fetch(vertices.data, optimized.data, index_count, vertex_count, sizeof(Math::Vec3f));
+		float32 fetch_acmr = mesh_analyze_vertex_cache(optimized.data, index_count, fetch_vertex_count);
+		if (fetch_vertex_count != vertex_count || fetch_acmr != optimized_acmr)
+		{
+			SHMERRORV("mesh_optimizer_self_check - Vertex fetch reordering changed the vertex count to %u or the ACMR to %f3.", fetch_vertex_count, fetch_acmr);
+			success = false;
+		}
+
+		vertices.free_data();
+		indices.free_data();
+		optimized.free_data();
+
+		return success;
+	}
+#endif
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "RendererTypes.hpp"
+
+namespace Renderer
+{
+
+	static const uint32 mesh_vertex_cache_size = 16;
+
+	// NOTE: Simulates a FIFO post-transform cache and returns the average cache miss count per triangle (ACMR).
+	SHMAPI float32 mesh_analyze_vertex_cache(const uint32* indices, uint32 index_count, uint32 vertex_count, uint32 cache_size = mesh_vertex_cache_size);
+
+	// NOTE: Reorders triangles for post-transform cache locality (Tipsify). out_indices must not alias indices.
+	SHMAPI void mesh_optimize_vertex_cache(uint32* out_indices, const uint32* indices, uint32 index_count, uint32 vertex_count, uint32 cache_size = mesh_vertex_cache_size);
+
+	// NOTE: Sorts cache-optimized triangle clusters front to back in a view independent way.
+	// The new order is only kept if the ACMR stays within threshold times the input's. Expects position to be the first member of the vertex type.
+	SHMAPI void mesh_optimize_overdraw(uint32* indices, uint32 index_count, const void* vertices, uint32 vertex_count, uint32 vertex_size, float32 threshold = 1.05f);
+
+	// NOTE: Quadric edge collapse onto existing vertices, so the result still indexes the input vertex buffer. Border and seam vertices stay locked.
+	// attribute_count floats at attribute_offset within each vertex add their weighted squared difference to the collapse cost.
+	// target_error is relative to the mesh extents, out_error receives the reached error in object space units. Returns the new index count.
+	SHMAPI uint32 mesh_simplify(uint32* out_indices, const uint32* indices, uint32 index_count, const void* vertices, uint32 vertex_count, uint32 vertex_size,
+		uint32 target_index_count, float32 target_error, uint32 attribute_offset, uint32 attribute_count, const float32* attribute_weights, float32* out_error);
+
+	// NOTE: Reorders vertices in order of first use by the index buffer and drops unreferenced ones. Returns the new vertex count.
+	SHMAPI uint32 mesh_optimize_vertex_fetch(void* vertices, uint32* indices, uint32 index_count, uint32 vertex_count, uint32 vertex_size);
+
+#ifdef DEBUG
+	// NOTE: Runs a shuffled grid through the optimizer passes and checks the resulting ACMR, logging every failed check.
+	SHMAPI bool8 mesh_optimizer_self_check();
+#endif
+
+}
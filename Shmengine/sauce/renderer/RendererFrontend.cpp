@@ -1,5 +1,6 @@
 #include "RendererFrontend.hpp"
 #include "RendererUtils.hpp"
+#include "TextureCodec.hpp"
 
 #include "core/Logging.hpp"
 #include "core/Memory.hpp"
@@ -8,6 +9,7 @@
 #include "memory/LinearAllocator.hpp"
 #include "memory/Freelist.hpp"
 #include "utility/math/Transform.hpp"
+#include "utility/Utility.hpp"
 #include "systems/TextureSystem.hpp"
 #include "systems/MaterialSystem.hpp"
 #include "systems/ShaderSystem.hpp"
@@ -32,10 +34,27 @@ namespace Renderer
 		SystemConfig* sys_config = (SystemConfig*)config;
 		system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
 
+		texture_codec_init();
+
 		uint64 texture_samplers_data_size = system_state->texture_samplers.get_external_size_requirement(system_state->max_texture_sampler_count);
 		void* texture_samplers_data = allocator_callback(allocator, texture_samplers_data_size);
 		system_state->texture_samplers.init(system_state->max_texture_sampler_count, DarrayFlags::NonResizable, AllocationTag::Renderer, texture_samplers_data);
 
+		system_state->queued_texture_loads.init(64, 0, AllocationTag::Renderer);
+		system_state->queued_texture_loads_head = 0;
+		system_state->pending_texture_uploads.init(64, 0, AllocationTag::Renderer);
+		system_state->texture_loads_in_flight = 0;
+		system_state->pending_texture_upload_size = 0;
+		system_state->average_texture_load_size = mebibytes(4);
+		system_state->streamed_textures.init(64, 0, AllocationTag::Renderer);
+		system_state->texture_residency_budget = sys_config->texture_residency_budget;
+		system_state->texture_resident_size = 0;
+		system_state->texture_stream_frame = 0;
+		system_state->texture_stream_request_id = 0;
+		system_state->texture_stream_loads_in_flight = 0;
+		system_state->texture_stream_pending_count = 0;
+		system_state->resource_loads.init(64, 0, AllocationTag::Renderer);
+
 		char renderer_module_filename[Constants::max_filepath_length];
 		CString::print_s(renderer_module_filename, Constants::max_filepath_length, "%s%s%s", Platform::dynamic_library_prefix, sys_config->renderer_module_name, Platform::dynamic_library_ext);
 		if (!Platform::load_dynamic_library(sys_config->renderer_module_name, renderer_module_filename, &system_state->renderer_lib))
@@ -110,6 +129,13 @@ namespace Renderer
 		renderbuffer_destroy(&system_state->general_vertex_buffer);
 		renderbuffer_destroy(&system_state->general_index_buffer);
 
+		for (uint32 i = 0; i < system_state->pending_texture_uploads.count; i++)
+			Memory::free_memory(system_state->pending_texture_uploads[i].pixels);
+		system_state->pending_texture_uploads.free_data();
+		system_state->queued_texture_loads.free_data();
+		system_state->streamed_textures.free_data();
+		system_state->resource_loads.free_data();
+
 		system_state->module.shutdown();
 		if (system_state->module_context)
 			Memory::free_memory(system_state->module_context);
@@ -136,6 +162,8 @@ namespace Renderer
 		backend.frame_number++;
 		bool8 did_resize = false;
 
+		texture_process_loads();
+
 		if (system_state->resizing) {
 			system_state->frames_since_resize++;
 
@@ -308,7 +336,8 @@ namespace Renderer
 		uint64 vertex_buffer_size = geometry->vertex_count * (uint64)geometry->vertex_size;
 		uint64 index_buffer_size = geometry->index_count * sizeof(geometry->indices[0]);
 
-		if (!vertex_buffer_size)
+		// NOTE: Geometry that referenced loader memory has none left to upload after its initial load.
+		if (!vertex_buffer_size || !geometry->vertices.data)
 			return false;
 
 		if (!(is_reload ?
@@ -349,6 +378,24 @@ namespace Renderer
 		return true;
 	}
 
+	bool8 geometry_load_vertex_range(GeometryData* geometry, uint32 vertex_offset, uint32 vertex_count)
+	{
+		if (!geometry->loaded)
+			return geometry_load(geometry);
+
+		uint64 range_offset = vertex_offset * (uint64)geometry->vertex_size;
+		uint64 range_size = vertex_count * (uint64)geometry->vertex_size;
+		SHMASSERT_MSG(range_offset + range_size <= geometry->vertex_buffer_alloc_ref.byte_size, "Vertex range exceeds the geometry's buffer allocation.");
+
+		if (!renderbuffer_load_range(&system_state->general_vertex_buffer, geometry->vertex_buffer_alloc_ref.byte_offset + range_offset, range_size, &geometry->vertices.data[range_offset]))
+		{
+			SHMERROR("Failed to load data range into vertex buffer.");
+			return false;
+		}
+
+		return true;
+	}
+
 	void geometry_unload(GeometryData* geometry)
 	{
 		if (!geometry->loaded)
@@ -357,13 +404,13 @@ namespace Renderer
 		system_state->module.device_sleep_till_idle();
 
 		renderbuffer_free(&system_state->general_vertex_buffer, &geometry->vertex_buffer_alloc_ref);
-		if (geometry->indices.data)
+		if (geometry->index_count)
 			renderbuffer_free(&system_state->general_index_buffer, &geometry->index_buffer_alloc_ref);
 
 		geometry->loaded = false;
 	}
 
-	void geometry_draw(GeometryData* geometry)
+	void geometry_draw(GeometryData* geometry, uint32 lod_index)
 	{
 		OPTICK_EVENT();
 		if (!geometry->loaded)
@@ -371,9 +418,75 @@ namespace Renderer
 
 		bool8 includes_indices = geometry->index_count > 0;
 
+		uint32 index_offset = 0;
+		uint32 index_count = geometry->index_count;
+		if (geometry->lod_count)
+		{
+			const GeometryLod* lod = &geometry->lods[lod_index < geometry->lod_count ? lod_index : geometry->lod_count - 1];
+			index_offset = lod->index_offset;
+			index_count = lod->index_count;
+		}
+
 		renderbuffer_draw(&system_state->general_vertex_buffer, geometry->vertex_buffer_alloc_ref.byte_offset, geometry->vertex_count, includes_indices);
 		if (includes_indices)
-			renderbuffer_draw(&system_state->general_index_buffer, geometry->index_buffer_alloc_ref.byte_offset, geometry->index_count, false);
+			renderbuffer_draw(&system_state->general_index_buffer, geometry->index_buffer_alloc_ref.byte_offset + index_offset * sizeof(uint32), index_count, false);
+	}
+
+	bool8 resource_load_begin(ResourceLoadType type, const char* name, void* owner)
+	{
+		uint64 name_hash = hash_fnv1a64(name, CString::length(name));
+		for (uint32 i = 0; i < system_state->resource_loads.count; i++)
+		{
+			ResourceLoad* load = &system_state->resource_loads[i];
+			if (load->type == type && load->name_hash == name_hash && !load->waiter)
+				return false;
+		}
+
+		system_state->resource_loads.push({ name_hash, type, owner, 0 });
+		return true;
+	}
+
+	bool8 resource_load_attach(ResourceLoadType type, const char* name, void* waiter)
+	{
+		uint64 name_hash = hash_fnv1a64(name, CString::length(name));
+		for (uint32 i = 0; i < system_state->resource_loads.count; i++)
+		{
+			ResourceLoad* load = &system_state->resource_loads[i];
+			if (load->type != type || load->name_hash != name_hash || load->waiter)
+				continue;
+
+			system_state->resource_loads.push({ name_hash, type, load->owner, waiter });
+			return true;
+		}
+
+		return false;
+	}
+
+	void* resource_load_next_waiter(ResourceLoadType type, void* owner)
+	{
+		Darray<ResourceLoad>& loads = system_state->resource_loads;
+		for (uint32 i = 0; i < loads.count; i++)
+		{
+			if (loads[i].type != type || loads[i].owner != owner || !loads[i].waiter)
+				continue;
+
+			void* waiter = loads[i].waiter;
+			loads[i] = loads[loads.count - 1];
+			loads.pop();
+			return waiter;
+		}
+
+		for (uint32 i = 0; i < loads.count; i++)
+		{
+			if (loads[i].type != type || loads[i].owner != owner)
+				continue;
+
+			loads[i] = loads[loads.count - 1];
+			loads.pop();
+			break;
+		}
+
+		return 0;
 	}
 
 	bool8 texture_map_init(TextureMapConfig* config, Texture* texture, TextureMap* out_map)
@@ -42,18 +42,28 @@ namespace Renderer
 	SHMAPI bool8 renderpass_end(RenderPass* pass);
 
 	SHMAPI bool8 texture_init(TextureConfig* config, Texture* out_texture);
-	SHMAPI bool8 texture_init_from_resource_async(const char* name, TextureType type, Texture* out_texture);
+	// NOTE: Streamed textures load their small mips first and get refined by what the views request through texture_request_screen_size.
+	SHMAPI bool8 texture_init_from_resource_async(const char* name, TextureType type, Texture* out_texture, bool8 streamed = false);
+	// NOTE: Starts queued texture loads within the decode budget, updates texture streaming and uploads finished loads in a single batch. Called once per frame.
+	void texture_process_loads();
+	// NOTE: Reports that a streamed texture got drawn stretched across screen_size pixels this frame.
+	SHMAPI void texture_request_screen_size(Texture* texture, float32 screen_size);
+	SHMAPI void texture_get_streaming_stats(TextureStreamingStats* out_stats);
 	SHMAPI bool8 texture_destroy(Texture* texture);
 	SHMAPI void texture_resize(Texture* texture, uint32 width, uint32 height);
 	SHMAPI bool8 texture_write_data(Texture* t, uint32 offset, uint32 size, const uint8* pixels);
+	// NOTE: Writes a tightly packed rectangle of pixels into the first mip level of an uncompressed 2D texture.
+	SHMAPI bool8 texture_write_region(Texture* t, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels);
 	SHMAPI bool8 texture_read_data(Texture* t, uint32 offset, uint32 size, void* out_memory);
 	SHMAPI bool8 texture_read_pixel(Texture* t, uint32 x, uint32 y, uint32* out_rgba);
 
 	SHMAPI bool8 geometry_init(GeometryConfig* config, GeometryData* g);
 	SHMAPI void geometry_destroy(GeometryData* g);
 	SHMAPI bool8 geometry_load(GeometryData* geometry);
+	// NOTE: Re-uploads part of an already loaded geometry's vertices into its existing allocation.
+	SHMAPI bool8 geometry_load_vertex_range(GeometryData* geometry, uint32 vertex_offset, uint32 vertex_count);
 	SHMAPI void geometry_unload(GeometryData* geometry);
-	SHMAPI void geometry_draw(GeometryData* geometry);
+	SHMAPI void geometry_draw(GeometryData* geometry, uint32 lod_index = 0);
 
 	SHMAPI bool8 shader_init(ShaderConfig* config, Shader* out_shader);
 	SHMAPI bool8 shader_init_from_resource(const char* name, RenderPass* renderpass, Shader* out_shader);
@@ -66,6 +76,8 @@ namespace Renderer
 	SHMAPI ShaderInstanceId shader_acquire_instance(Shader* shader);
 	SHMAPI bool8 shader_release_instance(Shader* shader, ShaderInstanceId instance_id);
 	SHMAPI ShaderUniformId shader_get_uniform_index(Shader* shader, const char* uniform_name);
+	// NOTE: Builds a perfect hash over the uniform names, so looking up a uniform index takes a single hash and slot read.
+	bool8 shader_build_uniform_lookup(uint32 uniform_count, const ShaderUniformConfig* uniforms, uint64* out_seed, Sarray<ShaderUniformId>* out_slots);
 	SHMAPI bool8 shader_set_uniform(Shader* shader, ShaderUniformId uniform_id, const void* value);
 
 	bool8 texture_map_init(TextureMapConfig* config, Texture* texture, TextureMap* out_map);
@@ -75,11 +87,20 @@ namespace Renderer
 	SHMAPI bool8 material_init(MaterialConfig* config, Material* out_material);
 	SHMAPI bool8 material_init_from_resource_async(const char* name, Material* out_material);
 	SHMAPI bool8 material_destroy(Material* material);
+	// NOTE: Called by texture loads a material waits on, whether they succeeded or not.
+	void material_on_texture_loaded(Material* material);
 
 	SHMAPI bool8 mesh_init(MeshConfig* config, Mesh* out_mesh);
 	SHMAPI bool8 mesh_init_from_resource_async(const char* name, Mesh* out_mesh);
 	SHMAPI bool8 mesh_destroy(Mesh* mesh);
 
+	// NOTE: Central table of loads in flight, so requesters of a resource that is already loading attach to that load instead of reading the file again.
+	// Begin opens the load for the owner and fails if one is in flight already. Attach only succeeds while a load for the name is in flight.
+	// The owner drains its waiters once the load finished, the call returning 0 also closes the load. All of it happens on the main thread.
+	bool8 resource_load_begin(ResourceLoadType type, const char* name, void* owner);
+	bool8 resource_load_attach(ResourceLoadType type, const char* name, void* waiter);
+	void* resource_load_next_waiter(ResourceLoadType type, void* owner);
+
 	SHMAPI bool8 renderbuffer_init(const char* name, RenderBufferType type, uint64 size, bool8 use_freelist, RenderBuffer* out_buffer);
 	SHMAPI void renderbuffer_destroy(RenderBuffer* buffer);
 	SHMAPI bool8 renderbuffer_bind(RenderBuffer* buffer, uint64 offset);
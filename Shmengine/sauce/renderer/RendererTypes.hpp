@@ -321,8 +321,12 @@ namespace Renderer
 
 		bool8 (*texture_init)(Texture* texture);
 		void (*texture_destroy)(Texture* texture);
+		// NOTE: Destroys the texture's backend data once all frames submitted so far finished, without waiting for the device.
+		void (*texture_destroy_deferred)(Texture* texture);
 		void (*texture_resize)(Texture* texture, uint32 width, uint32 height);
 		bool8(*texture_write_data)(Texture* t, uint32 offset, uint32 size, const uint8* pixels);
+		bool8(*texture_write_data_batch)(uint32 texture_count, Texture** textures, const uint32* sizes, const uint8** pixels);
+		bool8(*texture_write_region)(Texture* t, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels);
 		bool8(*texture_read_data)(Texture* t, uint32 offset, uint32 size, void* out_memory);
 		bool8(*texture_read_pixel)(Texture* t, uint32 x, uint32 y, uint32* out_rgba);
 
@@ -365,6 +369,27 @@ namespace Renderer
 		uint16 max_shader_uniform_count;
 		uint16 max_shader_global_textures;
 		uint16 max_shader_instance_textures;
+
+		// NOTE: Streamed textures only get refined while all textures loaded from resources fit into this many bytes.
+		uint64 texture_residency_budget;
+	};
+
+	struct TextureLoadRequest;
+	struct TextureUpload;
+
+	enum class ResourceLoadType : uint8
+	{
+		Texture,
+		Mesh
+	};
+
+	// NOTE: Entry of the in-flight load table. The entry with no waiter opens the load, every other one attaches a later requester to it.
+	struct ResourceLoad
+	{
+		uint64 name_hash;
+		ResourceLoadType type;
+		void* owner;
+		void* waiter;
 	};
 
 	struct SystemState
@@ -394,6 +419,28 @@ namespace Renderer
 		RendererConfigFlags::Value flags;
 
 		Darray<TextureSampler> texture_samplers;
+
+		inline static const uint64 texture_decode_budget = mebibytes(256);
+		inline static const uint64 texture_upload_budget_per_frame = mebibytes(64);
+		Darray<TextureLoadRequest> queued_texture_loads;
+		uint32 queued_texture_loads_head;
+		uint32 texture_loads_in_flight;
+		uint64 average_texture_load_size;
+		uint64 pending_texture_upload_size;
+		Darray<TextureUpload> pending_texture_uploads;
+
+		inline static const uint32 texture_stream_initial_dimension = 128;
+		inline static const uint32 texture_stream_eviction_frames = 300;
+		inline static const uint32 texture_stream_max_loads_in_flight = 4;
+		uint64 texture_residency_budget;
+		uint64 texture_resident_size;
+		uint32 texture_stream_frame;
+		uint32 texture_stream_request_id;
+		uint32 texture_stream_loads_in_flight;
+		uint32 texture_stream_pending_count;
+		Darray<Texture*> streamed_textures;
+
+		Darray<ResourceLoad> resource_loads;
 	};
 }
 
@@ -431,7 +478,8 @@ namespace TextureFlags
 		IsWrapped = 1 << 1,
 		FlipY = 1 << 2,
 		IsDepth = 1 << 3,
-		IsLoaded = 1 << 4
+		IsLoaded = 1 << 4,
+		IsStreamed = 1 << 5
 	};
 	typedef uint8 Value;
 }
@@ -442,12 +490,24 @@ enum class TextureType : uint8
 	Cube
 };
 
+// NOTE: Block compressed formats store 4x4 pixel blocks. Mip levels are stored back to back, largest first, each holding all layers.
+enum class TextureFormat : uint8
+{
+	RGBA8,
+	BC1,
+	BC3,
+	BC5,
+	BC7
+};
+
 struct TextureConfig
 {
 	const char* name;
 	uint8 channel_count;
 	TextureFlags::Value flags;
 	TextureType type;
+	TextureFormat format;
+	uint8 mip_levels;
 	uint32 width;
 	uint32 height;
 	uint32 pre_initialized_data_size;
@@ -460,12 +520,59 @@ struct Texture
 	TextureType type;
 	ResourceState state;
 	TextureFlags::Value flags;
+	TextureFormat format;
+	uint8 mip_levels;
 	uint8 channel_count;
 	uint32 width;
 	uint32 height;
 	Buffer internal_data = {};
+
+	// NOTE: Streaming state of textures flagged IsStreamed. The GPU image holds mip levels resident_mip and coarser out of stream_mip_count.
+	uint8 stream_mip_count;
+	uint8 resident_mip;
+	uint8 requested_mip;
+	uint8 pending_mip;
+	uint32 stream_width;
+	uint32 stream_height;
+	uint32 stream_request_id;
+	uint32 last_requested_frame;
+	float32 requested_screen_size;
+	uint32 resident_size;
 };
 
+namespace Renderer
+{
+	struct TextureLoadRequest
+	{
+		Texture* texture;
+		TextureType type;
+	};
+
+	// NOTE: Decoded texture waiting for its GPU image. Pixels are owned by the upload until it lands.
+	// Uploads with a stream_request_id replace the image of an already loaded texture with a different range of its mips.
+	struct TextureUpload
+	{
+		Texture* texture;
+		TextureConfig config;
+		uint8* pixels;
+		uint32 pixels_size;
+		uint8 stream_mip_count;
+		uint8 first_mip;
+		uint32 stream_width;
+		uint32 stream_height;
+		uint32 stream_request_id;
+	};
+
+	struct TextureStreamingStats
+	{
+		uint64 resident_size;
+		uint64 residency_budget;
+		uint32 streamed_texture_count;
+		uint32 pending_request_count;
+		uint32 loads_in_flight;
+	};
+}
+
 namespace TextureFilter
 {
 	enum : uint8
@@ -628,6 +735,9 @@ struct MaterialPhongProperties
 struct MaterialUIProperties
 {
 	Math::Vec4f diffuse_color;
+	// NOTE: Non-zero if the texture holds signed distances in alpha, edges get resolved in the fragment shader.
+	float32 distance_field;
+	Math::Vec3f padding;
 };
 
 struct MaterialTerrainProperties
@@ -646,11 +756,21 @@ struct Material
 	char name[Constants::max_material_name_length];
 	
 	Sarray<TextureMap> maps;
+	// NOTE: Texture loads a material loaded from resource still waits on before it counts as initialized.
+	uint16 pending_texture_count;
 
 	uint32 properties_size;
 	void* properties;
 };
 
+// NOTE: Levels of detail are ranges within one index buffer and share the geometry's vertices. Error is the simplification error in object space units.
+struct GeometryLod
+{
+	uint32 index_offset;
+	uint32 index_count;
+	float32 error;
+};
+
 struct GeometryResourceData
 {
 	char name[Constants::max_geometry_name_length];
@@ -661,6 +781,9 @@ struct GeometryResourceData
 	Math::Vec3f center;
 	Math::Extents3D extents;
 
+	uint32 lod_count;
+	GeometryLod lods[Constants::max_geometry_lod_count];
+
 	Sarray<byte> vertices;	
 	Sarray<uint32> indices;
 };
@@ -682,6 +805,13 @@ struct GeometryConfig
 
 	byte* vertices;	
 	uint32* indices;
+
+	// NOTE: Without any lods the whole index buffer gets drawn.
+	uint32 lod_count;
+	GeometryLod lods[Constants::max_geometry_lod_count];
+
+	// NOTE: Geometry references vertices and indices instead of copying them. They have to stay alive until the geometry has been uploaded.
+	bool8 reference_data;
 };
 
 struct GeometryData
@@ -695,6 +825,9 @@ struct GeometryData
 	uint32 vertex_count;
 	uint32 index_count;
 
+	uint32 lod_count;
+	GeometryLod lods[Constants::max_geometry_lod_count];
+
 	Sarray<byte> vertices;
 	Sarray<uint32> indices;
 
@@ -732,6 +865,11 @@ struct Mesh
 	Math::Extents3D extents;
 	Math::Vec3f center;
 	Math::Transform transform;
+
+	// NOTE: Largest error of each lod across all geometries. The current lod is kept between frames for hysteresis.
+	uint32 lod_count;
+	uint32 current_lod;
+	float32 lod_errors[Constants::max_geometry_lod_count];
 };
 
 #define UNIFORM_APPLY_OR_FAIL(expr)                  \
@@ -818,6 +956,9 @@ struct ShaderStageConfig
 {
 	ShaderStage::Value stage;
 	char filename[Constants::max_filename_length];
+	// NOTE: Spir-v embedded in a cooked shader. Stages without it get read from filename.
+	const void* code;
+	uint32 code_size;
 };
 
 struct ShaderConfig
@@ -837,10 +978,16 @@ struct ShaderConfig
 	ShaderAttributeConfig* attributes;
 	ShaderUniformConfig* uniforms;
 	ShaderStageConfig* stages;
+
+	// NOTE: Optional precomputed uniform lookup, see shader_build_uniform_lookup. Built on init if missing.
+	uint64 uniform_lookup_seed;
+	uint32 uniform_lookup_slot_count;
+	const ShaderUniformId* uniform_lookup_slots;
 };
 
 struct ShaderUniform
 {
+	uint64 name_hash;
 	uint32 offset;
 	uint16 location;
 	ShaderUniformId index;
@@ -904,7 +1051,9 @@ struct Shader
 
 	ShaderInstanceId bound_instance_id;
 
-	HashtableRH<ShaderUniformId, Constants::max_shader_uniform_name_length> uniform_lookup;
+	// NOTE: Collision free table of uniform indices, slotted by the seeded hash of the uniform name.
+	uint64 uniform_lookup_seed;
+	Sarray<ShaderUniformId> uniform_lookup;
 	Sarray<ShaderUniform> uniforms;
 	Sarray<ShaderAttribute> attributes;
 
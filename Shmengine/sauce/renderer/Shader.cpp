@@ -3,6 +3,7 @@
 #include "systems/TextureSystem.hpp"
 #include "systems/MaterialSystem.hpp"
 #include "resources/loaders/ShaderLoader.hpp"
+#include "utility/Utility.hpp"
 
 namespace Renderer
 {
@@ -13,6 +14,7 @@ namespace Renderer
 
 	static bool8 _add_attribute(Shader* shader, ShaderAttributeConfig* config, ShaderAttribute* out_attrib);
 	static bool8 _add_uniform(Shader* shader, ShaderUniformId index, ShaderUniformConfig* config, uint32* global_sampler_counter, uint32* instance_sampler_counter, ShaderUniform* out_uniform);
+	static uint32 _get_uniform_lookup_slot(uint64 name_hash, uint64 seed, uint32 slot_count);
 
 	bool8 shader_init(ShaderConfig* config, Shader* out_shader)
 	{
@@ -147,11 +149,22 @@ namespace Renderer
 		for (uint32 i = 0; i < out_shader->global_texture_maps.capacity; i++)
 			out_shader->global_texture_maps[i] = MaterialSystem::get_default_texture_map();
 
-		out_shader->uniform_lookup.init((uint32)(config->uniforms_count * 1.5f), 0);
 		out_shader->uniforms.init(config->uniforms_count, 0, AllocationTag::Renderer);
 		for (uint32 i = 0, global_sampler_counter = 0, instance_sampler_counter = 0; i < out_shader->uniforms.capacity; i++)
 			_add_uniform(out_shader, (uint16)i, &config->uniforms[i], &global_sampler_counter, &instance_sampler_counter, &out_shader->uniforms[i]);
 
+		if (config->uniform_lookup_slots)
+		{
+			out_shader->uniform_lookup_seed = config->uniform_lookup_seed;
+			out_shader->uniform_lookup.init(config->uniform_lookup_slot_count, 0, AllocationTag::Renderer);
+			out_shader->uniform_lookup.copy_memory(config->uniform_lookup_slots, config->uniform_lookup_slot_count, 0);
+		}
+		else if (!shader_build_uniform_lookup(config->uniforms_count, config->uniforms, &out_shader->uniform_lookup_seed, &out_shader->uniform_lookup))
+		{
+			SHMERRORV("Failed to build uniform lookup for shader '%s'.", out_shader->name.c_str());
+			return false;
+		}
+
 		out_shader->instance_count = 0;
 
 		// Make sure the UBO is aligned according to device requirements.
@@ -291,14 +304,73 @@ namespace Renderer
 
 	ShaderUniformId shader_get_uniform_index(Shader* shader, const char* uniform_name)
 	{
-		ShaderUniformId* id = shader->uniform_lookup.get(uniform_name);
-		if (!id)
+		uint64 name_hash = hash_fnv1a64(uniform_name, CString::length(uniform_name));
+		ShaderUniformId id = shader->uniform_lookup[_get_uniform_lookup_slot(name_hash, shader->uniform_lookup_seed, shader->uniform_lookup.capacity)];
+		if (!id.is_valid() || shader->uniforms[id].name_hash != name_hash)
 		{
 			SHMERRORV("Shader '%s' does not have a uniform named '%s' registered.", shader->name.c_str(), uniform_name);
 			return ShaderUniformId::invalid_value;
 		}
 
-		return shader->uniforms[(*id)].index;
+		return shader->uniforms[id].index;
+	}
+
+	bool8 shader_build_uniform_lookup(uint32 uniform_count, const ShaderUniformConfig* uniforms, uint64* out_seed, Sarray<ShaderUniformId>* out_slots)
+	{
+		const uint32 max_seed_attempts = 1024;
+
+		Sarray<uint64> name_hashes(uniform_count ? uniform_count : 1, 0, AllocationTag::Renderer);
+		for (uint32 i = 0; i < uniform_count; i++)
+			name_hashes[i] = hash_fnv1a64(uniforms[i].name, CString::length(uniforms[i].name));
+
+		// NOTE: Tries seeds until every name lands in its own slot, growing the table whenever a size runs out of seeds.
+		// Only done when a shader gets built from text, cooked shaders bring their seed and slots along.
+		uint32 slot_count = 1;
+		while (slot_count < uniform_count * 2)
+			slot_count <<= 1;
+
+		for (; slot_count <= Constants::max_u16; slot_count <<= 1)
+		{
+			out_slots->free_data();
+			out_slots->init(slot_count, 0, AllocationTag::Renderer);
+
+			for (uint64 seed = 0; seed < max_seed_attempts; seed++)
+			{
+				for (uint32 i = 0; i < slot_count; i++)
+					(*out_slots)[i].invalidate();
+
+				bool8 collided = false;
+				for (uint32 i = 0; i < uniform_count && !collided; i++)
+				{
+					if (!uniforms[i].name[0])
+						continue;
+
+					ShaderUniformId* slot = &(*out_slots)[_get_uniform_lookup_slot(name_hashes[i], seed, slot_count)];
+					collided = slot->is_valid();
+					*slot = (uint16)i;
+				}
+
+				if (collided)
+					continue;
+
+				*out_seed = seed;
+				name_hashes.free_data();
+				return true;
+			}
+		}
+
+		out_slots->free_data();
+		name_hashes.free_data();
+		return false;
+	}
+
+	static uint32 _get_uniform_lookup_slot(uint64 name_hash, uint64 seed, uint32 slot_count)
+	{
+		uint64 hash = name_hash ^ (seed * 0x9E3779B97F4A7C15ull);
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		return (uint32)hash & (slot_count - 1);
 	}
 
 	bool8 shader_set_uniform(Shader* shader, ShaderUniformId uniform_id, const void* value) 
@@ -390,6 +462,7 @@ namespace Renderer
 			return false;
 
 		out_uniform->index = index;
+		out_uniform->name_hash = hash_fnv1a64(config->name, CString::length(config->name));
 		out_uniform->scope = config->scope;
 		out_uniform->type = config->type;
 
@@ -467,8 +540,6 @@ namespace Renderer
 		}
 		}
 
-		shader->uniform_lookup.set_value(config->name, out_uniform->index);
-
 		return true;
 	}
 }
@@ -2,11 +2,13 @@
 #include "core/Memory.hpp"
 #include "core/Logging.hpp"
 #include "core/Identifier.hpp"
+#include "renderer/TextureCodec.hpp"
 #include "resources/loaders/TextureLoader.hpp"
 #include "utility/math/Transform.hpp"
 
 #include "systems/JobSystem.hpp"
 #include "systems/ShaderSystem.hpp"
+#include "platform/AsyncIO.hpp"
 
 namespace Renderer
 {
@@ -15,9 +17,32 @@ namespace Renderer
 	static bool8 _texture_init(TextureConfig* config, Texture* out_texture);
 	static void _texture_destroy(Texture* texture);
 
-	static void _texture_init_from_resource_job_success(void* params);
-	static void _texture_init_from_resource_job_fail(void* params);
-	static bool8 _texture_init_from_resource_job(uint32 thread_index, void* user_data);
+	struct TextureCubeLoad;
+
+	static void _texture_start_queued_loads();
+	static void _texture_upload_pending();
+	static void _texture_queue_upload(const TextureUpload* upload);
+	static void _texture_load_failed(Texture* texture);
+	static void _texture_load_finished(Texture* texture);
+
+	static void _texture_update_streaming();
+	static void _texture_start_stream_load(Texture* texture, uint8 target_mip);
+	static void _texture_stream_load_job_success(void* params);
+	static void _texture_stream_load_job_fail(void* params);
+	static void _texture_stream_remove(Texture* texture);
+	static uint8 _texture_get_initial_stream_mip(uint32 width, uint32 height, uint32 mip_count);
+	static uint32 _texture_get_stream_size(const Texture* texture, uint8 first_mip);
+
+	static void _texture_start_plane_load(Texture* texture);
+	static void _texture_load_job_success(void* params);
+	static void _texture_load_job_fail(void* params);
+	static bool8 _texture_load_job(uint32 thread_index, void* user_data);
+
+	static void _texture_start_cube_load(Texture* texture);
+	static void _texture_cube_face_job_success(void* params);
+	static void _texture_cube_face_job_fail(void* params);
+	static bool8 _texture_cube_face_job(uint32 thread_index, void* user_data);
+	static void _texture_cube_face_done(TextureCubeLoad* cube_load);
 
 	bool8 texture_init(TextureConfig* config, Texture* out_texture)
 	{
@@ -33,29 +58,102 @@ namespace Renderer
 
 	struct TextureLoadParams
 	{
-		TextureType texture_type;
+		AsyncIO::ReadResult read;
+		Texture* out_texture;
 		char texture_name[Constants::max_texture_name_length];
+		TextureConfig config;
+		uint8* pixels;
+		uint32 pixels_size;
+		bool8 streamed;
+		// NOTE: Set for stream loads that only read the kept mips out of the cooked file.
+		bool8 mip_range_read;
+		uint8 stream_mip_count;
+		uint8 first_mip;
+		uint32 stream_width;
+		uint32 stream_height;
+		uint32 stream_request_id;
+	};
+
+	struct TextureCubeLoad
+	{
 		Texture* out_texture;
-		Sarray<uint8>pixels;
+		TextureResourceData faces[6];
+		uint32 pending_face_count;
+		bool8 failed;
 	};
 
-	bool8 texture_init_from_resource_async(const char* name, TextureType type, Texture* out_texture)
+	struct TextureCubeFaceLoadParams
+	{
+		TextureCubeLoad* cube_load;
+		uint32 face_index;
+		char face_name[Constants::max_texture_name_length];
+	};
+
+	bool8 texture_init_from_resource_async(const char* name, TextureType type, Texture* out_texture, bool8 streamed)
 	{
 		if (out_texture->state >= ResourceState::Initialized)
 			return false;
 
 		out_texture->state = ResourceState::Initializing;
-		JobSystem::JobInfo job = JobSystem::job_create(_texture_init_from_resource_job, _texture_init_from_resource_job_success, _texture_init_from_resource_job_fail, sizeof(TextureLoadParams));
-		TextureLoadParams* params = (TextureLoadParams*)job.user_data;
-		CString::copy(name, params->texture_name, Constants::max_texture_name_length);
-		params->out_texture = out_texture;
-		params->texture_type = type;
-		params->pixels = {};
-		JobSystem::submit(job);
+		out_texture->type = type;
+		out_texture->flags = (streamed && type == TextureType::Plane) ? TextureFlags::IsStreamed : 0;
+		out_texture->stream_mip_count = 0;
+		out_texture->stream_request_id = 0;
+		out_texture->resident_size = 0;
+		CString::copy(name, out_texture->name, Constants::max_texture_name_length);
+		resource_load_begin(ResourceLoadType::Texture, out_texture->name, out_texture);
+
+		// NOTE: The load only gets queued here. texture_process_loads starts it once the decode budget allows and uploads the result.
+		// Until then the texture is not flagged as loaded, so shaders keep binding the default texture in its place.
+		TextureLoadRequest request = { out_texture, type };
+		system_state->queued_texture_loads.push(request);
 
 		return true;
 	}
 
+	void texture_process_loads()
+	{
+		_texture_update_streaming();
+		_texture_start_queued_loads();
+		_texture_upload_pending();
+	}
+
+	void texture_request_screen_size(Texture* texture, float32 screen_size)
+	{
+		if (!(texture->flags & TextureFlags::IsStreamed) || !texture->stream_mip_count)
+			return;
+
+		// NOTE: One texel per pixel is enough, so every halving of the screen size drops one mip level.
+		float32 dimension = (float32)SHMAX(texture->stream_width, texture->stream_height);
+		uint8 mip = 0;
+		while (mip + 1 < texture->stream_mip_count && dimension * 0.5f >= screen_size)
+		{
+			dimension *= 0.5f;
+			mip++;
+		}
+
+		if (texture->last_requested_frame != system_state->texture_stream_frame)
+		{
+			texture->last_requested_frame = system_state->texture_stream_frame;
+			texture->requested_mip = mip;
+			texture->requested_screen_size = screen_size;
+		}
+		else
+		{
+			texture->requested_mip = SHMIN(texture->requested_mip, mip);
+			texture->requested_screen_size = SHMAX(texture->requested_screen_size, screen_size);
+		}
+	}
+
+	void texture_get_streaming_stats(TextureStreamingStats* out_stats)
+	{
+		out_stats->resident_size = system_state->texture_resident_size;
+		out_stats->residency_budget = system_state->texture_residency_budget;
+		out_stats->streamed_texture_count = system_state->streamed_textures.count;
+		out_stats->pending_request_count = system_state->texture_stream_pending_count;
+		out_stats->loads_in_flight = system_state->texture_stream_loads_in_flight;
+	}
+
 	bool8 texture_destroy(Texture* texture)
 	{
 		if (texture->state != ResourceState::Initialized)
@@ -69,13 +167,19 @@ namespace Renderer
 
 	static bool8 _texture_init(TextureConfig* config, Texture* out_texture)
 	{
-		CString::copy(config->name, out_texture->name, Constants::max_texture_name_length);
+		if (config->name != out_texture->name)
+			CString::copy(config->name, out_texture->name, Constants::max_texture_name_length);
 		out_texture->channel_count = config->channel_count;
 		out_texture->width = config->width;
 		out_texture->height = config->height;
 		out_texture->type = config->type;
+		out_texture->format = config->format;
+		out_texture->mip_levels = SHMAX(config->mip_levels, 1);
 		out_texture->flags = config->flags;
 		out_texture->flags &= ~TextureFlags::IsLoaded;
+		out_texture->stream_mip_count = 0;
+		out_texture->stream_request_id = 0;
+		out_texture->resident_size = 0;
 		if (config->pre_initialized_data)
 		{
 			out_texture->internal_data.init(config->pre_initialized_data_size, 0, AllocationTag::Texture, config->pre_initialized_data);
@@ -93,138 +197,694 @@ namespace Renderer
 
     static void _texture_destroy(Texture* texture)
     {
+		// NOTE: Stream loads still in flight notice the cleared request id and drop their pixels.
+		if (texture->flags & TextureFlags::IsStreamed)
+			_texture_stream_remove(texture);
+		texture->stream_request_id = 0;
+		system_state->texture_resident_size -= texture->resident_size;
+		texture->resident_size = 0;
+
 		system_state->module.texture_destroy(texture);
 		texture->internal_data.free_data();
 		texture->flags = 0;
 		texture->name[0] = 0;
     }
 
-	static void _texture_init_from_resource_job_success(void* params) 
+	static void _texture_start_queued_loads()
 	{
-		TextureLoadParams* load_params = (TextureLoadParams*)params;
-
-		Renderer::texture_write_data(load_params->out_texture, 0, load_params->pixels.capacity, load_params->pixels.data);
+		uint32 max_loads_in_flight = SHMAX(JobSystem::get_thread_count() * 2, 2);
+		while (system_state->queued_texture_loads_head < system_state->queued_texture_loads.count)
+		{
+			// NOTE: Decoded sizes are only known after the job ran, so every load in flight gets charged the running average.
+			uint64 projected_size = system_state->pending_texture_upload_size + (system_state->texture_loads_in_flight + 1) * system_state->average_texture_load_size;
+			bool8 is_idle = !system_state->texture_loads_in_flight && !system_state->pending_texture_upload_size;
+			if (!is_idle && (system_state->texture_loads_in_flight >= max_loads_in_flight || projected_size > SystemState::texture_decode_budget))
+				break;
+
+			TextureLoadRequest request = system_state->queued_texture_loads[system_state->queued_texture_loads_head++];
+			system_state->texture_loads_in_flight++;
+
+			if (request.type == TextureType::Cube)
+				_texture_start_cube_load(request.texture);
+			else
+				_texture_start_plane_load(request.texture);
+		}
 
-		load_params->pixels.free_data();
-		load_params->out_texture->state = ResourceState::Initialized;
-		SHMTRACEV("Successfully loaded texture '%s'.", load_params->out_texture->name);
+		if (system_state->queued_texture_loads_head >= system_state->queued_texture_loads.count)
+		{
+			system_state->queued_texture_loads.clear();
+			system_state->queued_texture_loads_head = 0;
+		}
 	}
 
-	static void _texture_init_from_resource_job_fail(void* params) 
+	// NOTE: Image a stream upload replaces. It only gets destroyed once the new one holds its pixels.
+	struct TextureRetiredImage
 	{
-		TextureLoadParams* load_params = (TextureLoadParams*)params;
-		load_params->pixels.free_data();
-        load_params->out_texture->state = ResourceState::Destroyed;
-		SHMERRORV("Failed to load texture '%s'.", load_params->out_texture->name);
-	}
+		Buffer internal_data;
+		uint32 width;
+		uint32 height;
+		uint8 mip_levels;
+	};
 
-	static bool8 _texture_init_from_resource_job(uint32 thread_index, void* user_data) 
+	static void _texture_restore_image(Texture* texture, TextureRetiredImage* retired)
 	{
-		TextureLoadParams* load_params = (TextureLoadParams*)user_data;
-		TextureConfig config = {};
-		config.type = load_params->texture_type;
-		config.flags = 0;
-		config.name = load_params->texture_name;
+		texture->internal_data.steal(retired->internal_data);
+		texture->width = retired->width;
+		texture->height = retired->height;
+		texture->mip_levels = retired->mip_levels;
+		texture->pending_mip = Constants::max_u8;
+	}
 
-		switch (config.type)
-		{
-		case TextureType::Plane:
+	static void _texture_upload_pending()
+	{
+		const uint32 max_batch_count = 64;
+		Texture* textures[max_batch_count];
+		const uint8* pixels[max_batch_count];
+		uint32 sizes[max_batch_count];
+		const TextureUpload* batch_uploads[max_batch_count];
+		TextureRetiredImage retired_images[max_batch_count];
+
+		Darray<TextureUpload>& pending_uploads = system_state->pending_texture_uploads;
+		uint32 upload_count = 0;
+		uint32 batch_count = 0;
+		uint64 batch_size = 0;
+		for (; upload_count < pending_uploads.count && upload_count < max_batch_count; upload_count++)
 		{
-			TextureResourceData resource = {};
-			if (!ResourceSystem::texture_loader_load(load_params->texture_name, true, &resource))
+			TextureUpload* upload = &pending_uploads[upload_count];
+			if (upload_count && batch_size + upload->pixels_size > SystemState::texture_upload_budget_per_frame)
+				break;
+
+			batch_size += upload->pixels_size;
+			Texture* texture = upload->texture;
+			if (upload->stream_request_id)
+			{
+				if (texture->stream_request_id != upload->stream_request_id || texture->state != ResourceState::Initialized)
+					continue;
+
+				// NOTE: The texture keeps its current image until the new mip range landed, so it never falls back to the default texture.
+				TextureRetiredImage* retired = &retired_images[batch_count];
+				retired->internal_data.steal(texture->internal_data);
+				retired->width = texture->width;
+				retired->height = texture->height;
+				retired->mip_levels = texture->mip_levels;
+
+				texture->width = upload->config.width;
+				texture->height = upload->config.height;
+				texture->mip_levels = upload->config.mip_levels;
+				if (!system_state->module.texture_init(texture))
+				{
+					SHMERRORV("Failed to create streamed mips for texture '%s'.", texture->name);
+					_texture_restore_image(texture, retired);
+					continue;
+				}
+			}
+			else if (!_texture_init(&upload->config, texture))
 			{
-				SHMERRORV("Failed to load image resources for texture '%s'", load_params->texture_name);
-				return false;
+				texture->state = ResourceState::Destroyed;
+				_texture_load_finished(texture);
+				continue;
 			}
 
-			config.channel_count = resource.channel_count;
-			config.width = resource.width;
-			config.height = resource.height;
-			load_params->pixels.init((uint32)resource.pixels.size, 0);
-			load_params->pixels.copy_memory(resource.pixels.data, (uint32)resource.pixels.size, 0);
+			textures[batch_count] = texture;
+			pixels[batch_count] = upload->pixels;
+			sizes[batch_count] = upload->pixels_size;
+			batch_uploads[batch_count] = upload;
+			batch_count++;
+		}
+
+		if (!upload_count)
+			return;
 
-			for (uint64 i = 0; i < load_params->pixels.capacity; i += config.channel_count)
+		// NOTE: All textures of this frame share a single staging buffer and submit.
+		bool8 uploaded = !batch_count || system_state->module.texture_write_data_batch(batch_count, textures, sizes, pixels);
+		for (uint32 i = 0; i < batch_count; i++)
+		{
+			Texture* texture = textures[i];
+			const TextureUpload* upload = batch_uploads[i];
+
+			if (upload->stream_request_id)
 			{
-				uint8 a = load_params->pixels[i + 3];
-				if (a < 255)
+				if (uploaded)
 				{
-					config.flags |= TextureFlags::HasTransparency;
-					break;
+					// NOTE: Frames in flight may still sample the replaced image, the backend frees it once they finished instead of waiting for the device.
+					Texture retired_texture = {};
+					retired_texture.internal_data.steal(retired_images[i].internal_data);
+					system_state->module.texture_destroy_deferred(&retired_texture);
+
+					system_state->texture_resident_size += sizes[i] - texture->resident_size;
+					texture->resident_size = sizes[i];
+					texture->resident_mip = upload->first_mip;
+					texture->pending_mip = Constants::max_u8;
 				}
-			}
-			
-			ResourceSystem::texture_loader_unload(&resource);
-			break;
-		}
-		case TextureType::Cube:
-		{
-			char texture_names[6][Constants::max_texture_name_length];
-			CString::safe_print_s(texture_names[0], Constants::max_texture_name_length, "%s_r", config.name);
-			CString::safe_print_s(texture_names[1], Constants::max_texture_name_length, "%s_l", config.name);
-			CString::safe_print_s(texture_names[2], Constants::max_texture_name_length, "%s_u", config.name);
-			CString::safe_print_s(texture_names[3], Constants::max_texture_name_length, "%s_d", config.name);
-			CString::safe_print_s(texture_names[4], Constants::max_texture_name_length, "%s_f", config.name);
-			CString::safe_print_s(texture_names[5], Constants::max_texture_name_length, "%s_b", config.name);
-
-			TextureResourceData resources[6] = {};
-			bool8 resource_load_success = true;
-			for (uint32 i = 0; i < 6; i++)
-			{
-				if (!ResourceSystem::texture_loader_load(texture_names[i], false, &resources[i]))
+				else
 				{
-					SHMERRORV("Failed to load image resources for texture '%s'", texture_names[i]);
-					break;
+					SHMERRORV("Failed to upload streamed mips for texture '%s'.", texture->name);
+					system_state->module.texture_destroy(texture);
+					_texture_restore_image(texture, &retired_images[i]);
 				}
+				continue;
 			}
 
-			uint32 width = 0, height = 0;
-			uint8 channel_count = 0;
-			if (resource_load_success)
+			if (uploaded)
 			{
-				width = resources[0].width;
-				height = resources[0].height;
-				channel_count = resources[0].channel_count;
-				for (uint32 i = 1; i < 6; i++)
+				texture->state = ResourceState::Initialized;
+				texture->resident_size = sizes[i];
+				system_state->texture_resident_size += sizes[i];
+
+				if (upload->stream_mip_count)
 				{
-					if (resources[i].width != width || resources[i].height != height || resources[i].channel_count != channel_count)
-					{
-						SHMERRORV("Failed to load cube texture: Dimensions or channel counts do not match up!");
-						resource_load_success = false;
-					}
+					texture->stream_mip_count = upload->stream_mip_count;
+					texture->stream_width = upload->stream_width;
+					texture->stream_height = upload->stream_height;
+					texture->resident_mip = upload->first_mip;
+					texture->requested_mip = upload->first_mip;
+					texture->pending_mip = Constants::max_u8;
+					texture->last_requested_frame = 0;
+					texture->requested_screen_size = 0.0f;
+					system_state->streamed_textures.push(texture);
 				}
+				SHMTRACEV("Successfully loaded texture '%s'.", texture->name);
 			}
+			else
+			{
+				SHMERRORV("Failed to upload texture '%s'.", texture->name);
+				_texture_destroy(texture);
+				texture->state = ResourceState::Destroyed;
+			}
+			_texture_load_finished(texture);
+		}
 
-			if (resource_load_success)
+		for (uint32 i = 0; i < upload_count; i++)
+		{
+			Memory::free_memory(pending_uploads[i].pixels);
+			system_state->pending_texture_upload_size -= pending_uploads[i].pixels_size;
+		}
+
+		uint32 remaining_count = pending_uploads.count - upload_count;
+		for (uint32 i = 0; i < remaining_count; i++)
+			pending_uploads[i] = pending_uploads[upload_count + i];
+		pending_uploads.set_count(remaining_count);
+	}
+
+	static void _texture_queue_upload(const TextureUpload* upload)
+	{
+		system_state->texture_loads_in_flight--;
+		system_state->average_texture_load_size = (system_state->average_texture_load_size * 7 + upload->pixels_size) / 8;
+		system_state->pending_texture_upload_size += upload->pixels_size;
+
+		system_state->pending_texture_uploads.push(*upload);
+	}
+
+	static TextureUpload _texture_get_upload(const TextureLoadParams* load_params)
+	{
+		TextureUpload upload = {};
+		upload.texture = load_params->out_texture;
+		upload.config = load_params->config;
+		upload.pixels = load_params->pixels;
+		upload.pixels_size = load_params->pixels_size;
+		upload.stream_mip_count = load_params->stream_mip_count;
+		upload.first_mip = load_params->first_mip;
+		upload.stream_width = load_params->stream_width;
+		upload.stream_height = load_params->stream_height;
+		upload.stream_request_id = load_params->stream_request_id;
+		return upload;
+	}
+
+	static void _texture_load_failed(Texture* texture)
+	{
+		system_state->texture_loads_in_flight--;
+		texture->state = ResourceState::Destroyed;
+		SHMERRORV("Failed to load texture '%s'.", texture->name);
+		_texture_load_finished(texture);
+	}
+
+	static void _texture_load_finished(Texture* texture)
+	{
+		// NOTE: Materials waiting on the first load get told either way, failed textures leave the default texture bound in their place.
+		while (Material* material = (Material*)resource_load_next_waiter(ResourceLoadType::Texture, texture))
+			material_on_texture_loaded(material);
+	}
+
+	static void _texture_start_plane_load(Texture* texture)
+	{
+		JobSystem::JobInfo job = JobSystem::job_create(_texture_load_job, _texture_load_job_success, _texture_load_job_fail, sizeof(TextureLoadParams));
+		TextureLoadParams* params = (TextureLoadParams*)job.user_data;
+		params->read = {};
+		params->out_texture = texture;
+		CString::copy(texture->name, params->texture_name, Constants::max_texture_name_length);
+		params->config = {};
+		params->pixels = 0;
+		params->pixels_size = 0;
+		params->streamed = (texture->flags & TextureFlags::IsStreamed);
+		params->mip_range_read = false;
+		params->stream_mip_count = 0;
+		params->first_mip = 0;
+		params->stream_width = 0;
+		params->stream_height = 0;
+		params->stream_request_id = 0;
+
+		// NOTE: The file gets read asynchronously, so the job only has to decode.
+		char full_filepath[Constants::max_filepath_length];
+		if (ResourceSystem::texture_loader_get_filepath(texture->name, full_filepath))
+			AsyncIO::read_file(full_filepath, job);
+		else
+			JobSystem::submit(job);
+	}
+
+	static void _texture_load_job_success(void* params) 
+	{
+		TextureLoadParams* load_params = (TextureLoadParams*)params;
+		TextureUpload upload = _texture_get_upload(load_params);
+		_texture_queue_upload(&upload);
+	}
+
+	static void _texture_load_job_fail(void* params) 
+	{
+		TextureLoadParams* load_params = (TextureLoadParams*)params;
+		if (load_params->pixels)
+			Memory::free_memory(load_params->pixels);
+		_texture_load_failed(load_params->out_texture);
+	}
+
+	static uint8* _texture_take_pixels(TextureResourceData* resource)
+	{
+		uint8* pixels = 0;
+		if (resource->pixels.flags & BufferFlags::ExternalMemory)
+		{
+			pixels = (uint8*)Memory::allocate(resource->pixels.size, AllocationTag::Texture);
+			Memory::copy_memory(resource->pixels.data, pixels, resource->pixels.size);
+			ResourceSystem::texture_loader_unload(resource);
+		}
+		else
+		{
+			pixels = (uint8*)resource->pixels.data;
+			resource->pixels.data = 0;
+			resource->pixels.size = 0;
+		}
+
+		return pixels;
+	}
+
+	static bool8 _texture_load_mip_range(TextureLoadParams* load_params)
+	{
+		if (!load_params->read.success || load_params->read.size != load_params->pixels_size)
+		{
+			if (load_params->read.data)
+				Memory::free_memory(load_params->read.data);
+			load_params->read.data = 0;
+
+			SHMERRORV("Failed to read streamed mips of texture '%s'", load_params->texture_name);
+			return false;
+		}
+
+		TextureConfig* config = &load_params->config;
+		config->width = texture_get_mip_dimension(load_params->stream_width, load_params->first_mip);
+		config->height = texture_get_mip_dimension(load_params->stream_height, load_params->first_mip);
+		config->mip_levels = load_params->stream_mip_count - load_params->first_mip;
+
+		load_params->pixels = (uint8*)load_params->read.data;
+		load_params->read.data = 0;
+		return true;
+	}
+
+	static bool8 _texture_load_job(uint32 thread_index, void* user_data) 
+	{
+		TextureLoadParams* load_params = (TextureLoadParams*)user_data;
+		Texture* texture = load_params->out_texture;
+
+		if (load_params->mip_range_read)
+			return _texture_load_mip_range(load_params);
+
+		TextureResourceData resource = {};
+		bool8 decoded = load_params->read.success && 
+			ResourceSystem::texture_loader_load_from_memory(load_params->texture_name, load_params->read.data, load_params->read.size, true, &resource);
+
+		if (load_params->read.data)
+			Memory::free_memory(load_params->read.data);
+		load_params->read.data = 0;
+
+		if (!decoded)
+		{
+			SHMERRORV("Failed to load image resources for texture '%s'", load_params->texture_name);
+			return false;
+		}
+
+		// NOTE: Streamed textures only keep the tail of their mip chain. First loads start small, stream loads get the level the streamer asked for.
+		uint8 first_mip = 0;
+		bool8 streamed = load_params->streamed && resource.mip_count > 1;
+		if (streamed)
+		{
+			if (load_params->stream_request_id)
+				first_mip = (uint8)SHMIN((uint32)load_params->first_mip, resource.mip_count - 1u);
+			else
+				first_mip = _texture_get_initial_stream_mip(resource.width, resource.height, resource.mip_count);
+		}
+
+		TextureConfig* config = &load_params->config;
+		config->name = texture->name;
+		config->type = TextureType::Plane;
+		config->channel_count = resource.channel_count;
+		config->width = texture_get_mip_dimension(resource.width, first_mip);
+		config->height = texture_get_mip_dimension(resource.height, first_mip);
+		config->format = resource.format;
+		config->mip_levels = resource.mip_count - first_mip;
+		config->flags = resource.has_transparency ? TextureFlags::HasTransparency : 0;
+		config->flags |= streamed ? TextureFlags::IsStreamed : 0;
+
+		uint32 skipped_size = 0;
+		for (uint32 mip = 0; mip < first_mip; mip++)
+			skipped_size += texture_get_mip_size(resource.format, texture_get_mip_dimension(resource.width, mip), texture_get_mip_dimension(resource.height, mip));
+
+		load_params->stream_mip_count = streamed ? resource.mip_count : 0;
+		load_params->stream_width = resource.width;
+		load_params->stream_height = resource.height;
+		load_params->first_mip = first_mip;
+		load_params->pixels_size = (uint32)resource.pixels.size - skipped_size;
+		load_params->pixels = _texture_take_pixels(&resource);
+		ResourceSystem::texture_loader_unload(&resource);
+
+		if (skipped_size)
+		{
+			uint8* mip_tail = (uint8*)Memory::allocate(load_params->pixels_size, AllocationTag::Texture);
+			Memory::copy_memory(load_params->pixels + skipped_size, mip_tail, load_params->pixels_size);
+			Memory::free_memory(load_params->pixels);
+			load_params->pixels = mip_tail;
+		}
+
+		return true;
+	}
+
+	static void _texture_start_cube_load(Texture* texture)
+	{
+		static const char* face_suffixes[6] = { "_r", "_l", "_u", "_d", "_f", "_b" };
+
+		TextureCubeLoad* cube_load = (TextureCubeLoad*)Memory::allocate(sizeof(TextureCubeLoad), AllocationTag::Texture);
+		Memory::zero_memory(cube_load, sizeof(TextureCubeLoad));
+		cube_load->out_texture = texture;
+		cube_load->pending_face_count = 6;
+
+		// NOTE: Every face decodes in its own job. The last one to report back assembles the cube.
+		for (uint32 i = 0; i < 6; i++)
+		{
+			JobSystem::JobInfo job = JobSystem::job_create(_texture_cube_face_job, _texture_cube_face_job_success, _texture_cube_face_job_fail, sizeof(TextureCubeFaceLoadParams));
+			TextureCubeFaceLoadParams* params = (TextureCubeFaceLoadParams*)job.user_data;
+			params->cube_load = cube_load;
+			params->face_index = i;
+			CString::safe_print_s(params->face_name, Constants::max_texture_name_length, "%s%s", (const char*)texture->name, face_suffixes[i]);
+			JobSystem::submit(job);
+		}
+	}
+
+	static bool8 _texture_cube_face_job(uint32 thread_index, void* user_data)
+	{
+		TextureCubeFaceLoadParams* load_params = (TextureCubeFaceLoadParams*)user_data;
+		if (!ResourceSystem::texture_loader_load(load_params->face_name, false, &load_params->cube_load->faces[load_params->face_index]))
+		{
+			SHMERRORV("Failed to load image resources for texture '%s'", load_params->face_name);
+			return false;
+		}
+
+		return true;
+	}
+
+	static void _texture_cube_face_job_success(void* params)
+	{
+		TextureCubeFaceLoadParams* load_params = (TextureCubeFaceLoadParams*)params;
+		_texture_cube_face_done(load_params->cube_load);
+	}
+
+	static void _texture_cube_face_job_fail(void* params)
+	{
+		TextureCubeFaceLoadParams* load_params = (TextureCubeFaceLoadParams*)params;
+		load_params->cube_load->failed = true;
+		_texture_cube_face_done(load_params->cube_load);
+	}
+
+	static void _texture_cube_face_done(TextureCubeLoad* cube_load)
+	{
+		if (--cube_load->pending_face_count > 0)
+			return;
+
+		TextureResourceData* faces = cube_load->faces;
+		Texture* texture = cube_load->out_texture;
+		bool8 resource_load_success = !cube_load->failed;
+		for (uint32 i = 1; i < 6 && resource_load_success; i++)
+		{
+			if (faces[i].width != faces[0].width || faces[i].height != faces[0].height || faces[i].channel_count != faces[0].channel_count)
 			{
-				config.width = width;
-				config.height = height;
-				config.channel_count = channel_count;
+				SHMERRORV("Failed to load cube texture: Dimensions or channel counts do not match up!");
+				resource_load_success = false;
+			}
+			else if (faces[i].format != faces[0].format || faces[i].mip_count != faces[0].mip_count)
+			{
+				SHMERRORV("Failed to load cube texture: Faces have been cooked with different formats or mip counts!");
+				resource_load_success = false;
+			}
+		}
+
+		TextureConfig config = {};
+		uint8* pixels = 0;
+		uint32 pixels_size = 0;
+		if (resource_load_success)
+		{
+			config.name = texture->name;
+			config.type = TextureType::Cube;
+			config.width = faces[0].width;
+			config.height = faces[0].height;
+			config.channel_count = faces[0].channel_count;
+			config.format = faces[0].format;
+			config.mip_levels = faces[0].mip_count;
 
-				uint32 pixel_buffer_size = 0;
+			for (uint32 i = 0; i < 6; i++)
+				pixels_size += (uint32)faces[i].pixels.size;
+
+			// NOTE: Faces get interleaved per mip level, so every level's six layers sit next to each other for the upload.
+			pixels = (uint8*)Memory::allocate(pixels_size, AllocationTag::Texture);
+			uint32 face_offset = 0;
+			for (uint32 offset = 0, mip = 0; mip < config.mip_levels; mip++)
+			{
+				uint32 mip_size = texture_get_mip_size(config.format, texture_get_mip_dimension(config.width, mip), texture_get_mip_dimension(config.height, mip));
 				for (uint32 i = 0; i < 6; i++)
-					pixel_buffer_size += (uint32)resources[i].pixels.size;
+				{
+					Memory::copy_memory((uint8*)faces[i].pixels.data + face_offset, pixels + offset, mip_size);
+					offset += mip_size;
+				}
+				face_offset += mip_size;
+			}
+		}
+
+		for (uint32 i = 0; i < 6; i++)
+			ResourceSystem::texture_loader_unload(&faces[i]);
+		Memory::free_memory(cube_load);
+
+		if (resource_load_success)
+		{
+			TextureUpload upload = {};
+			upload.texture = texture;
+			upload.config = config;
+			upload.pixels = pixels;
+			upload.pixels_size = pixels_size;
+			_texture_queue_upload(&upload);
+		}
+		else
+			_texture_load_failed(texture);
+	}
+
+	static uint8 _texture_get_initial_stream_mip(uint32 width, uint32 height, uint32 mip_count)
+	{
+		uint8 mip = 0;
+		while (mip + 1u < mip_count && SHMAX(texture_get_mip_dimension(width, mip), texture_get_mip_dimension(height, mip)) > SystemState::texture_stream_initial_dimension)
+			mip++;
 
-				load_params->pixels.init(pixel_buffer_size, 0);
-				for (uint32 offset = 0, i = 0; i < 6; i++)
+		return mip;
+	}
+
+	static uint32 _texture_get_stream_size(const Texture* texture, uint8 first_mip)
+	{
+		uint32 size = 0;
+		for (uint32 mip = first_mip; mip < texture->stream_mip_count; mip++)
+			size += texture_get_mip_size(texture->format, texture_get_mip_dimension(texture->stream_width, mip), texture_get_mip_dimension(texture->stream_height, mip));
+
+		return size;
+	}
+
+	static void _texture_stream_remove(Texture* texture)
+	{
+		Darray<Texture*>& streamed_textures = system_state->streamed_textures;
+		for (uint32 i = 0; i < streamed_textures.count; i++)
+		{
+			if (streamed_textures[i] != texture)
+				continue;
+
+			streamed_textures[i] = streamed_textures[streamed_textures.count - 1];
+			streamed_textures.pop();
+			return;
+		}
+	}
+
+	static void _texture_update_streaming()
+	{
+		uint32 frame = system_state->texture_stream_frame;
+		uint64 budget = system_state->texture_residency_budget;
+
+		// NOTE: Loads in flight are charged with the size they are going to end up with.
+		uint64 projected_size = system_state->texture_resident_size;
+		uint32 waiting_count = 0;
+
+		Texture* upgrade = 0;
+		Texture* evict = 0;
+		Texture* trim = 0;
+		for (uint32 i = 0; i < system_state->streamed_textures.count; i++)
+		{
+			Texture* t = system_state->streamed_textures[i];
+			if (t->state != ResourceState::Initialized)
+				continue;
+
+			if (t->pending_mip != Constants::max_u8)
+			{
+				projected_size += _texture_get_stream_size(t, t->pending_mip);
+				projected_size -= t->resident_size;
+				continue;
+			}
+
+			bool8 recently_requested = frame - t->last_requested_frame <= 1;
+			if (recently_requested && t->requested_mip < t->resident_mip)
+			{
+				// NOTE: Textures missing the most mip levels go first, ties are broken by how large they appear on screen.
+				waiting_count++;
+				if (!upgrade)
+					upgrade = t;
+				else if (t->resident_mip - t->requested_mip > upgrade->resident_mip - upgrade->requested_mip)
+					upgrade = t;
+				else if (t->resident_mip - t->requested_mip == upgrade->resident_mip - upgrade->requested_mip && t->requested_screen_size > upgrade->requested_screen_size)
+					upgrade = t;
+			}
+			else if (!recently_requested)
+			{
+				uint8 initial_mip = _texture_get_initial_stream_mip(t->stream_width, t->stream_height, t->stream_mip_count);
+				if (frame - t->last_requested_frame >= SystemState::texture_stream_eviction_frames && t->resident_mip < initial_mip)
 				{
-					load_params->pixels.copy_memory(resources[i].pixels.data, (uint32)resources[i].pixels.size, offset);
-					offset += (uint32)resources[i].pixels.size;
+					if (!evict || t->last_requested_frame < evict->last_requested_frame)
+						evict = t;
 				}
 			}
+			else if (t->requested_mip > t->resident_mip)
+			{
+				if (!trim || t->requested_mip - t->resident_mip > trim->requested_mip - trim->resident_mip)
+					trim = t;
+			}
+		}
 
-			for (uint32 i = 0; i < 6; i++)
-				ResourceSystem::texture_loader_unload(&resources[i]);
+		system_state->texture_stream_pending_count = waiting_count + system_state->texture_stream_loads_in_flight;
+		system_state->texture_stream_frame++;
+
+		// NOTE: Over budget, least recently drawn textures drop back to their initial mips first, then textures drawn smaller than their resident mips allow.
+		if (system_state->texture_stream_loads_in_flight < SystemState::texture_stream_max_loads_in_flight)
+		{
+			uint64 upgrade_size = upgrade ? _texture_get_stream_size(upgrade, upgrade->requested_mip) - upgrade->resident_size : 0;
+			if (projected_size + upgrade_size > budget)
+			{
+				if (evict)
+					_texture_start_stream_load(evict, _texture_get_initial_stream_mip(evict->stream_width, evict->stream_height, evict->stream_mip_count));
+				else if (trim)
+					_texture_start_stream_load(trim, trim->requested_mip);
+			}
+		}
 
-			break;
+		if (upgrade && system_state->texture_stream_loads_in_flight < SystemState::texture_stream_max_loads_in_flight)
+		{
+			uint64 upgrade_size = _texture_get_stream_size(upgrade, upgrade->requested_mip) - upgrade->resident_size;
+			if (projected_size + upgrade_size <= budget)
+				_texture_start_stream_load(upgrade, upgrade->requested_mip);
 		}
-		default:
+	}
+
+	static void _texture_start_stream_load(Texture* texture, uint8 target_mip)
+	{
+		JobSystem::JobInfo job = JobSystem::job_create(_texture_load_job, _texture_stream_load_job_success, _texture_stream_load_job_fail, sizeof(TextureLoadParams));
+		TextureLoadParams* params = (TextureLoadParams*)job.user_data;
+		params->read = {};
+		params->out_texture = texture;
+		CString::copy(texture->name, params->texture_name, Constants::max_texture_name_length);
+		params->config = {};
+		params->pixels = 0;
+		params->pixels_size = 0;
+		params->streamed = true;
+		params->mip_range_read = false;
+		params->stream_mip_count = 0;
+		params->first_mip = target_mip;
+		params->stream_width = 0;
+		params->stream_height = 0;
+
+		system_state->texture_stream_request_id++;
+		if (!system_state->texture_stream_request_id)
+			system_state->texture_stream_request_id++;
+		params->stream_request_id = system_state->texture_stream_request_id;
+
+		texture->stream_request_id = params->stream_request_id;
+		texture->pending_mip = target_mip;
+		system_state->texture_stream_loads_in_flight++;
+
+		// NOTE: The mip layout is known since the first load, so cooked textures only get the mips read that are going to be kept.
+		char full_filepath[Constants::max_filepath_length];
+		uint64 range_offset, range_size;
+		if (ResourceSystem::texture_loader_get_mip_range(texture->name, texture->format, texture->stream_width, texture->stream_height, texture->stream_mip_count, target_mip, full_filepath, &range_offset, &range_size))
 		{
-			SHMASSERT_MSG(false, "Supplied unknown texture type.");
-			return false;
+			params->mip_range_read = true;
+			params->config.name = texture->name;
+			params->config.type = TextureType::Plane;
+			params->config.format = texture->format;
+			params->config.channel_count = texture->channel_count;
+			params->config.flags = (texture->flags & TextureFlags::HasTransparency) | TextureFlags::IsStreamed;
+			params->stream_mip_count = texture->stream_mip_count;
+			params->stream_width = texture->stream_width;
+			params->stream_height = texture->stream_height;
+			params->pixels_size = (uint32)range_size;
+			AsyncIO::read_file_range(full_filepath, range_offset, range_size, job);
 		}
+		else if (ResourceSystem::texture_loader_get_filepath(texture->name, full_filepath))
+			AsyncIO::read_file(full_filepath, job);
+		else
+			JobSystem::submit(job);
+	}
+
+	static void _texture_stream_load_job_success(void* params)
+	{
+		TextureLoadParams* load_params = (TextureLoadParams*)params;
+		Texture* texture = load_params->out_texture;
+		system_state->texture_stream_loads_in_flight--;
+
+		if (texture->stream_request_id != load_params->stream_request_id || texture->state != ResourceState::Initialized || !load_params->stream_mip_count)
+		{
+			Memory::free_memory(load_params->pixels);
+			if (texture->stream_request_id == load_params->stream_request_id)
+				texture->pending_mip = Constants::max_u8;
+			return;
 		}
 
-		return _texture_init(&config, load_params->out_texture);
+		system_state->pending_texture_upload_size += load_params->pixels_size;
+
+		TextureUpload upload = _texture_get_upload(load_params);
+		system_state->pending_texture_uploads.push(upload);
+	}
+
+	static void _texture_stream_load_job_fail(void* params)
+	{
+		TextureLoadParams* load_params = (TextureLoadParams*)params;
+		Texture* texture = load_params->out_texture;
+		system_state->texture_stream_loads_in_flight--;
+
+		if (load_params->pixels)
+			Memory::free_memory(load_params->pixels);
+
+		// NOTE: The texture keeps the mips it has, it just stops being streamed instead of retrying every frame.
+		if (texture->stream_request_id == load_params->stream_request_id && texture->state == ResourceState::Initialized)
+		{
+			SHMWARNV("Failed to stream mips of texture '%s'. Keeping its current mips.", texture->name);
+			_texture_stream_remove(texture);
+			texture->flags &= ~TextureFlags::IsStreamed;
+			texture->pending_mip = Constants::max_u8;
+		}
 	}
 
 	void texture_resize(Texture* texture, uint32 width, uint32 height)
@@ -237,6 +897,11 @@ namespace Renderer
 		return system_state->module.texture_write_data(t, offset, size, pixels);
 	}
 
+	bool8 texture_write_region(Texture* t, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels)
+	{
+		return system_state->module.texture_write_region(t, x, y, width, height, pixels);
+	}
+
 	bool8 texture_read_data(Texture* t, uint32 offset, uint32 size, void* out_memory)
 	{
 		return system_state->module.texture_read_data(t, offset, size, out_memory);
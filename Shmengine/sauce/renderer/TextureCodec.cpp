@@ -0,0 +1,647 @@
+#include "TextureCodec.hpp"
+
+#include "core/Memory.hpp"
+#include "utility/Math.hpp"
+
+namespace Renderer
+{
+
+	static const uint32 max_kernel_tap_count = 6;
+	static const float32 kaiser_alpha = 4.0f;
+	static const float32 kaiser_half_width = 3.0f;
+
+	// NOTE: Mode 6 interpolation weights for 4 bit indices, out of 64.
+	static const uint32 bc7_weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	struct DownsampleKernel
+	{
+		int32 first_offset;
+		uint32 tap_count;
+		float32 weights[max_kernel_tap_count];
+	};
+
+	static float32 srgb_to_linear_table[256];
+
+	void texture_codec_init()
+	{
+		for (uint32 i = 0; i < 256; i++)
+		{
+			float32 c = i / 255.0f;
+			srgb_to_linear_table[i] = c <= 0.04045f ? c / 12.92f : Math::pow((c + 0.055f) / 1.055f, 2.4f);
+		}
+	}
+
+	static uint8 unorm_to_byte(float32 value)
+	{
+		value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+		return (uint8)Math::round_f_to_i(value * 255.0f);
+	}
+
+	static uint8 linear_to_srgb(float32 value)
+	{
+		value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+		float32 s = value <= 0.0031308f ? value * 12.92f : 1.055f * Math::pow(value, 1.0f / 2.4f) - 0.055f;
+		return unorm_to_byte(s);
+	}
+
+	static float32 bessel_i0(float32 x)
+	{
+		float32 sum = 1.0f;
+		float32 term = 1.0f;
+		float32 half_x = x * 0.5f;
+		for (uint32 k = 1; k < 32; k++)
+		{
+			term *= half_x / (float32)k;
+			sum += term * term;
+			if (term * term < sum * 1e-8f)
+				break;
+		}
+		return sum;
+	}
+
+	static float32 sinc(float32 x)
+	{
+		if (Math::abs(x) < 1e-6f)
+			return 1.0f;
+		return Math::sin(Constants::PI * x) / (Constants::PI * x);
+	}
+
+	static void get_downsample_kernel(TextureMipFilter filter, uint32 src_dimension, DownsampleKernel* out_kernel)
+	{
+		if (src_dimension == 1)
+		{
+			out_kernel->first_offset = 0;
+			out_kernel->tap_count = 1;
+			out_kernel->weights[0] = 1.0f;
+			return;
+		}
+
+		if (filter == TextureMipFilter::Box)
+		{
+			out_kernel->first_offset = 0;
+			out_kernel->tap_count = 2;
+			out_kernel->weights[0] = 0.5f;
+			out_kernel->weights[1] = 0.5f;
+			return;
+		}
+
+		// NOTE: Kaiser windowed sinc at half the source frequency, centered between the two source texels of a box filter.
+		out_kernel->first_offset = -2;
+		out_kernel->tap_count = max_kernel_tap_count;
+		float32 weight_sum = 0.0f;
+		for (uint32 i = 0; i < out_kernel->tap_count; i++)
+		{
+			float32 distance = (float32)(out_kernel->first_offset + (int32)i) - 0.5f;
+			float32 t = distance / kaiser_half_width;
+			float32 window = bessel_i0(kaiser_alpha * Math::sqrt(SHMAX(1.0f - t * t, 0.0f))) / bessel_i0(kaiser_alpha);
+			out_kernel->weights[i] = sinc(distance * 0.5f) * window;
+			weight_sum += out_kernel->weights[i];
+		}
+
+		for (uint32 i = 0; i < out_kernel->tap_count; i++)
+			out_kernel->weights[i] /= weight_sum;
+	}
+
+	SHMINLINE uint32 clamp_coord(int32 coord, uint32 dimension)
+	{
+		if (coord < 0)
+			return 0;
+		return (uint32)coord >= dimension ? dimension - 1 : (uint32)coord;
+	}
+
+	uint32 texture_get_mip_count(uint32 width, uint32 height)
+	{
+		uint32 largest = SHMAX(width, height);
+		uint32 count = 1;
+		while (largest > 1)
+		{
+			largest >>= 1;
+			count++;
+		}
+		return count;
+	}
+
+	uint32 texture_get_mip_dimension(uint32 dimension, uint32 mip_level)
+	{
+		uint32 mip_dimension = dimension >> mip_level;
+		return mip_dimension ? mip_dimension : 1;
+	}
+
+	uint32 texture_get_mip_size(TextureFormat format, uint32 width, uint32 height)
+	{
+		uint32 block_count = ((width + 3) / 4) * ((height + 3) / 4);
+		switch (format)
+		{
+		case TextureFormat::BC1:
+			return block_count * 8;
+		case TextureFormat::BC3:
+		case TextureFormat::BC5:
+		case TextureFormat::BC7:
+			return block_count * 16;
+		default:
+			return width * height * 4;
+		}
+	}
+
+	void texture_downsample(const uint8* pixels, uint32 width, uint32 height, bool8 srgb, TextureMipFilter filter, uint8* out_pixels)
+	{
+
+
+		uint32 out_width = SHMAX(width / 2, 1);
+		uint32 out_height = SHMAX(height / 2, 1);
+
+		DownsampleKernel kernel_x, kernel_y;
+		get_downsample_kernel(filter, width, &kernel_x);
+		get_downsample_kernel(filter, height, &kernel_y);
+		uint32 step_x = width > 1 ? 2 : 1;
+		uint32 step_y = height > 1 ? 2 : 1;
+
+		float32* horizontal = (float32*)Memory::allocate(sizeof(float32) * 4 * out_width * height, AllocationTag::Texture);
+
+		for (uint32 y = 0; y < height; y++)
+		{
+			const uint8* row = &pixels[y * width * 4];
+			for (uint32 x = 0; x < out_width; x++)
+			{
+				float32 sum[4] = {};
+				for (uint32 t = 0; t < kernel_x.tap_count; t++)
+				{
+					const uint8* texel = &row[clamp_coord((int32)(x * step_x) + kernel_x.first_offset + (int32)t, width) * 4];
+					float32 weight = kernel_x.weights[t];
+					for (uint32 c = 0; c < 3; c++)
+						sum[c] += weight * (srgb ? srgb_to_linear_table[texel[c]] : texel[c] / 255.0f);
+					sum[3] += weight * (texel[3] / 255.0f);
+				}
+
+				float32* out = &horizontal[(y * out_width + x) * 4];
+				for (uint32 c = 0; c < 4; c++)
+					out[c] = sum[c];
+			}
+		}
+
+		for (uint32 y = 0; y < out_height; y++)
+		{
+			for (uint32 x = 0; x < out_width; x++)
+			{
+				float32 sum[4] = {};
+				for (uint32 t = 0; t < kernel_y.tap_count; t++)
+				{
+					const float32* texel = &horizontal[(clamp_coord((int32)(y * step_y) + kernel_y.first_offset + (int32)t, height) * out_width + x) * 4];
+					for (uint32 c = 0; c < 4; c++)
+						sum[c] += kernel_y.weights[t] * texel[c];
+				}
+
+				uint8* out = &out_pixels[(y * out_width + x) * 4];
+				for (uint32 c = 0; c < 3; c++)
+					out[c] = srgb ? linear_to_srgb(sum[c]) : unorm_to_byte(sum[c]);
+				out[3] = unorm_to_byte(sum[3]);
+			}
+		}
+
+		Memory::free_memory(horizontal);
+
+	}
+
+	// NOTE: Principal axis of the block's colors through power iteration on the covariance matrix.
+	static void block_principal_axis(const float32 (*texels)[4], uint32 channel_count, float32* out_mean, float32* out_axis)
+	{
+
+		for (uint32 c = 0; c < channel_count; c++)
+		{
+			out_mean[c] = 0.0f;
+			for (uint32 i = 0; i < 16; i++)
+				out_mean[c] += texels[i][c];
+			out_mean[c] /= 16.0f;
+		}
+
+		float32 covariance[4][4] = {};
+		for (uint32 i = 0; i < 16; i++)
+		{
+			for (uint32 a = 0; a < channel_count; a++)
+			{
+				for (uint32 b = 0; b < channel_count; b++)
+					covariance[a][b] += (texels[i][a] - out_mean[a]) * (texels[i][b] - out_mean[b]);
+			}
+		}
+
+		for (uint32 c = 0; c < channel_count; c++)
+			out_axis[c] = 1.0f;
+
+		for (uint32 iteration = 0; iteration < 8; iteration++)
+		{
+			float32 next[4] = {};
+			float32 largest = 0.0f;
+			for (uint32 a = 0; a < channel_count; a++)
+			{
+				for (uint32 b = 0; b < channel_count; b++)
+					next[a] += covariance[a][b] * out_axis[b];
+				largest = SHMAX(largest, Math::abs(next[a]));
+			}
+
+			if (largest < 1e-6f)
+				break;
+
+			for (uint32 c = 0; c < channel_count; c++)
+				out_axis[c] = next[c] / largest;
+		}
+
+	}
+
+	static void block_axis_endpoints(const float32 (*texels)[4], uint32 channel_count, float32 inset, float32* out_min, float32* out_max)
+	{
+
+		float32 mean[4];
+		float32 axis[4];
+		block_principal_axis(texels, channel_count, mean, axis);
+
+		float32 axis_length2 = 0.0f;
+		for (uint32 c = 0; c < channel_count; c++)
+			axis_length2 += axis[c] * axis[c];
+
+		float32 min_t = 0.0f;
+		float32 max_t = 0.0f;
+		if (axis_length2 > 1e-12f)
+		{
+			min_t = Constants::INFINITY;
+			max_t = -Constants::INFINITY;
+			for (uint32 i = 0; i < 16; i++)
+			{
+				float32 t = 0.0f;
+				for (uint32 c = 0; c < channel_count; c++)
+					t += (texels[i][c] - mean[c]) * axis[c];
+				t /= axis_length2;
+				min_t = SHMIN(min_t, t);
+				max_t = SHMAX(max_t, t);
+			}
+
+			float32 inset_t = (max_t - min_t) * inset;
+			min_t += inset_t;
+			max_t -= inset_t;
+		}
+
+		for (uint32 c = 0; c < channel_count; c++)
+		{
+			out_min[c] = mean[c] + axis[c] * min_t;
+			out_max[c] = mean[c] + axis[c] * max_t;
+		}
+
+	}
+
+	static uint16 pack_565(const float32* color)
+	{
+		int32 r = Math::round_f_to_i(SHMAX(SHMIN(color[0], 255.0f), 0.0f) * (31.0f / 255.0f));
+		int32 g = Math::round_f_to_i(SHMAX(SHMIN(color[1], 255.0f), 0.0f) * (63.0f / 255.0f));
+		int32 b = Math::round_f_to_i(SHMAX(SHMIN(color[2], 255.0f), 0.0f) * (31.0f / 255.0f));
+		return (uint16)((r << 11) | (g << 5) | b);
+	}
+
+	static void unpack_565(uint16 packed, float32* out_color)
+	{
+		uint32 r = (packed >> 11) & 0x1F;
+		uint32 g = (packed >> 5) & 0x3F;
+		uint32 b = packed & 0x1F;
+		out_color[0] = (float32)((r << 3) | (r >> 2));
+		out_color[1] = (float32)((g << 2) | (g >> 4));
+		out_color[2] = (float32)((b << 3) | (b >> 2));
+	}
+
+	static float32 bc1_fit_indices(const float32 (*texels)[4], uint16 c0, uint16 c1, uint32* out_indices)
+	{
+
+		float32 palette[4][3];
+		unpack_565(c0, palette[0]);
+		unpack_565(c1, palette[1]);
+		for (uint32 c = 0; c < 3; c++)
+		{
+			palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+			palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+		}
+
+		float32 total_error = 0.0f;
+		for (uint32 i = 0; i < 16; i++)
+		{
+			float32 best_error = Constants::INFINITY;
+			for (uint32 p = 0; p < 4; p++)
+			{
+				float32 error = 0.0f;
+				for (uint32 c = 0; c < 3; c++)
+				{
+					float32 d = texels[i][c] - palette[p][c];
+					error += d * d;
+				}
+
+				if (error < best_error)
+				{
+					best_error = error;
+					out_indices[i] = p;
+				}
+			}
+			total_error += best_error;
+		}
+
+		return total_error;
+
+	}
+
+	static void bc1_order_endpoints(uint16* c0, uint16* c1)
+	{
+		if (*c0 < *c1)
+		{
+			uint16 temp = *c0;
+			*c0 = *c1;
+			*c1 = temp;
+		}
+	}
+
+	// NOTE: Always uses the opaque four color mode. The first fit comes from the principal axis, a least squares pass over its indices refines the endpoints.
+	static void encode_bc1_block(const float32 (*texels)[4], uint8* out_block)
+	{
+
+		float32 low[4], high[4];
+		block_axis_endpoints(texels, 3, 1.0f / 16.0f, low, high);
+
+		uint16 c0 = pack_565(high);
+		uint16 c1 = pack_565(low);
+		bc1_order_endpoints(&c0, &c1);
+
+		uint32 indices[16] = {};
+		float32 error = c0 == c1 ? 0.0f : bc1_fit_indices(texels, c0, c1, indices);
+
+		if (c0 != c1)
+		{
+			static const float32 index_weights[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+			float32 aa = 0.0f, ab = 0.0f, bb = 0.0f;
+			float32 ax[3] = {}, bx[3] = {};
+			for (uint32 i = 0; i < 16; i++)
+			{
+				float32 a = index_weights[indices[i]];
+				float32 b = 1.0f - a;
+				aa += a * a;
+				ab += a * b;
+				bb += b * b;
+				for (uint32 c = 0; c < 3; c++)
+				{
+					ax[c] += a * texels[i][c];
+					bx[c] += b * texels[i][c];
+				}
+			}
+
+			float32 determinant = aa * bb - ab * ab;
+			if (Math::abs(determinant) > 1e-6f)
+			{
+				float32 refined0[3], refined1[3];
+				for (uint32 c = 0; c < 3; c++)
+				{
+					refined0[c] = (ax[c] * bb - bx[c] * ab) / determinant;
+					refined1[c] = (bx[c] * aa - ax[c] * ab) / determinant;
+				}
+
+				uint16 r0 = pack_565(refined0);
+				uint16 r1 = pack_565(refined1);
+				bc1_order_endpoints(&r0, &r1);
+				if (r0 != r1)
+				{
+					uint32 refined_indices[16];
+					float32 refined_error = bc1_fit_indices(texels, r0, r1, refined_indices);
+					if (refined_error < error)
+					{
+						c0 = r0;
+						c1 = r1;
+						for (uint32 i = 0; i < 16; i++)
+							indices[i] = refined_indices[i];
+					}
+				}
+			}
+		}
+
+		uint32 packed_indices = 0;
+		for (uint32 i = 0; i < 16; i++)
+			packed_indices |= indices[i] << (i * 2);
+
+		out_block[0] = (uint8)(c0 & 0xFF);
+		out_block[1] = (uint8)(c0 >> 8);
+		out_block[2] = (uint8)(c1 & 0xFF);
+		out_block[3] = (uint8)(c1 >> 8);
+		Memory::copy_memory(&packed_indices, &out_block[4], sizeof(uint32));
+
+	}
+
+	// NOTE: Eight value mode, the block's minimum and maximum are the endpoints.
+	static void encode_bc4_block(const float32 (*texels)[4], uint32 channel, uint8* out_block)
+	{
+
+		float32 min_value = 255.0f;
+		float32 max_value = 0.0f;
+		for (uint32 i = 0; i < 16; i++)
+		{
+			min_value = SHMIN(min_value, texels[i][channel]);
+			max_value = SHMAX(max_value, texels[i][channel]);
+		}
+
+		uint32 a0 = (uint32)Math::round_f_to_i(max_value);
+		uint32 a1 = (uint32)Math::round_f_to_i(min_value);
+		out_block[0] = (uint8)a0;
+		out_block[1] = (uint8)a1;
+
+		uint64 packed_indices = 0;
+		if (a0 > a1)
+		{
+			float32 palette[8];
+			palette[0] = (float32)a0;
+			palette[1] = (float32)a1;
+			for (uint32 p = 1; p < 7; p++)
+				palette[p + 1] = ((7 - p) * (float32)a0 + p * (float32)a1) / 7.0f;
+
+			for (uint32 i = 0; i < 16; i++)
+			{
+				uint64 best_index = 0;
+				float32 best_error = Constants::INFINITY;
+				for (uint32 p = 0; p < 8; p++)
+				{
+					float32 error = Math::abs(texels[i][channel] - palette[p]);
+					if (error < best_error)
+					{
+						best_error = error;
+						best_index = p;
+					}
+				}
+				packed_indices |= best_index << (i * 3);
+			}
+		}
+
+		for (uint32 i = 0; i < 6; i++)
+			out_block[2 + i] = (uint8)((packed_indices >> (i * 8)) & 0xFF);
+
+	}
+
+	static void write_block_bits(uint8* block, uint32* bit_offset, uint32 value, uint32 bit_count)
+	{
+		for (uint32 i = 0; i < bit_count; i++, (*bit_offset)++)
+		{
+			if ((value >> i) & 1)
+				block[*bit_offset >> 3] |= (uint8)(1 << (*bit_offset & 7));
+		}
+	}
+
+	static void bc7_quantize_endpoint(const float32* endpoint, uint32* out_values, uint32* out_p_bit)
+	{
+		float32 best_error = Constants::INFINITY;
+		for (uint32 p = 0; p < 2; p++)
+		{
+			uint32 values[4];
+			float32 error = 0.0f;
+			for (uint32 c = 0; c < 4; c++)
+			{
+				int32 q = Math::round_f_to_i(SHMAX((endpoint[c] - (float32)p) * 0.5f, 0.0f));
+				values[c] = (uint32)SHMIN(q, 127);
+				float32 d = endpoint[c] - (float32)((values[c] << 1) | p);
+				error += d * d;
+			}
+
+			if (error < best_error)
+			{
+				best_error = error;
+				*out_p_bit = p;
+				for (uint32 c = 0; c < 4; c++)
+					out_values[c] = values[c];
+			}
+		}
+	}
+
+	// NOTE: Mode 6 only: one subset, 7.7.7.7 endpoints with a shared p-bit each and 4 bit indices.
+	static void encode_bc7_block(const float32 (*texels)[4], uint8* out_block)
+	{
+
+		float32 low[4], high[4];
+		block_axis_endpoints(texels, 4, 0.0f, low, high);
+
+		uint32 e0[4], e1[4];
+		uint32 p0, p1;
+		bc7_quantize_endpoint(low, e0, &p0);
+		bc7_quantize_endpoint(high, e1, &p1);
+
+		float32 palette[16][4];
+		for (uint32 w = 0; w < 16; w++)
+		{
+			for (uint32 c = 0; c < 4; c++)
+			{
+				uint32 v0 = (e0[c] << 1) | p0;
+				uint32 v1 = (e1[c] << 1) | p1;
+				palette[w][c] = (float32)(((64 - bc7_weights[w]) * v0 + bc7_weights[w] * v1 + 32) >> 6);
+			}
+		}
+
+		uint32 indices[16];
+		for (uint32 i = 0; i < 16; i++)
+		{
+			float32 best_error = Constants::INFINITY;
+			for (uint32 w = 0; w < 16; w++)
+			{
+				float32 error = 0.0f;
+				for (uint32 c = 0; c < 4; c++)
+				{
+					float32 d = texels[i][c] - palette[w][c];
+					error += d * d;
+				}
+
+				if (error < best_error)
+				{
+					best_error = error;
+					indices[i] = w;
+				}
+			}
+		}
+
+		// NOTE: The first index is stored without its top bit, so it has to point into the lower half of the palette.
+		if (indices[0] & 8)
+		{
+			for (uint32 c = 0; c < 4; c++)
+			{
+				uint32 temp = e0[c];
+				e0[c] = e1[c];
+				e1[c] = temp;
+			}
+
+			uint32 temp_p = p0;
+			p0 = p1;
+			p1 = temp_p;
+
+			for (uint32 i = 0; i < 16; i++)
+				indices[i] = 15 - indices[i];
+		}
+
+		Memory::zero_memory(out_block, 16);
+		uint32 bit_offset = 0;
+		write_block_bits(out_block, &bit_offset, 1 << 6, 7);
+		for (uint32 c = 0; c < 4; c++)
+		{
+			write_block_bits(out_block, &bit_offset, e0[c], 7);
+			write_block_bits(out_block, &bit_offset, e1[c], 7);
+		}
+		write_block_bits(out_block, &bit_offset, p0, 1);
+		write_block_bits(out_block, &bit_offset, p1, 1);
+
+		write_block_bits(out_block, &bit_offset, indices[0], 3);
+		for (uint32 i = 1; i < 16; i++)
+			write_block_bits(out_block, &bit_offset, indices[i], 4);
+
+	}
+
+	void texture_compress(TextureFormat format, const uint8* pixels, uint32 width, uint32 height, uint8* out_blocks)
+	{
+
+		uint32 block_size = texture_get_mip_size(format, 1, 1);
+		uint32 blocks_x = (width + 3) / 4;
+		uint32 blocks_y = (height + 3) / 4;
+
+		float32 texels[16][4];
+		for (uint32 by = 0; by < blocks_y; by++)
+		{
+			for (uint32 bx = 0; bx < blocks_x; bx++)
+			{
+				for (uint32 i = 0; i < 16; i++)
+				{
+					uint32 x = SHMIN(bx * 4 + (i & 3), width - 1);
+					uint32 y = SHMIN(by * 4 + (i >> 2), height - 1);
+					const uint8* texel = &pixels[(y * width + x) * 4];
+					for (uint32 c = 0; c < 4; c++)
+						texels[i][c] = (float32)texel[c];
+				}
+
+				uint8* block = &out_blocks[(by * blocks_x + bx) * block_size];
+				switch (format)
+				{
+				case TextureFormat::BC1:
+				{
+					encode_bc1_block(texels, block);
+					break;
+				}
+				case TextureFormat::BC3:
+				{
+					encode_bc4_block(texels, 3, block);
+					encode_bc1_block(texels, block + 8);
+					break;
+				}
+				case TextureFormat::BC5:
+				{
+					encode_bc4_block(texels, 0, block);
+					encode_bc4_block(texels, 1, block + 8);
+					break;
+				}
+				case TextureFormat::BC7:
+				{
+					encode_bc7_block(texels, block);
+					break;
+				}
+				default:
+				{
+					SHMASSERT_MSG(false, "Texture format is not block compressed.");
+					return;
+				}
+				}
+			}
+		}
+
+	}
+
+}
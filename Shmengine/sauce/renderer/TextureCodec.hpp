@@ -0,0 +1,28 @@
+#pragma once
+
+#include "RendererTypes.hpp"
+
+namespace Renderer
+{
+
+	enum class TextureMipFilter : uint8
+	{
+		Box,
+		Kaiser
+	};
+
+	// NOTE: Fills the lookup tables used while filtering. Runs once during renderer init, before any texture gets loaded or cooked on the job threads.
+	void texture_codec_init();
+
+	SHMAPI uint32 texture_get_mip_count(uint32 width, uint32 height);
+	SHMAPI uint32 texture_get_mip_dimension(uint32 dimension, uint32 mip_level);
+	// NOTE: Byte size of a single layer of one mip level.
+	SHMAPI uint32 texture_get_mip_size(TextureFormat format, uint32 width, uint32 height);
+
+	// NOTE: Halves an RGBA8 image, odd dimensions round down. Color channels of sRGB images get filtered in linear space.
+	SHMAPI void texture_downsample(const uint8* pixels, uint32 width, uint32 height, bool8 srgb, TextureMipFilter filter, uint8* out_pixels);
+
+	// NOTE: Encodes an RGBA8 image into 4x4 blocks, partial blocks at the edges repeat the last row/column. BC5 takes red and green.
+	SHMAPI void texture_compress(TextureFormat format, const uint8* pixels, uint32 width, uint32 height, uint8* out_blocks);
+
+}
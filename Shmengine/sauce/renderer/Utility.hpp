@@ -71,6 +71,9 @@ namespace Renderer
 		geo_config.vertex_count = resource->vertex_count;
 		geo_config.vertex_size = resource->vertex_size;
 		geo_config.vertices = resource->vertices.data;
+		geo_config.lod_count = resource->lod_count;
+		for (uint32 i = 0; i < resource->lod_count; i++)
+			geo_config.lods[i] = resource->lods[i];
 		return geo_config;
 	}
 }
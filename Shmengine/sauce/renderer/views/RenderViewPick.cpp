@@ -86,6 +86,7 @@ bool8 render_view_pick_on_create(RenderView* self)
 	internal_data->near_clip_3D = 0.1f;
 	internal_data->far_clip_3D = 4000.0f;
 	internal_data->fov_3D = Math::deg_to_rad(45.0f);
+	self->fov = internal_data->fov_3D;
 	internal_data->projection_3D = Math::mat_perspective(internal_data->fov_3D, 1280.0f / 720.0f, internal_data->near_clip_3D, internal_data->far_clip_3D);
 
 	internal_data->near_clip_2D = -100.0f;
@@ -240,7 +241,7 @@ bool8 render_view_pick_on_render(RenderView* self, FrameData* frame_data, uint32
 			Renderer::shader_set_uniform(pick_shader, internal_data->id_color_location, &id_color);
 			Renderer::shader_set_uniform(pick_shader, internal_data->model_location, &object_data->model);
 
-			Renderer::geometry_draw(render_data->geometry_data);
+			Renderer::geometry_draw(render_data->geometry_data, render_data->lod_index);
 		}
 
 		if (!renderpass_end(depth_pass))
@@ -293,7 +294,7 @@ bool8 render_view_pick_on_render(RenderView* self, FrameData* frame_data, uint32
 			Renderer::shader_set_uniform(pick_shader, internal_data->id_color_location, &id_color);
 			Renderer::shader_set_uniform(pick_shader, internal_data->model_location, &object_data->model);
 
-			Renderer::geometry_draw(render_data->geometry_data);
+			Renderer::geometry_draw(render_data->geometry_data, render_data->lod_index);
 		}
 
 		if (!renderpass_end(ui_pass))
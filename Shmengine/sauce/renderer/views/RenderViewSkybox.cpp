@@ -53,6 +53,7 @@ bool8 render_view_skybox_on_create(RenderView* self)
 	internal_data->near_clip = 0.1f;
 	internal_data->far_clip = 1000.0f;
 	internal_data->fov = Math::deg_to_rad(45.0f);
+	self->fov = internal_data->fov;
 
 	internal_data->projection_matrix = Math::mat_perspective(internal_data->fov, 1280.0f / 720.0f, internal_data->near_clip, internal_data->far_clip);
 
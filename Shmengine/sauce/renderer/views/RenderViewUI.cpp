@@ -1,6 +1,7 @@
 #include "RenderViewUI.hpp"
 
 #include <core/Event.hpp>
+#include <core/Memory.hpp>
 #include <core/Identifier.hpp>
 #include <core/FrameData.hpp>
 #include <utility/Math.hpp>
@@ -14,10 +15,32 @@
 
 #include <optick.h>
 
+// NOTE: One segment per frame that can be in flight, so the cpu never writes vertices the gpu might still read.
+static const uint32 ui_batch_frame_count = 3;
+static const uint32 ui_batch_max_quads_per_frame = 16384;
+static const uint32 ui_batch_max_vertices_per_frame = ui_batch_max_quads_per_frame * 4;
+static const uint32 ui_batch_max_indices_per_frame = ui_batch_max_quads_per_frame * 6;
+
+struct UIBatchRun
+{
+	ShaderId shader_id;
+	uint32 instance_index;
+	// NOTE: Set for geometries that could not be batched and get drawn from their own buffers.
+	uint32 geometry_index;
+
+	uint32 vertex_offset;
+	uint32 vertex_count;
+	uint32 index_offset;
+	uint32 index_count;
+};
+
 struct RenderViewUIInternalData {
 	ShaderId ui_shader_id;
 	UIShaderUniformLocations ui_shader_u_locations;
 
+	Renderer::RenderBuffer batch_vertex_buffer;
+	Renderer::RenderBuffer batch_index_buffer;
+
 	float32 near_clip;
 	float32 far_clip;
 	Math::Mat4 projection_matrix;
@@ -47,12 +70,34 @@ bool8 render_view_ui_on_create(RenderView* self)
 	internal_data->projection_matrix = Math::mat_orthographic(0.0f, 1280.0f, 720.0f, 0.0f, internal_data->near_clip, internal_data->far_clip);
 	internal_data->view_matrix = MAT4_IDENTITY;
 
+	uint64 batch_vertex_buffer_size = (uint64)ui_batch_max_vertices_per_frame * ui_batch_frame_count * sizeof(Renderer::Vertex2D);
+	if (!Renderer::renderbuffer_init("ui_batch_vertex_buffer", Renderer::RenderBufferType::VERTEX, batch_vertex_buffer_size, false, &internal_data->batch_vertex_buffer))
+	{
+		SHMERROR("Failed to create ui batch vertex buffer.");
+		return false;
+	}
+	Renderer::renderbuffer_bind(&internal_data->batch_vertex_buffer, 0);
+	Renderer::renderbuffer_map_memory(&internal_data->batch_vertex_buffer, 0, internal_data->batch_vertex_buffer.size);
+
+	uint64 batch_index_buffer_size = (uint64)ui_batch_max_indices_per_frame * ui_batch_frame_count * sizeof(uint32);
+	if (!Renderer::renderbuffer_init("ui_batch_index_buffer", Renderer::RenderBufferType::INDEX, batch_index_buffer_size, false, &internal_data->batch_index_buffer))
+	{
+		SHMERROR("Failed to create ui batch index buffer.");
+		return false;
+	}
+	Renderer::renderbuffer_bind(&internal_data->batch_index_buffer, 0);
+	Renderer::renderbuffer_map_memory(&internal_data->batch_index_buffer, 0, internal_data->batch_index_buffer.size);
+
 	return true;
 
 }
 
 void render_view_ui_on_destroy(RenderView* self)
 {
+	RenderViewUIInternalData* internal_data = (RenderViewUIInternalData*)self->internal_data.data;
+
+	Renderer::renderbuffer_destroy(&internal_data->batch_vertex_buffer);
+	Renderer::renderbuffer_destroy(&internal_data->batch_index_buffer);
 }
 
 void render_view_ui_on_resize(RenderView* self, uint32 width, uint32 height)
@@ -114,6 +159,25 @@ static bool8 set_locals_ui(RenderViewUIInternalData* internal_data, Math::Mat4*
 	return true;
 }
 
+static uint32 find_instance_index(RenderView* self, ShaderInstanceId shader_instance_id, uint32* cursor)
+{
+	if (!shader_instance_id.is_valid())
+		return Constants::max_u32;
+
+	// NOTE: Instances get pushed alongside their geometries, so the search usually hits right at the cursor.
+	for (uint32 i = 0; i < self->instances.count; i++)
+	{
+		uint32 instance_i = (*cursor + i) % self->instances.count;
+		if (self->instances[instance_i].shader_instance_id == shader_instance_id)
+		{
+			*cursor = instance_i + 1;
+			return instance_i;
+		}
+	}
+
+	return Constants::max_u32;
+}
+
 bool8 render_view_ui_on_render(RenderView* self, FrameData* frame_data, uint32 frame_number, uint64 render_target_index)
 {
 
@@ -124,12 +188,100 @@ bool8 render_view_ui_on_render(RenderView* self, FrameData* frame_data, uint32 f
 	if (!set_globals_ui(internal_data))
 		SHMERROR("Failed to apply globals to ui shader.");
 
-	for (uint32 instance_i = 0; instance_i < self->instances.count; instance_i++)
+	uint32 segment = frame_number % ui_batch_frame_count;
+	uint32 segment_vertex_base = segment * ui_batch_max_vertices_per_frame;
+	uint32 segment_index_base = segment * ui_batch_max_indices_per_frame;
+	Renderer::Vertex2D* batch_vertices = (Renderer::Vertex2D*)internal_data->batch_vertex_buffer.mapped_memory + segment_vertex_base;
+	uint32* batch_indices = (uint32*)internal_data->batch_index_buffer.mapped_memory + segment_index_base;
+	uint32 batch_vertex_count = 0;
+	uint32 batch_index_count = 0;
+
+	UIBatchRun* runs = (UIBatchRun*)frame_data->frame_allocator.allocate(sizeof(UIBatchRun) * (self->geometries.count + 1));
+	uint32 run_count = 0;
+	UIBatchRun* open_run = 0;
+	uint32 instance_cursor = 0;
+
+	// NOTE: Transform quads into the per-frame segment and merge consecutive geometries sharing shader, atlas and properties into one run.
+	for (uint32 geometry_i = 0; geometry_i < self->geometries.count; geometry_i++)
 	{
-		RenderViewInstanceData* instance_data = &self->instances[instance_i];
+		RenderViewGeometryData* render_data = &self->geometries[geometry_i];
+		GeometryData* geometry = render_data->geometry_data;
 
-		if (instance_data->shader_instance_id == Constants::max_u32)
+		uint32 instance_index = find_instance_index(self, render_data->shader_instance_id, &instance_cursor);
+		RenderViewInstanceData* instance_data = instance_index != Constants::max_u32 ? &self->instances[instance_index] : 0;
+
+		bool8 batchable =
+			render_data->shader_id == internal_data->ui_shader_id &&
+			instance_data && instance_data->texture_maps_count &&
+			geometry->vertex_size == sizeof(Renderer::Vertex2D) &&
+			geometry->index_count && !geometry->lod_count &&
+			batch_vertex_count + geometry->vertex_count <= ui_batch_max_vertices_per_frame &&
+			batch_index_count + geometry->index_count <= ui_batch_max_indices_per_frame;
+
+		if (!batchable)
+		{
+			UIBatchRun* run = &runs[run_count++];
+			*run = {};
+			run->shader_id = render_data->shader_id;
+			run->instance_index = instance_index;
+			run->geometry_index = geometry_i;
+			open_run = 0;
 			continue;
+		}
+
+		if (open_run)
+		{
+			RenderViewInstanceData* run_instance = &self->instances[open_run->instance_index];
+			if (run_instance->texture_maps[0] != instance_data->texture_maps[0] || run_instance->instance_properties != instance_data->instance_properties)
+				open_run = 0;
+		}
+
+		if (!open_run)
+		{
+			open_run = &runs[run_count++];
+			open_run->shader_id = render_data->shader_id;
+			open_run->instance_index = instance_index;
+			open_run->geometry_index = Constants::max_u32;
+			open_run->vertex_offset = batch_vertex_count;
+			open_run->vertex_count = 0;
+			open_run->index_offset = batch_index_count;
+			open_run->index_count = 0;
+		}
+
+		Math::Mat4 model = MAT4_IDENTITY;
+		if (render_data->object_index != Constants::max_u32)
+			model = self->objects[render_data->object_index].model;
+		const Renderer::Vertex2D* src_vertices = (const Renderer::Vertex2D*)geometry->vertices.data;
+		Renderer::Vertex2D* dst_vertices = &batch_vertices[batch_vertex_count];
+		for (uint32 vertex_i = 0; vertex_i < geometry->vertex_count; vertex_i++)
+		{
+			Math::Vec3f position = Math::vec_mul_mat(Math::Vec3f{ src_vertices[vertex_i].position.x, src_vertices[vertex_i].position.y, 0.0f }, model);
+			dst_vertices[vertex_i].position = { position.x, position.y };
+			dst_vertices[vertex_i].tex_coordinates = src_vertices[vertex_i].tex_coordinates;
+		}
+
+		uint32 index_rebase = open_run->vertex_count;
+		uint32* dst_indices = &batch_indices[batch_index_count];
+		for (uint32 index_i = 0; index_i < geometry->index_count; index_i++)
+			dst_indices[index_i] = geometry->indices[index_i] + index_rebase;
+
+		open_run->vertex_count += geometry->vertex_count;
+		open_run->index_count += geometry->index_count;
+		batch_vertex_count += geometry->vertex_count;
+		batch_index_count += geometry->index_count;
+	}
+
+	// NOTE: Only instances leading a run get bound, so apply just those and each one once.
+	bool8* instance_applied = (bool8*)frame_data->frame_allocator.allocate(sizeof(bool8) * (self->instances.count + 1));
+	Memory::zero_memory(instance_applied, sizeof(bool8) * (self->instances.count + 1));
+	for (uint32 run_i = 0; run_i < run_count; run_i++)
+	{
+		uint32 instance_i = runs[run_i].instance_index;
+		if (instance_i == Constants::max_u32 || instance_applied[instance_i])
+			continue;
+
+		RenderViewInstanceData* instance_data = &self->instances[instance_i];
+		instance_applied[instance_i] = true;
 
 		bool8 instance_set = true;
 		if (instance_data->shader_id == internal_data->ui_shader_id)
@@ -151,29 +303,48 @@ bool8 render_view_ui_on_render(RenderView* self, FrameData* frame_data, uint32 f
 
 	ShaderId shader_id = ShaderId::invalid_value;
 	Shader* shader = 0;
+	bool8 model_is_identity = false;
+	Math::Mat4 identity = MAT4_IDENTITY;
 
-	for (uint32 geometry_i = 0; geometry_i < self->geometries.count; geometry_i++)
+	for (uint32 run_i = 0; run_i < run_count; run_i++)
 	{
-		RenderViewGeometryData* render_data = &self->geometries[geometry_i];
+		UIBatchRun* run = &runs[run_i];
 
-		if (render_data->shader_id != shader_id)
+		if (run->shader_id != shader_id)
 		{
-			shader_id = render_data->shader_id;
+			shader_id = run->shader_id;
 			shader = ShaderSystem::get_shader(shader_id);
 			Renderer::shader_use(shader);
 			Renderer::shader_bind_globals(shader);
+			model_is_identity = false;
 		}
 
-		if (render_data->shader_instance_id.is_valid())
-			Renderer::shader_bind_instance(shader, render_data->shader_instance_id);
+		if (run->instance_index != Constants::max_u32)
+			Renderer::shader_bind_instance(shader, self->instances[run->instance_index].shader_instance_id);
 
-		if (render_data->object_index != Constants::max_u32)
+		if (run->geometry_index != Constants::max_u32)
+		{
+			RenderViewGeometryData* render_data = &self->geometries[run->geometry_index];
+			if (render_data->object_index != Constants::max_u32)
+			{
+				set_locals_ui(internal_data, &self->objects[render_data->object_index].model);
+				model_is_identity = false;
+			}
+
+			Renderer::geometry_draw(render_data->geometry_data, render_data->lod_index);
+			continue;
+		}
+
+		// NOTE: Batched vertices are already in screen space.
+		if (!model_is_identity)
 		{
-			Math::Mat4* model = &self->objects[render_data->object_index].model;
-			set_locals_ui(internal_data, model);
+			set_locals_ui(internal_data, &identity);
+			model_is_identity = true;
 		}
 
-		Renderer::geometry_draw(render_data->geometry_data);
+		// NOTE: Indices are relative to the run, so the vertex buffer gets bound at the run's first vertex.
+		Renderer::renderbuffer_draw(&internal_data->batch_vertex_buffer, (uint64)(segment_vertex_base + run->vertex_offset) * sizeof(Renderer::Vertex2D), run->vertex_count, true);
+		Renderer::renderbuffer_draw(&internal_data->batch_index_buffer, (uint64)(segment_index_base + run->index_offset) * sizeof(uint32), run->index_count, false);
 	}
 
 	if (!renderpass_end(renderpass))
@@ -142,6 +142,7 @@ bool8 render_view_world_on_create(RenderView* self)
 	internal_data->near_clip = 0.1f;
 	internal_data->far_clip = 4000.0f;
 	internal_data->fov = Math::deg_to_rad(45.0f);
+	self->fov = internal_data->fov;
 
 	internal_data->projection_matrix = Math::mat_perspective(internal_data->fov, 1280.0f / 720.0f, internal_data->near_clip, internal_data->far_clip);
 	internal_data->ambient_color = { 0.25f, 0.25f, 0.25f, 1.0f };
@@ -441,7 +442,7 @@ bool8 render_view_world_on_render(RenderView* self, FrameData* frame_data, uint3
 				set_locals_color3D(internal_data, model);
 		}
 
-		Renderer::geometry_draw(render_data->geometry_data);
+		Renderer::geometry_draw(render_data->geometry_data, render_data->lod_index);
 	}
 
 	if (!Renderer::renderpass_end(renderpass))
@@ -63,6 +63,12 @@ bool8 terrain_init(TerrainConfig* config, Terrain* out_terrain)
 			SHMERROR("Failed to load heightmap for terrain!");
 			return false;
 		}
+		else if (resource.format != TextureFormat::RGBA8)
+		{
+			SHMERROR("Failed to load heightmap for terrain: Heightmaps have to be cooked as uncompressed RGBA8!");
+			ResourceSystem::texture_loader_unload(&resource);
+			return false;
+		}
 
 		out_terrain->tile_count_x = resource.width - 1;
 		out_terrain->tile_count_z = resource.height - 1;
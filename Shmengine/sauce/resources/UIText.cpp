@@ -10,13 +10,19 @@
 #include "renderer/RendererTypes.hpp"
 #include "renderer/RendererFrontend.hpp"
 #include "containers/Sarray.hpp"
+#include "utility/Utility.hpp"
 
 #include "optick.h"
 
-static void regenerate_geometry(UIText* ui_text, const FontAtlas* atlas);
+static void regenerate_geometry(UIText* ui_text, FontAtlas* atlas, uint32* out_dirty_first, uint32* out_dirty_end);
+static void write_quad_indices(GeometryData* geometry, uint32 first_quad, uint32 end_quad);
+static void reserve_quads(UIText* ui_text, uint32 quad_count);
+static void load_geometry(UIText* ui_text);
+static int32 decode_utf8(const char* text, uint32 length, uint32* index);
 
 static const uint32 quad_vertex_count = 4;
 static const uint32 quad_index_count = 6;
+static const uint32 min_quad_capacity = 32;
 
 bool8 ui_text_init(UITextConfig* config, UIText* out_ui_text)
 {
@@ -37,18 +43,25 @@ bool8 ui_text_init(UITextConfig* config, UIText* out_ui_text)
 
     out_ui_text->shader_instance_id.invalidate();
 
-    uint32 text_length = out_ui_text->text.len();
-    if (text_length < 1)
-        text_length = 1;
+    uint32 quad_capacity = SHMAX(out_ui_text->text.len(), min_quad_capacity);
 
     GeometryConfig geometry_config = {};
     geometry_config.extents = {};
     geometry_config.center = {};
 
     geometry_config.vertex_size = sizeof(Renderer::Vertex2D);
-    geometry_config.vertex_count = quad_vertex_count * text_length;
-    geometry_config.index_count = text_length * 6;
+    geometry_config.vertex_count = quad_vertex_count * quad_capacity;
+    geometry_config.index_count = quad_index_count * quad_capacity;
     Renderer::geometry_init(&geometry_config, &out_ui_text->geometry);
+    out_ui_text->geometry.vertex_count = 0;
+    out_ui_text->geometry.index_count = 0;
+
+    out_ui_text->glyph_run.init(quad_capacity, 0, AllocationTag::Array);
+    write_quad_indices(&out_ui_text->geometry, 0, quad_capacity);
+    out_ui_text->quad_count = 0;
+    out_ui_text->quad_capacity = quad_capacity;
+    out_ui_text->loaded_quad_capacity = 0;
+    out_ui_text->layout_font_id.invalidate();
 
     out_ui_text->unique_id = identifier_acquire_new_id(out_ui_text);
     out_ui_text->is_dirty = true;
@@ -65,9 +78,6 @@ bool8 ui_text_init(UITextConfig* config, UIText* out_ui_text)
     if (!atlas)
         return false;
 
-    regenerate_geometry(out_ui_text, atlas);
-    Renderer::geometry_load(&out_ui_text->geometry);
-
     out_ui_text->state = ResourceState::Initialized;
 
     return true;
@@ -91,6 +101,7 @@ bool8 ui_text_destroy(UIText* ui_text)
 
 
     Renderer::geometry_destroy(&ui_text->geometry);
+    ui_text->glyph_run.free_data();
     ui_text->text.free_data();
 
     ui_text->state = ResourceState::Destroyed;
@@ -111,12 +122,18 @@ void ui_text_set_text(UIText* ui_text, const char* text, uint32 offset, uint32 l
     if (length == Constants::max_u32)
         length = c_length;
 
+    if (ui_text->text.len() == length && CString::nequal(ui_text->text.c_str(), &text[offset], length))
+        return;
+
     ui_text->text.copy_n(&text[offset], length);
     ui_text->is_dirty = true;
 }
 
 void ui_text_set_text(UIText* ui_text, const String* text, uint32 offset, uint32 length)
 {
+    if (ui_text->text.len() == length && CString::nequal(ui_text->text.c_str(), &((*text)[offset]), length))
+        return;
+
     ui_text->text.copy_n(&((*text)[offset]), length);
 	ui_text->is_dirty = true;
 }
@@ -136,100 +153,210 @@ bool8 ui_text_set_font(UIText* ui_text, const char* font_name, uint16 font_size)
 void ui_text_update(UIText* ui_text)
 {
     OPTICK_EVENT();
-    if (!ui_text->is_dirty || ui_text->state != ResourceState::Initialized)
+    if (ui_text->state != ResourceState::Initialized)
         return;
 
-    const FontAtlas* atlas = FontSystem::get_atlas(ui_text->font_id, ui_text->font_size);
+    FontAtlas* atlas = FontSystem::get_atlas(ui_text->font_id, ui_text->font_size);
     if (!atlas)
         return;
 
-    regenerate_geometry(ui_text, atlas);
-	Renderer::geometry_load(&ui_text->geometry);
+    // NOTE: Glyphs moving inside the glyph cache invalidate the texture coordinates of existing quads.
+    uint32 glyph_generation = FontSystem::get_glyph_generation(atlas);
+    if (!ui_text->is_dirty && ui_text->layout_glyph_generation == glyph_generation)
+        return;
+
+    uint32 text_length = ui_text->text.len();
+    uint64 text_hash = hash_fnv1a64(ui_text->text.c_str(), text_length);
+    bool8 font_changed = ui_text->layout_font_id.id != ui_text->font_id.id || ui_text->layout_font_size != ui_text->font_size || ui_text->layout_glyph_generation != glyph_generation;
+    if (!font_changed && ui_text->layout_text_length == text_length && ui_text->layout_text_hash == text_hash)
+    {
+        ui_text->is_dirty = false;
+        return;
+    }
+
+    // NOTE: Texture coordinates depend on the atlas, so a font change invalidates the whole glyph run.
+    if (font_changed)
+        ui_text->quad_count = 0;
+
+    uint32 dirty_first, dirty_end;
+    FontSystem::begin_glyph_layout();
+    regenerate_geometry(ui_text, atlas, &dirty_first, &dirty_end);
+    FontSystem::end_glyph_layout();
+    FontSystem::flush_glyph_cache();
+
+    ui_text->layout_glyph_generation = glyph_generation;
+    ui_text->layout_font_id = ui_text->font_id;
+    ui_text->layout_font_size = ui_text->font_size;
+    ui_text->layout_text_length = text_length;
+    ui_text->layout_text_hash = text_hash;
+
+    // NOTE: The ui view batches the cpu side quads itself. Only views drawing the geometry directly (e.g. picking) cause an upload.
+    if (ui_text->geometry.loaded)
+    {
+        if (ui_text->loaded_quad_capacity != ui_text->quad_capacity)
+            load_geometry(ui_text);
+        else if (dirty_first < dirty_end)
+            Renderer::geometry_load_vertex_range(&ui_text->geometry, dirty_first * quad_vertex_count, (dirty_end - dirty_first) * quad_vertex_count);
+    }
         
     ui_text->is_dirty = false;
 }
 
-static void regenerate_geometry(UIText* ui_text, const FontAtlas* atlas)
+static void write_quad_indices(GeometryData* geometry, uint32 first_quad, uint32 end_quad)
 {
-    OPTICK_EVENT();
+    for (uint32 quad_i = first_quad; quad_i < end_quad; quad_i++)
+    {
+        geometry->indices[(quad_i * 6) + 0] = (quad_i * 4) + 2;
+        geometry->indices[(quad_i * 6) + 1] = (quad_i * 4) + 1;
+        geometry->indices[(quad_i * 6) + 2] = (quad_i * 4) + 0;
+        geometry->indices[(quad_i * 6) + 3] = (quad_i * 4) + 3;
+        geometry->indices[(quad_i * 6) + 4] = (quad_i * 4) + 0;
+        geometry->indices[(quad_i * 6) + 5] = (quad_i * 4) + 1;
+    }
+}
+
+static void reserve_quads(UIText* ui_text, uint32 quad_count)
+{
+    if (quad_count <= ui_text->quad_capacity)
+        return;
+
+    // NOTE: Grow geometrically so typing does not reallocate on every new character.
+    uint32 new_capacity = SHMAX(ui_text->quad_capacity * 2, quad_count);
 
     GeometryData* geometry = &ui_text->geometry;
+    geometry->vertices.resize(new_capacity * quad_vertex_count * sizeof(Renderer::Vertex2D));
+    geometry->indices.resize(new_capacity * quad_index_count);
+    ui_text->glyph_run.resize(new_capacity);
+    write_quad_indices(geometry, ui_text->quad_capacity, new_capacity);
 
-    uint32 max_vertex_count = quad_vertex_count * ui_text->text.len();
-    uint32 max_index_count = quad_index_count * ui_text->text.len();
+    ui_text->quad_capacity = new_capacity;
+}
 
-    uint64 vertex_buffer_size = sizeof(Renderer::Vertex2D) * max_vertex_count;
-    if (vertex_buffer_size > geometry->vertices.capacity)
-    {
-        geometry->vertices.resize((uint32)vertex_buffer_size);
-        geometry->indices.resize(max_index_count);
-    }  
+static void load_geometry(UIText* ui_text)
+{
+    GeometryData* geometry = &ui_text->geometry;
+    uint32 vertex_count = geometry->vertex_count;
+    uint32 index_count = geometry->index_count;
+
+    // NOTE: Allocate gpu memory for the full capacity, so later edits within it only need range uploads.
+    geometry->vertex_count = ui_text->quad_capacity * quad_vertex_count;
+    geometry->index_count = ui_text->quad_capacity * quad_index_count;
+    Renderer::geometry_load(geometry);
+    geometry->vertex_count = vertex_count;
+    geometry->index_count = index_count;
+
+    ui_text->loaded_quad_capacity = ui_text->quad_capacity;
+}
+
+static void regenerate_geometry(UIText* ui_text, FontAtlas* atlas, uint32* out_dirty_first, uint32* out_dirty_end)
+{
+    OPTICK_EVENT();
+
+    GeometryData* geometry = &ui_text->geometry;
+    reserve_quads(ui_text, ui_text->text.len());
+
+    *out_dirty_first = Constants::max_u32;
+    *out_dirty_end = 0;
 
     float32 x = 0;
     float32 y = 0;
+    float32 scale = atlas->render_scale;
+    int32 previous_codepoint = -1;
     uint32 quad_count = 0;
     SarrayRef<Renderer::Vertex2D> vertices(&geometry->vertices);
-    for (uint32 c = 0; c < ui_text->text.len(); c++) 
+    uint32 text_length = ui_text->text.len();
+    for (uint32 c = 0; c < text_length;) 
     {
-        char codepoint = ui_text->text[c];
+        int32 codepoint = decode_utf8(ui_text->text.c_str(), text_length, &c);
 
         if (codepoint == '\n') 
         {
             x = 0;
             y += atlas->line_height;
+            previous_codepoint = -1;
             continue;
         }
         else if (codepoint == '\t') 
         {
-            x += atlas->glyphs[' '].x_advance * 4.0f;
+            const FontGlyph* space_glyph = FontSystem::get_glyph(atlas, ' ');
+            x += space_glyph ? space_glyph->x_advance * scale * 4.0f : 0.0f;
+            previous_codepoint = -1;
             continue;
         }
 
-        const FontGlyph* glyph = &atlas->glyphs[(uint8)codepoint];
+        if (previous_codepoint >= 0)
+            x += FontSystem::get_kerning(atlas, previous_codepoint, codepoint) * scale;
+        previous_codepoint = codepoint;
+
+        const FontGlyph* glyph = FontSystem::get_glyph(atlas, codepoint);
+        if (!glyph)
+            continue;
         if (!glyph->width)
         {
-            x += glyph->x_advance;
+            x += glyph->x_advance * scale;
             continue;
         }
 
-		float32 minx = x + glyph->x_offset;
-		float32 miny = y + glyph->y_offset;
-		float32 maxx = minx + glyph->width;
-		float32 maxy = miny + glyph->height;
-		float32 tminx = (float32)glyph->x / atlas->atlas_size_x;
-		float32 tmaxx = (float32)(glyph->x + glyph->width) / atlas->atlas_size_x;
-		float32 tminy = (float32)glyph->y / atlas->atlas_size_y;
-		float32 tmaxy = (float32)(glyph->y + glyph->height) / atlas->atlas_size_y;
-		// Flip the y axis for system text
-		if (atlas->type == FontType::Truetype)
-		{
-			tminy = 1.0f - tminy;
-			tmaxy = 1.0f - tmaxy;
-		}
-
-		Renderer::Vertex2D p0 = { {minx, miny}, {tminx, tminy} };
-		Renderer::Vertex2D p1 = { {maxx, miny}, {tmaxx, tminy} };
-		Renderer::Vertex2D p2 = { {maxx, maxy}, {tmaxx, tmaxy} };
-		Renderer::Vertex2D p3 = { {minx, maxy}, {tminx, tmaxy} };
-
-		vertices[(quad_count * 4) + 0] = p0;  // 0    3
-		vertices[(quad_count * 4) + 1] = p2;  //
-		vertices[(quad_count * 4) + 2] = p3;  //
-		vertices[(quad_count * 4) + 3] = p1;  // 2    1
-
-		int32 kerning = 0;
-		x += glyph->x_advance + kerning;
-
-        geometry->indices[(quad_count * 6) + 0] = (quad_count * 4) + 2;
-        geometry->indices[(quad_count * 6) + 1] = (quad_count * 4) + 1;
-        geometry->indices[(quad_count * 6) + 2] = (quad_count * 4) + 0;
-        geometry->indices[(quad_count * 6) + 3] = (quad_count * 4) + 3;
-        geometry->indices[(quad_count * 6) + 4] = (quad_count * 4) + 0;
-        geometry->indices[(quad_count * 6) + 5] = (quad_count * 4) + 1;
+        UITextGlyphQuad* cached_quad = &ui_text->glyph_run[quad_count];
+        if (quad_count >= ui_text->quad_count || cached_quad->codepoint != codepoint || cached_quad->x != x || cached_quad->y != y)
+        {
+            cached_quad->codepoint = codepoint;
+            cached_quad->x = x;
+            cached_quad->y = y;
+
+            float32 minx = x + glyph->x_offset * scale;
+            float32 miny = y + glyph->y_offset * scale;
+            float32 maxx = minx + glyph->width * scale;
+            float32 maxy = miny + glyph->height * scale;
+            float32 tminx = (float32)glyph->x / atlas->atlas_size_x;
+            float32 tmaxx = (float32)(glyph->x + glyph->width) / atlas->atlas_size_x;
+            float32 tminy = (float32)glyph->y / atlas->atlas_size_y;
+            float32 tmaxy = (float32)(glyph->y + glyph->height) / atlas->atlas_size_y;
+            // Flip the y axis for system text
+            if (atlas->type != FontType::Bitmap)
+            {
+                tminy = 1.0f - tminy;
+                tmaxy = 1.0f - tmaxy;
+            }
+
+            Renderer::Vertex2D p0 = { {minx, miny}, {tminx, tminy} };
+            Renderer::Vertex2D p1 = { {maxx, miny}, {tmaxx, tminy} };
+            Renderer::Vertex2D p2 = { {maxx, maxy}, {tmaxx, tmaxy} };
+            Renderer::Vertex2D p3 = { {minx, maxy}, {tminx, tmaxy} };
+
+            vertices[(quad_count * 4) + 0] = p0;  // 0    3
+            vertices[(quad_count * 4) + 1] = p2;  //
+            vertices[(quad_count * 4) + 2] = p3;  //
+            vertices[(quad_count * 4) + 3] = p1;  // 2    1
+
+            *out_dirty_first = SHMIN(*out_dirty_first, quad_count);
+            *out_dirty_end = quad_count + 1;
+        }
 
+        x += glyph->x_advance * scale;
         quad_count++;
     }
 
+    ui_text->quad_count = quad_count;
     geometry->vertex_count = quad_vertex_count * quad_count;
     geometry->index_count = quad_index_count * quad_count;
 }
+
+static int32 decode_utf8(const char* text, uint32 length, uint32* index)
+{
+    uint8 lead = (uint8)text[*index];
+    uint32 sequence_length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (!sequence_length || *index + sequence_length > length)
+    {
+        // NOTE: Invalid sequences fall back to reading single bytes.
+        (*index)++;
+        return lead;
+    }
+
+    int32 codepoint = sequence_length == 1 ? lead : lead & (0x7F >> sequence_length);
+    for (uint32 i = 1; i < sequence_length; i++)
+        codepoint = (codepoint << 6) | ((uint8)text[*index + i] & 0x3F);
+
+    *index += sequence_length;
+    return codepoint;
+}
@@ -20,6 +20,13 @@ struct UITextConfig
 	uint16 font_size;
 };
 
+struct UITextGlyphQuad
+{
+	int32 codepoint;
+	float32 x;
+	float32 y;
+};
+
 struct UIText
 {
 	ResourceState state;
@@ -30,7 +37,21 @@ struct UIText
 	ShaderInstanceId shader_instance_id;
 	String text;
 	Math::Transform transform;
+	// NOTE: Quads in local space, uploaded lazily only when drawn outside the batched ui view.
 	GeometryData geometry;
+
+	// NOTE: Key of the current layout. Updates with an unchanged key skip the relayout entirely.
+	FontId layout_font_id;
+	uint16 layout_font_size;
+	uint32 layout_text_length;
+	uint64 layout_text_hash;
+	uint32 layout_glyph_generation;
+
+	// NOTE: Glyph run of the current layout, diffed against on relayout so only changed quads get rewritten.
+	Sarray<UITextGlyphQuad> glyph_run;
+	uint32 quad_count;
+	uint32 quad_capacity;
+	uint32 loaded_quad_capacity;
 };
 
 SHMAPI bool8 ui_text_init(UITextConfig* config, UIText* out_text);
@@ -6,7 +6,9 @@
 #include "utility/String.hpp"
 #include "platform/FileSystem.hpp"
 #include "systems/FontSystem.hpp"
+#include "systems/CookSystem.hpp"
 #include "utility/Sort.hpp"
+#include "utility/Utility.hpp"
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "vendor/stb/stb_truetype.h"
@@ -42,17 +44,46 @@ struct ShmbmfFileHeader
     uint16 font_size;
 };
 
+struct ShmsdfFileHeader
+{
+    uint16 version;
+    uint16 font_size;
+    uint16 line_height;
+    int16 baseline;
+    uint16 atlas_size_x;
+    uint16 atlas_size_y;
+    uint32 glyphs_count;
+    uint32 glyphs_offset;
+    uint32 kernings_count;
+    uint32 kernings_offset;
+    uint32 pixels_offset;
+};
+
+static const uint16 shmbmf_file_version = 1;
+static const uint16 shmsdf_file_version = 1;
+
 namespace ResourceSystem
 {
 
     static const char* loader_type_path = "fonts/";
 
+    // NOTE: Glyphs get rasterized once at this size, the distance falloff keeps edges sharp when scaling up or down.
+    static const uint16 distance_field_base_size = 48;
+    static const int32 distance_field_spread = 6;
+    static const int32 distance_field_first_codepoint = 32;
+    static const int32 distance_field_last_codepoint = 255;
+    static const uint16 distance_field_atlas_width = 512;
+
     static bool8 import_fnt_file(FileSystem::FileHandle* fnt_file, const char* resource_name, const char* shmbmf_filepath, FontResourceData* out_data);
     static bool8 write_shmbmf_file(const char* shmbmf_filepath, const char* name, const FontResourceData* out_data);
     static bool8 load_shmbmf_file(FileSystem::FileHandle* shmbmf_file, const char* shmbmf_filepath, FontResourceData* out_data);
 
     static bool8 import_ttf_file(FileSystem::FileHandle* ttf_file, const char* resource_name, const char* shmttf_filepath, Buffer* out_binary_buffer);
-    static bool8 parse_ttf_binary_data(const char* name, uint16 font_size, const Buffer* binary_buffer, FontResourceData* out_data);
+    static bool8 parse_ttf_binary_data(const char* name, uint16 font_size, Buffer* binary_buffer, FontResourceData* out_data);
+
+    static bool8 generate_distance_field(const char* name, Buffer* binary_buffer, FontResourceData* out_data);
+    static bool8 write_shmsdf_file(const char* shmsdf_filepath, const FontResourceData* data);
+    static bool8 load_shmsdf_file(FileSystem::FileHandle* shmsdf_file, const char* shmsdf_filepath, FontResourceData* out_data);
 
     bool8 font_loader_load(const char* name, uint16 font_size, FontResourceData* out_resource)
     {
@@ -71,7 +102,14 @@ namespace ResourceSystem
 
         String full_filepath(Constants::max_filepath_length);
         FontFileType file_type = FontFileType::NOT_FOUND;
-        for (uint32 i = 0; i < supported_file_type_count; i++)
+
+        // NOTE: Outputs listed in the cook manifest are known to be current, so the source formats do not need to be probed.
+        full_filepath = full_filepath_wo_extension;
+        full_filepath.append(".shmbmf");
+        if (CookSystem::is_cooked(full_filepath.c_str()))
+            file_type = FontFileType::SHMBMF;
+
+        for (uint32 i = 0; i < supported_file_type_count && file_type == FontFileType::NOT_FOUND; i++)
         {
             full_filepath = full_filepath_wo_extension;
             full_filepath.append(supported_file_types[i].extension);
@@ -138,12 +176,136 @@ namespace ResourceSystem
         return false;
     }
 
+    bool8 font_loader_load_distance_field(const char* name, FontResourceData* out_resource)
+    {
+        Buffer binary_buffer = {};
+        String full_filepath_wo_extension(Constants::max_filepath_length);
+        full_filepath_wo_extension.safe_print_s
+            ("%s%s%s", Engine::get_assets_base_path(), loader_type_path, name);
+
+        String shmsdf_filepath(Constants::max_filepath_length);
+        shmsdf_filepath = full_filepath_wo_extension;
+        shmsdf_filepath.append(".shmsdf");
+
+        String ttf_filepath(Constants::max_filepath_length);
+        ttf_filepath = full_filepath_wo_extension;
+        ttf_filepath.append(".ttf");
+
+        bool8 is_cached = CookSystem::is_cooked(shmsdf_filepath.c_str()) || FileSystem::file_exists(shmsdf_filepath.c_str());
+        const char* filepath = is_cached ? shmsdf_filepath.c_str() : ttf_filepath.c_str();
+        if (!is_cached && !FileSystem::file_exists(filepath))
+        {
+            SHMERRORV("Font resource loader failed to find distance field font '%s' as .shmsdf or .ttf file.", full_filepath_wo_extension.c_str());
+            return false;
+        }
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(filepath, FileMode::FILE_MODE_READ, &f))
+        {
+            SHMERRORV("font_loader_load_distance_field - Failed to open file '%s'", filepath);
+            return false;
+        }
+
+        if (is_cached && !load_shmsdf_file(&f, filepath, out_resource))
+        {
+            // NOTE: Outdated or broken cache files get regenerated from the ttf source when it is around.
+            FileSystem::file_close(&f);
+            font_loader_unload(out_resource);
+            filepath = ttf_filepath.c_str();
+            if (!FileSystem::file_exists(filepath) || !FileSystem::file_open(filepath, FileMode::FILE_MODE_READ, &f))
+            {
+                SHMERRORV("font_loader_load_distance_field - Failed to load distance field font '%s'.", full_filepath_wo_extension.c_str());
+                return false;
+            }
+            is_cached = false;
+        }
+
+        if (!is_cached)
+        {
+            goto_if(!import_ttf_file(&f, name, filepath, &binary_buffer), fail);
+            goto_if_log(!generate_distance_field(name, &binary_buffer, out_resource), fail, "Failed to generate distance field for ttf file '%s'!", filepath);
+            // NOTE: Failing to write the cache only costs the generation on the next load.
+            write_shmsdf_file(shmsdf_filepath.c_str(), out_resource);
+        }
+
+        FileSystem::file_close(&f);
+        binary_buffer.free_data();
+        return true;
+
+    fail:
+        FileSystem::file_close(&f);
+        binary_buffer.free_data();
+        font_loader_unload(out_resource);
+        return false;
+    }
+
+    bool8 font_loader_cook(const char* name, FontType type)
+    {
+        if (type != FontType::Bitmap && type != FontType::DistanceField)
+        {
+            SHMERRORV("font_loader_cook - Font '%s' can only be cooked as bitmap or distance field font.", name);
+            return false;
+        }
+
+        FontResourceData resource = {};
+        Buffer binary_buffer = {};
+        String full_filepath_wo_extension(Constants::max_filepath_length);
+        full_filepath_wo_extension.safe_print_s
+            ("%s%s%s", Engine::get_assets_base_path(), loader_type_path, name);
+
+        String source_filepath(Constants::max_filepath_length);
+        source_filepath = full_filepath_wo_extension;
+        source_filepath.append(type == FontType::Bitmap ? ".fnt" : ".ttf");
+
+        String cooked_filepath(Constants::max_filepath_length);
+        cooked_filepath = full_filepath_wo_extension;
+        cooked_filepath.append(type == FontType::Bitmap ? ".shmbmf" : ".shmsdf");
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(source_filepath.c_str(), FileMode::FILE_MODE_READ, &f))
+        {
+            SHMERRORV("font_loader_cook - Failed to open file '%s'", source_filepath.c_str());
+            return false;
+        }
+
+        bool8 res = false;
+        if (type == FontType::Bitmap)
+        {
+            res = import_fnt_file(&f, name, cooked_filepath.c_str(), &resource);
+        }
+        else
+        {
+            res = import_ttf_file(&f, name, source_filepath.c_str(), &binary_buffer) &&
+                generate_distance_field(name, &binary_buffer, &resource) &&
+                write_shmsdf_file(cooked_filepath.c_str(), &resource);
+        }
+
+        FileSystem::file_close(&f);
+        binary_buffer.free_data();
+        font_loader_unload(&resource);
+        return res;
+    }
+
+    uint64 font_loader_get_cook_settings_hash(FontType type)
+    {
+        if (type == FontType::Bitmap)
+            return hash_fnv1a64(&shmbmf_file_version, sizeof(shmbmf_file_version));
+
+        uint64 hash = hash_fnv1a64(&shmsdf_file_version, sizeof(shmsdf_file_version));
+        hash = hash_fnv1a64(&distance_field_base_size, sizeof(distance_field_base_size), hash);
+        hash = hash_fnv1a64(&distance_field_spread, sizeof(distance_field_spread), hash);
+        hash = hash_fnv1a64(&distance_field_first_codepoint, sizeof(distance_field_first_codepoint), hash);
+        hash = hash_fnv1a64(&distance_field_last_codepoint, sizeof(distance_field_last_codepoint), hash);
+        return hash_fnv1a64(&distance_field_atlas_width, sizeof(distance_field_atlas_width), hash);
+    }
+
     void font_loader_unload(FontResourceData* resource)
     {
         resource->glyphs.free_data();
         resource->kernings.free_data();
         resource->texture_name.free_data();
-        resource->texture_buffer.free_data();
+        resource->font_binary.free_data();
+        resource->distance_field.free_data();
     }
 
     FontConfig font_loader_get_config_from_resource(FontResourceData* resource)
@@ -161,8 +323,9 @@ namespace ResourceSystem
             .glyphs = resource->glyphs.data,
             .kernings = resource->kernings.data,
             .texture_name = resource->font_type == FontType::Bitmap ? resource->texture_name.c_str() : 0,
-            .texture_buffer_size = resource->font_type == FontType::Truetype ? resource->texture_buffer.capacity * sizeof(resource->texture_buffer[0]) : 0 ,
-            .texture_buffer = resource->font_type == FontType::Truetype ? resource->texture_buffer.data : 0
+            .font_binary_size = resource->font_type == FontType::Truetype ? (uint32)resource->font_binary.size : 0,
+            .font_binary = resource->font_type == FontType::Truetype ? (const uint8*)resource->font_binary.data : 0,
+            .distance_field = resource->font_type == FontType::DistanceField ? resource->distance_field.data : 0
         };
 
         return config;
@@ -344,7 +507,7 @@ namespace ResourceSystem
         uint32 written = 0;
 
         ShmbmfFileHeader file_header = {};
-        file_header.version = 1;
+        file_header.version = shmbmf_file_version;
         file_header.texture_name_length = (uint16)out_data->texture_name.len();
         file_header.glyphs_count = out_data->glyphs.capacity;
         file_header.kernings_count = out_data->kernings.capacity;
@@ -448,7 +611,7 @@ namespace ResourceSystem
         return true;
     }
 
-    static bool8 parse_ttf_binary_data(const char* name, uint16 font_size, const Buffer* binary_buffer, FontResourceData* out_data)
+    static bool8 parse_ttf_binary_data(const char* name, uint16 font_size, Buffer* binary_buffer, FontResourceData* out_data)
     {
         stbtt_fontinfo info;
         if (!stbtt_InitFont(&info, (unsigned char*)binary_buffer->data, 0))
@@ -457,100 +620,233 @@ namespace ResourceSystem
             return false;
         }
 
-        Sarray<int32> codepoints = {};
-        codepoints.init(256, 0, AllocationTag::Font);
-        for (int32 i = 0; i < (int32)codepoints.capacity; i++)
-            codepoints[i] = i;
-
         out_data->font_type = FontType::Truetype;
         out_data->font_size = font_size;
-        uint16 atlas_size = SHMAX(1024, out_data->font_size * 16);
-        out_data->atlas_size_x = atlas_size;
-        out_data->atlas_size_y = atlas_size;
 
-        float32 scale = stbtt_ScaleForPixelHeight(&info, (float32)font_size);
+        // NOTE: Metrics, glyphs and kerning depend on the requested size and get resolved by the font system.
+        out_data->font_binary.steal(*binary_buffer);
+
+		return true;
+    }
+
+    static bool8 generate_distance_field(const char* name, Buffer* binary_buffer, FontResourceData* out_data)
+    {
+        stbtt_fontinfo info;
+        if (!stbtt_InitFont(&info, (unsigned char*)binary_buffer->data, 0))
+        {
+            SHMERRORV("Failed to parse truetype font '%s'", name);
+            return false;
+        }
+
+        SHMDEBUGV("Generating distance field atlas for font '%s'...", name);
+
+        float32 scale = stbtt_ScaleForPixelHeight(&info, (float32)distance_field_base_size);
         int32 ascent, descent, line_gap;
         stbtt_GetFontVMetrics(&info, &ascent, &descent, &line_gap);
+
+        out_data->font_type = FontType::DistanceField;
+        out_data->font_size = distance_field_base_size;
         out_data->line_height = (uint16)((ascent - descent + line_gap) * scale);
+        out_data->baseline = (int16)(ascent * scale);
+        out_data->atlas_size_x = distance_field_atlas_width;
 
-        uint32 pack_image_size = out_data->atlas_size_x * out_data->atlas_size_y * sizeof(uint8);
-        Sarray<uint8> pixels(pack_image_size, 0);
-        Sarray<stbtt_packedchar> packed_chars(codepoints.capacity, 0);
+        // NOTE: Distances get stored with the glyph edge at 128, falling off to 0 and 255 over the spread in pixels.
+        const uint8 on_edge_value = 128;
+        const float32 pixel_distance_scale = (float32)on_edge_value / distance_field_spread;
 
-        stbtt_pack_context context;
-        if (!stbtt_PackBegin(&context, pixels.data, out_data->atlas_size_x, out_data->atlas_size_y, 0, 1, 0))
+        uint32 glyph_count = distance_field_last_codepoint - distance_field_first_codepoint + 1;
+        out_data->glyphs.init(glyph_count, 0, AllocationTag::Font);
+        Sarray<uint8*> glyph_bitmaps(glyph_count, 0, AllocationTag::Font);
+
+        uint16 cursor_x = 0;
+        uint16 cursor_y = 0;
+        uint16 row_height = 0;
+        for (uint32 i = 0; i < glyph_count; i++)
         {
-            SHMERROR("stbtt_PackBegin failed");
+            FontGlyph* glyph = &out_data->glyphs[i];
+            glyph->codepoint = distance_field_first_codepoint + (int32)i;
+            glyph->kernings_offset = Constants::max_u32;
+            if (!stbtt_FindGlyphIndex(&info, glyph->codepoint))
+                continue;
+
+            int32 advance, left_side_bearing;
+            stbtt_GetCodepointHMetrics(&info, glyph->codepoint, &advance, &left_side_bearing);
+            glyph->x_advance = (int16)(advance * scale + 0.5f);
+
+            int32 width, height, x_offset, y_offset;
+            glyph_bitmaps[i] = stbtt_GetCodepointSDF(&info, scale, glyph->codepoint, distance_field_spread, on_edge_value, pixel_distance_scale, &width, &height, &x_offset, &y_offset);
+            if (!glyph_bitmaps[i])
+                continue;
+
+            if (cursor_x + width > distance_field_atlas_width)
+            {
+                cursor_x = 0;
+                cursor_y += row_height + 1;
+                row_height = 0;
+            }
+
+            glyph->x = cursor_x;
+            glyph->y = cursor_y;
+            glyph->width = (uint16)width;
+            glyph->height = (uint16)height;
+            glyph->x_offset = (int16)x_offset;
+            glyph->y_offset = (int16)y_offset;
+
+            cursor_x += (uint16)width + 1;
+            row_height = SHMAX(row_height, (uint16)height);
+        }
+
+        uint16 atlas_height = 64;
+        while (atlas_height < cursor_y + row_height)
+            atlas_height *= 2;
+        out_data->atlas_size_y = atlas_height;
+
+        // NOTE: Zeroed pixels read as far outside of any glyph.
+        out_data->distance_field.init(distance_field_atlas_width * atlas_height, 0, AllocationTag::Font);
+        for (uint32 i = 0; i < glyph_count; i++)
+        {
+            if (!glyph_bitmaps[i])
+                continue;
+
+            const FontGlyph* glyph = &out_data->glyphs[i];
+            for (uint32 row = 0; row < glyph->height; row++)
+                out_data->distance_field.copy_memory(&glyph_bitmaps[i][row * glyph->width], glyph->width, (glyph->y + row) * distance_field_atlas_width + glyph->x);
+
+            stbtt_FreeSDF(glyph_bitmaps[i], 0);
+        }
+        glyph_bitmaps.free_data();
+
+        // NOTE: Kerning pairs get resolved once here, so the font system does not need the font file at runtime.
+        Darray<FontKerning> kernings(256, 0, AllocationTag::Font);
+        for (uint32 i = 0; i < glyph_count; i++)
+        {
+            if (!out_data->glyphs[i].x_advance)
+                continue;
+
+            for (uint32 j = 0; j < glyph_count; j++)
+            {
+                if (!out_data->glyphs[j].x_advance)
+                    continue;
+
+                int32 kern_advance = stbtt_GetCodepointKernAdvance(&info, out_data->glyphs[i].codepoint, out_data->glyphs[j].codepoint);
+                if (!kern_advance)
+                    continue;
+
+                float32 advance = kern_advance * scale;
+                FontKerning kerning = { out_data->glyphs[i].codepoint, out_data->glyphs[j].codepoint, (int16)(advance < 0.0f ? advance - 0.5f : advance + 0.5f) };
+                if (kerning.advance)
+                    kernings.push(kerning);
+            }
+        }
+
+        if (kernings.count)
+        {
+            out_data->kernings.init(kernings.count, 0, AllocationTag::Font);
+            out_data->kernings.copy_memory(kernings.data, kernings.count, 0);
+        }
+        kernings.free_data();
+
+        return true;
+    }
+
+    static bool8 write_shmsdf_file(const char* shmsdf_filepath, const FontResourceData* data)
+    {
+
+        FileSystem::FileHandle f;
+
+        if (!FileSystem::file_open(shmsdf_filepath, FILE_MODE_WRITE, &f)) {
+            SHMERRORV("Error opening distance field font file for writing: '%s'", shmsdf_filepath);
             return false;
         }
+        SHMDEBUGV("Writing .shmsdf file '%s'...", shmsdf_filepath);
+
+        uint32 written = 0;
+
+        ShmsdfFileHeader file_header = {};
+        file_header.version = shmsdf_file_version;
+        file_header.font_size = data->font_size;
+        file_header.line_height = data->line_height;
+        file_header.baseline = data->baseline;
+        file_header.atlas_size_x = data->atlas_size_x;
+        file_header.atlas_size_y = data->atlas_size_y;
+        file_header.glyphs_count = data->glyphs.capacity;
+        file_header.kernings_count = data->kernings.capacity;
+
+        file_header.glyphs_offset = sizeof(ShmsdfFileHeader);
+        file_header.kernings_offset = file_header.glyphs_offset + (file_header.glyphs_count * sizeof(FontGlyph));
+        file_header.pixels_offset = file_header.kernings_offset + (file_header.kernings_count * sizeof(FontKerning));
+
+        FileSystem::write(&f, sizeof(file_header), &file_header, &written);
+        FileSystem::write(&f, file_header.glyphs_count * sizeof(FontGlyph), data->glyphs.data, &written);
+        FileSystem::write(&f, file_header.kernings_count * sizeof(FontKerning), data->kernings.data, &written);
+        FileSystem::write(&f, data->distance_field.capacity, data->distance_field.data, &written);
+
+        FileSystem::file_close(&f);
 
-        stbtt_pack_range range;
-        range.first_unicode_codepoint_in_range = 0;
-        range.font_size = (float32)out_data->font_size;
-        range.num_chars = codepoints.capacity;
-        range.chardata_for_range = packed_chars.data;
-        range.array_of_unicode_codepoints = codepoints.data;
-        if (!stbtt_PackFontRanges(&context, (unsigned char*)binary_buffer->data, 0, &range, 1))
+        return true;
+
+    }
+
+    static bool8 load_shmsdf_file(FileSystem::FileHandle* shmsdf_file, const char* shmsdf_filepath, FontResourceData* out_data)
+    {
+
+        uint32 file_size = FileSystem::get_file_size32(shmsdf_file);
+        Buffer file_content(file_size, 0);
+        uint32 bytes_read = 0;
+        if (!FileSystem::read_all_bytes(shmsdf_file, file_content.data, (uint32)file_content.size, &bytes_read))
         {
-            SHMERROR("stbtt_PackFontRanges failed");
+            SHMERRORV("load_shmsdf_file - failed to read from file: '%s'.", shmsdf_filepath);
             return false;
         }
-        stbtt_PackEnd(&context);
 
-        out_data->texture_buffer.init(pack_image_size, 0, AllocationTag::Resource);
-        for (uint32 i = 0; i < pack_image_size; i++)
-            out_data->texture_buffer[i] = ((uint32)pixels[i] << 24) + ((uint32)pixels[i] << 16) + ((uint32)pixels[i] << 8) + (uint32)pixels[i];
-        pixels.free_data();
+        SHMTRACEV("Importing shmsdf file: '%s'.", shmsdf_filepath);
 
-        out_data->glyphs.free_data();
-        out_data->glyphs.init(codepoints.capacity, 0, AllocationTag::Font);
-        for (uint32 i = 0; i < out_data->glyphs.capacity; i++)
+        uint8* read_ptr = (uint8*)file_content.data;
+        if (file_content.size < sizeof(ShmsdfFileHeader))
         {
-            stbtt_packedchar* pc = &packed_chars[i];
-            FontGlyph* g = &out_data->glyphs[i];
-            g->codepoint = codepoints[i];
-            g->x_offset = (int16)pc->xoff;
-            g->y_offset = (int16)pc->yoff;
-            g->width = pc->x1 - pc->x0;
-            g->height = pc->y1 - pc->y0;
-            g->x = pc->x0;  // xmin;
-            g->y = pc->y0; // Flipping y coordinates
-            g->x_advance = (int16)pc->xadvance;
+            SHMERRORV("load_shmsdf_file - file '%s' is too small to contain a header.", shmsdf_filepath);
+            return false;
         }
-        packed_chars.free_data();
 
-        uint32 kerning_count = stbtt_GetKerningTableLength(&info);
-        if (kerning_count)
+        ShmsdfFileHeader* file_header = (ShmsdfFileHeader*)read_ptr;
+        if (file_header->version != shmsdf_file_version)
         {
-            SHMERROR("Truetype fonts with kerning are not implemented properly yet!"); 
+            SHMWARNV("load_shmsdf_file - file '%s' has version %hu, expected %hu.", shmsdf_filepath, file_header->version, shmsdf_file_version);
             return false;
         }
 
-        /*
-		if (kerning_count)
-		{
-			out_data->kernings.init(kerning_count, 0, AllocationTag::Font);
+        uint64 pixels_size = (uint64)file_header->atlas_size_x * file_header->atlas_size_y;
+        if (file_header->glyphs_offset + (uint64)file_header->glyphs_count * sizeof(FontGlyph) > file_content.size ||
+            file_header->kernings_offset + (uint64)file_header->kernings_count * sizeof(FontKerning) > file_content.size ||
+            file_header->pixels_offset + pixels_size > file_content.size)
+        {
+            SHMERRORV("load_shmsdf_file - file '%s' is truncated or corrupted.", shmsdf_filepath);
+            return false;
+        }
 
-			Sarray<stbtt_kerningentry> kerning_entries(kerning_count, 0);
-			int32 res = stbtt_GetKerningTable(&info, kerning_entries.data, (int32)kerning_entries.capacity);
-			if (res != (int32)kerning_entries.capacity)
-			{
-				SHMERROR("stbtt_GetKerningTable failed");
-				return false;
-			}
+        out_data->font_type = FontType::DistanceField;
+        out_data->font_size = file_header->font_size;
+        out_data->line_height = file_header->line_height;
+        out_data->baseline = file_header->baseline;
+        out_data->atlas_size_x = file_header->atlas_size_x;
+        out_data->atlas_size_y = file_header->atlas_size_y;
 
-			for (uint32 i = 0; i < kerning_count; i++)
-			{
-				FontKerning* k = &out_data->kernings[i];
-				k->codepoint_0 = kerning_entries[i].glyph1;
-				k->codepoint_1 = kerning_entries[i].glyph2;
-				k->advance = (int16)kerning_entries[i].advance;
-			}
+        if (file_header->glyphs_count)
+        {
+            out_data->glyphs.init(file_header->glyphs_count, 0, AllocationTag::Font);
+            out_data->glyphs.copy_memory(&read_ptr[file_header->glyphs_offset], file_header->glyphs_count, 0);
+        }
+
+        if (file_header->kernings_count)
+        {
+            out_data->kernings.init(file_header->kernings_count, 0, AllocationTag::Font);
+            out_data->kernings.copy_memory(&read_ptr[file_header->kernings_offset], file_header->kernings_count, 0);
+        }
 
-			kerning_entries.free_data();
-		}
-        */
+        out_data->distance_field.init((uint32)pixels_size, 0, AllocationTag::Font);
+        out_data->distance_field.copy_memory(&read_ptr[file_header->pixels_offset], (uint32)pixels_size, 0);
+
+        return true;
 
-		return true;
     }
-}
+}
\ No newline at end of file
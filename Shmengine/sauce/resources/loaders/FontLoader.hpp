@@ -2,6 +2,7 @@
 
 #include "Defines.hpp"
 #include "containers/Sarray.hpp"
+#include "containers/Buffer.hpp"
 #include "utility/String.hpp"
 #include "systems/FontSystem.hpp"
 
@@ -16,14 +17,24 @@ struct FontResourceData
 	Sarray<FontGlyph> glyphs;
 	Sarray<FontKerning> kernings;
 	String texture_name;
-	Sarray<uint32> texture_buffer;
+	// NOTE: Truetype fonts keep the whole font file, glyphs get rasterized on demand by the font system.
+	Buffer font_binary;
+	// NOTE: Distance field fonts keep a single channel atlas, generated once from the truetype file at a fixed base size.
+	Sarray<uint8> distance_field;
 };
 
 namespace ResourceSystem
 {
 	//ResourceLoader bitmap_font_resource_loader_create();
 	bool8 font_loader_load(const char* name, uint16 font_size, FontResourceData* out_resource);
+	// NOTE: Loads the cached .shmsdf file, or generates it from the .ttf file of the same name.
+	bool8 font_loader_load_distance_field(const char* name, FontResourceData* out_resource);
 	void font_loader_unload(FontResourceData* resource);
 
+	// NOTE: Writes the .shmbmf file of a .fnt font or the .shmsdf file of a .ttf font, without keeping the data around.
+	bool8 font_loader_cook(const char* name, FontType type);
+	// NOTE: Changes whenever the cook would write a different file from the same source.
+	uint64 font_loader_get_cook_settings_hash(FontType type);
+
 	FontConfig font_loader_get_config_from_resource(FontResourceData* resource);
 }
\ No newline at end of file
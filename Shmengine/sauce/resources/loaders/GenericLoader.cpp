@@ -6,6 +6,7 @@
 #include "containers/Buffer.hpp"
 #include "utility/CString.hpp"
 #include "platform/FileSystem.hpp"
+#include "utility/Utility.hpp"
 
 namespace ResourceSystem
 {
@@ -49,4 +50,25 @@ namespace ResourceSystem
         buffer->free_data();
     }
 
+    bool8 generic_loader_get_source_hash(const char* full_filepath, uint64* out_hash)
+    {
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
+            return false;
+
+        uint32 file_size = FileSystem::get_file_size32(&f);
+        Buffer content(file_size ? file_size : 1, 0, AllocationTag::Resource);
+        uint32 bytes_read = 0;
+        bool8 read = FileSystem::read_all_bytes(&f, content.data, file_size, &bytes_read) && bytes_read == file_size;
+        FileSystem::file_close(&f);
+
+        if (read)
+            *out_hash = hash_fnv1a64(content.data, file_size);
+
+        content.free_data();
+        return read;
+
+    }
+
 }
\ No newline at end of file
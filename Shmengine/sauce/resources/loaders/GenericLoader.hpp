@@ -8,4 +8,7 @@ namespace ResourceSystem
 {
 	SHMAPI bool8 generic_loader_load(const char* name, Buffer* out_buffer);
 	SHMAPI void generic_loader_unload(Buffer* buffer);
+
+	// NOTE: Hashes the content of a source file, binary files built from it store the hash to notice edits made afterwards. False if the file can not be read.
+	SHMAPI bool8 generic_loader_get_source_hash(const char* full_filepath, uint64* out_hash);
 }
\ No newline at end of file
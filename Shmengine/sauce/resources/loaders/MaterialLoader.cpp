@@ -5,9 +5,36 @@
 #include "core/Logging.hpp"
 #include "core/Memory.hpp"
 #include "utility/String.hpp"
+#include "utility/ConfigTokenizer.hpp"
 #include "platform/FileSystem.hpp"
+#include "resources/loaders/GenericLoader.hpp"
 #include "containers/Sarray.hpp"
 #include "renderer/RendererTypes.hpp"
+#include "systems/CookSystem.hpp"
+#include "utility/Utility.hpp"
+
+// NOTE: Property and texture map records keep their in-memory layout, the header stores their sizes to catch layout changes.
+struct ShmtbFileHeader
+{
+    uint32 magic;
+    uint16 version;
+    uint8 type;
+    bool8 auto_destroy;
+    uint16 property_record_size;
+    uint16 map_record_size;
+    uint32 properties_count;
+    uint32 properties_offset;
+    uint32 maps_count;
+    uint32 maps_offset;
+    uint32 strings_offset;
+    uint32 strings_size;
+    uint32 name_offset;
+    uint32 shader_name_offset;
+    uint64 source_hash;
+};
+
+static const uint32 shmtb_magic = 0x42544D53; // "SMTB"
+static const uint16 shmtb_file_version = 2;
 
 namespace ResourceSystem
 {
@@ -15,23 +42,32 @@ namespace ResourceSystem
     static const char* loader_type_path = "materials/";
 
     static bool8 write_shmt_file(MaterialResourceData* resource);
+    static bool8 load_shmt_file(const char* name, const char* full_filepath, MaterialResourceData* out_resource);
+    static bool8 write_shmtb_file(const char* full_filepath, const MaterialResourceData* resource, uint64 source_hash);
+    static bool8 load_shmtb_file(const char* full_filepath, const uint64* source_hash, MaterialResourceData* out_resource);
+
+    static void get_material_filepath(const char* name, const char* extension, char* out_filepath)
+    {
+        CString::safe_print_s<const char*, const char*, const char*, const char*>
+            (out_filepath, Constants::max_filepath_length, "%s%s%s%s", Engine::get_assets_base_path(), loader_type_path, name, extension);
+    }
 
-    static MaterialType parse_material_type(String* s, uint32 line_number)
+    static MaterialType parse_material_type(const char* s, uint32 line_number)
     {
-        if (s->equal_i("phong"))
+        if (CString::equal_i(s, "phong"))
         {
             return MaterialType::PHONG;
         }
-        if (s->equal_i("pbr"))
+        if (CString::equal_i(s, "pbr"))
         {
             SHMWARNV("PBR material type not upported yet. Setting to default phong.", line_number);
             return MaterialType::PHONG;
         }
-        if (s->equal_i("ui"))
+        if (CString::equal_i(s, "ui"))
         {
             return MaterialType::UI;
         }
-        if (s->equal_i("custom"))
+        if (CString::equal_i(s, "custom"))
         {
             return MaterialType::CUSTOM;
         }
@@ -42,13 +78,13 @@ namespace ResourceSystem
         }
     }
 
-    static TextureFilter::Value parse_texture_filter(String* s, uint32 line_number)
+    static TextureFilter::Value parse_texture_filter(const char* s, uint32 line_number)
     {
-        if (s->equal_i("nearest"))
+        if (CString::equal_i(s, "nearest"))
         {
             return TextureFilter::NEAREST;
         }
-        else if (s->equal_i("linear"))
+        else if (CString::equal_i(s, "linear"))
         {
             return TextureFilter::LINEAR;
         }
@@ -59,21 +95,21 @@ namespace ResourceSystem
         }
     }
 
-    static TextureRepeat::Value parse_texture_repeat(String* s, uint32 line_number)
+    static TextureRepeat::Value parse_texture_repeat(const char* s, uint32 line_number)
     {
-        if (s->equal_i("repeat"))
+        if (CString::equal_i(s, "repeat"))
         {
             return TextureRepeat::REPEAT;
         }
-        else if (s->equal_i("mirrored_repeat"))
+        else if (CString::equal_i(s, "mirrored_repeat"))
         {
             return TextureRepeat::MIRRORED_REPEAT;
         }
-        else if (s->equal_i("clamp_to_edge"))
+        else if (CString::equal_i(s, "clamp_to_edge"))
         {
             return TextureRepeat::CLAMP_TO_EDGE;
         }
-        else if (s->equal_i("clamp_to_border"))
+        else if (CString::equal_i(s, "clamp_to_border"))
         {
             return TextureRepeat::CLAMP_TO_BORDER;
         }
@@ -90,56 +126,56 @@ namespace ResourceSystem
         success = false; \
     }
 
-    static bool8 parse_property(String* s, uint32 line_number, MaterialProperty* out_property)
+    static bool8 parse_property(const char* s, uint32 line_number, MaterialProperty* out_property)
     {
 
         out_property->type = MaterialPropertyType::INVALID;
 
-        int32 div_index = s->index_of('/');
+        int32 div_index = CString::index_of(s, '/');
         if (div_index <= 0)
         {
             SHMWARNV("Failed to parse property on line %u. Values have to be formatted as TYPE/VALUE.", line_number);
             return false;
         }
 
-        if ((*s)[0] == 'u')
+        if (s[0] == 'u')
         {
-            if (s->nequal_i("u8", div_index))
+            if (CString::nequal_i(s, "u8", div_index))
                 out_property->type = MaterialPropertyType::UINT8;
-            else if (s->nequal_i("u16", div_index))
+            else if (CString::nequal_i(s, "u16", div_index))
                 out_property->type = MaterialPropertyType::UINT16;
-            else if (s->nequal_i("u32", div_index))
+            else if (CString::nequal_i(s, "u32", div_index))
                 out_property->type = MaterialPropertyType::UINT32;
-            else if (s->nequal_i("u64", div_index))
+            else if (CString::nequal_i(s, "u64", div_index))
                 out_property->type = MaterialPropertyType::UINT64;
         }
-        else if ((*s)[0] == 'i')
+        else if (s[0] == 'i')
         {
-            if (s->nequal_i("i8", div_index))
+            if (CString::nequal_i(s, "i8", div_index))
                 out_property->type = MaterialPropertyType::INT8;
-            else if (s->nequal_i("i16", div_index))
+            else if (CString::nequal_i(s, "i16", div_index))
                 out_property->type = MaterialPropertyType::INT16;
-            else if (s->nequal_i("i32", div_index))
+            else if (CString::nequal_i(s, "i32", div_index))
                 out_property->type = MaterialPropertyType::INT32;
-            else if (s->nequal_i("i64", div_index))
+            else if (CString::nequal_i(s, "i64", div_index))
                 out_property->type = MaterialPropertyType::INT64;
         }
-        else if ((*s)[0] == 'f')
+        else if (s[0] == 'f')
         {
-            if (s->nequal_i("f32", div_index))
+            if (CString::nequal_i(s, "f32", div_index))
                 out_property->type = MaterialPropertyType::FLOAT32;
-            else if (s->nequal_i("f64", div_index))
+            else if (CString::nequal_i(s, "f64", div_index))
                 out_property->type = MaterialPropertyType::FLOAT64;
         }
         else
         {
-            if (s->nequal_i("vec2", div_index))
+            if (CString::nequal_i(s, "vec2", div_index))
                 out_property->type = MaterialPropertyType::FLOAT32_2;
-            else if (s->nequal_i("vec3", div_index))
+            else if (CString::nequal_i(s, "vec3", div_index))
                 out_property->type = MaterialPropertyType::FLOAT32_3;
-            else if (s->nequal_i("vec4", div_index))
+            else if (CString::nequal_i(s, "vec4", div_index))
                 out_property->type = MaterialPropertyType::FLOAT32_4;
-            else if (s->nequal_i("mat4", div_index))
+            else if (CString::nequal_i(s, "mat4", div_index))
                 out_property->type = MaterialPropertyType::FLOAT32_16;
         }
 
@@ -155,72 +191,72 @@ namespace ResourceSystem
         {
         case MaterialPropertyType::UINT8:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index+1], &out_property->u8[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->u8[0]);
             break;
         }
         case MaterialPropertyType::UINT16:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->u16[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->u16[0]);
             break;
         }
         case MaterialPropertyType::UINT32:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->u32[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->u32[0]);
             break;
         }
         case MaterialPropertyType::UINT64:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->u64[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->u64[0]);
             break;
         }
         case MaterialPropertyType::INT8:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->i8[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->i8[0]);
             break;
         }
         case MaterialPropertyType::INT16:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->i16[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->i16[0]);
             break;
         }
         case MaterialPropertyType::INT32:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->i32[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->i32[0]);
             break;
         }
         case MaterialPropertyType::INT64:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->i64[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->i64[0]);
             break;
         }
         case MaterialPropertyType::FLOAT32:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->f32[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->f32[0]);
             break;
         }
         case MaterialPropertyType::FLOAT64:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], &out_property->f64[0]);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], &out_property->f64[0]);
             break;
         }
         case MaterialPropertyType::FLOAT32_2:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], (Math::Vec2f*)out_property->f32);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], (Math::Vec2f*)out_property->f32);
             break;
         }
         case MaterialPropertyType::FLOAT32_3:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], (Math::Vec3f*)out_property->f32);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], (Math::Vec3f*)out_property->f32);
             break;
         }
         case MaterialPropertyType::FLOAT32_4:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], (Math::Vec4f*)out_property->f32);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], (Math::Vec4f*)out_property->f32);
             break;
         }
         case MaterialPropertyType::FLOAT32_16:
         {
-            PARSE_PROPERTY_VALUE(&(*s)[div_index + 1], (Math::Mat4*)out_property->f32);
+            PARSE_PROPERTY_VALUE(&s[div_index + 1], (Math::Mat4*)out_property->f32);
             break;
         }
         }
@@ -232,11 +268,54 @@ namespace ResourceSystem
 	bool8 material_loader_load(const char* name, MaterialResourceData* out_resource)
 	{
 
-		const char* format = "%s%s%s%s";
-		char full_filepath[Constants::max_filepath_length];
+		char shmt_filepath[Constants::max_filepath_length];
+		char shmtb_filepath[Constants::max_filepath_length];
+		get_material_filepath(name, ".shmt", shmt_filepath);
+		get_material_filepath(name, ".shmtb", shmtb_filepath);
+
+		// NOTE: Binary files only get used while they match the text they were built from. Builds shipping without the text take them as they are.
+		uint64 source_hash = 0;
+		bool8 has_source = generic_loader_get_source_hash(shmt_filepath, &source_hash);
+
+		if (CookSystem::is_cooked(shmtb_filepath) || FileSystem::file_exists(shmtb_filepath))
+		{
+			if (load_shmtb_file(shmtb_filepath, has_source ? &source_hash : 0, out_resource))
+				return true;
+		}
+
+		if (!load_shmt_file(name, shmt_filepath, out_resource))
+			return false;
+
+		// NOTE: Failing to write the binary file only costs parsing the text again on the next load.
+		write_shmtb_file(shmtb_filepath, out_resource, source_hash);
+		return true;
+
+	}
+
+	bool8 material_loader_cook(const char* name)
+	{
+		char shmt_filepath[Constants::max_filepath_length];
+		char shmtb_filepath[Constants::max_filepath_length];
+		get_material_filepath(name, ".shmt", shmt_filepath);
+		get_material_filepath(name, ".shmtb", shmtb_filepath);
+
+		MaterialResourceData resource = {};
+		uint64 source_hash = 0;
+		bool8 res = generic_loader_get_source_hash(shmt_filepath, &source_hash) && 
+			load_shmt_file(name, shmt_filepath, &resource) && write_shmtb_file(shmtb_filepath, &resource, source_hash);
+		material_loader_unload(&resource);
+		return res;
+	}
+
+	uint64 material_loader_get_cook_settings_hash()
+	{
+		uint16 record_sizes[2] = { (uint16)sizeof(MaterialProperty), (uint16)sizeof(TextureMapResourceData) };
+		uint64 hash = hash_fnv1a64(&shmtb_file_version, sizeof(shmtb_file_version));
+		return hash_fnv1a64(record_sizes, sizeof(record_sizes), hash);
+	}
 
-		CString::safe_print_s<const char*, const char*, const char*, const char*>
-			(full_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, name, ".shmt");
+	static bool8 load_shmt_file(const char* name, const char* full_filepath, MaterialResourceData* out_resource)
+	{
 
 		FileSystem::FileHandle f;
 		if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
@@ -271,45 +350,29 @@ namespace ResourceSystem
             return false;
         }
 
-        // Read each line of the file.
-        String line(512);
-        uint64 line_length = 0;
-        uint32 line_number = 1;
-
-        String var_name;
-        String value;
-
         uint32 property_i = Constants::max_u32;
         uint32 texture_map_i = Constants::max_u32;
 
         bool8 success = true;
 
-        const char* continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
-        {
-            // Trim the string.
-
-            line.trim();
-
-            // Get the trimmed length.
-            line_length = line.len();
+        char* content = file_content.c_str_vulnerable();
+        content[bytes_read] = 0;
 
-            // Skip blank lines and comments.
-            if (line_length < 1 || line[0] == '#') 
-            {
-                line_number++;
-                continue;
-            }
+        ConfigTokenizer tokenizer(content, bytes_read, full_filepath);
+        ConfigToken token;
+        while (tokenizer.next(&token))
+        {
+            uint32 line_number = token.line_number;
 
-            if (line[0] == '[')
+            if (token.type == ConfigToken::Type::Section)
             {
                 if (scope == ParserScope::MATERIAL)
                 {
-                    if (line.equal_i("[Properties]"))
+                    if (CString::equal_i(token.name, "[Properties]"))
                     {
                         scope = ParserScope::PROPERTIES;
                     }
-                    else if (line.equal_i("[TextureMap]"))
+                    else if (CString::equal_i(token.name, "[TextureMap]"))
                     {
                         scope = ParserScope::TEXTURE_MAP;
                         out_resource->maps.emplace();
@@ -327,7 +390,7 @@ namespace ResourceSystem
                 }
                 else
                 {
-                    if (line.equal_i("[/]"))
+                    if (CString::equal_i(token.name, "[/]"))
                     {
                         scope = ParserScope::MATERIAL;
                     }
@@ -339,81 +402,64 @@ namespace ResourceSystem
                     }
                 }
 
-                line_number++;
                 continue;
             }
 
-            // Split into var/value
-            int32 equal_index = line.index_of('=');
-            if (equal_index == -1) {
-                SHMWARNV("Potential formatting issue found in file '%s': '=' token not found. Skipping line %ui.", full_filepath, line_number);
-                line_number++;
-                continue;
-            }
-
-            mid(var_name, line.c_str(), 0, equal_index);
-            var_name.trim();
-
-            mid(value, line.c_str(), equal_index + 1);
-            value.trim();
-
             if (scope == ParserScope::MATERIAL)
             {
-                if (var_name.equal_i("name"))
+                if (CString::equal_i(token.name, "name"))
                 {
-                    CString::copy(value.c_str(), out_resource->name, Constants::max_material_name_length);
+                    CString::copy(token.value, out_resource->name, Constants::max_material_name_length);
                 }
-                else if (var_name.equal_i("type"))
+                else if (CString::equal_i(token.name, "type"))
                 {
-                    out_resource->type = parse_material_type(&value, line_number);
+                    out_resource->type = parse_material_type(token.value, line_number);
                 }
-                else if (var_name.equal_i("shader"))
+                else if (CString::equal_i(token.name, "shader"))
                 {
-                    CString::copy(value.c_str(), out_resource->shader_name, Constants::max_shader_name_length);
+                    CString::copy(token.value, out_resource->shader_name, Constants::max_shader_name_length);
                 }
             }
             else if (scope == ParserScope::PROPERTIES)
             {
                 out_resource->properties.emplace();
                 property_i = out_resource->properties.count - 1;
-                CString::copy(var_name.c_str(), out_resource->properties[property_i].name, MaterialProperty::max_name_length);
-                parse_property(&value, line_number, &out_resource->properties[property_i]);
+                CString::copy(token.name, out_resource->properties[property_i].name, MaterialProperty::max_name_length);
+                parse_property(token.value, line_number, &out_resource->properties[property_i]);
             }
             else if (scope == ParserScope::TEXTURE_MAP)
             {
                 TextureMapResourceData* map = &out_resource->maps[texture_map_i];
 
-                if (var_name.equal_i("name"))
+                if (CString::equal_i(token.name, "name"))
                 {
-                    CString::copy(value.c_str(), map->name, Constants::max_texture_name_length);
+                    CString::copy(token.value, map->name, Constants::max_texture_name_length);
                 }
-                if (var_name.equal_i("texture_name"))
+                if (CString::equal_i(token.name, "texture_name"))
                 {
-                    CString::copy(value.c_str(), map->texture_name, Constants::max_texture_name_length);
+                    CString::copy(token.value, map->texture_name, Constants::max_texture_name_length);
                 }
-                else if (var_name.equal_i("filter_min"))
+                else if (CString::equal_i(token.name, "filter_min"))
                 {
-                    map->filter_min = parse_texture_filter(&value, line_number);
+                    map->filter_min = parse_texture_filter(token.value, line_number);
                 }
-                else if (var_name.equal_i("filter_mag"))
+                else if (CString::equal_i(token.name, "filter_mag"))
                 {
-                    map->filter_mag = parse_texture_filter(&value, line_number);
+                    map->filter_mag = parse_texture_filter(token.value, line_number);
                 }
-                else if (var_name.equal_i("repeat_u"))
+                else if (CString::equal_i(token.name, "repeat_u"))
                 {
-                    map->repeat_u = parse_texture_repeat(&value, line_number);
+                    map->repeat_u = parse_texture_repeat(token.value, line_number);
                 }
-                else if (var_name.equal_i("repeat_v"))
+                else if (CString::equal_i(token.name, "repeat_v"))
                 {
-                    map->repeat_v = parse_texture_repeat(&value, line_number);
+                    map->repeat_v = parse_texture_repeat(token.value, line_number);
                 }
-                else if (var_name.equal_i("repeat_w"))
+                else if (CString::equal_i(token.name, "repeat_w"))
                 {
-                    map->repeat_w = parse_texture_repeat(&value, line_number);
+                    map->repeat_w = parse_texture_repeat(token.value, line_number);
                 }
             }
-
-            line_number++;
         }
 
         FileSystem::file_close(&f);
@@ -421,7 +467,7 @@ namespace ResourceSystem
         if (!success)
             material_loader_unload(out_resource);            
 
-		return true;
+		return success;
 
 	}
 
@@ -707,24 +753,24 @@ namespace ResourceSystem
             }
             case MaterialPropertyType::FLOAT32:
             {
-                CString::print_s(line_buffer, 512, "%s=f32/%f6\n", resource->properties[i].name, resource->properties[i].f32[0]);
+                CString::print_s(line_buffer, 512, "%s=f32/%fr\n", resource->properties[i].name, resource->properties[i].f32[0]);
                 break;
             }
             case MaterialPropertyType::FLOAT64:
             {
-                CString::print_s(line_buffer, 512, "%s=f64/%lf6\n", resource->properties[i].name, resource->properties[i].f64[0]);
+                CString::print_s(line_buffer, 512, "%s=f64/%lfr\n", resource->properties[i].name, resource->properties[i].f64[0]);
                 break;
             }
             case MaterialPropertyType::FLOAT32_2:
             {
-                CString::print_s(line_buffer, 512, "%s=vec2/%f6 %f6\n", resource->properties[i].name, 
+                CString::print_s(line_buffer, 512, "%s=vec2/%fr %fr\n", resource->properties[i].name, 
                     resource->properties[i].f32[0],
                     resource->properties[i].f32[1]);
                 break;
             }
             case MaterialPropertyType::FLOAT32_3:
             {
-                CString::print_s(line_buffer, 512, "%s=vec3/%f6 %f6 %f6\n", resource->properties[i].name, 
+                CString::print_s(line_buffer, 512, "%s=vec3/%fr %fr %fr\n", resource->properties[i].name, 
                     resource->properties[i].f32[0],
                     resource->properties[i].f32[1],
                     resource->properties[i].f32[2]);
@@ -732,7 +778,7 @@ namespace ResourceSystem
             }
             case MaterialPropertyType::FLOAT32_4:
             {
-                CString::print_s(line_buffer, 512, "%s=vec4/%f6 %f6 %f6 %f6\n", resource->properties[i].name, 
+                CString::print_s(line_buffer, 512, "%s=vec4/%fr %fr %fr %fr\n", resource->properties[i].name, 
                     resource->properties[i].f32[0],
                     resource->properties[i].f32[1],
                     resource->properties[i].f32[2],
@@ -741,7 +787,7 @@ namespace ResourceSystem
             }
             case MaterialPropertyType::FLOAT32_16:
             {
-                CString::print_s(line_buffer, 512, "%s=mat4/%f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6 %f6\n", resource->properties[i].name, 
+                CString::print_s(line_buffer, 512, "%s=mat4/%fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr %fr\n", resource->properties[i].name, 
                     resource->properties[i].f32[0],
                     resource->properties[i].f32[1],
                     resource->properties[i].f32[2],
@@ -810,6 +856,123 @@ namespace ResourceSystem
 
         FileSystem::file_close(&f);
 
+        // NOTE: Written along with the text, so the material does not get parsed again on its first load.
+        get_material_filepath(resource->name, ".shmtb", full_filepath);
+        write_shmtb_file(full_filepath, resource, hash_fnv1a64(content.c_str(), content.len()));
+
+        return true;
+
+    }
+
+    static bool8 write_shmtb_file(const char* full_filepath, const MaterialResourceData* resource, uint64 source_hash)
+    {
+
+        uint32 name_length = CString::length(resource->name);
+        uint32 shader_name_length = CString::length(resource->shader_name);
+
+        ShmtbFileHeader header = {};
+        header.magic = shmtb_magic;
+        header.version = shmtb_file_version;
+        header.type = (uint8)resource->type;
+        header.auto_destroy = resource->auto_destroy;
+        header.property_record_size = sizeof(MaterialProperty);
+        header.map_record_size = sizeof(TextureMapResourceData);
+        header.properties_count = resource->properties.count;
+        header.properties_offset = (uint32)get_aligned_pow2(sizeof(ShmtbFileHeader), 16);
+        header.maps_count = resource->maps.count;
+        header.maps_offset = (uint32)get_aligned_pow2(header.properties_offset + header.properties_count * sizeof(MaterialProperty), 16);
+        header.strings_offset = header.maps_offset + header.maps_count * sizeof(TextureMapResourceData);
+        header.name_offset = 0;
+        header.shader_name_offset = name_length + 1;
+        header.strings_size = name_length + 1 + shader_name_length + 1;
+        header.source_hash = source_hash;
+
+        Buffer file_data(header.strings_offset + header.strings_size, 0, AllocationTag::Resource);
+        uint8* data = (uint8*)file_data.data;
+        Memory::copy_memory(&header, data, sizeof(header));
+        if (header.properties_count)
+            Memory::copy_memory(resource->properties.data, data + header.properties_offset, header.properties_count * sizeof(MaterialProperty));
+        if (header.maps_count)
+            Memory::copy_memory(resource->maps.data, data + header.maps_offset, header.maps_count * sizeof(TextureMapResourceData));
+        Memory::copy_memory(resource->name, data + header.strings_offset + header.name_offset, name_length + 1);
+        Memory::copy_memory(resource->shader_name, data + header.strings_offset + header.shader_name_offset, shader_name_length + 1);
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FILE_MODE_WRITE, &f)) 
+        {
+            SHMERRORV("Error opening material file for writing: '%s'", full_filepath);
+            file_data.free_data();
+            return false;
+        }
+        SHMDEBUGV("Writing .shmtb file '%s'...", full_filepath);
+
+        uint32 bytes_written = 0;
+        bool8 res = FileSystem::write(&f, (uint32)file_data.size, file_data.data, &bytes_written) && bytes_written == file_data.size;
+
+        FileSystem::file_close(&f);
+        file_data.free_data();
+        return res;
+
+    }
+
+    static bool8 load_shmtb_file(const char* full_filepath, const uint64* source_hash, MaterialResourceData* out_resource)
+    {
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
+            return false;
+
+        uint32 file_size = FileSystem::get_file_size32(&f);
+        uint32 bytes_read = 0;
+        out_resource->binary_data.init(file_size ? file_size : 1, 0, AllocationTag::Resource);
+        bool8 read = FileSystem::read_all_bytes(&f, out_resource->binary_data.data, file_size, &bytes_read) && bytes_read == file_size;
+        FileSystem::file_close(&f);
+
+        const uint8* data = (const uint8*)out_resource->binary_data.data;
+        const ShmtbFileHeader* header = (const ShmtbFileHeader*)data;
+        bool8 valid = read && file_size >= sizeof(ShmtbFileHeader) &&
+            header->magic == shmtb_magic &&
+            header->version == shmtb_file_version &&
+            header->property_record_size == sizeof(MaterialProperty) &&
+            header->map_record_size == sizeof(TextureMapResourceData) &&
+            header->properties_offset + (uint64)header->properties_count * sizeof(MaterialProperty) <= file_size &&
+            header->maps_offset + (uint64)header->maps_count * sizeof(TextureMapResourceData) <= file_size &&
+            header->strings_size && (uint64)header->strings_offset + header->strings_size <= file_size &&
+            header->name_offset < header->strings_size && header->shader_name_offset < header->strings_size &&
+            data[header->strings_offset + header->strings_size - 1] == 0;
+
+        if (!valid)
+        {
+            SHMWARNV("Failed to load binary material '%s'. Falling back to the text file.", full_filepath);
+            out_resource->binary_data.free_data();
+            return false;
+        }
+
+        if (source_hash && header->source_hash != *source_hash)
+        {
+            SHMDEBUGV("Binary material '%s' is outdated. Falling back to the text file.", full_filepath);
+            out_resource->binary_data.free_data();
+            return false;
+        }
+
+        const char* strings = (const char*)(data + header->strings_offset);
+        CString::copy(&strings[header->name_offset], out_resource->name, Constants::max_material_name_length);
+        CString::copy(&strings[header->shader_name_offset], out_resource->shader_name, Constants::max_shader_name_length);
+        out_resource->type = (MaterialType)header->type;
+        out_resource->auto_destroy = header->auto_destroy;
+
+        // NOTE: No parsing and no copies, the arrays get handed the records inside the file data.
+        if (header->properties_count)
+        {
+            out_resource->properties.init(header->properties_count, 0, AllocationTag::Resource, (uint8*)out_resource->binary_data.data + header->properties_offset);
+            out_resource->properties.set_count(header->properties_count);
+        }
+        if (header->maps_count)
+        {
+            out_resource->maps.init(header->maps_count, 0, AllocationTag::Resource, (uint8*)out_resource->binary_data.data + header->maps_offset);
+            out_resource->maps.set_count(header->maps_count);
+        }
+
         return true;
 
     }
@@ -819,6 +982,7 @@ namespace ResourceSystem
         resource->properties.free_data();
         resource->maps.free_data();
         resource->map_configs.free_data();
+        resource->binary_data.free_data();
 	}
 
 }
\ No newline at end of file
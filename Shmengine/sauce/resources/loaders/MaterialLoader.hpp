@@ -2,6 +2,7 @@
 
 #include "Defines.hpp"
 #include "systems/MaterialSystem.hpp"
+#include "containers/Buffer.hpp"
 
 struct TextureMapResourceData
 {
@@ -27,6 +28,9 @@ struct MaterialResourceData
 
 	Sarray<TextureMapConfig> map_configs;
 	Sarray<const char*> texture_names;
+
+	// NOTE: Contents of a .shmtb file. Properties and maps of binary materials point straight into it until the resource is unloaded.
+	Buffer binary_data;
 };
 
 namespace ResourceSystem
@@ -36,6 +40,11 @@ namespace ResourceSystem
 
 	bool8 material_loader_import_obj_material_library_file(const char* file_path);
 
+	// NOTE: Parses the .shmt text file and writes its .shmtb binary equivalent.
+	bool8 material_loader_cook(const char* name);
+	// NOTE: Changes whenever the same source would produce a different .shmtb file.
+	uint64 material_loader_get_cook_settings_hash();
+
 	MaterialConfig material_loader_get_config_from_resource(MaterialResourceData* resource);
 }
 
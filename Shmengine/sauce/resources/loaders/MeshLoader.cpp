@@ -7,7 +7,13 @@
 #include "core/Memory.hpp"
 #include "utility/String.hpp"
 #include "renderer/Utility.hpp"
+#include "renderer/MeshCodec.hpp"
+#include "renderer/MeshOptimizer.hpp"
 #include "platform/FileSystem.hpp"
+#include "systems/JobSystem.hpp"
+#include "systems/CookSystem.hpp"
+#include "core/Atomic.hpp"
+#include "utility/Utility.hpp"
 
 enum class MeshFileType {
     NOT_FOUND,
@@ -34,6 +40,70 @@ struct MeshGroupData {
     Darray<MeshFaceData> faces;
 };
 
+enum class ObjDirectiveType : uint8 {
+    Group,
+    UseMaterial,
+    MaterialLib
+};
+
+// NOTE: Directives change importer state, so they are recorded with their position among the chunk's faces and replayed in order.
+// Counts are chunk local and taken at the time the directive was parsed.
+struct ObjDirective {
+    ObjDirectiveType type;
+    uint32 face_index;
+    uint32 normal_count;
+    uint32 tex_coord_count;
+    const char* values;
+};
+
+// NOTE: Faces parsed without knowing whether earlier chunks contained normals and texture coordinates. Re-parsed while stitching if they did.
+struct ObjPendingFace {
+    uint32 face_index;
+    uint32 normal_count;
+    uint32 tex_coord_count;
+    const char* values;
+};
+
+struct ObjParseChunk {
+    char* begin;
+    char* end;
+    Darray<Math::Vec3f> positions;
+    Darray<Math::Vec3f> normals;
+    Darray<Math::Vec2f> tex_coords;
+    Darray<MeshFaceData> faces;
+    Darray<ObjDirective> directives;
+    Darray<ObjPendingFace> pending_faces;
+};
+
+// NOTE: Shared between the importing thread and its helper jobs. Whoever drops the last reference frees it, helpers may start after the import already finished.
+struct ObjParseContext {
+    ObjParseChunk* chunks;
+    uint32 chunk_count;
+    volatile uint32 next_chunk;
+    volatile uint32 completed_count;
+    volatile uint32 ref_count;
+};
+
+struct ObjParseJobParams {
+    ObjParseContext* context;
+};
+
+static const uint32 obj_parse_chunk_size = 0x40000;
+
+
+// NOTE: Version 2 pads every geometry's vertex block to 16 bytes within the file, so loaded data can be used in place.
+// Version 3 stores quantized vertices and encodes both streams, the data gets decoded on load instead.
+// Version 4 adds a lod table, the index stream holds all lods back to back.
+static const uint16 shmesh_file_version = 4;
+static const uint16 shmesh_file_version_encoded_streams = 3;
+static const uint16 shmesh_file_version_lods = 4;
+
+// NOTE: Every lod targets mesh_lod_reduction of its predecessor's triangles. The chain ends once simplification stops paying off or exceeds the error limit.
+static const float32 mesh_lod_reduction = 0.5f;
+static const float32 mesh_lod_min_reduction = 0.85f;
+static const float32 mesh_lod_max_error = 0.05f;
+// NOTE: Weights for normal and texture coordinates, which directly follow the position within Vertex3D.
+static const float32 mesh_lod_attribute_weights[5] = { 0.01f, 0.01f, 0.01f, 0.1f, 0.1f };
 
 struct ShmeshFileHeader
 {
@@ -60,18 +130,40 @@ struct ShmeshFileGeometryHeader
     uint32 index_count;
 };
 
+// NOTE: Follows the geometry header from version 3 on. Vertices are stored as QuantizedVertex3D if the stream vertex size differs from the vertex size.
+struct ShmeshFileGeometryStreams
+{
+    uint32 stream_vertex_size;
+    uint32 vertex_stream_size;
+    uint32 index_stream_size;
+};
+
+// NOTE: Follows the streams header from version 4 on.
+struct ShmeshFileGeometryLods
+{
+    uint32 lod_count;
+    GeometryLod lods[Constants::max_geometry_lod_count];
+};
+
 namespace ResourceSystem
 {
 
     static const char* loader_type_path = "models/";
 
     static bool8 import_obj_file(FileSystem::FileHandle* obj_file, const char* obj_filepath, const char* mesh_name, const char* out_shmesh_filename, MeshResourceData* out_resource);
-    static void process_subobject(const Darray<Math::Vec3f>& positions, const Darray<Math::Vec3f>& normals, const Darray<Math::Vec2f>& tex_coords, const Darray<MeshFaceData>& faces, GeometryResourceData* out_data);
+    static void process_subobject(const Darray<Math::Vec3f>& positions, const Darray<Math::Vec3f>& normals, const Darray<Math::Vec2f>& tex_coords, const Darray<MeshFaceData>& faces, bool8 skip_normals, bool8 skip_tex_coords, GeometryResourceData* out_data);
+
+    static void obj_parse_chunks(ObjParseChunk* chunks, uint32 chunk_count);
+    static void obj_parse_chunk(ObjParseChunk* chunk, bool8 has_previous_chunks);
+    static bool8 obj_parse_face(const char* values, bool8 indexed_attributes, MeshFaceData* out_face);
 
     static bool8 load_shmesh_file(FileSystem::FileHandle* shmesh_file, const char* shmesh_filepath, MeshResourceData* out_resource);
     static bool8 write_shmesh_file(const char* path, const char* name, MeshResourceData* resource);
 
+    static bool8 decode_geometry_streams(const ShmeshFileGeometryHeader* geo_header, const ShmeshFileGeometryStreams* streams, const uint8* vertex_stream, const uint8* index_stream, GeometryResourceData* g);
     static void geometry_resource_deduplicate_vertices(GeometryResourceData* geo);
+    static void geometry_resource_optimize(GeometryResourceData* geo);
+    static void geometry_resource_generate_lods(GeometryResourceData* geo);
 
     bool8 mesh_loader_load(const char* name, MeshResourceData* out_resource)
     {
@@ -89,7 +181,14 @@ namespace ResourceSystem
 
         String full_filepath(Constants::max_filepath_length);
         MeshFileType file_type = MeshFileType::NOT_FOUND;
-        for (uint32 i = 0; i < supported_file_type_count; i++)
+
+        // NOTE: Outputs listed in the cook manifest are known to be current, so the source formats do not need to be probed.
+        full_filepath = full_filepath_wo_extension;
+        full_filepath.append(".shmesh");
+        if (CookSystem::is_cooked(full_filepath.c_str()))
+            file_type = MeshFileType::SHMESH;
+
+        for (uint32 i = 0; i < supported_file_type_count && file_type == MeshFileType::NOT_FOUND; i++)
         {
             full_filepath = full_filepath_wo_extension;
             full_filepath.append(supported_file_types[i].extension);
@@ -150,6 +249,44 @@ namespace ResourceSystem
 
     }
 
+    bool8 mesh_loader_cook(const char* name)
+    {
+
+        char obj_filepath[Constants::max_filepath_length];
+        char shmesh_filepath[Constants::max_filepath_length];
+        CString::safe_print_s<const char*, const char*, const char*>
+            (obj_filepath, Constants::max_filepath_length, "%s%s%s.obj", Engine::get_assets_base_path(), loader_type_path, name);
+        CString::safe_print_s<const char*, const char*, const char*>
+            (shmesh_filepath, Constants::max_filepath_length, "%s%s%s.shmesh", Engine::get_assets_base_path(), loader_type_path, name);
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(obj_filepath, FileMode::FILE_MODE_READ, &f))
+        {
+            SHMERRORV("mesh_loader_cook - Failed to open file '%s'", obj_filepath);
+            return false;
+        }
+
+        MeshResourceData resource = {};
+        resource.geometries.init(1, 0, AllocationTag::Resource);
+        bool8 res = import_obj_file(&f, obj_filepath, name, shmesh_filepath, &resource);
+
+        FileSystem::file_close(&f);
+        mesh_loader_unload(&resource);
+
+        return res;
+
+    }
+
+    uint64 mesh_loader_get_cook_settings_hash()
+    {
+        uint64 hash = hash_fnv1a64(&shmesh_file_version, sizeof(shmesh_file_version));
+        hash = hash_fnv1a64(&mesh_lod_reduction, sizeof(mesh_lod_reduction), hash);
+        hash = hash_fnv1a64(&mesh_lod_min_reduction, sizeof(mesh_lod_min_reduction), hash);
+        hash = hash_fnv1a64(&mesh_lod_max_error, sizeof(mesh_lod_max_error), hash);
+        hash = hash_fnv1a64(mesh_lod_attribute_weights, sizeof(mesh_lod_attribute_weights), hash);
+        return hash;
+    }
+
     void mesh_loader_unload(MeshResourceData* resource)
     {
         for (uint32 i = 0; i < resource->geometries.count; i++)
@@ -160,6 +297,7 @@ namespace ResourceSystem
         }
         resource->geometries.free_data();
         resource->mesh_geometry_configs.free_data();
+        FileSystem::unmap_file(&resource->file_mapping);
     }
 
     MeshConfig mesh_loader_get_config_from_resource(const char* name, MeshResourceData* resource)
@@ -171,6 +309,7 @@ namespace ResourceSystem
         {
             MeshGeometryConfig* mesh_config = &resource->mesh_geometry_configs[i];
             mesh_config->geo_config = Renderer::geometry_get_config_from_resource(&resource->geometries[i].geometry_data);
+            mesh_config->geo_config.reference_data = true;
             mesh_config->material_name = resource->geometries[i].material_name;
         }
 
@@ -196,130 +335,156 @@ namespace ResourceSystem
             return false;
         }
 
-        Darray<Math::Vec3f> positions(0x4000, 0);
-        Darray<Math::Vec3f> normals(0x4000, 0);
-        Darray<Math::Vec2f> tex_coords(0x4000, 0);
+        // NOTE: Lines get terminated in place while parsing, directive values keep pointing into the file content until everything is stitched together.
+        char* content = file_content.c_str_vulnerable();
+        content[bytes_read] = 0;
+        uint32 content_length = CString::length(content);
+
+        Sarray<ObjParseChunk> chunks(content_length / obj_parse_chunk_size + 1, 0);
+        chunks.zero_memory();
+
+        uint32 chunk_count = 0;
+        char* chunk_begin = content;
+        while (*chunk_begin)
+        {
+            ObjParseChunk* chunk = &chunks[chunk_count++];
+            chunk->begin = chunk_begin;
+
+            char* content_end = content + content_length;
+            char* chunk_end = (uint32)(content_end - chunk_begin) > obj_parse_chunk_size ? chunk_begin + obj_parse_chunk_size : content_end;
+            while (chunk_end < content_end && chunk_end[-1] != '\n')
+                chunk_end++;
+
+            chunk->end = chunk_end;
+            chunk_begin = chunk_end;
+        }
+
+        if (chunk_count)
+            obj_parse_chunks(chunks.data, chunk_count);
+
+        // NOTE: Everything past this point replays the file in order, so the result is identical to a sequential parse.
+        uint32 position_count = 0;
+        uint32 normal_count = 0;
+        uint32 tex_coord_count = 0;
+        for (uint32 c = 0; c < chunk_count; c++)
+        {
+            position_count += chunks[c].positions.count;
+            normal_count += chunks[c].normals.count;
+            tex_coord_count += chunks[c].tex_coords.count;
+        }
+
+        Darray<Math::Vec3f> positions(SHMAX(position_count, 1), 0);
+        Darray<Math::Vec3f> normals(SHMAX(normal_count, 1), 0);
+        Darray<Math::Vec2f> tex_coords(SHMAX(tex_coord_count, 1), 0);
+
+        for (uint32 c = 0; c < chunk_count; c++)
+        {
+            positions.copy_memory(chunks[c].positions.data, chunks[c].positions.count, positions.count);
+            normals.copy_memory(chunks[c].normals.data, chunks[c].normals.count, normals.count);
+            tex_coords.copy_memory(chunks[c].tex_coords.data, chunks[c].tex_coords.count, tex_coords.count);
+        }
 
         Darray<MeshGroupData> groups(4, 0);
 
         String material_file_name(Constants::max_filepath_length);
 
         String name(Constants::max_filepath_length);
-        uint32 current_mat_name_count = 0;
         Darray<String> material_names(64, 0);
 
-        // Read each line of the file.
-        String line(512);
-        uint64 line_length = 0;
-        uint32 line_number = 1;
-        String identifier;
-        String values;
-
-        const char* continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
+        uint32 normal_prefix = 0;
+        uint32 tex_coord_prefix = 0;
+        for (uint32 c = 0; c < chunk_count; c++)
         {
 
-            if (line.len() < 1 || line[0] == '#') {
-                continue;
-            }
-
-            int32 first_space_i = line.index_of(' ');
-            if (first_space_i == -1)
-                continue;
-            
-            mid(identifier, line.c_str(), 0, first_space_i);
-            mid(values, line.c_str(), first_space_i + 1);
-            identifier.trim();
-            values.trim();
-
-            if (identifier.len() == 0)
-                continue;      
+            ObjParseChunk* chunk = &chunks[c];
 
-            if (identifier == "v")
+            // NOTE: Face formats depend on whether normals and texture coordinates showed up anywhere before, which only the previous chunks can tell.
+            for (uint32 i = 0; i < chunk->pending_faces.count; i++)
             {
-                Math::Vec3f pos;
-                CString::parse(values.c_str(), &pos);
-                positions.emplace(pos);
-            }
-            else if (identifier == "vn")
-            {
-                Math::Vec3f norm;
-                CString::parse(values.c_str(), &norm);
-                normals.emplace(norm);
+                const ObjPendingFace& pending = chunk->pending_faces[i];
+                if (normal_prefix + pending.normal_count && tex_coord_prefix + pending.tex_coord_count)
+                    obj_parse_face(pending.values, true, &chunk->faces[pending.face_index]);
             }
-            else if (identifier == "vt")
-            {
-                Math::Vec2f tex_c;
-                CString::parse(values.c_str(), &tex_c);
-                tex_coords.emplace(tex_c);
-            }
-            else if (identifier == "s")
-            {
-            }
-            else if (identifier == "f")
+
+            uint32 face_cursor = 0;
+            for (uint32 d = 0; d <= chunk->directives.count; d++)
             {
-                MeshFaceData face;
 
-                if (normals.count == 0 || tex_coords.count == 0)
+                uint32 face_end = d < chunk->directives.count ? chunk->directives[d].face_index : chunk->faces.count;
+                if (face_end > face_cursor)
                 {
-                    CString::scan(values.c_str(), "%u %u %u",
-                        &face.vertices[0].position_index,
-                        &face.vertices[1].position_index,
-                        &face.vertices[2].position_index);
+                    if (groups.count)
+                    {
+                        Darray<MeshFaceData>& group_faces = groups[groups.count - 1].faces;
+                        group_faces.copy_memory(&chunk->faces.data[face_cursor], face_end - face_cursor, group_faces.count);
+                    }
+                    else
+                    {
+                        SHMWARNV("import_obj_file - Skipping %u faces without material in file '%s'.", face_end - face_cursor, obj_filepath);
+                    }
+                    face_cursor = face_end;
                 }
-                else
+
+                if (d == chunk->directives.count)
+                    break;
+
+                const ObjDirective& directive = chunk->directives[d];
+                switch (directive.type)
                 {
-                    CString::scan(values.c_str(), "%u/%u/%u %u/%u/%u %u/%u/%u",
-                        &face.vertices[0].position_index,
-                        &face.vertices[0].texcoord_index,
-                        &face.vertices[0].normal_index,
-                        &face.vertices[1].position_index,
-                        &face.vertices[1].texcoord_index,
-                        &face.vertices[1].normal_index,
-                        &face.vertices[2].position_index,
-                        &face.vertices[2].texcoord_index,
-                        &face.vertices[2].normal_index);
+                case ObjDirectiveType::MaterialLib:
+                {
+                    material_file_name = directive.values;
+                    break;
                 }
-
-                uint32 group_index = groups.count - 1;
-                groups[group_index].faces.emplace(face);
-            }
-            else if (identifier == "mtllib")
-            {
-                material_file_name = values;
-            }
-            else if (identifier == "g")
-            {
-                for (uint32 i = 0; i < groups.count; i++)
+                case ObjDirectiveType::Group:
                 {
-                    MeshGeometryResourceData* new_data = &out_resource->geometries[out_resource->geometries.emplace()];
-                    if (!name[0])
+                    bool8 skip_normals = !(normal_prefix + directive.normal_count);
+                    bool8 skip_tex_coords = !(tex_coord_prefix + directive.tex_coord_count);
+
+                    for (uint32 i = 0; i < groups.count; i++)
                     {
-                        name = mesh_name;
-                        name += "_geo";
-                    }
-                    CString::copy(name.c_str(), new_data->geometry_data.name, Constants::max_geometry_name_length);
+                        MeshGeometryResourceData* new_data = &out_resource->geometries[out_resource->geometries.emplace()];
+                        if (!name[0])
+                        {
+                            name = mesh_name;
+                            name += "_geo";
+                        }
+                        CString::copy(name.c_str(), new_data->geometry_data.name, Constants::max_geometry_name_length);
+
+                        CString::copy(material_names[i].c_str(), new_data->material_name, Constants::max_material_name_length);
 
-                    CString::copy(material_names[i].c_str(), new_data->material_name, Constants::max_material_name_length);
+                        process_subobject(positions, normals, tex_coords, groups[i].faces, skip_normals, skip_tex_coords, &new_data->geometry_data);
+
+                        groups[i].faces.free_data();
+                    }
 
-                    process_subobject(positions, normals, tex_coords, groups[i].faces, &new_data->geometry_data);
+                    material_names.clear();
+                    groups.clear();
+                    name = directive.values;
+                    break;
+                }
+                case ObjDirectiveType::UseMaterial:
+                {
+                    MeshGroupData* new_group = &groups[groups.emplace()];
+                    new_group->faces.init(0xF000, 0);
 
-                    groups[i].faces.free_data();
+                    material_names.emplace(directive.values);
+                    break;
+                }
                 }
 
-                material_names.clear();
-                groups.clear();
-                name = values;
             }
-            else if (identifier == "usemtl")
-            {
-                MeshGroupData* new_group = &groups[groups.emplace()];
-                new_group->faces.init(0xF000, 0);      
 
-                material_names.emplace(values);
-            }
+            normal_prefix += chunk->normals.count;
+            tex_coord_prefix += chunk->tex_coords.count;
+
+            chunk->positions.free_data();
+            chunk->normals.free_data();
+            chunk->tex_coords.free_data();
+            chunk->faces.free_data();
+            chunk->directives.free_data();
+            chunk->pending_faces.free_data();
 
-            line_number++;
         }
 
         for (uint32 i = 0; i < groups.count; i++)
@@ -339,7 +504,7 @@ namespace ResourceSystem
                 
             CString::copy(material_names[i].c_str(), new_data->material_name, Constants::max_material_name_length);
 
-            process_subobject(positions, normals, tex_coords, groups[i].faces, &new_data->geometry_data);
+            process_subobject(positions, normals, tex_coords, groups[i].faces, normals.count == 0, tex_coords.count == 0, &new_data->geometry_data);
 
             groups[i].faces.free_data();
         }
@@ -366,6 +531,8 @@ namespace ResourceSystem
 
             geometry_resource_deduplicate_vertices(g);
             Renderer::geometry_generate_tangents<Renderer::Vertex3D>(g->vertex_count, (Renderer::Vertex3D*)g->vertices.data, g->index_count, g->indices.data);
+            geometry_resource_optimize(g);
+            geometry_resource_generate_lods(g);
 
             // TODO: Maybe shrink down vertex array to count after deduplication!
         }
@@ -375,7 +542,229 @@ namespace ResourceSystem
 
     }
 
-    static void process_subobject(const Darray<Math::Vec3f>& positions, const Darray<Math::Vec3f>& normals, const Darray<Math::Vec2f>& tex_coords, const Darray<MeshFaceData>& faces, GeometryResourceData* out_data)
+    static void obj_parse_claimed_chunks(ObjParseContext* context)
+    {
+        while (true)
+        {
+            uint32 chunk_index = Threading::atomic_increment(&context->next_chunk) - 1;
+            if (chunk_index >= context->chunk_count)
+                break;
+
+            obj_parse_chunk(&context->chunks[chunk_index], chunk_index > 0);
+            if (Threading::atomic_increment(&context->completed_count) == context->chunk_count)
+                Threading::atomic_wake_all(&context->completed_count);
+        }
+    }
+
+    static void obj_parse_context_release(ObjParseContext* context)
+    {
+        if (!Threading::atomic_decrement(&context->ref_count))
+            Memory::free_memory(context);
+    }
+
+    static bool8 obj_parse_job(uint32 thread_index, void* user_data)
+    {
+        ObjParseJobParams* params = (ObjParseJobParams*)user_data;
+        obj_parse_claimed_chunks(params->context);
+        obj_parse_context_release(params->context);
+        return true;
+    }
+
+    static void obj_parse_chunks(ObjParseChunk* chunks, uint32 chunk_count)
+    {
+
+        ObjParseContext* context = (ObjParseContext*)Memory::allocate(sizeof(ObjParseContext), AllocationTag::Resource);
+        context->chunks = chunks;
+        context->chunk_count = chunk_count;
+        context->next_chunk = 0;
+        context->completed_count = 0;
+
+        uint32 helper_count = SHMIN(chunk_count - 1, JobSystem::get_thread_count());
+        context->ref_count = helper_count + 1;
+
+        // NOTE: High priority hands the helpers straight to idle threads. Chunks nobody picked up yet get parsed on this thread, so it never waits on the queue.
+        for (uint32 i = 0; i < helper_count; i++)
+        {
+            JobSystem::JobInfo job = JobSystem::job_create(obj_parse_job, 0, 0, sizeof(ObjParseJobParams), JobSystem::JobTypeFlags::General, JobSystem::JobPriority::High);
+            ObjParseJobParams* params = (ObjParseJobParams*)job.user_data;
+            params->context = context;
+            JobSystem::submit(job);
+        }
+
+        obj_parse_claimed_chunks(context);
+
+        uint32 completed_count;
+        while ((completed_count = Threading::atomic_load(&context->completed_count)) < chunk_count)
+            Threading::atomic_wait(&context->completed_count, completed_count);
+
+        obj_parse_context_release(context);
+
+    }
+
+    static bool8 obj_identifier_equals(const char* identifier, uint32 identifier_length, const char* s)
+    {
+        for (uint32 i = 0; i < identifier_length; i++)
+        {
+            if (identifier[i] != s[i])
+                return false;
+        }
+
+        return !s[identifier_length];
+    }
+
+    static void obj_parse_chunk(ObjParseChunk* chunk, bool8 has_previous_chunks)
+    {
+
+        uint32 reserve_count = (uint32)(chunk->end - chunk->begin) / 32 + 1;
+        chunk->positions.init(reserve_count, 0);
+        chunk->normals.init(reserve_count, 0);
+        chunk->tex_coords.init(reserve_count, 0);
+        chunk->faces.init(reserve_count, 0);
+        chunk->directives.init(16, 0);
+        chunk->pending_faces.init(16, 0);
+
+        char* line = chunk->begin;
+        while (line < chunk->end)
+        {
+
+            char* line_end = line;
+            while (line_end < chunk->end && *line_end != '\n')
+                line_end++;
+
+            char* next_line = line_end + 1;
+            *line_end = 0;
+
+            if (!line[0] || line[0] == '#')
+            {
+                line = next_line;
+                continue;
+            }
+
+            char* first_space = line;
+            while (first_space < line_end && *first_space != ' ')
+                first_space++;
+
+            if (first_space == line_end)
+            {
+                line = next_line;
+                continue;
+            }
+
+            // NOTE: Trimmed in place, same as the identifier and values strings of the sequential parser.
+            char* identifier = line;
+            char* identifier_end = first_space;
+            while (identifier < identifier_end && CString::is_whitespace(*identifier))
+                identifier++;
+            while (identifier_end > identifier && CString::is_whitespace(identifier_end[-1]))
+                identifier_end--;
+
+            char* values = first_space + 1;
+            char* values_end = line_end;
+            while (values < values_end && CString::is_whitespace(*values))
+                values++;
+            while (values_end > values && CString::is_whitespace(values_end[-1]))
+                values_end--;
+            *values_end = 0;
+
+            uint32 identifier_length = (uint32)(identifier_end - identifier);
+            line = next_line;
+
+            if (!identifier_length)
+                continue;
+
+            if (obj_identifier_equals(identifier, identifier_length, "v"))
+            {
+                Math::Vec3f pos;
+                CString::parse(values, &pos);
+                chunk->positions.emplace(pos);
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "vn"))
+            {
+                Math::Vec3f norm;
+                CString::parse(values, &norm);
+                chunk->normals.emplace(norm);
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "vt"))
+            {
+                Math::Vec2f tex_c;
+                CString::parse(values, &tex_c);
+                chunk->tex_coords.emplace(tex_c);
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "f"))
+            {
+                MeshFaceData* face = &chunk->faces[chunk->faces.emplace()];
+                bool8 indexed_attributes = chunk->normals.count && chunk->tex_coords.count;
+                obj_parse_face(values, indexed_attributes, face);
+
+                if (!indexed_attributes && has_previous_chunks)
+                    chunk->pending_faces.push({ chunk->faces.count - 1, chunk->normals.count, chunk->tex_coords.count, values });
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "mtllib"))
+            {
+                chunk->directives.push({ ObjDirectiveType::MaterialLib, chunk->faces.count, chunk->normals.count, chunk->tex_coords.count, values });
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "g"))
+            {
+                chunk->directives.push({ ObjDirectiveType::Group, chunk->faces.count, chunk->normals.count, chunk->tex_coords.count, values });
+            }
+            else if (obj_identifier_equals(identifier, identifier_length, "usemtl"))
+            {
+                chunk->directives.push({ ObjDirectiveType::UseMaterial, chunk->faces.count, chunk->normals.count, chunk->tex_coords.count, values });
+            }
+
+        }
+
+    }
+
+    // NOTE: Reads the first three vertices of a face. Anything the fast path does not handle goes through the scanner, like it always did.
+    static bool8 obj_parse_face(const char* values, bool8 indexed_attributes, MeshFaceData* out_face)
+    {
+
+        *out_face = {};
+
+        const char* cursor = values;
+        bool8 valid = true;
+        for (uint32 v = 0; v < 3 && valid; v++)
+        {
+            MeshVertexIndexData* vertex = &out_face->vertices[v];
+
+            if (v > 0)
+                valid = *cursor++ == ' ';
+
+            valid = valid && *cursor != ' ' && *cursor != '\t' && CString::parse_next(cursor, &vertex->position_index);
+            if (indexed_attributes)
+            {
+                valid = valid && *cursor++ == '/' && *cursor != ' ' && *cursor != '\t' && CString::parse_next(cursor, &vertex->texcoord_index);
+                valid = valid && *cursor++ == '/' && *cursor != ' ' && *cursor != '\t' && CString::parse_next(cursor, &vertex->normal_index);
+            }
+        }
+
+        if (valid && (!*cursor || CString::is_whitespace(*cursor)))
+            return true;
+
+        *out_face = {};
+        if (!indexed_attributes)
+        {
+            return CString::scan(values, "%u %u %u",
+                &out_face->vertices[0].position_index,
+                &out_face->vertices[1].position_index,
+                &out_face->vertices[2].position_index);
+        }
+
+        return CString::scan(values, "%u/%u/%u %u/%u/%u %u/%u/%u",
+            &out_face->vertices[0].position_index,
+            &out_face->vertices[0].texcoord_index,
+            &out_face->vertices[0].normal_index,
+            &out_face->vertices[1].position_index,
+            &out_face->vertices[1].texcoord_index,
+            &out_face->vertices[1].normal_index,
+            &out_face->vertices[2].position_index,
+            &out_face->vertices[2].texcoord_index,
+            &out_face->vertices[2].normal_index);
+
+    }
+
+    static void process_subobject(const Darray<Math::Vec3f>& positions, const Darray<Math::Vec3f>& normals, const Darray<Math::Vec2f>& tex_coords, const Darray<MeshFaceData>& faces, bool8 skip_normals, bool8 skip_tex_coords, GeometryResourceData* out_data)
     {
 
         out_data->vertex_count = 0;
@@ -387,9 +776,6 @@ namespace ResourceSystem
         Darray<Renderer::Vertex3D> vertices(faces.count * 3, 0);
         Darray<uint32> indices(faces.count * 3, 0);
 
-        bool8 skip_normals = normals.count == 0;
-        bool8 skip_tex_coords = tex_coords.count == 0;
-
         if (skip_normals)
             SHMWARN("No normals found for mesh!");
 
@@ -487,7 +873,7 @@ namespace ResourceSystem
         uint32 written = 0;
 
         ShmeshFileHeader file_header = {};
-        file_header.version = 1;
+        file_header.version = shmesh_file_version;
         file_header.name_length = (uint16)CString::length(name);
         file_header.geometry_count = resource->geometries.count;
 
@@ -506,6 +892,37 @@ namespace ResourceSystem
             MeshGeometryResourceData& config = resource->geometries[i];
             GeometryResourceData& g_data = config.geometry_data;
 
+            ShmeshFileGeometryStreams streams = {};
+            streams.stream_vertex_size = g_data.vertex_size;
+            const void* stream_vertices = g_data.vertices.data;
+
+            Sarray<Renderer::QuantizedVertex3D> quantized_vertices;
+            if (g_data.vertex_size == sizeof(Renderer::Vertex3D))
+            {
+                quantized_vertices.init(g_data.vertex_count, 0);
+                Renderer::vertex3d_quantize((Renderer::Vertex3D*)g_data.vertices.data, g_data.vertex_count, g_data.extents, quantized_vertices.data);
+                stream_vertices = quantized_vertices.data;
+                streams.stream_vertex_size = sizeof(Renderer::QuantizedVertex3D);
+            }
+
+            Sarray<byte> vertex_stream((uint32)Renderer::vertex_buffer_encode_bound(g_data.vertex_count, streams.stream_vertex_size), 0);
+            streams.vertex_stream_size = (uint32)Renderer::vertex_buffer_encode(stream_vertices, g_data.vertex_count, streams.stream_vertex_size, vertex_stream.data, vertex_stream.capacity);
+            Sarray<byte> index_stream((uint32)Renderer::index_buffer_encode_bound(g_data.index_count), 0);
+            streams.index_stream_size = (uint32)Renderer::index_buffer_encode(g_data.indices.data, g_data.index_count, index_stream.data, index_stream.capacity);
+            quantized_vertices.free_data();
+
+            if (!streams.vertex_stream_size || !streams.index_stream_size)
+            {
+                SHMERRORV("Failed to encode vertex and index data of geometry '%s'.", g_data.name);
+                FileSystem::file_close(&f);
+                return false;
+            }
+
+            ShmeshFileGeometryLods lods = {};
+            lods.lod_count = g_data.lod_count;
+            for (uint32 lod = 0; lod < g_data.lod_count; lod++)
+                lods.lods[lod] = g_data.lods[lod];
+
             ShmeshFileGeometryHeader geo_header = {};
             geo_header.center = g_data.center;
             geo_header.min_extents = g_data.extents.min;
@@ -517,23 +934,29 @@ namespace ResourceSystem
             geo_header.name_length = (uint16)CString::length(g_data.name);
             geo_header.material_name_length = (uint16)CString::length(config.material_name);
 
-            geo_header.name_offset = sizeof(geo_header);
+            geo_header.name_offset = sizeof(geo_header) + sizeof(streams) + sizeof(lods);
             geo_header.material_name_offset = geo_header.name_offset + geo_header.name_length;
             geo_header.vertices_indices_offset = geo_header.material_name_offset + geo_header.material_name_length;
 
             FileSystem::write(&f, sizeof(geo_header), &geo_header, &written);
             written_total += written;
 
+            FileSystem::write(&f, sizeof(streams), &streams, &written);
+            written_total += written;
+
+            FileSystem::write(&f, sizeof(lods), &lods, &written);
+            written_total += written;
+
             FileSystem::write(&f, geo_header.name_length, g_data.name, &written);
             written_total += written;
 
             FileSystem::write(&f, geo_header.material_name_length, config.material_name, &written);
             written_total += written;
 
-            FileSystem::write(&f, geo_header.vertex_size * geo_header.vertex_count, g_data.vertices.data, &written);
+            FileSystem::write(&f, streams.vertex_stream_size, vertex_stream.data, &written);
             written_total += written;
 
-            FileSystem::write(&f, geo_header.index_size * geo_header.index_count, g_data.indices.data, &written);
+            FileSystem::write(&f, streams.index_stream_size, index_stream.data, &written);
             written_total += written;
         }
 
@@ -543,28 +966,26 @@ namespace ResourceSystem
 
     }
 
-
-
     static bool8 load_shmesh_file(FileSystem::FileHandle* shmesh_file, const char* shmesh_filepath, MeshResourceData* out_resource)
     {
 
-        uint32 file_size = FileSystem::get_file_size32(shmesh_file);
-        Buffer file_content(file_size, 0);
-        uint32 bytes_read = 0;
-        if (!FileSystem::read_all_bytes(shmesh_file, file_content.data, (uint32)file_content.size, &bytes_read))
+        // NOTE: The file gets mapped instead of read, so encoded streams decode straight from the page cache without a staging copy.
+        // Referencing geometry data in place only applies to raw files from before the encoded stream version.
+        FileSystem::FileMapping* mapping = &out_resource->file_mapping;
+        if (!FileSystem::map_file(shmesh_file, mapping))
         {
-            SHMERRORV("load_shmesh_file - failed to read from file: '%s'.", shmesh_filepath);
+            SHMERRORV("load_shmesh_file - failed to map file: '%s'.", shmesh_filepath);
             return false;
         }
 
         SHMTRACEV("Importing shmesh file: '%s'.", shmesh_filepath);
 
-        uint8* read_ptr = (uint8*)file_content.data;
+        uint8* read_ptr = (uint8*)mapping->data;
         uint64 read_bytes = 0;
 
-        auto check_buffer_size = [&read_bytes, &file_content](uint64 requested_size)
+        auto check_buffer_size = [&read_bytes, mapping](uint64 requested_size)
             {
-                SHMASSERT_MSG(read_bytes + requested_size <= file_content.size, "Tried to read outside of buffers memory! File formatting might be corrupted.")
+                SHMASSERT_MSG(read_bytes + requested_size <= mapping->size, "Tried to read outside of buffers memory! File formatting might be corrupted.")
             };
 
         check_buffer_size(sizeof(ShmeshFileHeader));
@@ -572,8 +993,6 @@ namespace ResourceSystem
         read_bytes += sizeof(ShmeshFileHeader);
 
         check_buffer_size(file_header->name_length);
-        String name;
-        name.copy_n((char*)&read_ptr[read_bytes], (uint32)file_header->name_length);
         read_bytes += file_header->name_length;
 
         for (uint32 i = 0; i < file_header->geometry_count; i++)
@@ -581,9 +1000,9 @@ namespace ResourceSystem
             MeshGeometryResourceData* config = &out_resource->geometries[out_resource->geometries.emplace()];
             GeometryResourceData* g = &config->geometry_data;
 
+            uint64 geo_start = read_bytes;
             check_buffer_size(sizeof(ShmeshFileGeometryHeader));
             ShmeshFileGeometryHeader* geo_header = (ShmeshFileGeometryHeader*)&read_ptr[read_bytes];
-            read_bytes += sizeof(*geo_header);
 
             g->center = geo_header->center;
             g->extents.min = geo_header->min_extents;
@@ -592,32 +1011,99 @@ namespace ResourceSystem
             g->vertex_count = geo_header->vertex_count;
             g->index_count = geo_header->index_count;
 
-            check_buffer_size(
-                (geo_header->name_length +
-                geo_header->material_name_length +
-                (geo_header->vertex_count * geo_header->vertex_size) +
-                (geo_header->index_count * geo_header->index_size))
-            );
+            uint64 vertices_size = (uint64)geo_header->vertex_count * geo_header->vertex_size;
+            uint64 indices_size = (uint64)geo_header->index_count * geo_header->index_size;
 
-            g->vertices.init(g->vertex_count * g->vertex_size, 0);
-            g->indices.init(g->index_count, 0);
+            ShmeshFileGeometryStreams* streams = 0;
+            if (file_header->version >= shmesh_file_version_encoded_streams)
+            {
+                check_buffer_size(sizeof(ShmeshFileGeometryHeader) + sizeof(ShmeshFileGeometryStreams));
+                streams = (ShmeshFileGeometryStreams*)&read_ptr[read_bytes + sizeof(ShmeshFileGeometryHeader)];
+                check_buffer_size(geo_header->vertices_indices_offset + (uint64)streams->vertex_stream_size + streams->index_stream_size);
+            }
 
-            CString::copy((char*)&read_ptr[read_bytes], g->name, Constants::max_geometry_name_length, (int32)geo_header->name_length);
-            read_bytes += geo_header->name_length;
+            g->lod_count = 0;
+            if (file_header->version >= shmesh_file_version_lods)
+            {
+                check_buffer_size(sizeof(ShmeshFileGeometryHeader) + sizeof(ShmeshFileGeometryStreams) + sizeof(ShmeshFileGeometryLods));
+                ShmeshFileGeometryLods* lods = (ShmeshFileGeometryLods*)&read_ptr[read_bytes + sizeof(ShmeshFileGeometryHeader) + sizeof(ShmeshFileGeometryStreams)];
+                g->lod_count = lods->lod_count <= Constants::max_geometry_lod_count ? lods->lod_count : 0;
+                for (uint32 lod = 0; lod < g->lod_count; lod++)
+                    g->lods[lod] = lods->lods[lod];
+            }
+            else if (!streams)
+            {
+                check_buffer_size(geo_header->vertices_indices_offset + vertices_size + indices_size);
+            }
 
-            CString::copy((char*)&read_ptr[read_bytes], config->material_name, Constants::max_material_name_length, (int32)geo_header->material_name_length);
-            read_bytes += geo_header->material_name_length;
+            CString::copy((char*)&read_ptr[geo_start + geo_header->name_offset], g->name, Constants::max_geometry_name_length, (int32)geo_header->name_length);
+            CString::copy((char*)&read_ptr[geo_start + geo_header->material_name_offset], config->material_name, Constants::max_material_name_length, (int32)geo_header->material_name_length);
 
-            g->vertices.copy_memory(&read_ptr[read_bytes], geo_header->vertex_count * geo_header->vertex_size, 0);
-            read_bytes += geo_header->vertex_count * geo_header->vertex_size;
+            read_bytes = geo_start + geo_header->vertices_indices_offset;
 
-            g->indices.copy_memory(&read_ptr[read_bytes], g->index_count, 0);
-            read_bytes += geo_header->index_count * geo_header->index_size;
+            if (streams)
+            {
+                uint8* vertex_stream = &read_ptr[read_bytes];
+                uint8* index_stream = vertex_stream + streams->vertex_stream_size;
+                read_bytes += (uint64)streams->vertex_stream_size + streams->index_stream_size;
+
+                if (!decode_geometry_streams(geo_header, streams, vertex_stream, index_stream, g))
+                {
+                    SHMERRORV("load_shmesh_file - failed to decode geometry '%s' in file: '%s'.", g->name, shmesh_filepath);
+                    return false;
+                }
+                continue;
+            }
+
+            uint8* vertices = &read_ptr[read_bytes];
+            uint8* indices = vertices + vertices_size;
+            read_bytes += vertices_size + indices_size;
+
+            // NOTE: Raw legacy geometry, referenced in place. Version 1 files were written without padding, their data only gets referenced if it happens to be aligned.
+            if (((uint64)vertices | (uint64)indices) & (sizeof(uint32) - 1))
+            {
+                g->vertices.init((uint32)vertices_size, 0);
+                g->vertices.copy_memory(vertices, (uint32)vertices_size, 0);
+                g->indices.init(g->index_count, 0);
+                g->indices.copy_memory(indices, g->index_count, 0);
+            }
+            else
+            {
+                g->vertices.init((uint32)vertices_size, 0, AllocationTag::Resource, vertices);
+                g->indices.init(g->index_count, 0, AllocationTag::Resource, indices);
+            }
         }
 
+        // NOTE: Decoded geometries do not reference the file anymore.
+        if (file_header->version >= shmesh_file_version_encoded_streams)
+            FileSystem::unmap_file(mapping);
+
         return true;
     }   
 
+    static bool8 decode_geometry_streams(const ShmeshFileGeometryHeader* geo_header, const ShmeshFileGeometryStreams* streams, const uint8* vertex_stream, const uint8* index_stream, GeometryResourceData* g)
+    {
+        bool8 quantized = streams->stream_vertex_size != geo_header->vertex_size;
+        if (quantized && (streams->stream_vertex_size != sizeof(Renderer::QuantizedVertex3D) || geo_header->vertex_size != sizeof(Renderer::Vertex3D)))
+            return false;
+
+        g->vertices.init(geo_header->vertex_count * geo_header->vertex_size, 0, AllocationTag::Resource);
+        g->indices.init(geo_header->index_count, 0, AllocationTag::Resource);
+
+        if (!Renderer::index_buffer_decode(index_stream, streams->index_stream_size, geo_header->index_count, geo_header->vertex_count, g->indices.data))
+            return false;
+
+        if (!quantized)
+            return Renderer::vertex_buffer_decode(vertex_stream, streams->vertex_stream_size, geo_header->vertex_count, streams->stream_vertex_size, g->vertices.data);
+
+        Sarray<Renderer::QuantizedVertex3D> quantized_vertices(geo_header->vertex_count, 0);
+        if (!Renderer::vertex_buffer_decode(vertex_stream, streams->vertex_stream_size, geo_header->vertex_count, streams->stream_vertex_size, quantized_vertices.data))
+            return false;
+
+        Renderer::vertex3d_dequantize(quantized_vertices.data, geo_header->vertex_count, g->extents, (Renderer::Vertex3D*)g->vertices.data);
+        return true;
+    }
+
     static bool8 vertex3d_equal(Renderer::Vertex3D vert_0, Renderer::Vertex3D vert_1) 
     {
         return 
@@ -676,4 +1162,73 @@ namespace ResourceSystem
         SHMDEBUGV("geometry_deduplicate_vertices: removed %u vertices, orig/now %u/%u.", removed_count, old_vertex_count, geo->vertex_count);
     }
 
+    static void geometry_resource_optimize(GeometryResourceData* geo)
+    {
+
+        if (!geo->index_count || !geo->vertex_count)
+            return;
+
+        float32 acmr_before = Renderer::mesh_analyze_vertex_cache(geo->indices.data, geo->index_count, geo->vertex_count);
+
+        Sarray<uint32> optimized_indices(geo->index_count, 0, (AllocationTag)geo->indices.allocation_tag);
+        Renderer::mesh_optimize_vertex_cache(optimized_indices.data, geo->indices.data, geo->index_count, geo->vertex_count);
+        Renderer::mesh_optimize_overdraw(optimized_indices.data, geo->index_count, geo->vertices.data, geo->vertex_count, geo->vertex_size);
+        geo->vertex_count = Renderer::mesh_optimize_vertex_fetch(geo->vertices.data, optimized_indices.data, geo->index_count, geo->vertex_count, geo->vertex_size);
+
+        geo->indices.free_data();
+        geo->indices.steal(optimized_indices);
+
+        float32 acmr_after = Renderer::mesh_analyze_vertex_cache(geo->indices.data, geo->index_count, geo->vertex_count);
+        SHMDEBUGV("geometry_optimize: ACMR of '%s' before/after %f3/%f3.", geo->name, acmr_before, acmr_after);
+
+    }
+
+    static void geometry_resource_generate_lods(GeometryResourceData* geo)
+    {
+
+        geo->lod_count = 1;
+        geo->lods[0] = { 0, geo->index_count, 0.0f };
+
+        if (!geo->index_count || geo->vertex_size != sizeof(Renderer::Vertex3D))
+            return;
+
+        // NOTE: Sized for lods halving their predecessor. Lods only need to undercut mesh_lod_min_reduction though, so the array grows when they fall short.
+        Sarray<uint32> lod_indices(geo->index_count * 2, 0, (AllocationTag)geo->indices.allocation_tag);
+        lod_indices.copy_memory(geo->indices.data, geo->index_count, 0);
+        uint32 total_index_count = geo->index_count;
+
+        Sarray<uint32> simplified(geo->index_count, 0);
+        uint32 previous_index_count = geo->index_count;
+        for (uint32 lod = 1; lod < Constants::max_geometry_lod_count; lod++)
+        {
+            uint32 target_index_count = (uint32)(previous_index_count * mesh_lod_reduction) / 3 * 3;
+            float32 error = 0.0f;
+            uint32 index_count = Renderer::mesh_simplify(simplified.data, geo->indices.data, geo->index_count, geo->vertices.data, geo->vertex_count, geo->vertex_size,
+                target_index_count, mesh_lod_max_error, sizeof(Math::Vec3f), 5, mesh_lod_attribute_weights, &error);
+
+            if (!index_count || index_count > previous_index_count * mesh_lod_min_reduction)
+                break;
+
+            if (total_index_count + index_count > lod_indices.capacity)
+            {
+                uint32 new_capacity = lod_indices.capacity + lod_indices.capacity / 2;
+                lod_indices.resize(new_capacity > total_index_count + index_count ? new_capacity : total_index_count + index_count);
+            }
+
+            Renderer::mesh_optimize_vertex_cache(&lod_indices[total_index_count], simplified.data, index_count, geo->vertex_count);
+            geo->lods[lod] = { total_index_count, index_count, error };
+            geo->lod_count++;
+
+            SHMDEBUGV("geometry_generate_lods: lod %u of '%s' has %u/%u indices, error %f3.", lod, geo->name, index_count, geo->index_count, error);
+
+            total_index_count += index_count;
+            previous_index_count = index_count;
+        }
+
+        geo->indices.free_data();
+        geo->indices.steal(lod_indices);
+        geo->index_count = total_index_count;
+
+    }
+
 }
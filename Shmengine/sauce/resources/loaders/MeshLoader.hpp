@@ -5,6 +5,7 @@
 #include "utility/MathTypes.hpp"
 #include "utility/String.hpp"
 #include "renderer/RendererTypes.hpp"
+#include "platform/FileSystem.hpp"
 
 struct MeshGeometryConfig;
 
@@ -19,6 +20,10 @@ struct MeshResourceData
 	Darray<MeshGeometryResourceData> geometries;
 
 	Sarray<MeshGeometryConfig> mesh_geometry_configs;
+
+	// NOTE: Only raw (version 1 and 2) .shmesh files keep their geometry data pointing into this mapping until the resource is unloaded.
+	// The cooker writes encoded streams, those get decoded straight from the mapping into owned buffers and the file is unmapped right after.
+	FileSystem::FileMapping file_mapping;
 };
 
 namespace ResourceSystem
@@ -26,5 +31,10 @@ namespace ResourceSystem
 	bool8 mesh_loader_load(const char* name, MeshResourceData* out_resource);
 	void mesh_loader_unload(MeshResourceData* resource);
 
+	// NOTE: Imports the .obj file and writes its .shmesh file, without keeping the geometry around.
+	bool8 mesh_loader_cook(const char* name);
+	// NOTE: Changes whenever the importer would write a different .shmesh file from the same source.
+	uint64 mesh_loader_get_cook_settings_hash();
+
 	MeshConfig mesh_loader_get_config_from_resource(const char* name, MeshResourceData* resource);
 }
\ No newline at end of file
@@ -5,22 +5,149 @@
 #include "core/Logging.hpp"
 #include "core/Memory.hpp"
 #include "utility/String.hpp"
+#include "utility/ConfigTokenizer.hpp"
 #include "platform/FileSystem.hpp"
+#include "platform/Platform.hpp"
+#include "utility/Utility.hpp"
+#include "systems/CookSystem.hpp"
+#include "renderer/RendererFrontend.hpp"
+#include "GenericLoader.hpp"
+
+// NOTE: Attribute, uniform and stage records keep their in-memory layout, the header stores their sizes to catch layout changes.
+// Stage code follows the records, every stage starting on a 4 byte boundary as spir-v gets read in words.
+struct ShmshaderFileHeader
+{
+    uint32 magic;
+    uint16 version;
+    uint16 attribute_record_size;
+    uint16 uniform_record_size;
+    uint16 stage_record_size;
+    uint8 cull_mode;
+    uint8 topologies;
+    bool8 depth_test;
+    bool8 depth_write;
+    char name[Constants::max_shader_name_length];
+    uint32 attributes_count;
+    uint32 attributes_offset;
+    uint32 uniforms_count;
+    uint32 uniforms_offset;
+    uint32 stages_count;
+    uint32 stages_offset;
+    uint64 uniform_lookup_seed;
+    uint32 uniform_lookup_slot_count;
+    uint32 uniform_lookup_offset;
+};
+
+struct ShmshaderStageRecord
+{
+    ShaderStage::Value stage;
+    char filename[Constants::max_filename_length];
+    uint32 code_offset;
+    uint32 code_size;
+};
+
+static const uint32 shmshader_magic = 0x44485353; // "SSHD"
+static const uint16 shmshader_file_version = 1;
 
 namespace ResourceSystem
 {
 
     static const char* loader_type_path = "shaders/configs/";
+    static const char* cooked_type_path = "shaders/bin/";
+
+    static bool8 load_shadercfg_file(const char* full_filepath, ShaderResourceData* out_resource);
+    static bool8 write_shmshader_file(const char* full_filepath, ShaderResourceData* resource);
+    static bool8 load_shmshader_file(const char* full_filepath, ShaderResourceData* out_resource);
+
+    // NOTE: Same invocation post-build.bat uses. Includes get resolved relative to the source file.
+    static const char* stage_compiler_path = "%VULKAN_SDK%\\bin\\glslc.exe";
+    static const char* stage_compile_command = "\"%s\" -fshader-stage=%s \"%s\" -o \"%s\"";
+
+    static const uint32 max_list_fields = 16;
+
+    // NOTE: Splits a comma separated value in place. Stops after max_count fields, so passing one more than expected detects surplus fields.
+    static uint32 split_list(char* list, char** out_fields, uint32 max_count)
+    {
+        uint32 count = 0;
+        char* cursor = list;
+        while (count < max_count && (out_fields[count] = ConfigTokenizer::split_next(&cursor, ',')) != 0)
+            count++;
+
+        return count;
+    }
+
+    static void get_shader_filepath(const char* name, const char* type_path, const char* extension, char* out_filepath)
+    {
+        CString::safe_print_s<const char*, const char*, const char*, const char*>
+            (out_filepath, Constants::max_filepath_length, "%s%s%s%s", Engine::get_assets_base_path(), type_path, name, extension);
+    }
 
 	bool8 shader_loader_load(const char* name, ShaderResourceData* out_resource)
 	{
 
-        using namespace Renderer;
-        const char* format = "%s%s%s%s";
+        // NOTE: Only trusted once cooked, the embedded stages would go stale whenever a stage gets recompiled on its own.
+        char shmshader_filepath[Constants::max_filepath_length];
+        get_shader_filepath(name, cooked_type_path, ".shmshader", shmshader_filepath);
+        if (CookSystem::is_cooked(shmshader_filepath))
+        {
+            if (load_shmshader_file(shmshader_filepath, out_resource))
+                return true;
+
+            SHMWARNV("Failed to load cooked shader '%s'. Falling back to the config file.", shmshader_filepath);
+        }
+
         char full_filepath[Constants::max_filepath_length];
+        get_shader_filepath(name, loader_type_path, ".shadercfg", full_filepath);
+        return load_shadercfg_file(full_filepath, out_resource);
 
-        CString::safe_print_s<const char*, const char*, const char*, const char*>
-            (full_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, name, ".shadercfg");
+    }
+
+    bool8 shader_loader_cook(const char* name)
+    {
+        char shadercfg_filepath[Constants::max_filepath_length];
+        char shmshader_filepath[Constants::max_filepath_length];
+        get_shader_filepath(name, loader_type_path, ".shadercfg", shadercfg_filepath);
+        get_shader_filepath(name, cooked_type_path, ".shmshader", shmshader_filepath);
+
+        ShaderResourceData resource = {};
+        bool8 res = load_shadercfg_file(shadercfg_filepath, &resource) &&
+            Renderer::shader_build_uniform_lookup(resource.uniforms.count, resource.uniforms.data, &resource.uniform_lookup_seed, &resource.uniform_lookup) &&
+            write_shmshader_file(shmshader_filepath, &resource);
+        shader_loader_unload(&resource);
+        return res;
+    }
+
+    uint64 shader_loader_get_cook_settings_hash(const char* name)
+    {
+        uint16 record_sizes[3] = { (uint16)sizeof(ShaderAttributeConfig), (uint16)sizeof(ShaderUniformConfig), (uint16)sizeof(ShmshaderStageRecord) };
+        uint64 hash = hash_fnv1a64(&shmshader_file_version, sizeof(shmshader_file_version), shader_loader_get_compile_settings_hash());
+        hash = hash_fnv1a64(record_sizes, sizeof(record_sizes), hash);
+
+        // NOTE: The stages are outputs of other cooks rather than dependencies of the config file, so their content goes in here.
+        char shadercfg_filepath[Constants::max_filepath_length];
+        get_shader_filepath(name, loader_type_path, ".shadercfg", shadercfg_filepath);
+        ShaderResourceData resource = {};
+        if (load_shadercfg_file(shadercfg_filepath, &resource))
+        {
+            for (uint32 i = 0; i < resource.stages.count; i++)
+            {
+                Buffer code = {};
+                if (ResourceSystem::generic_loader_load(resource.stages[i].filename, &code))
+                    hash = hash_fnv1a64(code.data, code.size, hash);
+                else
+                    hash = hash_fnv1a64(resource.stages[i].filename, CString::length(resource.stages[i].filename), hash);
+                ResourceSystem::generic_loader_unload(&code);
+            }
+        }
+        shader_loader_unload(&resource);
+
+        return hash;
+    }
+
+	static bool8 load_shadercfg_file(const char* full_filepath, ShaderResourceData* out_resource)
+	{
+
+        using namespace Renderer;
 
         FileSystem::FileHandle f;
         if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
@@ -44,200 +171,168 @@ namespace ResourceSystem
         out_resource->uniforms.init(1, 0);
         out_resource->stages.init(1, 0);
 
-        String var_name(512);
-        String value(512);
-        String line(512);
-        uint32 line_number = 1;
+        char* content = file_content.c_str_vulnerable();
+        content[bytes_read] = 0;
 
-        const char* continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
+        ConfigTokenizer tokenizer(content, bytes_read, full_filepath);
+        ConfigToken token;
+        while (tokenizer.next(&token))
         {
-
-            line.trim();
-
-            if (line.len() < 1 || line[0] == '#') {
-                line_number++;
+            if (token.type != ConfigToken::Type::Property)
                 continue;
-            }
-
-            int32 equal_index = line.index_of('=');
-            if (equal_index == -1) {
-                SHMWARNV("Potential formatting issue found in file '%s': '=' token not found. Skipping line %u.", full_filepath, line_number);
-                line_number++;
-                continue;
-            }
 
-            mid(var_name, line.c_str(), 0, equal_index);
-            var_name.trim();
-
-            mid(value, line.c_str(), equal_index + 1);
-            value.trim();
-
-            if (var_name.equal_i("version")) 
+            if (CString::equal_i(token.name, "version")) 
             {
                 // TODO: version
             }
-            else if (var_name.equal_i("name")) 
+            else if (CString::equal_i(token.name, "name")) 
             {
-                CString::copy(value.c_str(), out_resource->name, Constants::max_shader_name_length) ;
+                CString::copy(token.value, out_resource->name, Constants::max_shader_name_length) ;
             }
-            else if (var_name.equal_i("renderpass")) 
+            else if (CString::equal_i(token.name, "renderpass")) 
             {
                 //out_config->renderpass_name = value;
             }
-            else if (var_name.equal_i("depth_test")) 
+            else if (CString::equal_i(token.name, "depth_test")) 
             {
-                 CString::parse(value.c_str(), &out_resource->depth_test);
+                 CString::parse(token.value, &out_resource->depth_test);
             }
-            else if (var_name.equal_i("depth_write")) 
+            else if (CString::equal_i(token.name, "depth_write")) 
             {
-                CString::parse(value.c_str(), &out_resource->depth_write);
+                CString::parse(token.value, &out_resource->depth_write);
             }
-            else if (var_name.equal_i("stages")) 
+            else if (CString::equal_i(token.name, "stages")) 
             {
-                Darray<String> stage_names;
-                value.split(stage_names, ',');
+                char* stage_names[max_list_fields];
+                uint32 stage_name_count = split_list(token.value, stage_names, max_list_fields);
 
                 if (!out_resource->stages.capacity)
-                    out_resource->stages.init(stage_names.count, 0, AllocationTag::Resource);
-                else if (stage_names.count > out_resource->stages.capacity)
-                    out_resource->stages.resize(stage_names.count);
+                    out_resource->stages.init(stage_name_count, 0, AllocationTag::Resource);
+                else if (stage_name_count > out_resource->stages.capacity)
+                    out_resource->stages.resize(stage_name_count);
                 
-                if (stage_names.count > out_resource->stages.count)
-                    out_resource->stages.set_count(stage_names.count);
+                if (stage_name_count > out_resource->stages.count)
+                    out_resource->stages.set_count(stage_name_count);
 
-                for (uint32 i = 0; i < stage_names.count; i++)
+                for (uint32 i = 0; i < stage_name_count; i++)
                 {
-                    stage_names[i].trim();
-                    if (stage_names[i].equal_i("frag") || stage_names[i].equal_i("fragment"))
+                    if (CString::equal_i(stage_names[i], "frag") || CString::equal_i(stage_names[i], "fragment"))
                         out_resource->stages[i].stage = ShaderStage::Fragment;
-                    else if (stage_names[i].equal_i("vert") || stage_names[i].equal_i("vertex"))
+                    else if (CString::equal_i(stage_names[i], "vert") || CString::equal_i(stage_names[i], "vertex"))
                         out_resource->stages[i].stage = ShaderStage::Vertex;
-                    else if (stage_names[i].equal_i("geom") || stage_names[i].equal_i("geometry"))
+                    else if (CString::equal_i(stage_names[i], "geom") || CString::equal_i(stage_names[i], "geometry"))
                         out_resource->stages[i].stage = ShaderStage::Geometry;
-                    else if (stage_names[i].equal_i("comp") || stage_names[i].equal_i("compute"))
+                    else if (CString::equal_i(stage_names[i], "comp") || CString::equal_i(stage_names[i], "compute"))
                         out_resource->stages[i].stage = ShaderStage::Compute;
                     else
-                        SHMERRORV("shader_loader_load - Invalid file layout. Unrecognized stage '%s'", stage_names[i].c_str());
+                        SHMERRORV("shader_loader_load - Invalid file layout. Unrecognized stage '%s'", stage_names[i]);
                 }
             }
-            else if (var_name.equal_i("stagefiles")) 
+            else if (CString::equal_i(token.name, "stagefiles")) 
             {
-                Darray<String> stage_filenames;
-                value.split(stage_filenames, ',');
+                char* stage_filenames[max_list_fields];
+                uint32 stage_filename_count = split_list(token.value, stage_filenames, max_list_fields);
 
                 if (!out_resource->stages.capacity)
-                    out_resource->stages.init(stage_filenames.count, 0, AllocationTag::Resource);
-                else if (stage_filenames.count > out_resource->stages.capacity)
-                    out_resource->stages.resize(stage_filenames.count);
+                    out_resource->stages.init(stage_filename_count, 0, AllocationTag::Resource);
+                else if (stage_filename_count > out_resource->stages.capacity)
+                    out_resource->stages.resize(stage_filename_count);
 
-                if (stage_filenames.count > out_resource->stages.count)
-                    out_resource->stages.set_count(stage_filenames.count);
+                if (stage_filename_count > out_resource->stages.count)
+                    out_resource->stages.set_count(stage_filename_count);
 
-                for (uint32 i = 0; i < stage_filenames.count; i++)
-                    CString::copy(stage_filenames[i].c_str(), out_resource->stages[i].filename, Constants::max_filename_length);
-
-                for (uint32 i = 0; i < stage_filenames.count; i++)
-                    stage_filenames[i].free_data();
-                stage_filenames.free_data();
+                for (uint32 i = 0; i < stage_filename_count; i++)
+                    CString::copy(stage_filenames[i], out_resource->stages[i].filename, Constants::max_filename_length);
             }
-            else if (var_name.equal_i("topology"))
+            else if (CString::equal_i(token.name, "topology"))
             {
-                Darray<String> topologies;
-                value.split(topologies, ',');
+                char* topologies[max_list_fields];
+                uint32 topology_count = split_list(token.value, topologies, max_list_fields);
 
                 out_resource->topologies = RenderTopologyTypeFlags::None;
 
-                for (uint32 i = 0; i < topologies.count; i++)
+                for (uint32 i = 0; i < topology_count; i++)
                 {
-                    topologies[i].trim();
-                    if (topologies[i].equal_i("triangle_list"))
+                    if (CString::equal_i(topologies[i], "triangle_list"))
                         out_resource->topologies |= RenderTopologyTypeFlags::TriangleList;
-                    else if (topologies[i].equal_i("triangle_strip"))
+                    else if (CString::equal_i(topologies[i], "triangle_strip"))
                         out_resource->topologies |= RenderTopologyTypeFlags::TriangleStrip;
-                    else if (topologies[i].equal_i("triangle_fan"))
+                    else if (CString::equal_i(topologies[i], "triangle_fan"))
                         out_resource->topologies |= RenderTopologyTypeFlags::TriangleFan;
-                    else if (topologies[i].equal_i("line_list"))
+                    else if (CString::equal_i(topologies[i], "line_list"))
                         out_resource->topologies |= RenderTopologyTypeFlags::LineList;
-                    else if (topologies[i].equal_i("line_strip"))
+                    else if (CString::equal_i(topologies[i], "line_strip"))
                         out_resource->topologies |= RenderTopologyTypeFlags::LineStrip;
-                    else if (topologies[i].equal_i("point_list"))
+                    else if (CString::equal_i(topologies[i], "point_list"))
                         out_resource->topologies |= RenderTopologyTypeFlags::PointList;
                     else
-                        SHMERRORV("Invalid file layout. Unrecognized topology '%s'", topologies[i].c_str());
+                        SHMERRORV("Invalid file layout. Unrecognized topology '%s'", topologies[i]);
                 }
-
-                for (uint32 i = 0; i < topologies.count; i++)
-                    topologies[i].free_data();
-                topologies.free_data();
             }
-            else if (var_name.equal_i("cull_mode")) 
+            else if (CString::equal_i(token.name, "cull_mode")) 
             {
-                if (value.equal_i("front"))
+                if (CString::equal_i(token.value, "front"))
                     out_resource->cull_mode = RenderCullMode::Front;
-                else if (value.equal_i("back"))
+                else if (CString::equal_i(token.value, "back"))
                     out_resource->cull_mode = RenderCullMode::Back;
-                else if (value.equal_i("both"))
+                else if (CString::equal_i(token.value, "both"))
                     out_resource->cull_mode = RenderCullMode::Both;
             }
-            else if (var_name.equal_i("attributes") || var_name.equal_i("attribute")) 
+            else if (CString::equal_i(token.name, "attributes") || CString::equal_i(token.name, "attribute")) 
             {
-                Darray<String> tmp(2, 0);
-                value.split(tmp, ',');
-                if (tmp.count != 2)
+                char* tmp[3];
+                if (split_list(token.value, tmp, 3) != 2)
                     SHMERROR("shader_loader_load - Invalid file layout. Attribute fields must be 'type,name'. Skipping.");
                 else
                 {
-                    tmp[0].trim();
-                    tmp[1].trim();
                     ShaderAttributeConfig attribute;
                     // Parse field type
-                    if (tmp[0].equal_i("float32")) 
+                    if (CString::equal_i(tmp[0], "float32")) 
                     {
                         attribute.type = ShaderAttributeType::Float32;
                         attribute.size = 4;
                     }
-                    else if (tmp[0].equal_i("vec2")) 
+                    else if (CString::equal_i(tmp[0], "vec2")) 
                     {
                         attribute.type = ShaderAttributeType::Float32_2;
                         attribute.size = 8;
                     }
-                    else if (tmp[0].equal_i("vec3")) 
+                    else if (CString::equal_i(tmp[0], "vec3")) 
                     {
                         attribute.type = ShaderAttributeType::Float32_3;
                         attribute.size = 12;
                     }
-                    else if (tmp[0].equal_i("vec4")) 
+                    else if (CString::equal_i(tmp[0], "vec4")) 
                     {
                         attribute.type = ShaderAttributeType::Float32_4;
                         attribute.size = 16;
                     }
-                    else if (tmp[0].equal_i("uint8")) 
+                    else if (CString::equal_i(tmp[0], "uint8")) 
                     {
                         attribute.type = ShaderAttributeType::UInt8;
                         attribute.size = 1;
                     }
-                    else if (tmp[0].equal_i("uint16")) 
+                    else if (CString::equal_i(tmp[0], "uint16")) 
                     {
                         attribute.type = ShaderAttributeType::UInt16;
                         attribute.size = 2;
                     }
-                    else if (tmp[0].equal_i("uint32")) 
+                    else if (CString::equal_i(tmp[0], "uint32")) 
                     {
                         attribute.type = ShaderAttributeType::UInt32;
                         attribute.size = 4;
                     }
-                    else if (tmp[0].equal_i("int8")) 
+                    else if (CString::equal_i(tmp[0], "int8")) 
                     {
                         attribute.type = ShaderAttributeType::Int8;
                         attribute.size = 1;
                     }
-                    else if (tmp[0].equal_i("int16")) 
+                    else if (CString::equal_i(tmp[0], "int16")) 
                     {
                         attribute.type = ShaderAttributeType::Int16;
                         attribute.size = 2;
                     }
-                    else if (tmp[0].equal_i("int32")) 
+                    else if (CString::equal_i(tmp[0], "int32")) 
                     {
                         attribute.type = ShaderAttributeType::Int32;
                         attribute.size = 4;
@@ -250,20 +345,15 @@ namespace ResourceSystem
 
                     if (attribute.size)
                     {
-                        CString::copy(tmp[1].c_str(), attribute.name, Constants::max_shader_attribute_name_length);
+                        CString::copy(tmp[1], attribute.name, Constants::max_shader_attribute_name_length);
                         out_resource->attributes.emplace(attribute);
                     }
-
-                    for (uint32 i = 0; i < tmp.count; i++)
-                        tmp[i].free_data();
-                    tmp.free_data();
                 }
             }
-            else if (var_name.equal_i("uniforms") || var_name.equal_i("uniform")) 
+            else if (CString::equal_i(token.name, "uniforms") || CString::equal_i(token.name, "uniform")) 
             {
-                Darray<String> tmp(3, 0);
-                value.split(tmp, ',');
-                if (tmp.count != 3)
+                char* tmp[4];
+                if (split_list(token.value, tmp, 4) != 3)
                 {
                     SHMERROR("shader_loader_load - Invalid file layout. Attribute fields must be 'type,name'. Skipping.");
                     continue;
@@ -271,82 +361,79 @@ namespace ResourceSystem
                     
                 else
                 {
-                    tmp[0].trim();
-                    tmp[1].trim();
-                    tmp[2].trim();
                     ShaderUniformConfig uniform = {};
                     // Parse field type
-                    if (tmp[0].equal_i("float32")) 
+                    if (CString::equal_i(tmp[0], "float32")) 
                     {
                         uniform.type = ShaderUniformType::Float32;
                         uniform.size = 4;
                     }
-                    else if (tmp[0].equal_i("vec2")) 
+                    else if (CString::equal_i(tmp[0], "vec2")) 
                     {
                         uniform.type = ShaderUniformType::Float32_2;
                         uniform.size = 8;
                     }
-                    else if (tmp[0].equal_i("vec3")) 
+                    else if (CString::equal_i(tmp[0], "vec3")) 
                     {
                         uniform.type = ShaderUniformType::Float32_3;
                         uniform.size = 12;
                     }
-                    else if (tmp[0].equal_i("vec4")) 
+                    else if (CString::equal_i(tmp[0], "vec4")) 
                     {
                         uniform.type = ShaderUniformType::Float32_4;
                         uniform.size = 16;
                     }
-                    else if (tmp[0].equal_i("uint8")) 
+                    else if (CString::equal_i(tmp[0], "uint8")) 
                     {
                         uniform.type = ShaderUniformType::UInt8;
                         uniform.size = 1;
                     }
-                    else if (tmp[0].equal_i("uint16")) 
+                    else if (CString::equal_i(tmp[0], "uint16")) 
                     {
                         uniform.type = ShaderUniformType::UInt16;
                         uniform.size = 2;
                     }
-                    else if (tmp[0].equal_i("uint32")) 
+                    else if (CString::equal_i(tmp[0], "uint32")) 
                     {
                         uniform.type = ShaderUniformType::UInt32;
                         uniform.size = 4;
                     }
-                    else if (tmp[0].equal_i("int8")) 
+                    else if (CString::equal_i(tmp[0], "int8")) 
                     {
                         uniform.type = ShaderUniformType::Int8;
                         uniform.size = 1;
                     }
-                    else if (tmp[0].equal_i("int16")) 
+                    else if (CString::equal_i(tmp[0], "int16")) 
                     {
                         uniform.type = ShaderUniformType::Int16;
                         uniform.size = 2;
                     }
-                    else if (tmp[0].equal_i("int32")) 
+                    else if (CString::equal_i(tmp[0], "int32")) 
                     {
                         uniform.type = ShaderUniformType::Int32;
                         uniform.size = 4;
                     }
-                    else if (tmp[0].equal_i("mat4")) 
+                    else if (CString::equal_i(tmp[0], "mat4")) 
                     {
                         uniform.type = ShaderUniformType::Mat4;
                         uniform.size = 64;
                     }
-                    else if (tmp[0].equal_i("samp")) 
+                    else if (CString::equal_i(tmp[0], "samp")) 
                     {
                         uniform.type = ShaderUniformType::Sampler;
                         uniform.size = 1;
                     }
-                    else if (tmp[0].nequal_i("struct", 6)) 
+                    else if (CString::nequal_i(tmp[0], "struct", 6)) 
                     {
-                        if (tmp[0].len() <= 6)
+                        if (CString::length(tmp[0]) <= 6)
                         {
-                            SHMERRORV("Failed to load struct uniform. Size missing.", tmp[0].c_str());
+                            SHMERRORV("Failed to load struct uniform. Size missing.", tmp[0]);
                             return false;
                         }
                         uint16 size = 0;
                         if (!CString::parse(&tmp[0][6], &size))
                         {
-                            SHMERRORV("Failed to parse uniform struct size: '%s'", tmp[0].c_str());
+                            SHMERRORV("Failed to parse uniform struct size: '%s'", tmp[0]);
                             return false;
                         }
                         uniform.type = ShaderUniformType::Custom;
@@ -361,15 +448,15 @@ namespace ResourceSystem
                     if (uniform.size)
                     {
 
-                        if (tmp[1].equal_i("0") || tmp[1].equal_i("global"))
+                        if (CString::equal_i(tmp[1], "0") || CString::equal_i(tmp[1], "global"))
                         {
                             uniform.scope = ShaderScope::Global;
                         }
-                        else if (tmp[1].equal_i("1") || tmp[1].equal_i("instance"))
+                        else if (CString::equal_i(tmp[1], "1") || CString::equal_i(tmp[1], "instance"))
                         {
                             uniform.scope = ShaderScope::Instance;
                         }
-                        else if (tmp[1].equal_i("2") || tmp[1].equal_i("local"))
+                        else if (CString::equal_i(tmp[1], "2") || CString::equal_i(tmp[1], "local"))
                         {
                             uniform.scope = ShaderScope::Local;
                         }
@@ -383,31 +470,226 @@ namespace ResourceSystem
                         if (uniform.type == ShaderUniformType::Sampler)
                             uniform.size = 0;
 
-                        CString::copy(tmp[2].c_str(), uniform.name, Constants::max_shader_uniform_name_length);
+                        CString::copy(tmp[2], uniform.name, Constants::max_shader_uniform_name_length);
                         out_resource->uniforms.emplace(uniform);
                     }
                 }
+            }
+        }
+
+        FileSystem::file_close(&f);
+
+        return true;
+
+	}
+
+    bool8 shader_loader_compile_stage(const char* source_filepath, const char* output_filepath)
+    {
+        uint32 path_length = CString::length(source_filepath);
+        const char* stage = 0;
+        if (path_length >= 9 && CString::equal_i(&source_filepath[path_length - 9], "vert.glsl"))
+            stage = "vert";
+        else if (path_length >= 9 && CString::equal_i(&source_filepath[path_length - 9], "frag.glsl"))
+            stage = "frag";
+
+        if (!stage)
+        {
+            SHMERRORV("shader_loader_compile_stage - Cannot tell the stage of shader source '%s'.", source_filepath);
+            return false;
+        }
 
-                for (uint32 i = 0; i < tmp.count; i++)
-                    tmp[i].free_data();
-                tmp.free_data();
+        char command_line[Constants::max_filepath_length * 3];
+        CString::safe_print_s<const char*, const char*, const char*, const char*>
+            (command_line, sizeof(command_line), stage_compile_command, stage_compiler_path, stage, source_filepath, output_filepath);
+
+        int32 exit_code = 0;
+        if (!Platform::execute_process(command_line, &exit_code))
+        {
+            SHMERRORV("shader_loader_compile_stage - Failed to launch shader compiler for '%s'.", source_filepath);
+            return false;
+        }
+
+        if (exit_code != 0)
+        {
+            SHMERRORV("shader_loader_compile_stage - Shader compiler failed on '%s' with exit code %i.", source_filepath, exit_code);
+            return false;
+        }
+
+        return true;
+    }
+
+    uint64 shader_loader_get_compile_settings_hash()
+    {
+        uint64 hash = hash_fnv1a64(stage_compiler_path, CString::length(stage_compiler_path));
+        return hash_fnv1a64(stage_compile_command, CString::length(stage_compile_command), hash);
+    }
+
+    static bool8 write_shmshader_file(const char* full_filepath, ShaderResourceData* resource)
+    {
+
+        Buffer stage_code[max_list_fields] = {};
+        goto_if_log(resource->stages.count > max_list_fields, fail, "Too many shader stages to cook.");
+
+        {
+            ShmshaderFileHeader header = {};
+            header.magic = shmshader_magic;
+            header.version = shmshader_file_version;
+            header.attribute_record_size = sizeof(ShaderAttributeConfig);
+            header.uniform_record_size = sizeof(ShaderUniformConfig);
+            header.stage_record_size = sizeof(ShmshaderStageRecord);
+            header.cull_mode = (uint8)resource->cull_mode;
+            header.topologies = resource->topologies;
+            header.depth_test = resource->depth_test;
+            header.depth_write = resource->depth_write;
+            CString::copy(resource->name, header.name, Constants::max_shader_name_length);
+            header.attributes_count = resource->attributes.count;
+            header.attributes_offset = (uint32)get_aligned_pow2(sizeof(ShmshaderFileHeader), 16);
+            header.uniforms_count = resource->uniforms.count;
+            header.uniforms_offset = (uint32)get_aligned_pow2(header.attributes_offset + header.attributes_count * sizeof(ShaderAttributeConfig), 16);
+            header.uniform_lookup_seed = resource->uniform_lookup_seed;
+            header.uniform_lookup_slot_count = resource->uniform_lookup.capacity;
+            header.uniform_lookup_offset = (uint32)get_aligned_pow2(header.uniforms_offset + header.uniforms_count * sizeof(ShaderUniformConfig), 16);
+            header.stages_count = resource->stages.count;
+            header.stages_offset = (uint32)get_aligned_pow2(header.uniform_lookup_offset + header.uniform_lookup_slot_count * sizeof(ShaderUniformId), 16);
+
+            ShmshaderStageRecord stage_records[max_list_fields] = {};
+            uint32 file_size = header.stages_offset + header.stages_count * sizeof(ShmshaderStageRecord);
+            for (uint32 i = 0; i < header.stages_count; i++)
+            {
+                goto_if_log(!ResourceSystem::generic_loader_load(resource->stages[i].filename, &stage_code[i]), fail, "Failed to read compiled shader stage.");
+
+                stage_records[i].stage = resource->stages[i].stage;
+                CString::copy(resource->stages[i].filename, stage_records[i].filename, Constants::max_filename_length);
+                stage_records[i].code_offset = (uint32)get_aligned_pow2(file_size, 4);
+                stage_records[i].code_size = (uint32)stage_code[i].size;
+                file_size = stage_records[i].code_offset + stage_records[i].code_size;
+            }
+
+            Buffer file_data(file_size, 0, AllocationTag::Resource);
+            uint8* data = (uint8*)file_data.data;
+            Memory::copy_memory(&header, data, sizeof(header));
+            if (header.attributes_count)
+                Memory::copy_memory(resource->attributes.data, data + header.attributes_offset, header.attributes_count * sizeof(ShaderAttributeConfig));
+            if (header.uniforms_count)
+                Memory::copy_memory(resource->uniforms.data, data + header.uniforms_offset, header.uniforms_count * sizeof(ShaderUniformConfig));
+            if (header.uniform_lookup_slot_count)
+                Memory::copy_memory(resource->uniform_lookup.data, data + header.uniform_lookup_offset, header.uniform_lookup_slot_count * sizeof(ShaderUniformId));
+            if (header.stages_count)
+                Memory::copy_memory(stage_records, data + header.stages_offset, header.stages_count * sizeof(ShmshaderStageRecord));
+            for (uint32 i = 0; i < header.stages_count; i++)
+                Memory::copy_memory(stage_code[i].data, data + stage_records[i].code_offset, stage_records[i].code_size);
+
+            FileSystem::FileHandle f;
+            if (!FileSystem::file_open(full_filepath, FILE_MODE_WRITE, &f))
+            {
+                SHMERRORV("Error opening shader file for writing: '%s'", full_filepath);
+                file_data.free_data();
+                goto fail;
             }
+            SHMDEBUGV("Writing .shmshader file '%s'...", full_filepath);
 
-            line_number++;
+            uint32 bytes_written = 0;
+            bool8 res = FileSystem::write(&f, (uint32)file_data.size, file_data.data, &bytes_written) && bytes_written == file_data.size;
 
+            FileSystem::file_close(&f);
+            file_data.free_data();
+            for (uint32 i = 0; i < max_list_fields; i++)
+                ResourceSystem::generic_loader_unload(&stage_code[i]);
+            return res;
         }
 
+    fail:
+        for (uint32 i = 0; i < max_list_fields; i++)
+            ResourceSystem::generic_loader_unload(&stage_code[i]);
+        return false;
+
+    }
+
+    static bool8 load_shmshader_file(const char* full_filepath, ShaderResourceData* out_resource)
+    {
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
+            return false;
+
+        uint32 file_size = FileSystem::get_file_size32(&f);
+        uint32 bytes_read = 0;
+        out_resource->binary_data.init(file_size ? file_size : 1, 0, AllocationTag::Resource);
+        bool8 read = FileSystem::read_all_bytes(&f, out_resource->binary_data.data, file_size, &bytes_read) && bytes_read == file_size;
         FileSystem::file_close(&f);
 
+        uint8* data = (uint8*)out_resource->binary_data.data;
+        const ShmshaderFileHeader* header = (const ShmshaderFileHeader*)data;
+        bool8 valid = read && file_size >= sizeof(ShmshaderFileHeader) &&
+            header->magic == shmshader_magic &&
+            header->version == shmshader_file_version &&
+            header->attribute_record_size == sizeof(ShaderAttributeConfig) &&
+            header->uniform_record_size == sizeof(ShaderUniformConfig) &&
+            header->stage_record_size == sizeof(ShmshaderStageRecord) &&
+            header->attributes_offset + (uint64)header->attributes_count * sizeof(ShaderAttributeConfig) <= file_size &&
+            header->uniforms_offset + (uint64)header->uniforms_count * sizeof(ShaderUniformConfig) <= file_size &&
+            header->uniform_lookup_slot_count && !(header->uniform_lookup_slot_count & (header->uniform_lookup_slot_count - 1)) &&
+            header->uniform_lookup_offset + (uint64)header->uniform_lookup_slot_count * sizeof(ShaderUniformId) <= file_size &&
+            header->stages_offset + (uint64)header->stages_count * sizeof(ShmshaderStageRecord) <= file_size;
+
+        ShaderUniformId* lookup_slots = valid ? (ShaderUniformId*)(data + header->uniform_lookup_offset) : 0;
+        for (uint32 i = 0; valid && i < header->uniform_lookup_slot_count; i++)
+            valid = !lookup_slots[i].is_valid() || lookup_slots[i] < header->uniforms_count;
+
+        const ShmshaderStageRecord* stage_records = valid ? (const ShmshaderStageRecord*)(data + header->stages_offset) : 0;
+        for (uint32 i = 0; valid && i < header->stages_count; i++)
+            valid = !(stage_records[i].code_offset & 3) && stage_records[i].code_offset + (uint64)stage_records[i].code_size <= file_size;
+
+        if (!valid)
+        {
+            out_resource->binary_data.free_data();
+            return false;
+        }
+
+        CString::copy(header->name, out_resource->name, Constants::max_shader_name_length);
+        out_resource->cull_mode = (Renderer::RenderCullMode)header->cull_mode;
+        out_resource->topologies = header->topologies;
+        out_resource->depth_test = header->depth_test;
+        out_resource->depth_write = header->depth_write;
+
+        // NOTE: No parsing and no copies, the arrays get handed the records inside the file data.
+        if (header->attributes_count)
+        {
+            out_resource->attributes.init(header->attributes_count, 0, AllocationTag::Resource, data + header->attributes_offset);
+            out_resource->attributes.set_count(header->attributes_count);
+        }
+        if (header->uniforms_count)
+        {
+            out_resource->uniforms.init(header->uniforms_count, 0, AllocationTag::Resource, data + header->uniforms_offset);
+            out_resource->uniforms.set_count(header->uniforms_count);
+        }
+        out_resource->uniform_lookup_seed = header->uniform_lookup_seed;
+        out_resource->uniform_lookup.init(header->uniform_lookup_slot_count, 0, AllocationTag::Resource, data + header->uniform_lookup_offset);
+
+        if (header->stages_count)
+        {
+            out_resource->stages.init(header->stages_count, 0, AllocationTag::Resource);
+            for (uint32 i = 0; i < header->stages_count; i++)
+            {
+                ShaderStageConfig* stage = &out_resource->stages[out_resource->stages.emplace()];
+                stage->stage = stage_records[i].stage;
+                CString::copy(stage_records[i].filename, stage->filename, Constants::max_filename_length);
+                stage->code = data + stage_records[i].code_offset;
+                stage->code_size = stage_records[i].code_size;
+            }
+        }
+
         return true;
 
-	}
+    }
 
     void shader_loader_unload(ShaderResourceData* resource)
     {
         resource->stages.free_data();
         resource->attributes.free_data();
         resource->uniforms.free_data();
+        resource->uniform_lookup.free_data();
+        resource->binary_data.free_data();
     }
 
     ShaderConfig shader_loader_get_config_from_resource(ShaderResourceData* resource, Renderer::RenderPass* renderpass)
@@ -426,6 +708,9 @@ namespace ResourceSystem
         config.attributes_count = resource->attributes.count;
         config.uniforms = resource->uniforms.data;
         config.uniforms_count = resource->uniforms.count;
+        config.uniform_lookup_seed = resource->uniform_lookup_seed;
+        config.uniform_lookup_slot_count = resource->uniform_lookup.capacity;
+        config.uniform_lookup_slots = resource->uniform_lookup.capacity ? resource->uniform_lookup.data : 0;
 
         return config;
     }
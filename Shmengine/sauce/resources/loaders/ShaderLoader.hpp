@@ -1,6 +1,7 @@
 #pragma once
 
 #include "systems/ShaderSystem.hpp"
+#include "containers/Buffer.hpp"
 
 struct ShaderResourceData
 {
@@ -15,6 +16,13 @@ struct ShaderResourceData
 
 	Renderer::RenderCullMode cull_mode;
 	Renderer::RenderTopologyTypeFlags::Value topologies;
+
+	// NOTE: Only filled for cooked shaders, shaders parsed from text get their lookup built on init.
+	uint64 uniform_lookup_seed;
+	Sarray<ShaderUniformId> uniform_lookup;
+
+	// NOTE: Contents of a .shmshader file. Attributes, uniforms, lookup slots and stage code point into it until the resource is unloaded.
+	Buffer binary_data;
 };
 
 namespace ResourceSystem
@@ -22,5 +30,15 @@ namespace ResourceSystem
 	bool8 shader_loader_load(const char* name, ShaderResourceData* out_resource);
 	void shader_loader_unload(ShaderResourceData* resource);
 
+	// NOTE: Compiles a *vert.glsl or *frag.glsl source to spir-v with the Vulkan SDK's glslc.
+	bool8 shader_loader_compile_stage(const char* source_filepath, const char* output_filepath);
+	// NOTE: Changes whenever the compiler invocation changes.
+	uint64 shader_loader_get_compile_settings_hash();
+
+	// NOTE: Parses the .shadercfg file and writes its .shmshader file, embedding the compiled stages and the uniform lookup.
+	bool8 shader_loader_cook(const char* name);
+	// NOTE: Changes whenever the cook would write a different .shmshader file from the same .shadercfg, including when a stage got recompiled.
+	uint64 shader_loader_get_cook_settings_hash(const char* name);
+
 	ShaderConfig shader_loader_get_config_from_resource(ShaderResourceData* resource, Renderer::RenderPass* renderpass);
 }
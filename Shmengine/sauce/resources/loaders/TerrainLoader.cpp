@@ -4,6 +4,7 @@
 #include "core/Logging.hpp"
 #include "core/Memory.hpp"
 #include "utility/String.hpp"
+#include "utility/ConfigTokenizer.hpp"
 #include "utility/math/Transform.hpp"
 #include "platform/FileSystem.hpp"
 #include "renderer/RendererTypes.hpp"
@@ -45,19 +46,6 @@ namespace ResourceSystem
             return false;
         }
 
-        enum class ParserScope
-        {
-            TERRAIN
-        };
-
-        ParserScope scope = ParserScope::TERRAIN;
-        // Read each line of the file.
-        String line(512);
-        uint64 line_length = 0;
-
-        String var_name;
-        String value;
-
         bool8 success = true;
 
         out_resource->name[0] = 0;
@@ -71,79 +59,53 @@ namespace ResourceSystem
 
         out_resource->sub_materials_count = 0;
 
-        uint32 line_number = 1;
-        const char* continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
-        {
-            // Trim the string.
-            line.trim();
+        char* content = file_content.c_str_vulnerable();
+        content[bytes_read] = 0;
 
-            // Get the trimmed length.
-            line_length = line.len();
+        ConfigTokenizer tokenizer(content, bytes_read, full_filepath);
+        ConfigToken token;
+        while (tokenizer.next(&token))
+        {
+            if (token.type != ConfigToken::Type::Property)
+                continue;
 
-            // Skip blank lines and comments.
-            if (line_length < 1 || line[0] == '#')
+            uint32 line_number = token.line_number;
+            if (CString::equal_i(token.name, "version"))
             {
-                line_number++;
-                continue;
             }
-
-            int32 equal_index = line.index_of('=');
-            if (equal_index == -1) {
-                SHMWARNV("Potential formatting issue found in file '%s': '=' token not found. Skipping line %ui.", full_filepath, line_number);
-                line_number++;
-                continue;
+            else if (CString::equal_i(token.name, "name"))
+            {
+                CString::copy(token.value, out_resource->name, Constants::max_terrain_name_length);
             }
-
-            mid(var_name, line.c_str(), 0, equal_index);
-            var_name.trim();
-
-            mid(value, line.c_str(), equal_index + 1);
-            value.trim();
-
-            if (scope == ParserScope::TERRAIN)
+            else if (CString::equal_i(token.name, "heightmap_resource_name"))
             {
-                // Process the variable.
-                if (var_name.equal_i("version"))
-                {
-                }
-                else if (var_name.equal_i("name"))
-                {
-                    CString::copy(value.c_str(), out_resource->name, Constants::max_terrain_name_length);
-                }
-                else if (var_name.equal_i("heightmap_resource_name"))
-                {
-                    CString::copy(value.c_str(), out_resource->heightmap_name, Constants::max_texture_name_length);
-                }
-                else if (var_name.equal_i("tile_count_x"))
-                {
-                    PARSE_VALUE(value.c_str(), &out_resource->tile_count_x);
-                }
-                else if (var_name.equal_i("tile_count_z"))
-                {
-                    PARSE_VALUE(value.c_str(), &out_resource->tile_count_z);
-                }
-                else if (var_name.equal_i("scale_x"))
-                {
-                    PARSE_VALUE(value.c_str(), &out_resource->tile_scale_x);
-                }
-                else if (var_name.equal_i("scale_z"))
-                {
-                    PARSE_VALUE(value.c_str(), &out_resource->tile_scale_z);
-                }
-                else if (var_name.equal_i("scale_y"))
-                {
-                    PARSE_VALUE(value.c_str(), &out_resource->scale_y);
-                }
-                else if (var_name.equal_i("material"))
-                {
-                    if (out_resource->sub_materials_count < Constants::max_terrain_materials_count)
-                        CString::copy(value.c_str(), out_resource->sub_material_names[out_resource->sub_materials_count++].name, Constants::max_material_name_length);
-                }
+                CString::copy(token.value, out_resource->heightmap_name, Constants::max_texture_name_length);
+            }
+            else if (CString::equal_i(token.name, "tile_count_x"))
+            {
+                PARSE_VALUE(token.value, &out_resource->tile_count_x);
+            }
+            else if (CString::equal_i(token.name, "tile_count_z"))
+            {
+                PARSE_VALUE(token.value, &out_resource->tile_count_z);
+            }
+            else if (CString::equal_i(token.name, "scale_x"))
+            {
+                PARSE_VALUE(token.value, &out_resource->tile_scale_x);
+            }
+            else if (CString::equal_i(token.name, "scale_z"))
+            {
+                PARSE_VALUE(token.value, &out_resource->tile_scale_z);
+            }
+            else if (CString::equal_i(token.name, "scale_y"))
+            {
+                PARSE_VALUE(token.value, &out_resource->scale_y);
+            }
+            else if (CString::equal_i(token.name, "material"))
+            {
+                if (out_resource->sub_materials_count < Constants::max_terrain_materials_count)
+                    CString::copy(token.value, out_resource->sub_material_names[out_resource->sub_materials_count++].name, Constants::max_material_name_length);
             }
-            
-
-            line_number++;
         }
 
         FileSystem::file_close(&f);
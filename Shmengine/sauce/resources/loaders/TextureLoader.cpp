@@ -7,6 +7,9 @@
 #include "platform/FileSystem.hpp"
 #include "utility/CString.hpp"
 #include "systems/TextureSystem.hpp"
+#include "systems/CookSystem.hpp"
+#include "renderer/TextureCodec.hpp"
+#include "utility/Utility.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #define STBI_NO_STDIO
@@ -15,65 +18,148 @@
 #define STBI_FREE(p)              if(p) Memory::free_memory(p)
 #include "vendor/stb/stb_image.h"
 
+namespace ShmtexFlags
+{
+	enum : uint8
+	{
+		FlippedY = 1 << 0,
+		HasTransparency = 1 << 1,
+		Srgb = 1 << 2
+	};
+	typedef uint8 Value;
+}
+
+// NOTE: Mip levels follow the header back to back, largest first. Their sizes follow from format and dimensions.
+struct ShmtexFileHeader
+{
+	uint32 magic;
+	uint16 version;
+	uint8 format;
+	uint8 mip_count;
+	ShmtexFlags::Value flags;
+	uint8 channel_count;
+	uint16 reserved;
+	uint32 width;
+	uint32 height;
+	uint32 data_offset;
+	uint32 data_size;
+};
+
+static const uint32 shmtex_magic = 0x58544853; // "SHTX"
+static const uint16 shmtex_file_version = 1;
+
 namespace ResourceSystem
 {
 	static const char* loader_type_path = "textures/";
 
-	bool8 texture_loader_load(const char* resource_name, bool8 flip_y, TextureResourceData* out_resource)
-	{
-		Buffer file_data = {};
-		FileSystem::FileHandle f;
-		uint32 file_size = 0;
-		uint32 bytes_read = 0;
-		uint32 pixel_buffer_size = 0;
-		uint8* pixels_data = 0;
-		int width, height, channel_count;
+	static bool8 load_shmtex(const char* resource_name, const void* file_data, uint64 file_size, TextureResourceData* out_resource);
+	static bool8 decode_source_image(const char* resource_name, const void* file_data, uint64 file_size, bool8 flip_y, TextureResourceData* out_resource);
+	static bool8 cook_from_source_file(const char* resource_name, bool8 flip_y, TextureResourceData* out_resource);
+	static bool8 write_shmtex_file(const char* path, const TextureResourceData* resource, bool8 srgb);
 
+	static void get_base_filepath(const char* resource_name, char* out_filepath)
+	{
 		const char* format = "%s%s%s";
-		const int32 required_channel_count = 4;
-		stbi_set_flip_vertically_on_load_thread(flip_y);
-		char full_filepath[Constants::max_filepath_length];
-
 		CString::safe_print_s<const char*, const char*, const char*>
-			(full_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, resource_name);
+			(out_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, resource_name);
+	}
+
+	static bool8 get_source_filepath(const char* resource_name, char* out_filepath)
+	{
+		char full_filepath[Constants::max_filepath_length];
+		get_base_filepath(resource_name, full_filepath);
 
 		const uint32 valid_extension_count = 4;
-		bool8 found = false;
 		const char* extensions[valid_extension_count] = { ".tga", ".png", ".jpg", ".bmp" };
-		char full_filepath_tmp[Constants::max_filepath_length] = {};
 		for (uint32 i = 0; i < valid_extension_count; i++)
-		{			
-			CString::copy(full_filepath, full_filepath_tmp, Constants::max_filepath_length);
-			CString::append(full_filepath_tmp, Constants::max_filepath_length, extensions[i]);
-			if (FileSystem::file_exists(full_filepath_tmp))
-			{
-				found = true;
-				break;
-			}
+		{
+			CString::copy(full_filepath, out_filepath, Constants::max_filepath_length);
+			CString::append(out_filepath, Constants::max_filepath_length, extensions[i]);
+			if (FileSystem::file_exists(out_filepath))
+				return true;
+		}
+
+		SHMERRORV("Image resource loader failed to find file '%s' with any valid extensions.", full_filepath);
+		return false;
+	}
+
+	bool8 texture_loader_get_filepath(const char* resource_name, char* out_filepath)
+	{
+		get_base_filepath(resource_name, out_filepath);
+		CString::append(out_filepath, Constants::max_filepath_length, ".shmtex");
+		if (CookSystem::is_cooked(out_filepath) || FileSystem::file_exists(out_filepath))
+			return true;
+
+		return get_source_filepath(resource_name, out_filepath);
+	}
+
+	bool8 texture_loader_get_mip_range(const char* resource_name, TextureFormat format, uint32 width, uint32 height, uint8 mip_count, uint8 first_mip, char* out_filepath, uint64* out_offset, uint64* out_size)
+	{
+		get_base_filepath(resource_name, out_filepath);
+		CString::append(out_filepath, Constants::max_filepath_length, ".shmtex");
+		if (!CookSystem::is_cooked(out_filepath) && !FileSystem::file_exists(out_filepath))
+			return false;
+
+		uint64 offset = sizeof(ShmtexFileHeader);
+		uint64 size = 0;
+		for (uint32 mip = 0; mip < mip_count; mip++)
+		{
+			uint32 mip_size = Renderer::texture_get_mip_size(format, Renderer::texture_get_mip_dimension(width, mip), Renderer::texture_get_mip_dimension(height, mip));
+			if (mip < first_mip)
+				offset += mip_size;
+			else
+				size += mip_size;
+		}
+
+		*out_offset = offset;
+		*out_size = size;
+		return true;
+	}
+
+	bool8 texture_loader_load_from_memory(const char* resource_name, const void* file_data, uint64 file_size, bool8 flip_y, TextureResourceData* out_resource)
+	{
+		if (file_size >= sizeof(ShmtexFileHeader) && ((const ShmtexFileHeader*)file_data)->magic == shmtex_magic)
+		{
+			if (!load_shmtex(resource_name, file_data, file_size, out_resource))
+				return false;
+
+			if (out_resource->flipped_y == flip_y)
+				return true;
+
+			// NOTE: Block compressed data can not simply be flipped, so the texture gets cooked again with the requested orientation.
+			SHMDEBUGV("Cooked texture '%s' has been flipped differently than requested, cooking it again.", resource_name);
+			texture_loader_unload(out_resource);
+			return cook_from_source_file(resource_name, flip_y, out_resource);
 		}
 
-		goto_if_log(!found, fail, "Image resource loader failed to find file '%s' with any valid extensions.", full_filepath_tmp);
-		CString::copy(full_filepath_tmp,full_filepath, Constants::max_filepath_length);
+		if (!decode_source_image(resource_name, file_data, file_size, flip_y, out_resource))
+			return false;
+
+		TextureCookConfig config;
+		texture_loader_get_cook_config(resource_name, out_resource->has_transparency, &config);
+		return texture_loader_cook(resource_name, out_resource, &config);
+	}
+
+	bool8 texture_loader_load(const char* resource_name, bool8 flip_y, TextureResourceData* out_resource)
+	{
+		Buffer file_data = {};
+		FileSystem::FileHandle f = {};
+		uint32 file_size = 0;
+		uint32 bytes_read = 0;
+		char full_filepath[Constants::max_filepath_length];
+
+		goto_if(!texture_loader_get_filepath(resource_name, full_filepath), fail);
 
 		goto_if_log(!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f), fail, "Unable to read file: %s.", full_filepath);
 
 		file_size = FileSystem::get_file_size32(&f);
-		goto_if_log(!FileSystem::get_file_size32(&f), fail, "Unable to get size of file: %s.", full_filepath);
+		goto_if_log(!file_size, fail, "Unable to get size of file: %s.", full_filepath);
 
 		file_data.init(file_size, 0, AllocationTag::Resource);
-		bytes_read = 0;
 		goto_if_log(!FileSystem::read_all_bytes(&f, file_data.data, (uint32)file_data.size, &bytes_read), fail, "Unable to read file: %s.", full_filepath);
 
 		FileSystem::file_close(&f);
-		pixels_data = stbi_load_from_memory((stbi_uc*)file_data.data, (int)file_data.size, &width, &height, &channel_count, required_channel_count);
-		goto_if_log(!pixels_data, fail, "Image resource loader failed to load file '%s'.", full_filepath);
-
-		out_resource->width = width;
-		out_resource->height = height;
-		out_resource->channel_count = required_channel_count;
-		out_resource->flipped_y = flip_y;
-		pixel_buffer_size = out_resource->width * out_resource->height * out_resource->channel_count;
-		out_resource->pixels.init(pixel_buffer_size, 0, AllocationTag::Resource, pixels_data);
+		goto_if(!texture_loader_load_from_memory(resource_name, file_data.data, file_data.size, flip_y, out_resource), fail);
 
 		file_data.free_data();
 		return true;
@@ -87,10 +173,294 @@ namespace ResourceSystem
 
 	void texture_loader_unload(TextureResourceData* resource)
 	{
-		if (resource->pixels.data)
+		if (resource->pixels.data && (resource->pixels.flags & BufferFlags::ExternalMemory))
 			stbi_image_free(resource->pixels.data);
 		resource->pixels.free_data();
 	}
 
+	static bool8 name_has_suffix(const char* name, const char* suffix)
+	{
+		uint32 name_length = CString::length(name);
+		uint32 suffix_length = CString::length(suffix);
+		if (name_length < suffix_length)
+			return false;
+
+		return CString::equal_i(&name[name_length - suffix_length], suffix);
+	}
+
+	void texture_loader_get_cook_config(const char* resource_name, bool8 has_transparency, TextureCookConfig* out_config)
+	{
+		out_config->format = TextureFormat::RGBA8;
+		out_config->mip_filter = Renderer::TextureMipFilter::Kaiser;
+		out_config->srgb = true;
+		out_config->generate_mips = true;
+
+		const char* normal_suffixes[] = { "_ddn", "_nrm", "_norm", "_normal", "_normals", "_nor" };
+		// NOTE: Maps holding data instead of color, they get filtered and compressed without the sRGB curve.
+		const char* data_suffixes[] = { "_spec", "_specular", "_gloss", "_glossiness", "_rough", "_roughness", "_metal", "_metallic", "_metalness",
+			"_ao", "_occlusion", "_orm", "_arm", "_rma", "_height", "_disp", "_displacement", "_bump", "_mask", "_opacity" };
+		const char* diffuse_suffixes[] = { "_diff", "_diffuse", "_albedo" };
+
+		for (uint32 i = 0; i < sizeof(normal_suffixes) / sizeof(*normal_suffixes); i++)
+		{
+			if (name_has_suffix(resource_name, normal_suffixes[i]))
+			{
+				out_config->format = TextureFormat::BC5;
+				out_config->srgb = false;
+				return;
+			}
+		}
+
+		for (uint32 i = 0; i < sizeof(data_suffixes) / sizeof(*data_suffixes); i++)
+		{
+			if (name_has_suffix(resource_name, data_suffixes[i]))
+			{
+				out_config->format = has_transparency ? TextureFormat::BC3 : TextureFormat::BC1;
+				out_config->srgb = false;
+				return;
+			}
+		}
+
+		for (uint32 i = 0; i < sizeof(diffuse_suffixes) / sizeof(*diffuse_suffixes); i++)
+		{
+			if (name_has_suffix(resource_name, diffuse_suffixes[i]))
+			{
+				out_config->format = has_transparency ? TextureFormat::BC3 : TextureFormat::BC1;
+				return;
+			}
+		}
+	}
+
+	bool8 texture_loader_cook(const char* resource_name, TextureResourceData* resource, const TextureCookConfig* config)
+	{
+
+		if (resource->format != TextureFormat::RGBA8 || resource->mip_count != 1 || resource->channel_count != 4)
+		{
+			SHMERRORV("Texture '%s' can not be cooked, expected a single level RGBA8 image.", resource_name);
+			return false;
+		}
+
+		uint32 mip_count = config->generate_mips ? Renderer::texture_get_mip_count(resource->width, resource->height) : 1;
+
+		uint64 cooked_size = 0;
+		for (uint32 mip = 0; mip < mip_count; mip++)
+			cooked_size += Renderer::texture_get_mip_size(config->format, Renderer::texture_get_mip_dimension(resource->width, mip), Renderer::texture_get_mip_dimension(resource->height, mip));
+
+		Buffer cooked = {};
+		cooked.init(cooked_size, 0, AllocationTag::Resource);
+
+		// NOTE: Every level gets filtered from its uncompressed predecessor, compression only happens on the way out.
+		Buffer level_pixels[2] = {};
+		const uint8* level = (const uint8*)resource->pixels.data;
+		uint64 cooked_offset = 0;
+		for (uint32 mip = 0; mip < mip_count; mip++)
+		{
+			uint32 mip_width = Renderer::texture_get_mip_dimension(resource->width, mip);
+			uint32 mip_height = Renderer::texture_get_mip_dimension(resource->height, mip);
+			uint32 mip_size = Renderer::texture_get_mip_size(config->format, mip_width, mip_height);
+			uint8* cooked_level = (uint8*)cooked.data + cooked_offset;
+
+			if (config->format == TextureFormat::RGBA8)
+				Memory::copy_memory(level, cooked_level, mip_size);
+			else
+				Renderer::texture_compress(config->format, level, mip_width, mip_height, cooked_level);
+			cooked_offset += mip_size;
+
+			if (mip + 1 < mip_count)
+			{
+				Buffer* next_level = &level_pixels[mip & 1];
+				uint32 next_width = Renderer::texture_get_mip_dimension(resource->width, mip + 1);
+				uint32 next_height = Renderer::texture_get_mip_dimension(resource->height, mip + 1);
+				if (!next_level->data)
+					next_level->init(next_width * next_height * 4, 0, AllocationTag::Resource);
+
+				Renderer::texture_downsample(level, mip_width, mip_height, config->srgb, config->mip_filter, (uint8*)next_level->data);
+				level = (const uint8*)next_level->data;
+			}
+		}
+
+		level_pixels[0].free_data();
+		level_pixels[1].free_data();
+
+		texture_loader_unload(resource);
+		resource->pixels.steal(cooked);
+		resource->format = config->format;
+		resource->mip_count = (uint8)mip_count;
+
+		char shmtex_filepath[Constants::max_filepath_length];
+		get_base_filepath(resource_name, shmtex_filepath);
+		CString::append(shmtex_filepath, Constants::max_filepath_length, ".shmtex");
+		if (!write_shmtex_file(shmtex_filepath, resource, config->srgb))
+			SHMWARNV("Failed to write cooked texture file '%s'. The texture gets cooked again on the next load.", shmtex_filepath);
+
+		return true;
+
+	}
+
+	bool8 texture_loader_cook_source(const char* resource_name)
+	{
+		char shmtex_filepath[Constants::max_filepath_length];
+		get_base_filepath(resource_name, shmtex_filepath);
+		CString::append(shmtex_filepath, Constants::max_filepath_length, ".shmtex");
+
+		bool8 flip_y = true;
+		FileSystem::FileHandle f = {};
+		if (FileSystem::file_exists(shmtex_filepath) && FileSystem::file_open(shmtex_filepath, FileMode::FILE_MODE_READ, &f))
+		{
+			ShmtexFileHeader header = {};
+			uint32 bytes_read = 0;
+			if (FileSystem::read_bytes(&f, sizeof(header), &header, sizeof(header), &bytes_read) && bytes_read == sizeof(header) && header.magic == shmtex_magic)
+				flip_y = (header.flags & ShmtexFlags::FlippedY) != 0;
+			FileSystem::file_close(&f);
+		}
+
+		TextureResourceData resource = {};
+		bool8 res = cook_from_source_file(resource_name, flip_y, &resource);
+		texture_loader_unload(&resource);
+		return res;
+	}
+
+	uint64 texture_loader_get_cook_settings_hash(const char* resource_name)
+	{
+		// NOTE: Transparency only shows after decoding, so both possible configs go into the hash.
+		TextureCookConfig configs[2];
+		texture_loader_get_cook_config(resource_name, false, &configs[0]);
+		texture_loader_get_cook_config(resource_name, true, &configs[1]);
+
+		uint64 hash = hash_fnv1a64(&shmtex_file_version, sizeof(shmtex_file_version));
+		return hash_fnv1a64(configs, sizeof(configs), hash);
+	}
+
+	static bool8 load_shmtex(const char* resource_name, const void* file_data, uint64 file_size, TextureResourceData* out_resource)
+	{
+
+		const ShmtexFileHeader* header = (const ShmtexFileHeader*)file_data;
+		if (header->version != shmtex_file_version || header->format > (uint8)TextureFormat::BC7 || !header->mip_count || !header->width || !header->height)
+		{
+			SHMERRORV("Cooked texture '%s' has an unsupported version or a corrupted header.", resource_name);
+			return false;
+		}
+
+		uint64 expected_size = 0;
+		for (uint32 mip = 0; mip < header->mip_count; mip++)
+			expected_size += Renderer::texture_get_mip_size((TextureFormat)header->format, Renderer::texture_get_mip_dimension(header->width, mip), Renderer::texture_get_mip_dimension(header->height, mip));
+
+		// NOTE: Mips have to follow the header directly, texture_loader_get_mip_range relies on it.
+		if (header->data_size != expected_size || header->data_offset != sizeof(ShmtexFileHeader) || (uint64)header->data_offset + header->data_size > file_size)
+		{
+			SHMERRORV("Cooked texture '%s' is truncated or its mip chain does not match its dimensions.", resource_name);
+			return false;
+		}
+
+		out_resource->width = header->width;
+		out_resource->height = header->height;
+		out_resource->channel_count = header->channel_count;
+		out_resource->format = (TextureFormat)header->format;
+		out_resource->mip_count = header->mip_count;
+		out_resource->flipped_y = (header->flags & ShmtexFlags::FlippedY) != 0;
+		out_resource->has_transparency = (header->flags & ShmtexFlags::HasTransparency) != 0;
+		out_resource->pixels.init(header->data_size, 0, AllocationTag::Resource);
+		out_resource->pixels.copy_memory((const uint8*)file_data + header->data_offset, header->data_size);
+
+		return true;
+
+	}
+
+	static bool8 decode_source_image(const char* resource_name, const void* file_data, uint64 file_size, bool8 flip_y, TextureResourceData* out_resource)
+	{
+		const int32 required_channel_count = 4;
+		int width, height, channel_count;
+
+		stbi_set_flip_vertically_on_load_thread(flip_y);
+		uint8* pixels_data = stbi_load_from_memory((stbi_uc*)file_data, (int)file_size, &width, &height, &channel_count, required_channel_count);
+		if (!pixels_data)
+		{
+			SHMERRORV("Image resource loader failed to load texture '%s'.", resource_name);
+			return false;
+		}
+
+		out_resource->width = width;
+		out_resource->height = height;
+		out_resource->channel_count = required_channel_count;
+		out_resource->flipped_y = flip_y;
+		out_resource->format = TextureFormat::RGBA8;
+		out_resource->mip_count = 1;
+		uint32 pixel_buffer_size = out_resource->width * out_resource->height * out_resource->channel_count;
+		out_resource->pixels.init(pixel_buffer_size, 0, AllocationTag::Resource, pixels_data);
+
+		out_resource->has_transparency = false;
+		for (uint32 i = 3; i < pixel_buffer_size; i += required_channel_count)
+		{
+			if (pixels_data[i] < 255)
+			{
+				out_resource->has_transparency = true;
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	static bool8 cook_from_source_file(const char* resource_name, bool8 flip_y, TextureResourceData* out_resource)
+	{
+		Buffer file_data = {};
+		FileSystem::FileHandle f = {};
+		uint32 bytes_read = 0;
+		char source_filepath[Constants::max_filepath_length];
+
+		if (!get_source_filepath(resource_name, source_filepath))
+			return false;
+
+		if (!FileSystem::file_open(source_filepath, FileMode::FILE_MODE_READ, &f))
+		{
+			SHMERRORV("Unable to read file: %s.", source_filepath);
+			return false;
+		}
+
+		file_data.init(FileSystem::get_file_size32(&f), 0, AllocationTag::Resource);
+		bool8 read = FileSystem::read_all_bytes(&f, file_data.data, (uint32)file_data.size, &bytes_read);
+		FileSystem::file_close(&f);
+
+		bool8 decoded = read && decode_source_image(resource_name, file_data.data, file_data.size, flip_y, out_resource);
+		file_data.free_data();
+		if (!decoded)
+			return false;
+
+		TextureCookConfig config;
+		texture_loader_get_cook_config(resource_name, out_resource->has_transparency, &config);
+		return texture_loader_cook(resource_name, out_resource, &config);
+	}
+
+	static bool8 write_shmtex_file(const char* path, const TextureResourceData* resource, bool8 srgb)
+	{
+
+		FileSystem::FileHandle f;
+		if (!FileSystem::file_open(path, FILE_MODE_WRITE, &f))
+		{
+			SHMERRORV("Error opening texture file for writing: '%s'", path);
+			return false;
+		}
+		SHMDEBUGV("Writing .shmtex file '%s'...", path);
+
+		ShmtexFileHeader header = {};
+		header.magic = shmtex_magic;
+		header.version = shmtex_file_version;
+		header.format = (uint8)resource->format;
+		header.mip_count = resource->mip_count;
+		header.channel_count = resource->channel_count;
+		header.flags = (resource->flipped_y ? ShmtexFlags::FlippedY : 0) | (resource->has_transparency ? ShmtexFlags::HasTransparency : 0) | (srgb ? ShmtexFlags::Srgb : 0);
+		header.width = resource->width;
+		header.height = resource->height;
+		header.data_offset = sizeof(ShmtexFileHeader);
+		header.data_size = (uint32)resource->pixels.size;
+
+		uint32 written = 0;
+		bool8 success = FileSystem::write(&f, sizeof(header), &header, &written);
+		success = success && FileSystem::write(&f, header.data_size, resource->pixels.data, &written);
+		FileSystem::file_close(&f);
+
+		return success;
+
+	}
 
 }
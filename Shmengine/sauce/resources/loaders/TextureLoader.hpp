@@ -4,19 +4,51 @@
 #include "containers/Buffer.hpp"
 
 struct TextureConfig;
+enum class TextureFormat : uint8;
 
+namespace Renderer
+{
+	enum class TextureMipFilter : uint8;
+}
+
+// NOTE: Pixels hold all mip levels back to back, largest first.
 struct TextureResourceData
 {
 	uint8 channel_count;
 	bool8 flipped_y;
+	bool8 has_transparency;
+	TextureFormat format;
+	uint8 mip_count;
 	uint32 width;
 	uint32 height;
 	Buffer pixels;
 };
 
+struct TextureCookConfig
+{
+	TextureFormat format;
+	Renderer::TextureMipFilter mip_filter;
+	bool8 srgb;
+	bool8 generate_mips;
+};
+
 namespace ResourceSystem
 {
 	bool8 texture_loader_load(const char* resource_name, bool8 flip_y, TextureResourceData* out_resource);
+	// NOTE: Split up steps of texture_loader_load, for callers that read the file themselves.
+	bool8 texture_loader_get_filepath(const char* resource_name, char* out_filepath);
+	bool8 texture_loader_load_from_memory(const char* resource_name, const void* file_data, uint64 file_size, bool8 flip_y, TextureResourceData* out_resource);
 	void texture_loader_unload(TextureResourceData* resource);
-}
+	// NOTE: Where the mips from first_mip on sit inside the texture's .shmtex file, so streaming can read them without the larger ones. False if there is no cooked file.
+	bool8 texture_loader_get_mip_range(const char* resource_name, TextureFormat format, uint32 width, uint32 height, uint8 mip_count, uint8 first_mip, char* out_filepath, uint64* out_offset, uint64* out_size);
 
+	// NOTE: Cooked settings picked by name suffix: normal maps get BC5, diffuse and data maps (specular, roughness, metallic, occlusion, height, masks) BC1 (BC3 with alpha),
+	// everything else stays RGBA8. Only normal and data maps are treated as linear, so their mips and blocks are not computed through the sRGB curve.
+	void texture_loader_get_cook_config(const char* resource_name, bool8 has_transparency, TextureCookConfig* out_config);
+	// NOTE: Builds the mip chain and block compresses a decoded RGBA8 image, then writes it to the texture's .shmtex file. Takes ownership of the pixels.
+	bool8 texture_loader_cook(const char* resource_name, TextureResourceData* resource, const TextureCookConfig* config);
+	// NOTE: Cooks the source image into its .shmtex file. Keeps the orientation of an existing .shmtex file, so textures loaded unflipped are not cooked again on their next load.
+	bool8 texture_loader_cook_source(const char* resource_name);
+	// NOTE: Changes whenever the cook would write a different .shmtex file from the same source.
+	uint64 texture_loader_get_cook_settings_hash(const char* resource_name);
+}
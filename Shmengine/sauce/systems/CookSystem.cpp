@@ -0,0 +1,639 @@
+#include "CookSystem.hpp"
+
+#include "core/Logging.hpp"
+#include "core/Memory.hpp"
+#include "core/Console.hpp"
+#include "core/Atomic.hpp"
+#include "core/Mutex.hpp"
+#include "containers/Darray.hpp"
+#include "containers/Buffer.hpp"
+#include "platform/FileSystem.hpp"
+#include "platform/Platform.hpp"
+#include "systems/JobSystem.hpp"
+#include "resources/loaders/MeshLoader.hpp"
+#include "resources/loaders/MaterialLoader.hpp"
+#include "resources/loaders/TextureLoader.hpp"
+#include "resources/loaders/FontLoader.hpp"
+#include "resources/loaders/ShaderLoader.hpp"
+#include "utility/CString.hpp"
+#include "utility/Utility.hpp"
+
+namespace CookSystem
+{
+
+	typedef bool8 (*FP_cook)(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	typedef uint64 (*FP_cook_settings_hash)(const char* resource_name);
+
+	// NOTE: Resource names are source paths relative to source_directory, without the source extension.
+	struct AssetCooker
+	{
+		const char* source_directory;
+		const char* source_extension;
+		const char* output_directory;
+		const char* output_extension;
+		// NOTE: Lines starting with this directive name another file next to the source, which gets hashed along with it.
+		const char* dependency_directive;
+		FP_cook cook;
+		FP_cook_settings_hash settings_hash;
+		// NOTE: Cookers reading outputs of other cookers go into a later pass, which only starts once every earlier pass finished.
+		uint8 pass;
+	};
+
+	struct CookManifestHeader
+	{
+		uint32 magic;
+		uint16 version;
+		uint16 reserved;
+		uint32 entry_count;
+		uint32 entries_offset;
+	};
+
+	// NOTE: Paths are relative to the root path, the hash is taken over the normalized output path.
+	struct CookManifestEntry
+	{
+		uint64 output_path_hash;
+		uint64 source_hash;
+		uint64 settings_hash;
+		char source_path[Constants::max_filepath_length];
+		char output_path[Constants::max_filepath_length];
+	};
+
+	enum class CookResult : uint8
+	{
+		Pending,
+		UpToDate,
+		Cooked,
+		Failed
+	};
+
+	struct CookTask
+	{
+		const AssetCooker* cooker;
+		char resource_name[Constants::max_filepath_length];
+		CookManifestEntry entry;
+		CookResult result;
+	};
+
+	struct CookContext
+	{
+		CookTask* tasks;
+		uint32 task_count;
+		bool8 force;
+
+		volatile uint32 next_task;
+		volatile uint32 completed_count;
+		volatile uint32 ref_count;
+	};
+
+	struct CookJobParams
+	{
+		CookContext* context;
+	};
+
+	struct CollectContext
+	{
+		Darray<CookTask>* tasks;
+	};
+
+	struct SystemState
+	{
+		char root_path[Constants::max_filepath_length];
+		uint32 root_path_length;
+		char manifest_filepath[Constants::max_filepath_length];
+
+		// NOTE: Only replaced once a cook has finished, cook jobs read it without taking the mutex.
+		Darray<CookManifestEntry> entries;
+		Threading::Mutex entries_mutex;
+	};
+
+	static const uint32 manifest_magic = 0x4B4F4F43; // "COOK"
+	static const uint16 manifest_version = 1;
+
+	static SystemState* system_state = 0;
+
+	static bool8 _cook_mesh(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_material(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_texture(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_bitmap_font(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_distance_field_font(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_shader_stage(const char* resource_name, const char* source_filepath, const char* output_filepath);
+	static bool8 _cook_shader(const char* resource_name, const char* source_filepath, const char* output_filepath);
+
+	static uint64 _mesh_settings_hash(const char* resource_name);
+	static uint64 _material_settings_hash(const char* resource_name);
+	static uint64 _bitmap_font_settings_hash(const char* resource_name);
+	static uint64 _distance_field_font_settings_hash(const char* resource_name);
+	static uint64 _shader_stage_settings_hash(const char* resource_name);
+	static uint64 _shader_settings_hash(const char* resource_name);
+
+	static const AssetCooker asset_cookers[] =
+	{
+		{ "models/", ".obj", "models/", ".shmesh", "mtllib", _cook_mesh, _mesh_settings_hash },
+		// NOTE: Mesh cooks import .mtl files and rewrite the materials they define, so materials get cooked after them.
+		{ "materials/", ".shmt", "materials/", ".shmtb", 0, _cook_material, _material_settings_hash, 1 },
+		{ "textures/", ".tga", "textures/", ".shmtex", 0, _cook_texture, ResourceSystem::texture_loader_get_cook_settings_hash },
+		{ "textures/", ".png", "textures/", ".shmtex", 0, _cook_texture, ResourceSystem::texture_loader_get_cook_settings_hash },
+		{ "textures/", ".jpg", "textures/", ".shmtex", 0, _cook_texture, ResourceSystem::texture_loader_get_cook_settings_hash },
+		{ "textures/", ".bmp", "textures/", ".shmtex", 0, _cook_texture, ResourceSystem::texture_loader_get_cook_settings_hash },
+		{ "fonts/", ".fnt", "fonts/", ".shmbmf", 0, _cook_bitmap_font, _bitmap_font_settings_hash },
+		{ "fonts/", ".ttf", "fonts/", ".shmsdf", 0, _cook_distance_field_font, _distance_field_font_settings_hash },
+		{ "shaders/sauce/", ".vert.glsl", "shaders/bin/", ".vert.spv", "#include", _cook_shader_stage, _shader_stage_settings_hash },
+		{ "shaders/sauce/", ".frag.glsl", "shaders/bin/", ".frag.spv", "#include", _cook_shader_stage, _shader_stage_settings_hash },
+		{ "shaders/configs/", ".shadercfg", "shaders/bin/", ".shmshader", 0, _cook_shader, _shader_settings_hash, 1 }
+	};
+	static const uint32 asset_cooker_count = sizeof(asset_cookers) / sizeof(asset_cookers[0]);
+
+	static bool8 _load_manifest();
+	static bool8 _write_manifest(const Darray<CookManifestEntry>* entries);
+	static void command_cook_assets(Console::CommandContext context);
+	static void command_cook_assets_force(Console::CommandContext context);
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config)
+	{
+		SystemConfig* sys_config = (SystemConfig*)config;
+
+		system_state = (SystemState*)allocator_callback(allocator, sizeof(SystemState));
+		Memory::zero_memory(system_state, sizeof(SystemState));
+
+		system_state->root_path_length = CString::copy(sys_config->root_path, system_state->root_path, Constants::max_filepath_length);
+		CString::copy(sys_config->manifest_filepath, system_state->manifest_filepath, Constants::max_filepath_length);
+		Threading::mutex_create(&system_state->entries_mutex);
+
+		Console::register_command("cook_assets", 0, command_cook_assets);
+		Console::register_command("cook_assets_force", 0, command_cook_assets_force);
+
+		// NOTE: Without a manifest nothing counts as cooked, loaders keep probing for source formats.
+		if (FileSystem::file_exists(system_state->manifest_filepath) && !_load_manifest())
+			SHMWARNV("Failed to load cook manifest '%s'. Loaders fall back to probing for source files.", system_state->manifest_filepath);
+
+		return true;
+	}
+
+	void system_shutdown(void* state)
+	{
+		Console::unregister_command("cook_assets");
+		Console::unregister_command("cook_assets_force");
+
+		system_state->entries.free_data();
+		Threading::mutex_destroy(&system_state->entries_mutex);
+		system_state = 0;
+	}
+
+	static SHMINLINE char _normalize_path_char(char c)
+	{
+		if (c == '\\')
+			return '/';
+		if (c >= 'A' && c <= 'Z')
+			return c + ('a' - 'A');
+		return c;
+	}
+
+	static bool8 _path_equal(const char* a, const char* b)
+	{
+		for (; *a && *b; a++, b++)
+		{
+			if (_normalize_path_char(*a) != _normalize_path_char(*b))
+				return false;
+		}
+		return *a == *b;
+	}
+
+	static const CookManifestEntry* _find_entry(const char* relative_output_path, uint64 output_path_hash)
+	{
+		for (uint32 i = 0; i < system_state->entries.count; i++)
+		{
+			const CookManifestEntry* entry = &system_state->entries[i];
+			if (entry->output_path_hash == output_path_hash && _path_equal(entry->output_path, relative_output_path))
+				return entry;
+		}
+		return 0;
+	}
+
+	bool8 is_cooked(const char* output_filepath)
+	{
+		if (!system_state || !system_state->entries.count)
+			return false;
+
+		if (!CString::nequal_i(output_filepath, system_state->root_path, system_state->root_path_length))
+			return false;
+
+		const char* relative_path = &output_filepath[system_state->root_path_length];
+		uint64 hash = FileSystem::hash_path(relative_path);
+
+		Threading::mutex_lock(system_state->entries_mutex);
+		bool8 found = _find_entry(relative_path, hash) != 0;
+		Threading::mutex_unlock(system_state->entries_mutex);
+		return found;
+	}
+
+	static bool8 _has_extension(const char* path, uint32 path_length, const char* extension)
+	{
+		uint32 extension_length = CString::length(extension);
+		return path_length >= extension_length && CString::equal_i(&path[path_length - extension_length], extension);
+	}
+
+	static void _collect_source_file(const char* relative_path, void* user_data)
+	{
+		CollectContext* context = (CollectContext*)user_data;
+		uint32 path_length = CString::length(relative_path);
+
+		for (uint32 i = 0; i < asset_cooker_count; i++)
+		{
+			const AssetCooker* cooker = &asset_cookers[i];
+			uint32 directory_length = CString::length(cooker->source_directory);
+			if (!CString::nequal_i(relative_path, cooker->source_directory, directory_length) || !_has_extension(relative_path, path_length, cooker->source_extension))
+				continue;
+
+			uint32 name_length = path_length - directory_length - CString::length(cooker->source_extension);
+			if (!name_length)
+				continue;
+
+			CookTask* task = &(*context->tasks)[context->tasks->emplace()];
+			Memory::zero_memory(task, sizeof(CookTask));
+			task->cooker = cooker;
+			CString::copy(&relative_path[directory_length], task->resource_name, Constants::max_filepath_length, (int32)name_length);
+
+			CString::copy(relative_path, task->entry.source_path, Constants::max_filepath_length);
+			CString::safe_print_s<const char*, const char*, const char*>
+				(task->entry.output_path, Constants::max_filepath_length, "%s%s%s", cooker->output_directory, task->resource_name, cooker->output_extension);
+			task->entry.output_path_hash = FileSystem::hash_path(task->entry.output_path);
+			return;
+		}
+	}
+
+	static bool8 _read_file(const char* filepath, Buffer* out_content)
+	{
+		FileSystem::FileHandle f;
+		if (!FileSystem::file_open(filepath, FileMode::FILE_MODE_READ, &f))
+			return false;
+
+		uint32 bytes_read = 0;
+		uint32 file_size = FileSystem::get_file_size32(&f);
+		out_content->init(file_size + 1, 0, AllocationTag::Resource);
+		bool8 res = FileSystem::read_all_bytes(&f, out_content->data, file_size, &bytes_read) && bytes_read == file_size;
+		FileSystem::file_close(&f);
+
+		// NOTE: Terminated for the dependency scan, the terminator is not part of the hash.
+		((char*)out_content->data)[file_size] = 0;
+		return res;
+	}
+
+	// NOTE: Hashes the source content followed by every file its dependency directives name. Missing dependencies hash their name, so adding them later counts as a change.
+	static bool8 _hash_source(const AssetCooker* cooker, const char* source_filepath, uint64* out_hash)
+	{
+		Buffer content = {};
+		if (!_read_file(source_filepath, &content))
+		{
+			content.free_data();
+			return false;
+		}
+
+		const char* text = (const char*)content.data;
+		uint64 hash = hash_fnv1a64(text, content.size - 1);
+
+		if (cooker->dependency_directive)
+		{
+			uint32 directive_length = CString::length(cooker->dependency_directive);
+			int32 directory_length = CString::index_of_last(source_filepath, '/') + 1;
+
+			const char* line = text;
+			while (*line)
+			{
+				while (*line == ' ' || *line == '\t')
+					line++;
+
+				if (CString::nequal(line, cooker->dependency_directive, directive_length))
+				{
+					const char* name = &line[directive_length];
+					while (*name == ' ' || *name == '\t' || *name == '"' || *name == '<')
+						name++;
+
+					uint32 name_length = 0;
+					while (name[name_length] && name[name_length] != '"' && name[name_length] != '>' && name[name_length] != '\r' && name[name_length] != '\n')
+						name_length++;
+					while (name_length && CString::is_whitespace(name[name_length - 1]))
+						name_length--;
+
+					char dependency_filepath[Constants::max_filepath_length];
+					CString::copy(source_filepath, dependency_filepath, Constants::max_filepath_length, directory_length);
+					CString::append(dependency_filepath, Constants::max_filepath_length, name, (int32)name_length);
+
+					Buffer dependency = {};
+					if (name_length && _read_file(dependency_filepath, &dependency))
+						hash = hash_fnv1a64(dependency.data, dependency.size - 1, hash);
+					else
+						hash = hash_fnv1a64(name, name_length, hash);
+					dependency.free_data();
+				}
+
+				while (*line && *line != '\n')
+					line++;
+				if (*line)
+					line++;
+			}
+		}
+
+		content.free_data();
+		*out_hash = hash;
+		return true;
+	}
+
+	static void _run_task(CookContext* context, CookTask* task)
+	{
+		char source_filepath[Constants::max_filepath_length];
+		char output_filepath[Constants::max_filepath_length];
+		CString::concat(source_filepath, Constants::max_filepath_length, system_state->root_path, task->entry.source_path);
+		CString::concat(output_filepath, Constants::max_filepath_length, system_state->root_path, task->entry.output_path);
+
+		if (!_hash_source(task->cooker, source_filepath, &task->entry.source_hash))
+		{
+			SHMERRORV("Failed to read asset source '%s'.", source_filepath);
+			task->result = CookResult::Failed;
+			return;
+		}
+		task->entry.settings_hash = task->cooker->settings_hash(task->resource_name);
+
+		const CookManifestEntry* previous = _find_entry(task->entry.output_path, task->entry.output_path_hash);
+		if (!context->force && previous &&
+			previous->source_hash == task->entry.source_hash &&
+			previous->settings_hash == task->entry.settings_hash &&
+			FileSystem::file_exists(output_filepath))
+		{
+			task->result = CookResult::UpToDate;
+			return;
+		}
+
+		SHMDEBUGV("Cooking '%s' -> '%s'...", task->entry.source_path, task->entry.output_path);
+		if (task->cooker->cook(task->resource_name, source_filepath, output_filepath))
+		{
+			task->result = CookResult::Cooked;
+		}
+		else
+		{
+			SHMERRORV("Failed to cook asset '%s'.", source_filepath);
+			task->result = CookResult::Failed;
+		}
+	}
+
+	static void _run_claimed_tasks(CookContext* context)
+	{
+		while (true)
+		{
+			uint32 task_index = Threading::atomic_increment(&context->next_task) - 1;
+			if (task_index >= context->task_count)
+				break;
+
+			_run_task(context, &context->tasks[task_index]);
+			if (Threading::atomic_increment(&context->completed_count) == context->task_count)
+				Threading::atomic_wake_all(&context->completed_count);
+		}
+	}
+
+	static void _cook_context_release(CookContext* context)
+	{
+		if (!Threading::atomic_decrement(&context->ref_count))
+			Memory::free_memory(context);
+	}
+
+	static bool8 _cook_job(uint32 thread_index, void* user_data)
+	{
+		CookJobParams* params = (CookJobParams*)user_data;
+		_run_claimed_tasks(params->context);
+		_cook_context_release(params->context);
+		return true;
+	}
+
+	static void _run_tasks(CookTask* tasks, uint32 task_count, bool8 force)
+	{
+		CookContext* context = (CookContext*)Memory::allocate(sizeof(CookContext), AllocationTag::Resource);
+		context->tasks = tasks;
+		context->task_count = task_count;
+		context->force = force;
+		context->next_task = 0;
+		context->completed_count = 0;
+
+		uint32 helper_count = SHMIN(task_count - 1, JobSystem::get_thread_count());
+		context->ref_count = helper_count + 1;
+
+		// NOTE: Same scheme as the obj parser. Helpers go straight to idle threads, this thread works through whatever nobody picked up and then sleeps until the last task wakes it.
+		for (uint32 i = 0; i < helper_count; i++)
+		{
+			JobSystem::JobInfo job = JobSystem::job_create(_cook_job, 0, 0, sizeof(CookJobParams), JobSystem::JobTypeFlags::General, JobSystem::JobPriority::High);
+			CookJobParams* params = (CookJobParams*)job.user_data;
+			params->context = context;
+			JobSystem::submit(job);
+		}
+
+		_run_claimed_tasks(context);
+
+		uint32 completed_count;
+		while ((completed_count = Threading::atomic_load(&context->completed_count)) < task_count)
+			Threading::atomic_wait(&context->completed_count, completed_count);
+
+		_cook_context_release(context);
+	}
+
+	bool8 cook_assets(bool8 force)
+	{
+		// NOTE: Sources would get read through the mounted pack instead of the disk, and outputs written next to them would never be seen.
+		if (FileSystem::is_pack_mounted())
+		{
+			SHMERROR("Cannot cook assets while an asset pack is mounted. Remove the pack and restart to cook from loose files.");
+			return false;
+		}
+
+		float64 start_time = Platform::get_absolute_time();
+
+		Darray<CookTask> tasks(256, 0, AllocationTag::Resource);
+		CollectContext collect_context = { &tasks };
+		FileSystem::iterate_directory(system_state->root_path, _collect_source_file, &collect_context);
+
+		// NOTE: Tasks get grouped by pass, every pass runs in parallel on its own.
+		uint32 pass_begin = 0;
+		for (uint8 pass = 0; pass_begin < tasks.count; pass++)
+		{
+			uint32 pass_end = pass_begin;
+			for (uint32 i = pass_begin; i < tasks.count; i++)
+			{
+				if (tasks[i].cooker->pass != pass)
+					continue;
+
+				CookTask task = tasks[i];
+				tasks[i] = tasks[pass_end];
+				tasks[pass_end++] = task;
+			}
+
+			if (pass_end > pass_begin)
+				_run_tasks(&tasks[pass_begin], pass_end - pass_begin, force);
+			pass_begin = pass_end;
+		}
+
+		uint32 cooked_count = 0;
+		uint32 up_to_date_count = 0;
+		uint32 failed_count = 0;
+
+		// NOTE: Failed cooks drop out of the manifest, so their outputs are not trusted and they get retried next time.
+		Darray<CookManifestEntry> entries(tasks.count ? tasks.count : 1, 0, AllocationTag::Resource);
+		for (uint32 i = 0; i < tasks.count; i++)
+		{
+			switch (tasks[i].result)
+			{
+			case CookResult::Cooked: cooked_count++; break;
+			case CookResult::UpToDate: up_to_date_count++; break;
+			default: failed_count++; continue;
+			}
+
+			entries.emplace(tasks[i].entry);
+		}
+		tasks.free_data();
+
+		bool8 written = _write_manifest(&entries);
+		if (!written)
+			SHMERRORV("Failed to write cook manifest '%s'.", system_state->manifest_filepath);
+
+		Threading::mutex_lock(system_state->entries_mutex);
+		system_state->entries.free_data();
+		system_state->entries.steal(entries);
+		Threading::mutex_unlock(system_state->entries_mutex);
+
+		SHMINFOV("Cooked %u assets, %u up to date, %u failed in %lf3 ms.", cooked_count, up_to_date_count, failed_count, (Platform::get_absolute_time() - start_time) * 1000.0);
+		return written && !failed_count;
+	}
+
+	static bool8 _load_manifest()
+	{
+		Buffer content = {};
+		if (!_read_file(system_state->manifest_filepath, &content))
+		{
+			content.free_data();
+			return false;
+		}
+
+		uint64 file_size = content.size - 1;
+		const CookManifestHeader* header = (const CookManifestHeader*)content.data;
+		if (file_size < sizeof(CookManifestHeader) ||
+			header->magic != manifest_magic ||
+			header->version != manifest_version ||
+			header->entries_offset + (uint64)header->entry_count * sizeof(CookManifestEntry) > file_size)
+		{
+			content.free_data();
+			return false;
+		}
+
+		if (header->entry_count)
+		{
+			system_state->entries.init(header->entry_count, 0, AllocationTag::Resource);
+			system_state->entries.copy_memory((const CookManifestEntry*)((const uint8*)content.data + header->entries_offset), header->entry_count, 0);
+		}
+
+		SHMINFOV("Loaded cook manifest with %u cooked assets.", header->entry_count);
+		content.free_data();
+		return true;
+	}
+
+	static bool8 _write_manifest(const Darray<CookManifestEntry>* entries)
+	{
+		FileSystem::FileHandle f;
+		if (!FileSystem::file_open(system_state->manifest_filepath, FILE_MODE_WRITE, &f))
+			return false;
+
+		CookManifestHeader header = {};
+		header.magic = manifest_magic;
+		header.version = manifest_version;
+		header.entry_count = entries->count;
+		header.entries_offset = sizeof(CookManifestHeader);
+
+		uint32 written = 0;
+		uint32 entries_size = entries->count * sizeof(CookManifestEntry);
+		bool8 res = FileSystem::write(&f, sizeof(header), &header, &written) && written == sizeof(header);
+		if (res && entries_size)
+			res = FileSystem::write(&f, entries_size, entries->data, &written) && written == entries_size;
+
+		FileSystem::file_close(&f);
+		return res;
+	}
+
+	static bool8 _cook_mesh(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		return ResourceSystem::mesh_loader_cook(resource_name);
+	}
+
+	static bool8 _cook_material(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		return ResourceSystem::material_loader_cook(resource_name);
+	}
+
+	static bool8 _cook_texture(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		return ResourceSystem::texture_loader_cook_source(resource_name);
+	}
+
+	static bool8 _cook_bitmap_font(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		return ResourceSystem::font_loader_cook(resource_name, FontType::Bitmap);
+	}
+
+	static bool8 _cook_distance_field_font(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		return ResourceSystem::font_loader_cook(resource_name, FontType::DistanceField);
+	}
+
+	static bool8 _cook_shader_stage(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		char output_directory[Constants::max_filepath_length];
+		CString::copy(output_filepath, output_directory, Constants::max_filepath_length, CString::index_of_last(output_filepath, '/') + 1);
+		FileSystem::create_directory(output_directory);
+
+		return ResourceSystem::shader_loader_compile_stage(source_filepath, output_filepath);
+	}
+
+	static bool8 _cook_shader(const char* resource_name, const char* source_filepath, const char* output_filepath)
+	{
+		char output_directory[Constants::max_filepath_length];
+		CString::copy(output_filepath, output_directory, Constants::max_filepath_length, CString::index_of_last(output_filepath, '/') + 1);
+		FileSystem::create_directory(output_directory);
+
+		return ResourceSystem::shader_loader_cook(resource_name);
+	}
+
+	static uint64 _mesh_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::mesh_loader_get_cook_settings_hash();
+	}
+
+	static uint64 _material_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::material_loader_get_cook_settings_hash();
+	}
+
+	static uint64 _bitmap_font_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::font_loader_get_cook_settings_hash(FontType::Bitmap);
+	}
+
+	static uint64 _distance_field_font_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::font_loader_get_cook_settings_hash(FontType::DistanceField);
+	}
+
+	static uint64 _shader_stage_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::shader_loader_get_compile_settings_hash();
+	}
+
+	static uint64 _shader_settings_hash(const char* resource_name)
+	{
+		return ResourceSystem::shader_loader_get_cook_settings_hash(resource_name);
+	}
+
+	static void command_cook_assets(Console::CommandContext context)
+	{
+		cook_assets(false);
+	}
+
+	static void command_cook_assets_force(Console::CommandContext context)
+	{
+		cook_assets(true);
+	}
+
+}
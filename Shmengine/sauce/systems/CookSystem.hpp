@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "core/Subsystems.hpp"
+
+namespace CookSystem
+{
+	struct SystemConfig
+	{
+		// NOTE: Sources get looked up below root_path, manifest paths are stored relative to it.
+		const char* root_path;
+		const char* manifest_filepath;
+	};
+
+	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config);
+	void system_shutdown(void* state);
+
+	// NOTE: Rebuilds every cooked asset whose source, dependencies or importer settings changed since the last cook, then rewrites the manifest.
+	SHMAPI bool8 cook_assets(bool8 force);
+
+	// NOTE: True if the manifest lists the file as the up to date output of a cook. Loaders open it directly instead of probing for source formats.
+	SHMAPI bool8 is_cooked(const char* output_filepath);
+}
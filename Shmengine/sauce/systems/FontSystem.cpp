@@ -6,17 +6,95 @@
 #include "renderer/RendererFrontend.hpp"
 #include "resources/loaders/FontLoader.hpp"
 #include "utility/Sort.hpp"
+#include "systems/JobSystem.hpp"
+#include "core/Atomic.hpp"
 
+#include "vendor/stb/stb_truetype.h"
 
 namespace FontSystem
 {
+	struct FontFace
+	{
+		// NOTE: Truetype only.
+		Buffer font_binary;
+		stbtt_fontinfo info;
+		// NOTE: Atlases for sizes other than the one the font got loaded with.
+		Darray<FontAtlas*> size_variants;
+	};
+
+	struct GlyphCacheShelf
+	{
+		uint16 y;
+		uint16 height;
+		uint16 x_cursor;
+		uint32 last_used;
+	};
+
+	// NOTE: All truetype glyphs of every size get packed into rows (shelves) of one shared texture.
+	// The texture grows in height until its limit, after that the least recently used shelf gets evicted.
+	struct GlyphCache
+	{
+		inline static const uint16 width = 1024;
+		inline static const uint16 initial_height = 256;
+		inline static const uint16 max_height = 2048;
+		inline static const uint16 glyph_padding = 1;
+		inline static const char* texture_name = "_font_glyph_cache_";
+
+		Texture* texture;
+		uint16 height;
+		uint16 next_shelf_y;
+		Sarray<uint32> pixels;
+		Darray<GlyphCacheShelf> shelves;
+		Sarray<uint8> raster_scratch;
+
+		uint32 use_counter;
+		uint32 generation;
+		// NOTE: Shelves used after pinned_use_counter stay while a layout is running.
+		uint32 pinned_use_counter;
+		uint32 layout_depth;
+
+		bool8 needs_full_upload;
+		uint16 dirty_min_x;
+		uint16 dirty_min_y;
+		uint16 dirty_max_x;
+		uint16 dirty_max_y;
+	};
+
+	// NOTE: Workers claim requests one by one, the context lives until the last worker let go of it.
+	struct FontBatchLoadContext
+	{
+		const FontLoadRequest* requests;
+		FontResourceData* resources;
+		bool8* loaded;
+		uint32 request_count;
+		volatile uint32 next_request;
+		volatile uint32 completed_count;
+		volatile uint32 ref_count;
+	};
+
+	struct FontBatchLoadJobParams
+	{
+		FontBatchLoadContext* context;
+	};
+
 	struct SystemState
 	{
 		LinearHashedStorage<FontAtlas, FontId, Constants::max_font_name_length> font_storage;
+		Sarray<FontFace> font_faces;
+		GlyphCache glyph_cache;
 	};
 
-	static bool8 _create_font(FontConfig* config, FontAtlas* out_font);
+	static const uint32 glyph_not_resident = Constants::max_u32;
+	static const uint32 glyph_without_shelf = Constants::max_u32 - 1;
+
+	static bool8 _load_font_resource(const char* resource_name, uint16 font_size, bool8 distance_field, FontResourceData* out_resource);
+	static bool8 _add_font(const char* name, FontResourceData* resource);
+	static bool8 _create_font(FontConfig* config, FontId font_id, FontAtlas* out_font);
 	static void _destroy_font(FontAtlas* font);
+	static bool8 _init_truetype_atlas(FontFace* face, const char* name, FontId font_id, uint16 font_size, FontAtlas* out_atlas);
+	static bool8 _init_distance_field_variant(const FontAtlas* base, uint16 font_size, FontAtlas* out_atlas);
+	static bool8 _init_glyph_cache();
+	static bool8 _cache_glyph(FontAtlas* atlas, FontCachedGlyph* cached_glyph);
 
 	static SystemState* system_state = 0;
 
@@ -29,6 +107,8 @@ namespace FontSystem
 		void* font_storage_data = allocator_callback(allocator, font_storage_size);
 		system_state->font_storage.init(sys_config->max_font_count, AllocationTag::Font, font_storage_data);
 
+		system_state->font_faces.init(sys_config->max_font_count, 0, AllocationTag::Font);
+
 		return true;
 	}
 
@@ -42,14 +122,39 @@ namespace FontSystem
 			_destroy_font(font);
 		}
 		system_state->font_storage.destroy();
+		system_state->font_faces.free_data();
+
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (cache->texture)
+			TextureSystem::release(GlyphCache::texture_name);
+		cache->texture = 0;
+		cache->pixels.free_data();
+		cache->shelves.free_data();
+		cache->raster_scratch.free_data();
 	}
 
-	bool8 load_font(const char* name, const char* resource_name, uint16 font_size)
+	static bool8 _load_font_resource(const char* resource_name, uint16 font_size, bool8 distance_field, FontResourceData* out_resource)
+	{
+		if (distance_field)
+		{
+			if (ResourceSystem::font_loader_load_distance_field(resource_name, out_resource))
+				return true;
+
+			SHMERRORV("Failed to load distance field font resource '%s'", resource_name);
+			return false;
+		}
+
+		if (ResourceSystem::font_loader_load(resource_name, font_size, out_resource))
+			return true;
+
+		SHMERRORV("Failed to load font resource '%s'", resource_name);
+		return false;
+	}
+
+	static bool8 _add_font(const char* name, FontResourceData* resource)
 	{
 		FontId id;
 		FontAtlas* font;
-		FontResourceData resource;
-		FontConfig config;
 
 		system_state->font_storage.acquire(name, &id, &font);
 		if (!id.is_valid())
@@ -63,20 +168,123 @@ namespace FontSystem
 			return true;
 		}
 
-		resource = {};
-		goto_if_log(!ResourceSystem::font_loader_load(resource_name, font_size, &resource), fail, "Failed to load font resource");
-
-		config = ResourceSystem::font_loader_get_config_from_resource(&resource);
+		FontConfig config = ResourceSystem::font_loader_get_config_from_resource(resource);
 		config.name = name;
 
-		goto_if_log(!_create_font(&config, font), fail, "Failed to create font object");
+		if (!_create_font(&config, id, font))
+		{
+			SHMERROR("Failed to create font object");
+			system_state->font_storage.release(name, &id, &font);
+			return false;
+		}
 
+		return true;
+	}
+
+	static bool8 _load_font(const char* name, const char* resource_name, uint16 font_size, bool8 distance_field)
+	{
+		if (system_state->font_storage.get_id(name).is_valid())
+		{
+			SHMWARNV("Font named '%s' already exists!", name);
+			return true;
+		}
+
+		FontResourceData resource = {};
+		bool8 res = _load_font_resource(resource_name, font_size, distance_field, &resource) && _add_font(name, &resource);
 		ResourceSystem::font_loader_unload(&resource);
+		return res;
+	}
+
+	static void _load_claimed_font_resources(FontBatchLoadContext* context)
+	{
+		while (true)
+		{
+			uint32 request_index = Threading::atomic_increment(&context->next_request) - 1;
+			if (request_index >= context->request_count)
+				break;
+
+			const FontLoadRequest* request = &context->requests[request_index];
+			context->loaded[request_index] = _load_font_resource(request->resource_name, request->font_size, request->distance_field, &context->resources[request_index]);
+			if (Threading::atomic_increment(&context->completed_count) == context->request_count)
+				Threading::atomic_wake_all(&context->completed_count);
+		}
+	}
+
+	static void _font_batch_load_context_release(FontBatchLoadContext* context)
+	{
+		if (!Threading::atomic_decrement(&context->ref_count))
+			Memory::free_memory(context);
+	}
+
+	static bool8 _font_batch_load_job(uint32 thread_index, void* user_data)
+	{
+		FontBatchLoadJobParams* params = (FontBatchLoadJobParams*)user_data;
+		_load_claimed_font_resources(params->context);
+		_font_batch_load_context_release(params->context);
 		return true;
+	}
 
-	fail:
-		system_state->font_storage.release(name, &id, &font);
-		return false;
+	bool8 load_fonts(uint32 request_count, const FontLoadRequest* requests)
+	{
+		if (!request_count)
+			return true;
+
+		FontBatchLoadContext* context = (FontBatchLoadContext*)Memory::allocate(sizeof(FontBatchLoadContext), AllocationTag::Font);
+		context->requests = requests;
+		context->resources = (FontResourceData*)Memory::allocate(sizeof(FontResourceData) * request_count, AllocationTag::Font);
+		context->loaded = (bool8*)Memory::allocate(sizeof(bool8) * request_count, AllocationTag::Font);
+		context->request_count = request_count;
+		context->next_request = 0;
+		context->completed_count = 0;
+		for (uint32 i = 0; i < request_count; i++)
+		{
+			new (&context->resources[i]) FontResourceData();
+			context->loaded[i] = false;
+		}
+
+		uint32 helper_count = SHMIN(request_count - 1, JobSystem::get_thread_count());
+		context->ref_count = helper_count + 1;
+
+		// NOTE: Requests nobody picked up yet get loaded on this thread, so waiting only ever covers loads already running elsewhere.
+		for (uint32 i = 0; i < helper_count; i++)
+		{
+			JobSystem::JobInfo job = JobSystem::job_create(_font_batch_load_job, 0, 0, sizeof(FontBatchLoadJobParams), JobSystem::JobTypeFlags::General, JobSystem::JobPriority::High);
+			FontBatchLoadJobParams* params = (FontBatchLoadJobParams*)job.user_data;
+			params->context = context;
+			JobSystem::submit(job);
+		}
+
+		_load_claimed_font_resources(context);
+
+		uint32 completed_count;
+		while ((completed_count = Threading::atomic_load(&context->completed_count)) < request_count)
+			Threading::atomic_wait(&context->completed_count, completed_count);
+
+		// NOTE: Fonts create their textures, which stays on this thread.
+		bool8 success = true;
+		for (uint32 i = 0; i < request_count; i++)
+		{
+			if (!context->loaded[i] || !_add_font(requests[i].name, &context->resources[i]))
+				success = false;
+
+			ResourceSystem::font_loader_unload(&context->resources[i]);
+			context->resources[i].~FontResourceData();
+		}
+
+		Memory::free_memory(context->resources);
+		Memory::free_memory(context->loaded);
+		_font_batch_load_context_release(context);
+		return success;
+	}
+
+	bool8 load_font(const char* name, const char* resource_name, uint16 font_size)
+	{
+		return _load_font(name, resource_name, font_size, false);
+	}
+
+	bool8 load_distance_field_font(const char* name, const char* resource_name)
+	{
+		return _load_font(name, resource_name, 0, true);
 	}
 
 	FontId acquire(const char* font_name)
@@ -87,20 +295,477 @@ namespace FontSystem
     FontAtlas* get_atlas(FontId id, uint16 font_size)
 	{	
 		FontAtlas* atlas = system_state->font_storage.get_object(id);
-		if (atlas->font_size != font_size)
+		if (!atlas)
+			return 0;
+		if (atlas->font_size == font_size)
+			return atlas;
+		if (atlas->type != FontType::Truetype && atlas->type != FontType::DistanceField)
+			return 0;
+
+		FontFace* face = &system_state->font_faces[id];
+		for (uint32 i = 0; i < face->size_variants.count; i++)
+		{
+			if (face->size_variants[i]->font_size == font_size)
+				return face->size_variants[i];
+		}
+
+		FontAtlas* variant = (FontAtlas*)Memory::allocate(sizeof(FontAtlas), AllocationTag::Font);
+		bool8 variant_created = atlas->type == FontType::Truetype ?
+			_init_truetype_atlas(face, atlas->name, id, font_size, variant) :
+			_init_distance_field_variant(atlas, font_size, variant);
+		if (!variant_created)
+		{
+			Memory::free_memory(variant);
 			return 0;
+		}
+
+		face->size_variants.push(variant);
+		return variant;
+	}
+
+	static FontCachedGlyph* _find_cached_glyph(FontAtlas* atlas, int32 codepoint, uint32* out_insert_index)
+	{
+		uint32 low = 0;
+		uint32 high = atlas->cached_glyphs.count;
+		while (low < high)
+		{
+			uint32 mid = (low + high) / 2;
+			if (atlas->cached_glyphs[mid].glyph.codepoint < codepoint)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+
+		*out_insert_index = low;
+		if (low < atlas->cached_glyphs.count && atlas->cached_glyphs[low].glyph.codepoint == codepoint)
+			return &atlas->cached_glyphs[low];
 
+		return 0;
+	}
+
+	static const FontAtlas* _get_glyph_table(const FontAtlas* atlas)
+	{
+		// NOTE: Distance field size variants keep no glyphs of their own.
+		if (atlas->type == FontType::DistanceField && !atlas->glyphs.data)
+			return system_state->font_storage.get_object(atlas->font_id);
 		return atlas;
 	}
 
-	static bool8 _create_font(FontConfig* config, FontAtlas* out_font)
+	const FontGlyph* get_glyph(FontAtlas* atlas, int32 codepoint)
+	{
+		if (atlas->type != FontType::Truetype)
+		{
+			const FontAtlas* table = _get_glyph_table(atlas);
+			return (codepoint >= 0 && codepoint < (int32)table->glyphs.capacity) ? &table->glyphs[codepoint] : 0;
+		}
+
+		uint32 insert_index;
+		FontCachedGlyph* cached_glyph = _find_cached_glyph(atlas, codepoint, &insert_index);
+		if (!cached_glyph)
+		{
+			FontFace* face = &system_state->font_faces[atlas->font_id];
+
+			int32 advance, left_side_bearing;
+			stbtt_GetCodepointHMetrics(&face->info, codepoint, &advance, &left_side_bearing);
+			int32 x0, y0, x1, y1;
+			stbtt_GetCodepointBitmapBox(&face->info, codepoint, atlas->scale, atlas->scale, &x0, &y0, &x1, &y1);
+
+			FontCachedGlyph new_glyph = {};
+			new_glyph.glyph.codepoint = codepoint;
+			new_glyph.glyph.width = (uint16)(x1 - x0);
+			new_glyph.glyph.height = (uint16)(y1 - y0);
+			new_glyph.glyph.x_offset = (int16)x0;
+			new_glyph.glyph.y_offset = (int16)y0;
+			new_glyph.glyph.x_advance = (int16)(advance * atlas->scale + 0.5f);
+			new_glyph.glyph.kernings_offset = Constants::max_u32;
+			new_glyph.shelf_index = glyph_not_resident;
+			cached_glyph = atlas->cached_glyphs.insert_at(new_glyph, insert_index);
+		}
+
+		if (cached_glyph->shelf_index == glyph_not_resident && !_cache_glyph(atlas, cached_glyph))
+			return 0;
+
+		GlyphCache* cache = &system_state->glyph_cache;
+		cached_glyph->last_used = ++cache->use_counter;
+		if (cached_glyph->shelf_index != glyph_without_shelf)
+			cache->shelves[cached_glyph->shelf_index].last_used = cache->use_counter;
+
+		return &cached_glyph->glyph;
+	}
+
+	int16 get_kerning(const FontAtlas* atlas, int32 codepoint_0, int32 codepoint_1)
+	{
+		// NOTE: stb_truetype resolves kerning from both the kern and the GPOS table.
+		if (atlas->type == FontType::Truetype)
+		{
+			FontFace* face = &system_state->font_faces[atlas->font_id];
+			float32 kerning = stbtt_GetCodepointKernAdvance(&face->info, codepoint_0, codepoint_1) * atlas->scale;
+			return (int16)(kerning < 0.0f ? kerning - 0.5f : kerning + 0.5f);
+		}
+
+		atlas = _get_glyph_table(atlas);
+		if (codepoint_0 < 0 || codepoint_0 >= (int32)atlas->glyphs.capacity)
+			return 0;
+
+		// NOTE: Kernings are sorted by pair, the glyph points at the first one for its codepoint.
+		for (uint32 i = atlas->glyphs[codepoint_0].kernings_offset; i < atlas->kernings.count; i++)
+		{
+			const FontKerning* kerning = &atlas->kernings[i];
+			if (kerning->codepoint_0 != codepoint_0 || kerning->codepoint_1 > codepoint_1)
+				break;
+			if (kerning->codepoint_1 == codepoint_1)
+				return kerning->advance;
+		}
+
+		return 0;
+	}
+
+	uint32 get_glyph_generation(const FontAtlas* atlas)
+	{
+		return atlas->type == FontType::Truetype ? system_state->glyph_cache.generation : 0;
+	}
+
+	static void _mark_glyph_cache_dirty(uint16 x, uint16 y, uint16 width, uint16 height)
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		cache->dirty_min_x = SHMIN(cache->dirty_min_x, x);
+		cache->dirty_min_y = SHMIN(cache->dirty_min_y, y);
+		cache->dirty_max_x = SHMAX(cache->dirty_max_x, (uint16)(x + width));
+		cache->dirty_max_y = SHMAX(cache->dirty_max_y, (uint16)(y + height));
+	}
+
+	static void _reset_glyph_cache_dirty_region()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		cache->needs_full_upload = false;
+		cache->dirty_min_x = GlyphCache::width;
+		cache->dirty_min_y = cache->height;
+		cache->dirty_max_x = 0;
+		cache->dirty_max_y = 0;
+	}
+
+	void begin_glyph_layout()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (!cache->layout_depth++)
+			cache->pinned_use_counter = cache->use_counter;
+	}
+
+	void end_glyph_layout()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (cache->layout_depth)
+			cache->layout_depth--;
+	}
+
+	void flush_glyph_cache()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (!cache->texture)
+			return;
+
+		if (cache->needs_full_upload)
+		{
+			if (cache->texture->height != cache->height)
+				TextureSystem::resize(cache->texture, GlyphCache::width, cache->height, true);
+			TextureSystem::write_to_texture(cache->texture, 0, (uint32)cache->pixels.size(), (uint8*)cache->pixels.data);
+		}
+		else if (cache->dirty_min_x < cache->dirty_max_x && cache->dirty_min_y < cache->dirty_max_y)
+		{
+			uint32 region_width = cache->dirty_max_x - cache->dirty_min_x;
+			uint32 region_height = cache->dirty_max_y - cache->dirty_min_y;
+
+			Sarray<uint32> region_pixels(region_width * region_height, 0, AllocationTag::Font);
+			for (uint32 row = 0; row < region_height; row++)
+				region_pixels.copy_memory(&cache->pixels[(cache->dirty_min_y + row) * GlyphCache::width + cache->dirty_min_x], region_width, row * region_width);
+
+			Renderer::texture_write_region(cache->texture, cache->dirty_min_x, cache->dirty_min_y, region_width, region_height, (uint8*)region_pixels.data);
+			region_pixels.free_data();
+		}
+
+		_reset_glyph_cache_dirty_region();
+	}
+
+	static void _invalidate_glyph_cache_atlases(uint32 evicted_shelf_index)
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+
+		// NOTE: Visits every truetype atlas, dropping glyphs of the evicted shelf and picking up the new cache height.
+		auto iter = system_state->font_storage.get_iterator();
+		while (FontAtlas* font = iter.get_next())
+		{
+			if (font->type != FontType::Truetype)
+				continue;
+
+			FontFace* face = &system_state->font_faces[font->font_id];
+			for (uint32 variant_i = 0; variant_i <= face->size_variants.count; variant_i++)
+			{
+				FontAtlas* atlas = variant_i < face->size_variants.count ? face->size_variants[variant_i] : font;
+				atlas->atlas_size_y = cache->height;
+
+				if (evicted_shelf_index == Constants::max_u32)
+					continue;
+
+				for (uint32 glyph_i = 0; glyph_i < atlas->cached_glyphs.count; glyph_i++)
+				{
+					if (atlas->cached_glyphs[glyph_i].shelf_index == evicted_shelf_index)
+						atlas->cached_glyphs[glyph_i].shelf_index = glyph_not_resident;
+				}
+			}
+		}
+
+		cache->generation++;
+	}
+
+	static bool8 _grow_glyph_cache()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (cache->height >= GlyphCache::max_height)
+			return false;
+
+		// NOTE: Rows keep their layout when growing in height, so the old pixels stay valid at the front.
+		cache->height = SHMIN((uint16)(cache->height * 2), GlyphCache::max_height);
+		cache->pixels.resize(GlyphCache::width * cache->height);
+		cache->needs_full_upload = true;
+
+		_invalidate_glyph_cache_atlases(Constants::max_u32);
+		return true;
+	}
+
+	static bool8 _allocate_glyph_rect(uint16 width, uint16 height, uint32* out_shelf_index, uint16* out_x, uint16* out_y)
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (width > GlyphCache::width || height > GlyphCache::max_height)
+			return false;
+
+		// NOTE: Shelf heights get rounded up, so glyphs of similar size end up sharing rows.
+		uint16 shelf_height = (height + 3) & ~3;
+
+		uint32 best_shelf = Constants::max_u32;
+		for (uint32 i = 0; i < cache->shelves.count; i++)
+		{
+			GlyphCacheShelf* shelf = &cache->shelves[i];
+			if (shelf->height < shelf_height || shelf->height > shelf_height + shelf_height / 2 || GlyphCache::width - shelf->x_cursor < width)
+				continue;
+			if (best_shelf == Constants::max_u32 || shelf->height < cache->shelves[best_shelf].height)
+				best_shelf = i;
+		}
+
+		if (best_shelf == Constants::max_u32)
+		{
+			while (cache->next_shelf_y + shelf_height > cache->height && _grow_glyph_cache());
+
+			if (cache->next_shelf_y + shelf_height <= cache->height)
+			{
+				GlyphCacheShelf new_shelf = { .y = cache->next_shelf_y, .height = shelf_height, .x_cursor = 0, .last_used = 0 };
+				cache->next_shelf_y += shelf_height;
+				best_shelf = cache->shelves.push(new_shelf);
+			}
+			else
+			{
+				for (uint32 i = 0; i < cache->shelves.count; i++)
+				{
+					GlyphCacheShelf* shelf = &cache->shelves[i];
+					if (shelf->height < shelf_height || shelf->last_used == cache->use_counter || (cache->layout_depth && shelf->last_used > cache->pinned_use_counter))
+						continue;
+					if (best_shelf == Constants::max_u32 || shelf->last_used < cache->shelves[best_shelf].last_used)
+						best_shelf = i;
+				}
+
+				if (best_shelf == Constants::max_u32)
+					return false;
+
+				GlyphCacheShelf* evicted = &cache->shelves[best_shelf];
+				evicted->x_cursor = 0;
+				for (uint32 row = 0; row < evicted->height; row++)
+					Memory::zero_memory(&cache->pixels[(evicted->y + row) * GlyphCache::width], GlyphCache::width * sizeof(uint32));
+				_mark_glyph_cache_dirty(0, evicted->y, GlyphCache::width, evicted->height);
+
+				_invalidate_glyph_cache_atlases(best_shelf);
+			}
+		}
+
+		GlyphCacheShelf* shelf = &cache->shelves[best_shelf];
+		*out_shelf_index = best_shelf;
+		*out_x = shelf->x_cursor;
+		*out_y = shelf->y;
+		shelf->x_cursor += width;
+		return true;
+	}
+
+	static bool8 _cache_glyph(FontAtlas* atlas, FontCachedGlyph* cached_glyph)
+	{
+		FontGlyph* glyph = &cached_glyph->glyph;
+		if (!glyph->width || !glyph->height)
+		{
+			cached_glyph->shelf_index = glyph_without_shelf;
+			return true;
+		}
+
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (!cache->texture && !_init_glyph_cache())
+			return false;
+
+		uint32 shelf_index;
+		uint16 x, y;
+		if (!_allocate_glyph_rect(glyph->width + GlyphCache::glyph_padding, glyph->height + GlyphCache::glyph_padding, &shelf_index, &x, &y))
+		{
+			SHMWARNV("Glyph cache is out of space for codepoint %i of font '%s'.", glyph->codepoint, atlas->name);
+			return false;
+		}
+
+		uint32 raster_size = glyph->width * glyph->height;
+		if (cache->raster_scratch.capacity < raster_size)
+		{
+			cache->raster_scratch.free_data();
+			cache->raster_scratch.init(raster_size, 0, AllocationTag::Font);
+		}
+
+		FontFace* face = &system_state->font_faces[atlas->font_id];
+		stbtt_MakeCodepointBitmap(&face->info, cache->raster_scratch.data, glyph->width, glyph->height, glyph->width, atlas->scale, atlas->scale, glyph->codepoint);
+
+		for (uint32 row = 0; row < glyph->height; row++)
+		{
+			uint32* dst = &cache->pixels[(y + row) * GlyphCache::width + x];
+			const uint8* src = &cache->raster_scratch[row * glyph->width];
+			for (uint32 col = 0; col < glyph->width; col++)
+				dst[col] = ((uint32)src[col] << 24) + ((uint32)src[col] << 16) + ((uint32)src[col] << 8) + (uint32)src[col];
+		}
+		_mark_glyph_cache_dirty(x, y, glyph->width, glyph->height);
+
+		glyph->x = x;
+		glyph->y = y;
+		cached_glyph->shelf_index = shelf_index;
+		return true;
+	}
+
+	static bool8 _init_glyph_cache()
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		cache->height = GlyphCache::initial_height;
+		cache->next_shelf_y = 0;
+		cache->pixels.init(GlyphCache::width * cache->height, 0, AllocationTag::Font);
+		cache->shelves.init(64, 0, AllocationTag::Font);
+		cache->use_counter = 0;
+		cache->pinned_use_counter = 0;
+		_reset_glyph_cache_dirty_region();
+
+		cache->texture = TextureSystem::acquire_writable(GlyphCache::texture_name, GlyphCache::width, cache->height, 4, true);
+		if (!cache->texture)
+		{
+			SHMERROR("Failed to create glyph cache texture.");
+			cache->pixels.free_data();
+			cache->shelves.free_data();
+			return false;
+		}
+
+		TextureSystem::write_to_texture(cache->texture, 0, (uint32)cache->pixels.size(), (uint8*)cache->pixels.data);
+		return true;
+	}
+
+	static bool8 _init_truetype_atlas(FontFace* face, const char* name, FontId font_id, uint16 font_size, FontAtlas* out_atlas)
+	{
+		GlyphCache* cache = &system_state->glyph_cache;
+		if (!cache->texture && !_init_glyph_cache())
+			return false;
+
+		CString::copy(name, out_atlas->name, Constants::max_font_name_length);
+		out_atlas->type = FontType::Truetype;
+		out_atlas->font_id = font_id;
+		out_atlas->font_size = font_size;
+		out_atlas->scale = stbtt_ScaleForPixelHeight(&face->info, (float32)font_size);
+		out_atlas->render_scale = 1.0f;
+
+		int32 ascent, descent, line_gap;
+		stbtt_GetFontVMetrics(&face->info, &ascent, &descent, &line_gap);
+		out_atlas->line_height = (uint16)((ascent - descent + line_gap) * out_atlas->scale);
+		out_atlas->baseline = (int16)(ascent * out_atlas->scale);
+
+		out_atlas->atlas_size_x = GlyphCache::width;
+		out_atlas->atlas_size_y = cache->height;
+		out_atlas->cached_glyphs.init(128, 0, AllocationTag::Font);
+
+		TextureMapConfig map_config = {};
+		map_config.filter_magnify = map_config.filter_minify = TextureFilter::LINEAR;
+		map_config.repeat_u = map_config.repeat_v = map_config.repeat_w = TextureRepeat::CLAMP_TO_EDGE;
+		if (!Renderer::texture_map_init(&map_config, cache->texture, &out_atlas->map))
+		{
+			SHMERROR("Unable to acquire resources for font atlas texture map.");
+			out_atlas->cached_glyphs.free_data();
+			return false;
+		}
+
+		return true;
+	}
+
+	static bool8 _init_distance_field_variant(const FontAtlas* base, uint16 font_size, FontAtlas* out_atlas)
 	{
+		CString::copy(base->name, out_atlas->name, Constants::max_font_name_length);
+		out_atlas->type = FontType::DistanceField;
+		out_atlas->font_id = base->font_id;
+		out_atlas->font_size = font_size;
+		out_atlas->render_scale = (float32)font_size / base->font_size;
+		out_atlas->line_height = (uint16)(base->line_height * out_atlas->render_scale + 0.5f);
+		out_atlas->baseline = (int16)(base->baseline * out_atlas->render_scale + 0.5f);
+		out_atlas->atlas_size_x = base->atlas_size_x;
+		out_atlas->atlas_size_y = base->atlas_size_y;
+
 		TextureMapConfig map_config = {};
+		map_config.filter_magnify = map_config.filter_minify = TextureFilter::LINEAR;
+		map_config.repeat_u = map_config.repeat_v = map_config.repeat_w = TextureRepeat::CLAMP_TO_EDGE;
+		if (!Renderer::texture_map_init(&map_config, base->map.texture, &out_atlas->map))
+		{
+			SHMERROR("Unable to acquire resources for font atlas texture map.");
+			return false;
+		}
+
+		return true;
+	}
+
+	static Texture* _create_distance_field_texture(FontConfig* config)
+	{
+		char texture_name[Constants::max_texture_name_length];
+		CString::safe_print_s<const char*>(texture_name, Constants::max_texture_name_length, "_font_sdf_%s_", config->name);
+
+		Texture* texture = TextureSystem::acquire_writable(texture_name, config->atlas_size_x, config->atlas_size_y, 1, true);
+		if (!texture)
+			return 0;
+
+		// NOTE: Single channel texture, the ui shader reads the distances from red.
+		TextureSystem::write_to_texture(texture, 0, (uint32)config->atlas_size_x * config->atlas_size_y, config->distance_field);
+		return texture;
+	}
+
+	static bool8 _create_font(FontConfig* config, FontId font_id, FontAtlas* out_font)
+	{
+		TextureMapConfig map_config = {};
+
+		if (config->type == FontType::Truetype)
+		{
+			// NOTE: The font file has to outlive the resource, stb_truetype reads glyph outlines from it on demand.
+			FontFace* face = &system_state->font_faces[font_id];
+			face->font_binary.init(config->font_binary_size, 0, AllocationTag::Font);
+			face->font_binary.copy_memory(config->font_binary, config->font_binary_size);
+			face->size_variants.init(4, 0, AllocationTag::Font);
+
+			if (!stbtt_InitFont(&face->info, (unsigned char*)face->font_binary.data, 0) ||
+				!_init_truetype_atlas(face, config->name, font_id, config->font_size, out_font))
+			{
+				SHMERRORV("Failed to create truetype font '%s'.", config->name);
+				face->font_binary.free_data();
+				face->size_variants.free_data();
+				return false;
+			}
+
+			return true;
+		}
 
 		CString::copy(config->name, out_font->name, Constants::max_font_name_length);
 		
 		out_font->type = config->type;
+		out_font->font_id = font_id;
 		out_font->font_size = config->font_size;
+		out_font->render_scale = 1.0f;
 		out_font->atlas_size_x = config->atlas_size_x;
 		out_font->atlas_size_y = config->atlas_size_y;
 		out_font->baseline = config->baseline;
@@ -131,17 +796,14 @@ namespace FontSystem
         }
 
 		Texture* atlas_texture = 0;
-		if (config->texture_name)
+		if (config->type == FontType::DistanceField)
 		{
-			atlas_texture = TextureSystem::acquire(config->texture_name, TextureType::Plane, true);
+			system_state->font_faces[font_id].size_variants.init(4, 0, AllocationTag::Font);
+			atlas_texture = _create_distance_field_texture(config);
 		}
-		else if (config->texture_buffer && config->texture_buffer_size)
+		else
 		{
-			char font_texture_name[Constants::max_texture_name_length];
-			CString::print_s(font_texture_name, sizeof(font_texture_name), "_font_%s_sz%u_", out_font->name, out_font->font_size);
-			atlas_texture = TextureSystem::acquire_writable(font_texture_name, out_font->atlas_size_x, out_font->atlas_size_y, 4, true);
-			if (atlas_texture)
-				TextureSystem::write_to_texture(atlas_texture, 0, config->texture_buffer_size, (uint8*)config->texture_buffer);
+			atlas_texture = TextureSystem::acquire(config->texture_name, TextureType::Plane, true);
 		}
 		goto_if_log(!atlas_texture, fail, "Unable to acquire texture for font atlas.");
 
@@ -158,9 +820,24 @@ namespace FontSystem
 
 	static void _destroy_font(FontAtlas* font)
 	{
+		if (font->type == FontType::Truetype || font->type == FontType::DistanceField)
+		{
+			FontFace* face = &system_state->font_faces[font->font_id];
+			for (uint32 i = 0; i < face->size_variants.count; i++)
+			{
+				FontAtlas* variant = face->size_variants[i];
+				Renderer::texture_map_destroy(&variant->map);
+				variant->cached_glyphs.free_data();
+				Memory::free_memory(variant);
+			}
+			face->size_variants.free_data();
+			face->font_binary.free_data();
+		}
+		font->cached_glyphs.free_data();
+
 		Renderer::texture_map_destroy(&font->map);
 
-		if (font->type == FontType::Bitmap && font->map.texture)
+		if (font->type != FontType::Truetype && font->map.texture)
 			TextureSystem::release(font->map.texture->name);
 		font->map.texture = 0;
 		font->glyphs.free_data();
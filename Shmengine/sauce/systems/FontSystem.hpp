@@ -30,11 +30,18 @@ struct FontGlyph {
 	uint32 kernings_offset;
 };
 
+struct FontCachedGlyph {
+	FontGlyph glyph;
+	uint32 shelf_index;
+	uint32 last_used;
+};
+
 enum class FontType : uint8
 {
 	None = 0,
 	Bitmap,
-	Truetype
+	Truetype,
+	DistanceField
 };
 
 struct FontConfig
@@ -51,8 +58,9 @@ struct FontConfig
 	FontGlyph* glyphs;
 	FontKerning* kernings;
 	const char* texture_name;
-	uint32 texture_buffer_size;
-	uint32* texture_buffer;
+	uint32 font_binary_size;
+	const uint8* font_binary;
+	const uint8* distance_field;
 };
 
 typedef Id16 FontId;
@@ -66,9 +74,16 @@ struct FontAtlas
 	int16 baseline;
 	uint16 atlas_size_x;
 	uint16 atlas_size_y;
+	// NOTE: Factor applied to glyph metrics when laying out text. Distance field atlases of any size share the glyphs of the base size.
+	float32 render_scale;
 	TextureMap map;
 	Sarray<FontGlyph> glyphs;
 	Darray<FontKerning> kernings;
+
+	// NOTE: Truetype only. Glyphs requested so far, sorted by codepoint and rasterized into the shared glyph cache.
+	FontId font_id;
+	float32 scale;
+	Darray<FontCachedGlyph> cached_glyphs;
 };
 
 namespace FontSystem
@@ -78,11 +93,36 @@ namespace FontSystem
 		uint8 max_font_count;
 	};	
 
+	struct FontLoadRequest
+	{
+		const char* name;
+		const char* resource_name;
+		uint16 font_size;
+		bool8 distance_field;
+	};
+
 	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config);
 	void system_shutdown(void* state);
 
 	SHMAPI bool8 load_font(const char* name, const char* resource_name, uint16 font_size);
+	// NOTE: Renders at any size from a single atlas, meant for scalable ui and world space text.
+	SHMAPI bool8 load_distance_field_font(const char* name, const char* resource_name);
+	// NOTE: Loads the font resources on the job threads and the calling thread at once, then creates the fonts on the calling thread. Meant for preloads.
+	SHMAPI bool8 load_fonts(uint32 request_count, const FontLoadRequest* requests);
 
 	FontId acquire(const char* font_name);
+	// NOTE: Truetype fonts create atlases for new sizes on demand, all of them sharing one glyph cache texture.
+	// Distance field fonts do the same, sharing the texture and glyphs of the base size.
 	FontAtlas* get_atlas(FontId id, uint16 font_size);
+	// NOTE: Rasterizes truetype glyphs on first use. The pointer stays valid until the next glyph request for the atlas.
+	const FontGlyph* get_glyph(FontAtlas* atlas, int32 codepoint);
+	int16 get_kerning(const FontAtlas* atlas, int32 codepoint_0, int32 codepoint_1);
+
+	// NOTE: Changes whenever cached glyphs move or get evicted, so geometry referencing the atlas has to be rebuilt.
+	uint32 get_glyph_generation(const FontAtlas* atlas);
+	// NOTE: Shelves holding glyphs requested between begin and end are not evicted until the outermost end, so a layout never loses glyphs it already placed.
+	void begin_glyph_layout();
+	void end_glyph_layout();
+	// NOTE: Uploads the glyph cache region touched since the last flush.
+	void flush_glyph_cache();
 }
\ No newline at end of file
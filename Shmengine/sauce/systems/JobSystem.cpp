@@ -4,6 +4,7 @@
 #include "core/Mutex.hpp"
 #include "core/Logging.hpp"
 #include "core/FrameData.hpp"
+#include "platform/Platform.hpp"
 #include "containers/RingQueue.hpp"
 
 #include "optick.h"
@@ -113,8 +114,11 @@ namespace JobSystem
 		system_state->normal_prio_queue.free_data();
 		system_state->high_prio_queue.free_data();
 
+		// NOTE: Threads finish their current job and hand back their log rings before the handles go away.
 		for (uint32 i = 0; i < system_state->job_threads.capacity; i++)
 		{
+			while (Threading::thread_is_active(&system_state->job_threads[i].thread))
+				Platform::sleep(1);
 			Threading::thread_destroy(&system_state->job_threads[i].thread);
 		}
 			
@@ -219,6 +223,11 @@ namespace JobSystem
 
 	}
 
+	uint32 get_thread_count()
+	{
+		return system_state ? system_state->job_threads.capacity : 0;
+	}
+
 	JobInfo job_create(FP_job_start entry_point, FP_job_on_complete on_success, FP_job_on_complete on_failure, uint32 user_data_size, JobTypeFlags::Value type_flags, JobPriority priority)
 	{
 		JobInfo info = {};
@@ -302,6 +311,7 @@ namespace JobSystem
 		}
 
 		Threading::mutex_destroy(&thread->info_mutex);
+		Log::release_thread_ring();
 		return 1;
 	}
 
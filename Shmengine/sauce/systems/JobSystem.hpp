@@ -57,6 +57,8 @@ namespace JobSystem
 
 	SHMAPI void submit(JobInfo info);
 
+	SHMAPI uint32 get_thread_count();
+
 	SHMAPI JobInfo job_create(FP_job_start entry_point, FP_job_on_complete on_success, FP_job_on_complete on_failure, uint32 user_data_size, JobTypeFlags::Value type = JobTypeFlags::General, JobPriority priority = JobPriority::Normal);
 
 }
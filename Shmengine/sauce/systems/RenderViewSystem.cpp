@@ -126,6 +126,7 @@ namespace RenderViewSystem
 		out_view->width = config->width;
 		out_view->height = config->height;
 		out_view->enabled = true;
+		out_view->fov = 0.0f;
 
 		out_view->on_build_packet = config->on_build_packet;
 		out_view->on_end_frame = config->on_end_frame;
@@ -249,6 +250,87 @@ namespace RenderViewSystem
 		return meshes_draw(mesh, 1, lighting, frame_data, frustum, view_id, shader_id);
 	}
 
+	// NOTE: Lod errors get projected to the screen as a fraction of half the screen height.
+	static const float32 lod_screen_error_threshold = 0.002f;
+	static const float32 lod_hysteresis = 0.25f;
+
+	struct MeshProjection
+	{
+		float32 world_radius;
+		// NOTE: Converts object space lengths to fractions of half the screen height. 0 if the camera is inside the bounds or the view has no perspective projection.
+		float32 error_scale;
+		float32 screen_scale;
+	};
+
+	static MeshProjection mesh_project(Mesh* m, const Math::Mat4& model, Math::Vec3f camera_position, float32 fov)
+	{
+		MeshProjection projection = {};
+
+		Math::Vec3f center = Math::vec_mul_mat(m->center, model);
+		Math::Vec3f extents_max = Math::vec_mul_mat(m->extents.max, model);
+		float32 object_radius = Math::length(m->extents.max - m->center);
+		projection.world_radius = Math::length(extents_max - center);
+
+		float32 distance = Math::vec_distance(center, camera_position) - projection.world_radius;
+		if (distance <= 0.0f || fov <= 0.0f)
+			return projection;
+
+		float32 scale = object_radius > 0.0f ? projection.world_radius / object_radius : 1.0f;
+		projection.screen_scale = 1.0f / (distance * Math::tan(fov * 0.5f));
+		projection.error_scale = scale * projection.screen_scale;
+		return projection;
+	}
+
+	static uint32 mesh_select_lod(Mesh* m, const MeshProjection& projection)
+	{
+		if (m->lod_count < 2)
+			return 0;
+
+		if (projection.error_scale <= 0.0f)
+		{
+			m->current_lod = 0;
+			return 0;
+		}
+
+		float32 error_scale = projection.error_scale;
+
+		// NOTE: Coarser lods need to stay below the threshold by the hysteresis margin, finer ones are picked as soon as the current lod exceeds it.
+		uint32 lod = m->current_lod < m->lod_count ? m->current_lod : 0;
+		if (m->lod_errors[lod] * error_scale > lod_screen_error_threshold)
+		{
+			while (lod > 0 && m->lod_errors[lod] * error_scale > lod_screen_error_threshold)
+				lod--;
+		}
+		else
+		{
+			while (lod + 1 < m->lod_count && m->lod_errors[lod + 1] * error_scale <= lod_screen_error_threshold * (1.0f - lod_hysteresis))
+				lod++;
+		}
+
+		m->current_lod = lod;
+		return lod;
+	}
+
+	// NOTE: Streamed textures count as stretched across the screen diameter of the mesh bounds. Meshes the camera is inside of ask for full resolution.
+	static const float32 texture_stream_full_resolution_size = 65536.0f;
+
+	static float32 mesh_get_screen_size(const MeshProjection& projection, uint32 viewport_height)
+	{
+		if (projection.screen_scale <= 0.0f)
+			return texture_stream_full_resolution_size;
+
+		return projection.world_radius * projection.screen_scale * (float32)viewport_height;
+	}
+
+	static void material_request_texture_mips(Material* material, float32 screen_size)
+	{
+		for (uint32 i = 0; i < material->maps.capacity; i++)
+		{
+			if (material->maps[i].texture)
+				Renderer::texture_request_screen_size(material->maps[i].texture, screen_size);
+		}
+	}
+
 	uint32 meshes_draw(Mesh* meshes, uint32 mesh_count, LightingInfo lighting, FrameData* frame_data, const Math::Frustum* frustum, RenderViewId view_id, ShaderId shader_id)
 	{
 		if (!view_id.is_valid())
@@ -265,6 +347,8 @@ namespace RenderViewSystem
 		packet_data.instances_pushed_count = 0;
 		packet_data.objects_pushed_count = 0;
 
+		Math::Vec3f camera_position = get_bound_world_camera()->get_position();
+
 		for (uint32 i = 0; i < mesh_count; i++)
 		{
 			Mesh* m = &meshes[i];
@@ -277,6 +361,10 @@ namespace RenderViewSystem
 			object_data->lighting = lighting;
 			packet_data.objects_pushed_count++;
 
+			MeshProjection projection = mesh_project(m, object_data->model, camera_position, view->fov);
+			uint32 lod_index = mesh_select_lod(m, projection);
+			float32 screen_size = mesh_get_screen_size(projection, view->height);
+
 			for (uint32 j = 0; j < m->geometries.capacity; j++)
 			{
 				MeshGeometry* g = &m->geometries[j];
@@ -296,12 +384,14 @@ namespace RenderViewSystem
 					Material* material = MaterialSystem::get_material(g->material_id);
 					if (material->state != ResourceState::Initialized)
 						material = MaterialSystem::get_default_material();
+					material_request_texture_mips(material, screen_size);
 
 					RenderViewGeometryData* geo_render_data = &view->geometries[view->geometries.emplace()];
 					geo_render_data->object_index = view->objects.count - 1;
 					geo_render_data->shader_instance_id = material->shader_instance_id;
 					geo_render_data->shader_id = shader_id;
 					geo_render_data->geometry_data = &g->geometry_data;
+					geo_render_data->lod_index = lod_index;
 					geo_render_data->has_transparency = (material->maps[0].texture->flags & TextureFlags::HasTransparency);
 					packet_data.geometries_pushed_count++;
 
@@ -370,6 +460,8 @@ namespace RenderViewSystem
 			Material* material = MaterialSystem::get_material(terrain->material_ids[mat_i]);
 			if (material->state != ResourceState::Initialized)
 				material = MaterialSystem::get_default_material();
+			// NOTE: Terrain materials tile across the whole surface, so their textures always ask for full resolution.
+			material_request_texture_mips(material, texture_stream_full_resolution_size);
 
 			out_instance_data->texture_maps[mat_i * 3] = &material->maps[0];
 			out_instance_data->texture_maps[mat_i * 3 + 1] = &material->maps[1];
@@ -429,12 +521,15 @@ namespace RenderViewSystem
 
 	static void ui_text_get_instance_render_data(UIText* text, FrameData* frame_data, ShaderId shader_id, RenderViewInstanceData* out_instance_data)
 	{
+		static MaterialUIProperties bitmap_properties = { .diffuse_color = { 1.0f, 1.0f, 1.0f, 1.0f }, .distance_field = 0.0f };
+		static MaterialUIProperties distance_field_properties = { .diffuse_color = { 1.0f, 1.0f, 1.0f, 1.0f }, .distance_field = 1.0f };
+
+		FontAtlas* atlas = FontSystem::get_atlas(text->font_id, text->font_size);
 		out_instance_data->shader_id = shader_id;
-		static Math::Vec4f white_color = { 1.0f, 1.0f, 1.0f, 1.0f };
-		out_instance_data->instance_properties = &white_color;
+		out_instance_data->instance_properties = atlas->type == FontType::DistanceField ? &distance_field_properties : &bitmap_properties;
 		out_instance_data->texture_maps_count = 1;
 		out_instance_data->texture_maps = (TextureMap**)frame_data->frame_allocator.allocate(sizeof(TextureMap*) * out_instance_data->texture_maps_count);
-		out_instance_data->texture_maps[0] = &FontSystem::get_atlas(text->font_id, text->font_size)->map;
+		out_instance_data->texture_maps[0] = &atlas->map;
 		out_instance_data->shader_instance_id = text->shader_instance_id;
 	}
 
@@ -46,6 +46,7 @@ struct RenderViewGeometryData
 	ShaderInstanceId shader_instance_id;
 	uint32 object_index;
 	bool8 has_transparency;
+	uint32 lod_index;
 	GeometryData* geometry_data;
 };
 
@@ -85,6 +86,8 @@ struct RenderView
 	uint16 width;
 	uint16 height;
 	bool8 enabled;
+	// NOTE: Vertical field of view in radians for views with a perspective projection, 0 otherwise.
+	float32 fov;
 
 	String name;
 
@@ -80,7 +80,7 @@ namespace TextureSystem
 		system_state = 0;
 	}
 
-	Texture* acquire(const char* name, TextureType type, bool8 auto_destroy)
+	Texture* acquire(const char* name, TextureType type, bool8 auto_destroy, bool8 streamed)
 	{
         TextureId id;
         Texture* texture;
@@ -97,7 +97,7 @@ namespace TextureSystem
             return system_state->texture_storage.get_object(id);
 		}
 
-		Renderer::texture_init_from_resource_async(name, type, texture);
+		Renderer::texture_init_from_resource_async(name, type, texture, streamed);
 
         system_state->texture_ref_counters[id] = { 1, auto_destroy };
         return texture;
@@ -167,9 +167,14 @@ namespace TextureSystem
 		t->height = height;
 		t->channel_count = channel_count;
 		t->type = TextureType::Plane;
+		t->format = TextureFormat::RGBA8;
+		t->mip_levels = 1;
 		t->flags = 0;
 		t->flags |= has_transparency ? TextureFlags::HasTransparency : 0;
 		t->flags |= TextureFlags::IsWrapped;
+		t->stream_mip_count = 0;
+		t->stream_request_id = 0;
+		t->resident_size = 0;
 		t->internal_data.init(internal_data_size, 0, AllocationTag::Texture, internal_data);
 
 		if (register_texture)
@@ -19,7 +19,8 @@ namespace TextureSystem
 	bool8 system_init(FP_allocator_allocate allocator_callback, void* allocator, void* config);
 	void system_shutdown(void* state);
 
-	SHMAPI Texture* acquire(const char* name, TextureType type, bool8 auto_destroy);
+	// NOTE: Streamed textures start out with their small mips only, see Renderer::texture_request_screen_size.
+	SHMAPI Texture* acquire(const char* name, TextureType type, bool8 auto_destroy, bool8 streamed = false);
 	SHMAPI Texture* acquire_writable(const char* name, uint32 width, uint32 height, uint8 channel_count, bool8 has_transparency);
 
 	SHMAPI bool8 wrap_internal(const char* name, uint32 width, uint32 height, uint8 channel_count, bool8 has_transparency, bool8 is_writable, bool8 register_texture, void* internal_data, uint64 internal_data_size, Texture* out_texture);
@@ -17,6 +17,17 @@ namespace CString
 	SHMAPI char* to_string(float32 val, int32 decimals = 2);
 	SHMAPI char* to_string(float64 val, int32 decimals = 2);
 
+	// NOTE: Passed as decimals for the shortest output that parses back to the same value.
+	static const int32 format_float_shortest = -1;
+	static const uint32 format_float_max_length = 320;
+
+	// NOTE: Write the decimal representation to the output buffer without null terminator and return the number of characters written.
+	// Integers need up to 20 characters, floats up to format_float_max_length. Fixed decimals round like printf, ties to even.
+	SHMAPI uint32 format_uint64(uint64 val, char* out_buffer);
+	SHMAPI uint32 format_int64(int64 val, char* out_buffer);
+	SHMAPI uint32 format_float64(float64 val, int32 decimals, char* out_buffer);
+	SHMAPI uint32 format_float32(float32 val, int32 decimals, char* out_buffer);
+
 	SHMAPI uint32 append(char* buffer_output, uint32 buffer_output_size, char appendage);
 	SHMAPI uint32 append(char* buffer_output, uint32 buffer_output_size, const char* buffer_source, int32 length = -1);
 
@@ -121,6 +132,24 @@ namespace CString
 	SHMAPI bool8 parse(const char* s, uint64* out);
 	SHMAPI bool8 parse(const char* s, bool8* out);
 
+#ifdef DEBUG
+	// NOTE: Checks the float parsers against inputs with known correctly rounded results, logging every mismatch.
+	SHMAPI bool8 float_parse_self_check();
+#endif
+
+	// NOTE: Parse one value starting at the cursor (leading blanks are skipped) and advance the cursor past it. The cursor is left untouched on failure.
+	SHMAPI bool8 parse_next(const char*& cursor, float32* out);
+	SHMAPI bool8 parse_next(const char*& cursor, float64* out);
+	SHMAPI bool8 parse_next(const char*& cursor, int8* out);
+	SHMAPI bool8 parse_next(const char*& cursor, int16* out);
+	SHMAPI bool8 parse_next(const char*& cursor, int32* out);
+	SHMAPI bool8 parse_next(const char*& cursor, int64* out);
+	SHMAPI bool8 parse_next(const char*& cursor, uint8* out);
+	SHMAPI bool8 parse_next(const char*& cursor, uint16* out);
+	SHMAPI bool8 parse_next(const char*& cursor, uint32* out);
+	SHMAPI bool8 parse_next(const char*& cursor, uint64* out);
+	SHMAPI bool8 parse_next(const char*& cursor, bool8* out);
+
 	SHMAPI bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, float32* out_arr);
 	SHMAPI bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, float64* out_arr);
 	SHMAPI bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, int8* out_arr);
@@ -245,27 +274,22 @@ namespace CString
 
 	SHMINLINE bool8 parse(const char* s, Math::Mat4* out_f)
 	{
-		return safe_scan<float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*, float32*>
-			(s, "%f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f", 
-				&out_f->data[0], &out_f->data[1], &out_f->data[2], &out_f->data[3],
-				&out_f->data[4], &out_f->data[5], &out_f->data[6], &out_f->data[7],
-				&out_f->data[8], &out_f->data[9], &out_f->data[10], &out_f->data[11],
-				&out_f->data[12], &out_f->data[13], &out_f->data[14], &out_f->data[15]);
+		return parse_arr(s, ' ', 16, out_f->data);
 	}
 
 	SHMINLINE bool8 parse(const char* s, Math::Vec4f* out_f)
 	{
-		return safe_scan<float32*, float32*, float32*, float32*>(s, "%f %f %f %f", &out_f->e[0], &out_f->e[1], &out_f->e[2], &out_f->e[3]);
+		return parse_arr(s, ' ', 4, out_f->e);
 	}
 
 	SHMINLINE bool8 parse(const char* s, Math::Vec3f* out_f)
 	{
-		return safe_scan<float32*, float32*, float32*>(s, "%f %f %f", &out_f->e[0], &out_f->e[1], &out_f->e[2]);
+		return parse_arr(s, ' ', 3, out_f->e);
 	}
 
 	SHMINLINE bool8 parse(const char* s, Math::Vec2f* out_f)
 	{
-		return safe_scan<float32*, float32*>(s, "%f %f", &out_f->e[0], &out_f->e[1]);
+		return parse_arr(s, ' ', 2, out_f->e);
 	}
 
 	
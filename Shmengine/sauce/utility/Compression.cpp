@@ -0,0 +1,184 @@
+#include "Compression.hpp"
+
+#include "core/Memory.hpp"
+
+namespace Compression
+{
+
+	// NOTE: A sequence is a token (high nibble literal count, low nibble match length - min_match_length), extra length bytes for nibbles of 15,
+	// the literals, a 16-bit little endian match offset and extra match length bytes. The last sequence carries literals only.
+	static const uint32 min_match_length = 4;
+	static const uint32 max_match_offset = 0xFFFF;
+	static const uint32 hash_bits = 12;
+
+	static SHMINLINE uint32 read_u32(const uint8* p)
+	{
+		return (uint32)p[0] | ((uint32)p[1] << 8) | ((uint32)p[2] << 16) | ((uint32)p[3] << 24);
+	}
+
+	static SHMINLINE uint32 hash_sequence(uint32 sequence)
+	{
+		return (sequence * 2654435761u) >> (32 - hash_bits);
+	}
+
+	static SHMINLINE bool8 write_length(uint8** op, const uint8* oend, uint64 length)
+	{
+		while (length >= 255)
+		{
+			if (*op >= oend)
+				return false;
+			*(*op)++ = 255;
+			length -= 255;
+		}
+
+		if (*op >= oend)
+			return false;
+		*(*op)++ = (uint8)length;
+		return true;
+	}
+
+	static bool8 write_sequence(uint8** op, const uint8* oend, const uint8* literals, uint64 literal_count, uint32 match_offset, uint64 match_length)
+	{
+		if (*op >= oend)
+			return false;
+
+		uint8* token = (*op)++;
+		uint8 literal_nibble = (uint8)(literal_count < 15 ? literal_count : 15);
+		*token = literal_nibble << 4;
+		if (literal_nibble == 15 && !write_length(op, oend, literal_count - 15))
+			return false;
+
+		if ((uint64)(oend - *op) < literal_count)
+			return false;
+		Memory::copy_memory(literals, *op, literal_count);
+		*op += literal_count;
+
+		if (!match_length)
+			return true;
+
+		if (oend - *op < 2)
+			return false;
+		*(*op)++ = (uint8)(match_offset & 0xFF);
+		*(*op)++ = (uint8)(match_offset >> 8);
+
+		uint64 match_extra = match_length - min_match_length;
+		uint8 match_nibble = (uint8)(match_extra < 15 ? match_extra : 15);
+		*token |= match_nibble;
+		if (match_nibble == 15 && !write_length(op, oend, match_extra - 15))
+			return false;
+
+		return true;
+	}
+
+	uint64 lz_get_max_compressed_size(uint64 size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	uint64 lz_compress(const void* source, uint64 source_size, void* dest, uint64 dest_capacity)
+	{
+		const uint8* ip = (const uint8*)source;
+		const uint8* iend = ip + source_size;
+		const uint8* literal_start = ip;
+		uint8* op = (uint8*)dest;
+		const uint8* oend = op + dest_capacity;
+
+		uint32 hash_table[1 << hash_bits];
+		Memory::zero_memory(hash_table, sizeof(hash_table));
+
+		// NOTE: Positions are stored off by one, so zero marks empty slots.
+		while (iend - ip >= (int64)min_match_length)
+		{
+			uint32 sequence = read_u32(ip);
+			uint32 hash = hash_sequence(sequence);
+			uint32 candidate_pos = hash_table[hash];
+			uint64 pos = (uint64)(ip - (const uint8*)source);
+			hash_table[hash] = (uint32)(pos + 1);
+
+			const uint8* candidate = candidate_pos ? (const uint8*)source + candidate_pos - 1 : 0;
+			if (!candidate || ip - candidate > max_match_offset || read_u32(candidate) != sequence)
+			{
+				ip++;
+				continue;
+			}
+
+			uint64 match_length = min_match_length;
+			while (ip + match_length < iend && candidate[match_length] == ip[match_length])
+				match_length++;
+
+			if (!write_sequence(&op, oend, literal_start, (uint64)(ip - literal_start), (uint32)(ip - candidate), match_length))
+				return 0;
+
+			ip += match_length;
+			literal_start = ip;
+		}
+
+		if (!write_sequence(&op, oend, literal_start, (uint64)(iend - literal_start), 0, 0))
+			return 0;
+
+		return (uint64)(op - (uint8*)dest);
+	}
+
+	static SHMINLINE bool8 read_length(const uint8** ip, const uint8* iend, uint64* length)
+	{
+		uint8 b;
+		do
+		{
+			if (*ip >= iend)
+				return false;
+			b = *(*ip)++;
+			*length += b;
+		} while (b == 255);
+
+		return true;
+	}
+
+	bool8 lz_decompress(const void* source, uint64 source_size, void* dest, uint64 dest_size)
+	{
+		const uint8* ip = (const uint8*)source;
+		const uint8* iend = ip + source_size;
+		uint8* op = (uint8*)dest;
+		uint8* oend = op + dest_size;
+
+		while (ip < iend)
+		{
+			uint8 token = *ip++;
+
+			uint64 literal_count = token >> 4;
+			if (literal_count == 15 && !read_length(&ip, iend, &literal_count))
+				return false;
+			if ((uint64)(iend - ip) < literal_count || (uint64)(oend - op) < literal_count)
+				return false;
+
+			Memory::copy_memory(ip, op, literal_count);
+			ip += literal_count;
+			op += literal_count;
+
+			if (ip == iend)
+				break;
+
+			if (iend - ip < 2)
+				return false;
+			uint32 match_offset = (uint32)ip[0] | ((uint32)ip[1] << 8);
+			ip += 2;
+			if (!match_offset || match_offset > (uint64)(op - (uint8*)dest))
+				return false;
+
+			uint64 match_length = token & 15;
+			if (match_length == 15 && !read_length(&ip, iend, &match_length))
+				return false;
+			match_length += min_match_length;
+			if ((uint64)(oend - op) < match_length)
+				return false;
+
+			// NOTE: Matches may overlap their own output, so this has to go byte by byte.
+			const uint8* match = op - match_offset;
+			for (uint64 i = 0; i < match_length; i++)
+				op[i] = match[i];
+			op += match_length;
+		}
+
+		return op == oend;
+	}
+
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Defines.hpp"
+
+namespace Compression
+{
+
+	// NOTE: Byte oriented LZ77 in the style of LZ4 blocks. Fast to decode, meant for assets that get compressed once offline.
+	SHMAPI uint64 lz_get_max_compressed_size(uint64 size);
+	// NOTE: Returns the compressed size, or 0 if the output does not fit into dest_capacity.
+	SHMAPI uint64 lz_compress(const void* source, uint64 source_size, void* dest, uint64 dest_capacity);
+	// NOTE: Fails on malformed input or if the output size does not match dest_size exactly.
+	SHMAPI bool8 lz_decompress(const void* source, uint64 source_size, void* dest, uint64 dest_size);
+
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Defines.hpp"
+
+struct ConfigToken
+{
+	enum class Type : uint8
+	{
+		Section,
+		Property
+	};
+
+	Type type;
+	uint32 line_number;
+	// NOTE: Section tokens hold the whole trimmed line including brackets (e.g. "[Mesh]"), property tokens the trimmed key.
+	const char* name;
+	// NOTE: Trimmed value of property tokens, may be empty. Writable, so it can be split further in place.
+	char* value;
+};
+
+// NOTE: Streams "[Section]" and "key = value" lines of the engine's text formats (.shmt, .shmene, .shmter, .shadercfg) straight out of the file buffer.
+// Blank lines and '#' comments are skipped. Terminators are written into the buffer, so tokens point into it and stay valid as long as it does.
+// The buffer needs room for one terminator at buffer[size].
+struct SHMAPI ConfigTokenizer
+{
+	ConfigTokenizer(char* buffer, uint32 size, const char* source_name);
+
+	bool8 next(ConfigToken* out_token);
+
+	// NOTE: Splits off the next trimmed item of a delimited list in place. Returns 0 once the list is exhausted.
+	static char* split_next(char** cursor, char delimiter);
+	// NOTE: Counts section header lines without modifying the buffer.
+	static uint32 count_sections(const char* buffer, uint32 size, const char* section_header);
+
+	char* cursor;
+	char* end;
+	uint32 line_number;
+	const char* source_name;
+};
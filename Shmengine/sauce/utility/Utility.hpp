@@ -92,4 +92,16 @@ SHMINLINE uint64 get_aligned_pow2(uint64 operand, uint64 granularity)
 SHMINLINE Range get_aligned_range(uint64 offset, uint64 size, uint64 granularity)
 {
 	return { get_aligned_pow2(offset, granularity), get_aligned_pow2(size, granularity) };
-}
\ No newline at end of file
+}
+// NOTE: 64-bit FNV-1a. Passing the previous result as seed hashes several blocks as if they were one.
+SHMINLINE uint64 hash_fnv1a64(const void* data, uint64 size, uint64 seed = 14695981039346656037ull)
+{
+	const uint8* bytes = (const uint8*)data;
+	uint64 hash = seed;
+	for (uint64 i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
@@ -11,6 +11,7 @@ namespace Math
 	SHMAPI float32 acos(float32 x);
 	SHMAPI float32 abs(float32 x);
 	SHMAPI float32 sqrt(float32 a);
+	SHMAPI float32 pow(float32 x, float32 y);
 
 	SHMAPI int32 round_f_to_i(float32 x);
 	SHMAPI int64 round_f_to_i64(float32 x);
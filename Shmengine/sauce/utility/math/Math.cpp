@@ -43,6 +43,11 @@ namespace Math
 		return res;
 	}
 
+	float32 pow(float32 x, float32 y)
+	{
+		return powf(x, y);
+	}
+
 	float32 sin(float32 x)
 	{
 		return sinf(x);
@@ -1,6 +1,8 @@
 #include "../CString.hpp"
+#include "Pow5Table.hpp"
 
 #include "core/Memory.hpp"
+#include "core/Logging.hpp"
 #include "utility/Math.hpp"
 
 namespace CString
@@ -89,183 +91,619 @@ namespace CString
 		return written_count;
 	}
 
-	char* to_string(uint32 val) 
+	static const char digit_pairs[201] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+
+	static const uint64 powers_of_ten[20] =
 	{
-		uint32 base = 10;
-		static char buf[64] = {};
+		1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+		10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+		10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+	};
+
+	static void multiply_64x64(uint64 a, uint64 b, uint64* out_high, uint64* out_low)
+	{
+		uint64 a_low = a & 0xFFFFFFFF;
+		uint64 a_high = a >> 32;
+		uint64 b_low = b & 0xFFFFFFFF;
+		uint64 b_high = b >> 32;
+
+		uint64 low_low = a_low * b_low;
+		uint64 high_low = a_high * b_low;
+		uint64 low_high = a_low * b_high;
+		uint64 high_high = a_high * b_high;
+
+		uint64 middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+		*out_low = (middle << 32) | (low_low & 0xFFFFFFFF);
+		*out_high = high_high + (high_low >> 32) + (middle >> 32);
+	}
+
+	// NOTE: Arbitrary precision decimal, shared by the exact paths of float formatting and parsing. Shifting by powers of two is exact as long as the digits fit.
+	// 800 digits hold every double exactly and are enough to decide the rounding of any parsed one, dropped digits beyond that only get remembered as non-zero.
+	struct FloatDecimal
+	{
+		uint32 digit_count;
+		int32 decimal_point;
+		bool8 truncated;
+		uint8 digits[800];
+	};
+
+	static const uint32 float_decimal_max_shift = 60;
+
+	static void float_decimal_trim(FloatDecimal* d)
+	{
+		while (d->digit_count > 0 && d->digits[d->digit_count - 1] == 0)
+			d->digit_count--;
+		if (d->digit_count == 0)
+			d->decimal_point = 0;
+	}
+
+	static void float_decimal_shift_right(FloatDecimal* d, uint32 shift)
+	{
+		uint32 read = 0;
+		uint32 write = 0;
+		uint64 n = 0;
 
-		int i = 62;
-		if (val)
+		while (!(n >> shift))
 		{
-			for (; val && i; val /= base)
-				buf[i--] = "0123456789abcdef"[val % base];
+			if (read >= d->digit_count)
+			{
+				if (!n)
+				{
+					d->digit_count = 0;
+					return;
+				}
+				while (!(n >> shift))
+				{
+					n *= 10;
+					read++;
+				}
+				break;
+			}
+			n = n * 10 + d->digits[read++];
 		}
-		else
-			buf[i--] = '0';
+		d->decimal_point -= (int32)read - 1;
 
-		return &buf[i + 1];
+		uint64 mask = (1ULL << shift) - 1;
+		for (; read < d->digit_count; read++)
+		{
+			d->digits[write++] = (uint8)(n >> shift);
+			n = (n & mask) * 10 + d->digits[read];
+		}
+
+		while (n)
+		{
+			uint8 digit = (uint8)(n >> shift);
+			if (write < sizeof(d->digits))
+				d->digits[write++] = digit;
+			else if (digit)
+				d->truncated = true;
+			n = (n & mask) * 10;
+		}
+
+		d->digit_count = write;
+		float_decimal_trim(d);
 	}
 
-	char* to_string(uint64 val) 
+	static void float_decimal_shift_left(FloatDecimal* d, uint32 shift)
 	{
-		uint32 base = 10;
-		static char buf[64] = {};
+		// NOTE: Up to 19 new leading digits get written right to left behind the current ones, then everything moves to the front.
+		uint8 shifted[sizeof(FloatDecimal::digits) + 20];
+		uint32 write = d->digit_count + 20;
+		uint64 n = 0;
 
-		int i = 62;
-		if (val)
+		for (int32 read = (int32)d->digit_count - 1; read >= 0; read--)
 		{
-			for (; val && i; val /= base)
-				buf[i--] = "0123456789abcdef"[val % base];
+			n += (uint64)d->digits[read] << shift;
+			shifted[--write] = (uint8)(n % 10);
+			n /= 10;
+		}
+		while (n)
+		{
+			shifted[--write] = (uint8)(n % 10);
+			n /= 10;
 		}
-		else
-			buf[i--] = '0';
 
-		return &buf[i + 1];
+		uint32 new_digit_count = d->digit_count + 20 - write;
+		d->decimal_point += (int32)(new_digit_count - d->digit_count);
+		if (new_digit_count > sizeof(d->digits))
+		{
+			for (uint32 i = write + sizeof(d->digits); i < d->digit_count + 20; i++)
+				d->truncated |= shifted[i] != 0;
+			new_digit_count = sizeof(d->digits);
+		}
+
+		Memory::copy_memory(&shifted[write], d->digits, new_digit_count);
+		d->digit_count = new_digit_count;
+		float_decimal_trim(d);
 	}
 
-	// NOTE: Could take the base to get different number formats
-	char* to_string(int32 val) 
+	static void float_decimal_shift(FloatDecimal* d, int32 shift)
 	{
-		uint32 base = 10;
-		static char buf[64] = {};
-		bool8 is_neg = (val < 0);
-		uint32 value = is_neg ? -val : val;
+		if (!d->digit_count)
+			return;
+
+		for (; shift > (int32)float_decimal_max_shift; shift -= float_decimal_max_shift)
+			float_decimal_shift_left(d, float_decimal_max_shift);
+		for (; shift < -(int32)float_decimal_max_shift; shift += float_decimal_max_shift)
+			float_decimal_shift_right(d, float_decimal_max_shift);
+
+		if (shift > 0)
+			float_decimal_shift_left(d, (uint32)shift);
+		else if (shift < 0)
+			float_decimal_shift_right(d, (uint32)-shift);
+	}
 
-		int i = 62;
-		if (val)
+	static void float_decimal_assign(FloatDecimal* d, uint64 value)
+	{
+		uint8 reversed[20];
+		uint32 count = 0;
+		while (value)
 		{
-			for (; value && i; value /= base)
-				buf[i--] = "0123456789abcdef"[value % base];
+			reversed[count++] = (uint8)(value % 10);
+			value /= 10;
+		}
 
-			if (is_neg)
-				buf[i--] = '-';
+		d->digit_count = count;
+		d->decimal_point = (int32)count;
+		d->truncated = false;
+		for (uint32 i = 0; i < count; i++)
+			d->digits[i] = reversed[count - 1 - i];
+		float_decimal_trim(d);
+	}
+
+	static bool8 float_decimal_should_round_up(FloatDecimal* d, int32 digit_count)
+	{
+		if (digit_count < 0 || digit_count >= (int32)d->digit_count)
+			return false;
+
+		// NOTE: Exactly halfway rounds to even, unless dropped digits put the value above the halfway point.
+		uint8 digit = d->digits[digit_count];
+		if (digit == 5 && digit_count + 1 == (int32)d->digit_count && !d->truncated)
+			return digit_count > 0 && (d->digits[digit_count - 1] & 1);
+
+		return digit >= 5;
+	}
+
+	static void float_decimal_round_up(FloatDecimal* d, int32 digit_count)
+	{
+		if (digit_count < 0 || digit_count >= (int32)d->digit_count)
+			return;
+
+		for (int32 i = digit_count - 1; i >= 0; i--)
+		{
+			if (d->digits[i] < 9)
+			{
+				d->digits[i]++;
+				d->digit_count = (uint32)i + 1;
+				return;
+			}
 		}
-		else
-			buf[i--] = '0';
 
-		return &buf[i + 1];
+		d->digits[0] = 1;
+		d->digit_count = 1;
+		d->decimal_point++;
 	}
 
-	char* to_string(int64 val) 
+	static void float_decimal_round_down(FloatDecimal* d, int32 digit_count)
 	{
-		uint32 base = 10;
-		static char buf[64] = {};
-		bool8 is_neg = (val < 0);
-		uint64 value = is_neg ? -val : val;
+		if (digit_count < 0 || digit_count >= (int32)d->digit_count)
+			return;
+
+		d->digit_count = (uint32)digit_count;
+		float_decimal_trim(d);
+	}
+
+	static uint64 float_decimal_rounded_integer(FloatDecimal* d)
+	{
+		uint64 n = 0;
+		int32 i = 0;
+		for (; i < d->decimal_point && i < (int32)d->digit_count; i++)
+			n = n * 10 + d->digits[i];
+		for (; i < d->decimal_point; i++)
+			n *= 10;
+
+		return n + float_decimal_should_round_up(d, d->decimal_point);
+	}
 
-		int i = 62;
-		if (val)
+	uint32 format_uint64(uint64 val, char* out_buffer)
+	{
+		char digits[20];
+		uint32 i = 20;
+
+		// NOTE: Emitting two digits per division halves the number of (slow) 64 bit divisions.
+		while (val >= 100)
 		{
-			for (; value && i; value /= base)
-				buf[i--] = "0123456789abcdef"[value % base];
+			uint32 pair = (uint32)(val % 100) * 2;
+			val /= 100;
+			digits[--i] = digit_pairs[pair + 1];
+			digits[--i] = digit_pairs[pair];
+		}
 
-			if (is_neg)
-				buf[i--] = '-';
+		if (val >= 10)
+		{
+			uint32 pair = (uint32)val * 2;
+			digits[--i] = digit_pairs[pair + 1];
+			digits[--i] = digit_pairs[pair];
 		}
 		else
-			buf[i--] = '0';
+		{
+			digits[--i] = (char)('0' + val);
+		}
+
+		uint32 count = 20 - i;
+		for (uint32 j = 0; j < count; j++)
+			out_buffer[j] = digits[i + j];
 
-		return &buf[i + 1];
+		return count;
 	}
 
-	char* to_string(float32 val, int32 decimals) 
+	uint32 format_int64(int64 val, char* out_buffer)
+	{
+		if (val >= 0)
+			return format_uint64((uint64)val, out_buffer);
+
+		out_buffer[0] = '-';
+		return format_uint64(0ULL - (uint64)val, out_buffer + 1) + 1;
+	}
+
+	static uint32 format_fraction(uint64 fraction, int32 decimals, char* out_buffer)
 	{
-		int32 base = 10;
-		int32 leading_zeroes = 0;
-		for (int32 i = 0; i < decimals; i++)
+		char digits[20];
+		uint32 count = format_uint64(fraction, digits);
+
+		uint32 written = 0;
+		for (uint32 i = count; i < (uint32)decimals; i++)
+			out_buffer[written++] = '0';
+		for (uint32 i = 0; i < count; i++)
+			out_buffer[written++] = digits[i];
+
+		return written;
+	}
+
+	// NOTE: Rounds fraction_bits * scale / 2^shift to an integer, ties to even like printf. With a scale of 1 the parity comes from the integer part in front.
+	static uint64 round_scaled_fraction(uint64 fraction_bits, uint32 shift, uint64 scale, bool8 odd_integer_part)
+	{
+		// NOTE: fraction_bits < 2^53 and scale < 2^30 keep the product below 2^83.
+		if (shift >= 128)
+			return 0;
+
+		uint64 high, low;
+		multiply_64x64(fraction_bits, scale, &high, &low);
+
+		uint64 quotient, remainder_high, remainder_low, half_high, half_low;
+		if (shift > 64)
+		{
+			quotient = high >> (shift - 64);
+			remainder_high = high & ((1ULL << (shift - 64)) - 1);
+			remainder_low = low;
+			half_high = 1ULL << (shift - 65);
+			half_low = 0;
+		}
+		else if (shift == 64)
 		{
-			if (val < 1.0f && val > -1.0f)
-				leading_zeroes++;
-			val *= 10;
+			quotient = high;
+			remainder_high = 0;
+			remainder_low = low;
+			half_high = 0;
+			half_low = 1ULL << 63;
+		}
+		else
+		{
+			quotient = (low >> shift) | (high << (64 - shift));
+			remainder_high = 0;
+			remainder_low = low & ((1ULL << shift) - 1);
+			half_high = 0;
+			half_low = 1ULL << (shift - 1);
 		}
 
-		// NOTE: Accounting for pre-comma zero
-		if (val < 1.0f && val > -1.0f && val != 0.0f)
-			leading_zeroes++;
+		bool8 odd = scale == 1 ? odd_integer_part : (bool8)(quotient & 1);
+		if (remainder_high > half_high || (remainder_high == half_high && remainder_low > half_low))
+			return quotient + 1;
+		else if (remainder_high == half_high && remainder_low == half_low && odd)
+			return quotient + 1;
 
-		static char buf[64] = {};
-		bool8 is_neg = (val < 0);
-		int64 value = Math::round_f_to_i64(is_neg ? -val : val);
+		return quotient;
+	}
+
+	// NOTE: Cuts the exact decimal expansion of mantissa * 2^(exponent - mantissa_bits) at the first digit where it can be rounded and still lies
+	// between the halfway points to the neighbouring floats (Steele-White), so parsing the digits gives back the same float.
+	static void float_decimal_shortest(FloatDecimal* d, uint64 mantissa, int32 exponent, uint32 mantissa_bits, int32 min_exponent)
+	{
+		float_decimal_assign(d, mantissa);
+		float_decimal_shift(d, exponent - (int32)mantissa_bits);
+		if (!mantissa)
+			return;
+
+		// NOTE: Neighbours are at most 2^(exponent - mantissa_bits) away, the closest shorter decimal at least 10^(decimal_point - digit_count). log2(10) > 3.32
+		if (exponent > min_exponent && 332 * (d->decimal_point - (int32)d->digit_count) >= 100 * (exponent - (int32)mantissa_bits))
+			return;
+
+		FloatDecimal upper;
+		float_decimal_assign(&upper, mantissa * 2 + 1);
+		float_decimal_shift(&upper, exponent - (int32)mantissa_bits - 1);
+
+		// NOTE: The next lower float sits closer if the mantissa is a power of two, except for subnormals.
+		uint64 lower_mantissa = mantissa - 1;
+		int32 lower_exponent = exponent;
+		if (mantissa <= (1ULL << mantissa_bits) && exponent != min_exponent)
+		{
+			lower_mantissa = mantissa * 2 - 1;
+			lower_exponent = exponent - 1;
+		}
 
-		int32 i = 62;
+		FloatDecimal lower;
+		float_decimal_assign(&lower, lower_mantissa * 2 + 1);
+		float_decimal_shift(&lower, lower_exponent - (int32)mantissa_bits - 1);
 
-		if (leading_zeroes)
-			decimals = -1;
+		// NOTE: Parsing rounds halfway cases to even, so the bounds themselves are only valid outputs for even mantissas.
+		bool8 inclusive = !(mantissa & 1);
 
-		for (; value && i; value /= base)
+		// NOTE: 0 while the digits equal upper's, 1 after a difference of one followed only by 9s against 0s, 2 once rounding up safely stays below upper.
+		uint8 upper_delta = 0;
+		for (int32 upper_i = 0; ; upper_i++)
 		{
-			buf[i--] = "0123456789abcdef"[value % base];
-			decimals--;
-			if (decimals == 0)
-				buf[i--] = '.';
+			int32 middle_i = upper_i - upper.decimal_point + d->decimal_point;
+			if (middle_i >= (int32)d->digit_count)
+				break;
+
+			int32 lower_i = upper_i - upper.decimal_point + lower.decimal_point;
+			uint8 l = lower_i >= 0 && lower_i < (int32)lower.digit_count ? lower.digits[lower_i] : 0;
+			uint8 m = middle_i >= 0 ? d->digits[middle_i] : 0;
+			uint8 u = upper_i < (int32)upper.digit_count ? upper.digits[upper_i] : 0;
+
+			bool8 ok_down = l != m || (inclusive && lower_i + 1 == (int32)lower.digit_count);
+
+			if (upper_delta == 0 && m + 1 < u)
+				upper_delta = 2;
+			else if (upper_delta == 0 && m != u)
+				upper_delta = 1;
+			else if (upper_delta == 1 && (m != 9 || u != 0))
+				upper_delta = 2;
+
+			bool8 ok_up = upper_delta > 0 && (inclusive || upper_delta > 1 || upper_i + 1 < (int32)upper.digit_count);
+
+			if (ok_down && ok_up)
+			{
+				if (float_decimal_should_round_up(d, middle_i + 1))
+					float_decimal_round_up(d, middle_i + 1);
+				else
+					float_decimal_round_down(d, middle_i + 1);
+				return;
+			}
+			else if (ok_down)
+			{
+				float_decimal_round_down(d, middle_i + 1);
+				return;
+			}
+			else if (ok_up)
+			{
+				float_decimal_round_up(d, middle_i + 1);
+				return;
+			}
 		}
+	}
 
-		for (int32 j = 0; j < leading_zeroes - 1; j++)
+	// NOTE: Plain notation within [1e-6, 1e21), exponent notation outside of it.
+	static uint32 write_float_shortest(uint64 mantissa, int32 exponent, uint32 mantissa_bits, int32 min_exponent, bool8 is_neg, char* out_buffer)
+	{
+		FloatDecimal d;
+		float_decimal_shortest(&d, mantissa, exponent, mantissa_bits, min_exponent);
+
+		uint32 written = 0;
+		if (is_neg)
+			out_buffer[written++] = '-';
+
+		if (!d.digit_count)
 		{
-			buf[i--] = '0';
+			out_buffer[written++] = '0';
+			return written;
 		}
-		if (leading_zeroes)
+
+		int32 decimal_exponent = d.decimal_point - 1;
+		if (decimal_exponent < -6 || decimal_exponent >= 21)
 		{
-			buf[i--] = '.';
-			buf[i--] = '0';
-			leading_zeroes--;
+			out_buffer[written++] = (char)('0' + d.digits[0]);
+			if (d.digit_count > 1)
+			{
+				out_buffer[written++] = '.';
+				for (uint32 i = 1; i < d.digit_count; i++)
+					out_buffer[written++] = (char)('0' + d.digits[i]);
+			}
+
+			out_buffer[written++] = 'e';
+			out_buffer[written++] = decimal_exponent < 0 ? '-' : '+';
+			written += format_uint64((uint64)(decimal_exponent < 0 ? -decimal_exponent : decimal_exponent), out_buffer + written);
+			return written;
 		}
 
-		if (is_neg)
-			buf[i--] = '-';
+		if (d.decimal_point <= 0)
+		{
+			out_buffer[written++] = '0';
+			out_buffer[written++] = '.';
+			for (int32 i = d.decimal_point; i < 0; i++)
+				out_buffer[written++] = '0';
+			for (uint32 i = 0; i < d.digit_count; i++)
+				out_buffer[written++] = (char)('0' + d.digits[i]);
+			return written;
+		}
+
+		for (int32 i = 0; i < d.decimal_point; i++)
+			out_buffer[written++] = i < (int32)d.digit_count ? (char)('0' + d.digits[i]) : '0';
+
+		if ((int32)d.digit_count > d.decimal_point)
+		{
+			out_buffer[written++] = '.';
+			for (uint32 i = (uint32)d.decimal_point; i < d.digit_count; i++)
+				out_buffer[written++] = (char)('0' + d.digits[i]);
+		}
 
-		return &buf[i + 1];
+		return written;
 	}
 
-	char* to_string(float64 val, int32 decimals) 
+	static uint32 format_float_special(float64 val, char* out_buffer)
 	{
-		int32 base = 10;
-		int32 leading_zeroes = 0;
-		for (int32 i = 0; i < decimals; i++)
+		if (val != val)
 		{
-			if (val < 1.0f && val > -1.0f)
-				leading_zeroes++;
-			val *= 10;
+			out_buffer[0] = 'n'; out_buffer[1] = 'a'; out_buffer[2] = 'n';
+			return 3;
 		}
 
-		// NOTE: Accounting for pre-comma zero
-		if (val < 1.0f && val > -1.0f && val != 0.0f)
-			leading_zeroes++;
+		uint32 written = 0;
+		if (val < 0.0)
+			out_buffer[written++] = '-';
+		out_buffer[written++] = 'i'; out_buffer[written++] = 'n'; out_buffer[written++] = 'f';
+		return written;
+	}
 
-		static char buf[64] = {};
-		bool8 is_neg = (val < 0);
-		int64 value = Math::round_f_to_i64(is_neg ? -val : val);
+	uint32 format_float64(float64 val, int32 decimals, char* out_buffer)
+	{
+		if (val != val || val - val != 0.0)
+			return format_float_special(val, out_buffer);
+
+		uint64 bits;
+		Memory::copy_memory(&val, &bits, sizeof(float64));
 
-		int32 i = 62;
+		bool8 is_neg = (bool8)(bits >> 63);
+		uint64 mantissa = bits & ((1ULL << 52) - 1);
+		int32 biased_exponent = (int32)((bits >> 52) & 0x7FF);
+		if (biased_exponent)
+			mantissa |= 1ULL << 52;
+		else
+			biased_exponent = 1;
 
-		if (leading_zeroes)
+		if (decimals == format_float_shortest)
+			return write_float_shortest(mantissa, biased_exponent - 1023, 52, -1022, is_neg, out_buffer);
+
+		if (decimals < 0)
+			decimals = 0;
+		else if (decimals > 9)
+			decimals = 9;
+
+		uint32 written = 0;
+		uint64 scale = powers_of_ten[decimals];
+
+		// NOTE: val == mantissa * 2^-shift.
+		int32 shift = 1075 - biased_exponent;
+		if (shift < -11)
 		{
-			decimals = -1;
+			// NOTE: Beyond the 64 bit range, always an integer.
+			FloatDecimal d;
+			float_decimal_assign(&d, mantissa);
+			float_decimal_shift(&d, -shift);
+
+			if (is_neg)
+				out_buffer[written++] = '-';
+			for (int32 i = 0; i < d.decimal_point; i++)
+				out_buffer[written++] = i < (int32)d.digit_count ? (char)('0' + d.digits[i]) : '0';
+
+			if (decimals)
+			{
+				out_buffer[written++] = '.';
+				written += format_fraction(0, decimals, out_buffer + written);
+			}
+
+			return written;
 		}
 
-		for (; value && i; value /= base)
+		uint64 integer_part = 0;
+		uint64 fraction = 0;
+		if (shift <= 0)
 		{
-			buf[i--] = "0123456789abcdef"[value % base];
-			decimals--;
-			if (decimals == 0)
-				buf[i--] = '.';
+			integer_part = mantissa << -shift;
 		}
-
-		for (int32 j = 0; j < leading_zeroes - 1; j++)
+		else
 		{
-			buf[i--] = '0';
+			integer_part = shift < 64 ? mantissa >> shift : 0;
+			uint64 fraction_bits = shift < 64 ? mantissa & ((1ULL << shift) - 1) : mantissa;
+			fraction = round_scaled_fraction(fraction_bits, (uint32)shift, scale, (bool8)(integer_part & 1));
+			if (fraction >= scale)
+			{
+				integer_part++;
+				fraction -= scale;
+			}
 		}
-		if (leading_zeroes)
+
+		// NOTE: Avoid printing "-0.00" for tiny negative values.
+		if (is_neg && (integer_part || fraction))
+			out_buffer[written++] = '-';
+
+		written += format_uint64(integer_part, out_buffer + written);
+		if (decimals)
 		{
-			buf[i--] = '.';
-			buf[i--] = '0';
-			leading_zeroes--;
+			out_buffer[written++] = '.';
+			written += format_fraction(fraction, decimals, out_buffer + written);
 		}
 
-		if (is_neg)
-			buf[i--] = '-';
+		return written;
+	}
+
+	uint32 format_float32(float32 val, int32 decimals, char* out_buffer)
+	{
+		if (decimals != format_float_shortest)
+			return format_float64(val, decimals, out_buffer);
 
-		return &buf[i + 1];
+		if (val != val || val - val != 0.0f)
+			return format_float_special(val, out_buffer);
+
+		uint32 bits;
+		Memory::copy_memory(&val, &bits, sizeof(float32));
+
+		bool8 is_neg = (bool8)(bits >> 31);
+		uint64 mantissa = bits & ((1U << 23) - 1);
+		int32 biased_exponent = (int32)((bits >> 23) & 0xFF);
+		if (biased_exponent)
+			mantissa |= 1U << 23;
+		else
+			biased_exponent = 1;
+
+		return write_float_shortest(mantissa, biased_exponent - 127, 23, -126, is_neg, out_buffer);
+	}
+
+	char* to_string(uint32 val) 
+	{
+		static char buf[64] = {};
+		buf[format_uint64(val, buf)] = 0;
+		return buf;
+	}
+
+	char* to_string(uint64 val) 
+	{
+		static char buf[64] = {};
+		buf[format_uint64(val, buf)] = 0;
+		return buf;
+	}
+
+	char* to_string(int32 val) 
+	{
+		static char buf[64] = {};
+		buf[format_int64(val, buf)] = 0;
+		return buf;
+	}
+
+	char* to_string(int64 val) 
+	{
+		static char buf[64] = {};
+		buf[format_int64(val, buf)] = 0;
+		return buf;
+	}
+
+	char* to_string(float32 val, int32 decimals) 
+	{
+		static char buf[format_float_max_length + 1] = {};
+		buf[format_float32(val, decimals, buf)] = 0;
+		return buf;
+	}
+
+	char* to_string(float64 val, int32 decimals) 
+	{
+		static char buf[format_float_max_length + 1] = {};
+		buf[format_float64(val, decimals, buf)] = 0;
+		return buf;
 	}
 
 	bool8 equal(const char* a, const char* b)
@@ -429,570 +867,609 @@ namespace CString
 
 	}
 
-	bool8 parse(const char* s, float32* out)
+	// NOTE: Bit layout of the types the float parser rounds to. The fast path applies while mantissa and power of ten are both exact in the type,
+	// decimal exponents below min_exponent round any 19 digit mantissa to zero.
+	struct FloatFormat
+	{
+		uint32 mantissa_bits;
+		uint32 exponent_bits;
+		int32 bias;
+		uint64 fast_path_max_mantissa;
+		int32 fast_path_max_exponent;
+		int32 min_exponent;
+		int32 max_exponent;
+	};
+
+	static const FloatFormat float64_format = { 52, 11, 1023, 1ULL << 53, 22, pow5_table_min_exponent, pow5_table_max_exponent };
+	static const FloatFormat float32_format = { 23, 8, 127, 1ULL << 24, 10, -65, 38 };
+
+	static const float64 exact_powers_of_ten[23] =
 	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
 
-		int32 sign = 1;
-		const char* ptr = s;
-		float32 ret = 0.0f;
+	static const float32 exact_powers_of_ten_f32[11] =
+	{
+		1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+	};
 
-		if (ptr[0] == '-')
-		{
-			sign = -1;
-			ptr++;
-		}
+	SHMINLINE bool8 is_digit(char c)
+	{
+		return (uint8)(c - '0') < 10;
+	}
 
-		s = ptr;
-		uint32 length = 0;
-		uint32 sep_index = 0;
-		while (*ptr)
-		{
-			if (*ptr == '.' && !sep_index && ptr != s)
-				sep_index = length;
-			else if (*ptr < '0' || *ptr > '9')
-				return false;
+	SHMINLINE const char* skip_blanks(const char* cursor)
+	{
+		while (*cursor == ' ' || *cursor == '\t')
+			cursor++;
+		return cursor;
+	}
 
-			length++;
-			ptr++;
-		}
+	static bool8 parse_next_integer(const char*& cursor, uint64* out_magnitude, bool8* out_negative)
+	{
+		const char* ptr = skip_blanks(cursor);
 
-		ptr = s;
-		uint32 low_part_l;
-		uint32 high_part_l;
-		if (!sep_index)
+		*out_negative = false;
+		if (*ptr == '-')
 		{
-			high_part_l = length;
-			low_part_l = 0;			
+			*out_negative = true;
+			ptr++;
 		}
-		else
+		else if (*ptr == '+')
 		{
-			high_part_l = sep_index;
-			low_part_l = length - high_part_l - 1;
+			ptr++;
 		}
 
-		float64 multiplier = 1 / Math::pow(10.0, low_part_l);
+		if (!is_digit(*ptr))
+			return false;
 
-		for (int32 i = (int32)(high_part_l + low_part_l); i >= 0; i--)
-		{
-			if (ptr[i] != '.')
-			{
-				uint32 digit = ptr[i] - '0';
-				ret += (float32)(digit * multiplier);
-				multiplier *= 10;
-			}
-		}
+		uint64 value = 0;
+		while (is_digit(*ptr))
+			value = value * 10 + (uint64)(*ptr++ - '0');
 
-		*out = ret * sign;
+		*out_magnitude = value;
+		cursor = ptr;
 		return true;
 	}
 
-	bool8 parse(const char* s, float64* out)
+	static uint32 leading_zero_count(uint64 v)
 	{
+		uint32 count = 0;
+		if (!(v & 0xFFFFFFFF00000000ULL)) { count += 32; v <<= 32; }
+		if (!(v & 0xFFFF000000000000ULL)) { count += 16; v <<= 16; }
+		if (!(v & 0xFF00000000000000ULL)) { count += 8; v <<= 8; }
+		if (!(v & 0xF000000000000000ULL)) { count += 4; v <<= 4; }
+		if (!(v & 0xC000000000000000ULL)) { count += 2; v <<= 2; }
+		if (!(v & 0x8000000000000000ULL)) { count += 1; }
+		return count;
+	}
 
-		int32 sign = 1;
-		const char* ptr = s;
-		float64 ret = 0.0;
-
-		if (ptr[0] == '-')
+	// NOTE: Eisel-Lemire: multiplies the normalized mantissa with a 128 bit approximation of 10^exponent and rounds the high bits directly into the target type.
+	// Returns false for the rare cases where the truncated product is too close to a rounding boundary, as well as for subnormal and overflowing results.
+	static bool8 compute_float_eisel_lemire(uint64 mantissa, int32 exponent, const FloatFormat* format, uint64* out_bits)
+	{
+		if (exponent < format->min_exponent)
 		{
-			sign = -1;
-			ptr++;
+			*out_bits = 0;
+			return true;
 		}
+		if (exponent > format->max_exponent)
+			return false;
 
-		s = ptr;
-		uint32 length = 0;
-		uint32 sep_index = 0;
-		while (*ptr)
-		{
-			if (*ptr == '.' && !sep_index && ptr != s)
-				sep_index = length;
-			else if (*ptr < '0' || *ptr > '9')
-				return false;
+		const uint64* factor = pow5_table[exponent - pow5_table_min_exponent];
+		int64 biased_exponent = (((152170 + 65536) * (int64)exponent) >> 16) + format->bias + 1 + 63;
 
-			length++;
-			ptr++;
-		}
+		// NOTE: Bits below the mantissa plus its rounding and overflow bits, they decide whether the truncated product is precise enough.
+		uint32 low_bit_count = 64 - format->mantissa_bits - 3;
+		uint64 low_mask = (1ULL << low_bit_count) - 1;
 
-		ptr = s;
-		uint32 low_part_l;
-		uint32 high_part_l;
-		if (!sep_index)
-		{
-			high_part_l = length;
-			low_part_l = 0;
-		}
-		else
-		{
-			high_part_l = sep_index;
-			low_part_l = length - high_part_l - 1;
-		}
+		uint32 lz = leading_zero_count(mantissa);
+		mantissa <<= lz;
 
-		float64 multiplier = 1 / Math::pow(10.0, low_part_l);
+		uint64 upper, lower;
+		multiply_64x64(mantissa, factor[0], &upper, &lower);
 
-		for (int32 i = (int32)(high_part_l + low_part_l); i >= 0; i--)
+		if ((upper & low_mask) == low_mask && lower + mantissa < lower)
 		{
-			if (ptr[i] != '.')
-			{
-				uint32 digit = ptr[i] - '0';
-				ret += digit * multiplier;
-				multiplier *= 10;
-			}
-		}
-
-		*out = ret * sign;
-		return true;
-	}
+			uint64 product_middle2, product_low;
+			multiply_64x64(mantissa, factor[1], &product_middle2, &product_low);
 
-	bool8 parse(const char* s, int8* out)
-	{
+			uint64 product_high = upper;
+			uint64 product_middle = lower + product_middle2;
+			if (product_middle < lower)
+				product_high++;
 
-		int8 sign = 1;
-		const char* ptr = s;
-		int8 ret = 0;
+			if (product_middle + 1 == 0 && (product_high & low_mask) == low_mask && product_low + mantissa < product_low)
+				return false;
 
-		if (ptr[0] == '-')
-		{
-			sign = -1;
-			ptr++;
+			upper = product_high;
+			lower = product_middle;
 		}
 
-		uint32 multiplier = 1;
+		uint64 upper_bit = upper >> 63;
+		uint64 result = upper >> (upper_bit + low_bit_count);
+		lz += (uint32)(1 ^ upper_bit);
 
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
-		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+		// NOTE: Exactly halfway, needs round-to-even with full precision.
+		if (lower == 0 && (upper & low_mask) == 0 && (result & 3) == 1)
+			return false;
 
-			uint32 digit = ptr[i] - '0';
-			ret += (int8)(digit * multiplier);
-			multiplier *= 10;
+		result += result & 1;
+		result >>= 1;
+		if (result >= (2ULL << format->mantissa_bits))
+		{
+			result = 1ULL << format->mantissa_bits;
+			lz--;
 		}
+		result &= ~(1ULL << format->mantissa_bits);
 
-		*out = ret * sign;
+		int64 real_exponent = biased_exponent - lz;
+		if (real_exponent < 1 || real_exponent > (1LL << format->exponent_bits) - 2)
+			return false;
+
+		*out_bits = result | ((uint64)real_exponent << format->mantissa_bits);
 		return true;
 	}
 
-	bool8 parse(const char* s, int16* out)
+	static uint64 compute_float_decimal(const char* digits, const char* digits_end, int32 exponent, const FloatFormat* format)
 	{
+		FloatDecimal d;
+		d.digit_count = 0;
+		d.decimal_point = 0;
+		d.truncated = false;
 
-		int8 sign = 1;
-		const char* ptr = s;
-		int16 ret = 0;
-
-		if (ptr[0] == '-')
-		{
-			sign = -1;
-			ptr++;
-		}
-
-		uint32 multiplier = 1;
-
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
+		bool8 saw_point = false;
+		for (const char* c = digits; c < digits_end; c++)
 		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+			if (*c == '.')
+			{
+				saw_point = true;
+				d.decimal_point = (int32)d.digit_count;
+				continue;
+			}
 
-			uint32 digit = ptr[i] - '0';
-			ret += (int16)(digit * multiplier);
-			multiplier *= 10;
+			if (*c == '0' && !d.digit_count)
+				d.decimal_point--;
+			else if (d.digit_count < sizeof(d.digits))
+				d.digits[d.digit_count++] = (uint8)(*c - '0');
+			else
+				d.truncated |= *c != '0';
 		}
+		if (!saw_point)
+			d.decimal_point = (int32)d.digit_count;
+		d.decimal_point += exponent;
 
-		*out = ret * sign;
-		return true;
-	}
+		float_decimal_trim(&d);
 
-	bool8 parse(const char* s, int32* out)
-	{
+		int32 min_binary_exponent = 1 - format->bias;
+		uint32 infinite_exponent = (1U << format->exponent_bits) - 1;
+		uint64 infinity_bits = (uint64)infinite_exponent << format->mantissa_bits;
+		uint64 bits = 0;
 
-		int8 sign = 1;
-		const char* ptr = s;
-		int32 ret = 0;
+		if (!d.digit_count || d.decimal_point < -330)
+			return 0;
 
-		if (ptr[0] == '-')
+		if (d.decimal_point > 310)
 		{
-			sign = -1;
-			ptr++;
+			bits = infinity_bits;
 		}
+		else
+		{
+			// NOTE: Bits per shift that are guaranteed not to move the decimal point past zero, indexed by decimal digits.
+			static const int32 shift_table[9] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
 
-		uint32 multiplier = 1 ;
+			int32 binary_exponent = 0;
+			while (d.decimal_point > 0)
+			{
+				int32 shift = d.decimal_point >= 9 ? 27 : shift_table[d.decimal_point];
+				float_decimal_shift(&d, -shift);
+				binary_exponent += shift;
+			}
+			while (d.decimal_point < 0 || (d.decimal_point == 0 && d.digits[0] < 5))
+			{
+				int32 shift = -d.decimal_point >= 9 ? 27 : shift_table[-d.decimal_point];
+				float_decimal_shift(&d, shift);
+				binary_exponent -= shift;
+			}
 
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
-		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+			// NOTE: Value is in [0.5, 1) now, floats are normalized to [1, 2).
+			binary_exponent--;
+			if (binary_exponent < min_binary_exponent)
+			{
+				float_decimal_shift(&d, binary_exponent - min_binary_exponent);
+				binary_exponent = min_binary_exponent;
+			}
 
-			uint32 digit = ptr[i] - '0';
-			ret += digit * multiplier;
-			multiplier *= 10;
+			if (binary_exponent + format->bias >= (int32)infinite_exponent)
+			{
+				bits = infinity_bits;
+			}
+			else
+			{
+				float_decimal_shift(&d, format->mantissa_bits + 1);
+				uint64 mantissa = float_decimal_rounded_integer(&d);
+				if (mantissa == (2ULL << format->mantissa_bits))
+				{
+					mantissa >>= 1;
+					binary_exponent++;
+				}
+
+				if (binary_exponent + format->bias >= (int32)infinite_exponent)
+					bits = infinity_bits;
+				else if (!(mantissa & (1ULL << format->mantissa_bits)))
+					bits = mantissa;
+				else
+					bits = (mantissa & ((1ULL << format->mantissa_bits) - 1)) | ((uint64)(binary_exponent + format->bias) << format->mantissa_bits);
+			}
 		}
 
-		*out = ret * sign;
-		return true;
+		return bits;
 	}
 
-	bool8 parse(const char* s, int64* out)
+	// NOTE: Exact mantissas times or divided by exact powers of ten round correctly when computed in the target type itself.
+	static uint64 compute_float_fast_path(uint64 mantissa, int32 exponent, const FloatFormat* format)
 	{
-
-		int8 sign = 1;
-		const char* ptr = s;
-		int64 ret = 0;
-
-		if (ptr[0] == '-')
+		if (format == &float32_format)
 		{
-			sign = -1;
-			ptr++;
-		}
-
-		uint64 multiplier = 1;
-
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
-		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+			float32 value = (float32)mantissa;
+			if (exponent < 0)
+				value /= exact_powers_of_ten_f32[-exponent];
+			else
+				value *= exact_powers_of_ten_f32[exponent];
 
-			uint32 digit = ptr[i] - '0';
-			ret += digit * multiplier;
-			multiplier *= 10;
+			uint32 bits;
+			Memory::copy_memory(&value, &bits, sizeof(bits));
+			return bits;
 		}
 
-		*out = ret * sign;
-		return true;
+		float64 value = (float64)mantissa;
+		if (exponent < 0)
+			value /= exact_powers_of_ten[-exponent];
+		else
+			value *= exact_powers_of_ten[exponent];
+
+		uint64 bits;
+		Memory::copy_memory(&value, &bits, sizeof(bits));
+		return bits;
 	}
 
-	bool8 parse(const char* s, uint8* out)
+	// NOTE: Collects up to 19 significant digits into an integer mantissa plus a decimal exponent.
+	// Mantissas and powers of ten exact in the target type need a single multiplication or division (Clinger's fast path, up to 2^53 and 10^22 for doubles, 2^24 and 10^10 for floats),
+	// everything else goes through Eisel-Lemire. If that can not decide (or more than 19 digits were given and the rounding depends on the dropped ones),
+	// the digits get converted again with arbitrary precision. Every path rounds straight to the target type, so floats do not get rounded twice.
+	static bool8 parse_next_float(const char*& cursor, const FloatFormat* format, uint64* out_bits)
 	{
+		const char* ptr = skip_blanks(cursor);
 
-		int8 sign = 1;
-		const char* ptr = s;
-		uint8 ret = 0;
-
-		if (ptr[0] == '-')
+		bool8 negative = false;
+		if (*ptr == '-')
 		{
-			sign = -1;
+			negative = true;
 			ptr++;
 		}
-
-		uint32 multiplier = 1;
-
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
+		else if (*ptr == '+')
 		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
-
-			uint32 digit = ptr[i] - '0';
-			ret += (uint8)(digit * multiplier);
-			multiplier *= 10;
+			ptr++;
 		}
 
-		*out = ret * sign;
-		return true;
-	}
+		const char* digits = ptr;
+		uint64 mantissa = 0;
+		int32 exponent = 0;
+		uint32 significant_digits = 0;
+		bool8 truncated = false;
+		bool8 any_digits = false;
 
-	bool8 parse(const char* s, uint16* out)
-	{
-
-		int8 sign = 1;
-		const char* ptr = s;
-		uint16 ret = 0;
-
-		if (ptr[0] == '-')
+		while (*ptr == '0')
 		{
-			sign = -1;
 			ptr++;
+			any_digits = true;
 		}
 
-		uint32 multiplier = 1;
-
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
+		while (is_digit(*ptr))
 		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
-
-			uint32 digit = ptr[i] - '0';
-			ret += (uint8)(digit * multiplier);
-			multiplier *= 10;
+			if (significant_digits < 19)
+			{
+				mantissa = mantissa * 10 + (uint64)(*ptr - '0');
+				significant_digits++;
+			}
+			else
+			{
+				exponent++;
+				truncated |= *ptr != '0';
+			}
+			ptr++;
+			any_digits = true;
 		}
 
-		*out = ret * sign;
-		return true;
-	}
-
-	bool8 parse(const char* s, uint32* out)
-	{
-
-		int8 sign = 1;
-		const char* ptr = s;
-		uint32 ret = 0;
-
-		if (ptr[0] == '-')
+		if (*ptr == '.')
 		{
-			sign = -1;
 			ptr++;
+			if (!mantissa)
+			{
+				while (*ptr == '0')
+				{
+					ptr++;
+					exponent--;
+					any_digits = true;
+				}
+			}
+
+			while (is_digit(*ptr))
+			{
+				if (significant_digits < 19)
+				{
+					mantissa = mantissa * 10 + (uint64)(*ptr - '0');
+					significant_digits++;
+					exponent--;
+				}
+				else
+				{
+					truncated |= *ptr != '0';
+				}
+				ptr++;
+				any_digits = true;
+			}
 		}
 
-		uint32 multiplier = 1;
+		if (!any_digits)
+			return false;
 
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
+		const char* digits_end = ptr;
+		int32 explicit_exponent = 0;
+		if (*ptr == 'e' || *ptr == 'E')
 		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+			const char* exp_ptr = ptr + 1;
+			bool8 exp_negative = false;
+			if (*exp_ptr == '-' || *exp_ptr == '+')
+				exp_negative = *exp_ptr++ == '-';
 
-			uint32 digit = ptr[i] - '0';
-			ret += digit * multiplier;
-			multiplier *= 10;
+			if (is_digit(*exp_ptr))
+			{
+				int32 exp_value = 0;
+				while (is_digit(*exp_ptr))
+				{
+					if (exp_value < 100000)
+						exp_value = exp_value * 10 + (*exp_ptr - '0');
+					exp_ptr++;
+				}
+
+				explicit_exponent = exp_negative ? -exp_value : exp_value;
+				exponent += explicit_exponent;
+				ptr = exp_ptr;
+			}
 		}
 
-		*out = ret * sign;
-		return true;
-	}
-
-	bool8 parse(const char* s, uint64* out)
-	{
-
-		int8 sign = 1;
-		const char* ptr = s;
-		uint64 ret = 0;
-
-		if (ptr[0] == '-')
+		uint64 bits = 0;
+		if (!mantissa)
 		{
-			sign = -1;
-			ptr++;
+			bits = 0;
 		}
-
-		uint64 multiplier = 1;
-
-		for (int32 i = (int32)(length(ptr) - 1); i >= 0; i--)
+		else if (!truncated && (!exponent || (mantissa <= format->fast_path_max_mantissa && exponent >= -format->fast_path_max_exponent && exponent <= format->fast_path_max_exponent)))
 		{
-			if (ptr[i] < '0' || ptr[i] > '9')
-				return false;
+			bits = compute_float_fast_path(mantissa, exponent, format);
+		}
+		else
+		{
+			uint64 upper_bits;
+			bool8 exact = compute_float_eisel_lemire(mantissa, exponent, format, &bits);
+			if (exact && truncated)
+				exact = compute_float_eisel_lemire(mantissa + 1, exponent, format, &upper_bits) && upper_bits == bits;
 
-			uint32 digit = ptr[i] - '0';
-			ret += digit * multiplier;
-			multiplier *= 10;
+			if (!exact)
+				bits = compute_float_decimal(digits, digits_end, explicit_exponent, format);
 		}
 
-		*out = ret * sign;
+		if (negative)
+			bits |= 1ULL << (format->mantissa_bits + format->exponent_bits);
+
+		*out_bits = bits;
+		cursor = ptr;
 		return true;
 	}
 
-	bool8 parse(const char* s, bool8* out)
+	bool8 parse_next(const char*& cursor, float32* out)
 	{
-		if (equal_i(s, "true") || equal_i(s, "1"))
-			*out = true;
-		else
-			*out = false;
+		uint64 bits;
+		if (!parse_next_float(cursor, &float32_format, &bits))
+			return false;
 
+		uint32 bits32 = (uint32)bits;
+		Memory::copy_memory(&bits32, out, sizeof(float32));
 		return true;
 	}
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, float32* out_arr)
+	bool8 parse_next(const char*& cursor, float64* out)
 	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
-		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-			
-			read = &read[next_del_index + 1];
-		}
+		uint64 bits;
+		if (!parse_next_float(cursor, &float64_format, &bits))
+			return false;
 
+		Memory::copy_memory(&bits, out, sizeof(float64));
 		return true;
 	}
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, float64* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
-		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
+	// NOTE: Integers wrap on overflow and unsigned targets accept a minus sign, matching the old parsers (e.g. "-1" for invalid ids).
+#define PARSE_NEXT_INTEGER(type) \
+	bool8 parse_next(const char*& cursor, type* out) \
+	{ \
+		uint64 magnitude; \
+		bool8 negative; \
+		if (!parse_next_integer(cursor, &magnitude, &negative)) \
+			return false; \
+		*out = (type)(negative ? 0ULL - magnitude : magnitude); \
+		return true; \
+	}
 
-			read = &read[next_del_index + 1];
-		}
+	PARSE_NEXT_INTEGER(int8)
+	PARSE_NEXT_INTEGER(int16)
+	PARSE_NEXT_INTEGER(int32)
+	PARSE_NEXT_INTEGER(int64)
+	PARSE_NEXT_INTEGER(uint8)
+	PARSE_NEXT_INTEGER(uint16)
+	PARSE_NEXT_INTEGER(uint32)
+	PARSE_NEXT_INTEGER(uint64)
 
-		return true;
-	}
+#undef PARSE_NEXT_INTEGER
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, int8* out_arr)
+	bool8 parse_next(const char*& cursor, bool8* out)
 	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
+		const char* ptr = skip_blanks(cursor);
 
-		for (uint32 i = 0; i < arr_count; i++)
+		if (nequal_i(ptr, "true", 4))
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			*out = true;
+			ptr += 4;
 		}
-
-		return true;
-	}
-
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, int16* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
+		else if (nequal_i(ptr, "false", 5))
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			*out = false;
+			ptr += 5;
 		}
-
-		return true;
-	}
-
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, int32* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
+		else if (*ptr == '0' || *ptr == '1')
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			*out = *ptr == '1';
+			ptr++;
 		}
-
-		return true;
-	}
-
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, int64* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
+		else
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			return false;
 		}
 
+		cursor = ptr;
 		return true;
 	}
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, uint8* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
-		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
-		}
-
-		return true;
+	// NOTE: Whole string has to be consumed. Empty strings parse as zero, as they always did.
+#define PARSE_WHOLE(type) \
+	bool8 parse(const char* s, type* out) \
+	{ \
+		if (!*s) \
+		{ \
+			*out = 0; \
+			return true; \
+		} \
+		const char* cursor = s; \
+		return parse_next(cursor, out) && !*cursor; \
 	}
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, uint16* out_arr)
+	PARSE_WHOLE(float32)
+	PARSE_WHOLE(float64)
+	PARSE_WHOLE(int8)
+	PARSE_WHOLE(int16)
+	PARSE_WHOLE(int32)
+	PARSE_WHOLE(int64)
+	PARSE_WHOLE(uint8)
+	PARSE_WHOLE(uint16)
+	PARSE_WHOLE(uint32)
+	PARSE_WHOLE(uint64)
+
+#ifdef DEBUG
+	bool8 float_parse_self_check()
 	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
+		struct Float32Case { const char* text; uint32 bits; };
+		struct Float64Case { const char* text; uint64 bits; };
 
-		for (uint32 i = 0; i < arr_count; i++)
+		// NOTE: The first two come out wrong when rounded through float64 first, the rest sit on range and rounding boundaries.
+		static const Float32Case float32_cases[] =
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			{ "1.00000005960464477550", 0x3F800001 },
+			{ "7.038531e-26", 0x15AE43FD },
+			{ "1.00000005960464477539", 0x3F800000 },
+			{ "16777217", 0x4B800000 },
+			{ "1.17549435e-38", 0x00800000 },
+			{ "1.4e-45", 0x00000001 },
+			{ "7.006492e-46", 0x00000000 },
+			{ "3.4028235e38", 0x7F7FFFFF },
+			{ "3.4028236e38", 0x7F800000 },
+			{ "-0.5", 0xBF000000 }
+		};
+
+		static const Float64Case float64_cases[] =
+		{
+			{ "24812.13027313195379111103", 0x40D83B0856651E52ULL },
+			{ "2.2250738585072011e-308", 0x000FFFFFFFFFFFFFULL },
+			{ "4.9406564584124654e-324", 0x0000000000000001ULL },
+			{ "1.7976931348623158e308", 0x7FEFFFFFFFFFFFFFULL }
+		};
+
+		bool8 success = true;
+		for (uint32 i = 0; i < sizeof(float32_cases) / sizeof(*float32_cases); i++)
+		{
+			float32 value = 0.0f;
+			uint32 bits = 0;
+			bool8 parsed = parse(float32_cases[i].text, &value);
+			Memory::copy_memory(&value, &bits, sizeof(bits));
+			if (!parsed || bits != float32_cases[i].bits)
+			{
+				SHMERRORV("float_parse_self_check - '%s' parsed to float32 bits %u, expected %u.", float32_cases[i].text, bits, float32_cases[i].bits);
+				success = false;
+			}
 		}
 
-		return true;
-	}
-
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, uint32* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
+		for (uint32 i = 0; i < sizeof(float64_cases) / sizeof(*float64_cases); i++)
 		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
+			float64 value = 0.0;
+			uint64 bits = 0;
+			bool8 parsed = parse(float64_cases[i].text, &value);
+			Memory::copy_memory(&value, &bits, sizeof(bits));
+			if (!parsed || bits != float64_cases[i].bits)
+			{
+				SHMERRORV("float_parse_self_check - '%s' parsed to float64 bits %lu, expected %lu.", float64_cases[i].text, bits, float64_cases[i].bits);
+				success = false;
+			}
 		}
 
-		return true;
+		return success;
 	}
+#endif
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, uint64* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
+#undef PARSE_WHOLE
 
-		for (uint32 i = 0; i < arr_count; i++)
-		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
-
-			read = &read[next_del_index + 1];
-		}
+	bool8 parse(const char* s, bool8* out)
+	{
+		if (equal_i(s, "true") || equal_i(s, "1"))
+			*out = true;
+		else
+			*out = false;
 
 		return true;
 	}
 
-	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, bool8* out_arr)
-	{
-		const char* read = s;
-		char parse_buffer[32];
-		uint32 c = 0;
-
-		for (uint32 i = 0; i < arr_count; i++)
-		{
-			uint32 next_del_index = CString::index_of(read, delimiter);
-			CString::copy(read, parse_buffer, 32, next_del_index);
-			if (!parse(parse_buffer, &out_arr[i]))
-				return false;
+	// NOTE: Parses straight out of the source string. Blanks around values are skipped, unless the delimiter itself is a blank.
+#define PARSE_ARR(type) \
+	bool8 parse_arr(const char* s, char delimiter, uint32 arr_count, type* out_arr) \
+	{ \
+		const char* read = s; \
+		bool8 blank_delimiter = delimiter == ' ' || delimiter == '\t'; \
+		for (uint32 i = 0; i < arr_count; i++) \
+		{ \
+			if (!parse_next(read, &out_arr[i])) \
+				return false; \
+			if (!blank_delimiter) \
+				read = skip_blanks(read); \
+			if (i + 1 < arr_count) \
+			{ \
+				if (*read != delimiter) \
+					return false; \
+				read++; \
+			} \
+		} \
+		return true; \
+	}
 
-			read = &read[next_del_index + 1];
-		}
+	PARSE_ARR(float32)
+	PARSE_ARR(float64)
+	PARSE_ARR(int8)
+	PARSE_ARR(int16)
+	PARSE_ARR(int32)
+	PARSE_ARR(int64)
+	PARSE_ARR(uint8)
+	PARSE_ARR(uint16)
+	PARSE_ARR(uint32)
+	PARSE_ARR(uint64)
+	PARSE_ARR(bool8)
 
-		return true;
-	}
+#undef PARSE_ARR
 
 }
-
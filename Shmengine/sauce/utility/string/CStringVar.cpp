@@ -7,12 +7,50 @@
 namespace CString
 {
 
+	// NOTE: Arguments get truncated to the remaining buffer space. Returns the number of characters written.
+	static uint32 write_chars(char* target_buffer, uint32 buffer_limit, uint32 target_i, const char* source, uint32 length)
+	{
+		uint32 space = buffer_limit - 1 - target_i;
+		if (length > space)
+			length = space;
+
+		for (uint32 i = 0; i < length; i++)
+			target_buffer[target_i + i] = source[i];
+
+		return length;
+	}
+
+	static uint32 write_int(char* target_buffer, uint32 buffer_limit, uint32 target_i, int64 value)
+	{
+		char digits[32];
+		return write_chars(target_buffer, buffer_limit, target_i, digits, format_int64(value, digits));
+	}
+
+	static uint32 write_uint(char* target_buffer, uint32 buffer_limit, uint32 target_i, uint64 value)
+	{
+		char digits[32];
+		return write_chars(target_buffer, buffer_limit, target_i, digits, format_uint64(value, digits));
+	}
+
+	static uint32 write_float(char* target_buffer, uint32 buffer_limit, uint32 target_i, float64 value, int32 decimals)
+	{
+		char digits[format_float_max_length];
+		return write_chars(target_buffer, buffer_limit, target_i, digits, format_float64(value, decimals, digits));
+	}
+
+	static uint32 write_float(char* target_buffer, uint32 buffer_limit, uint32 target_i, float32 value, int32 decimals)
+	{
+		char digits[format_float_max_length];
+		return write_chars(target_buffer, buffer_limit, target_i, digits, format_float32(value, decimals, digits));
+	}
+
 	int32 _print_s_base(char* target_buffer, uint32 buffer_limit, const char* format, const PrintArg* args, uint64 arg_count)
 	{
 
-		for (uint32 i = 0; i < buffer_limit; i++)
-			target_buffer[i] = 0;
+		if (!buffer_limit)
+			return -1;
 
+		target_buffer[0] = 0;
 		uint32 target_i = 0;
 		uint32 arg_i = 0;
 
@@ -20,12 +58,13 @@ namespace CString
 		{
 			while (*c != '%' && *c != 0)
 			{
-				target_buffer[target_i++] = *c;
 				if (target_i >= buffer_limit - 1)
 				{
+					target_buffer[target_i] = 0;
 					SHMERROR("print_s: Buffer ran out of space!");
 					return -1;
 				}
+				target_buffer[target_i++] = *c;
 				c++;
 			}
 
@@ -69,7 +108,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::INT64)
 					{
 						int64 v = args[arg_i++].int64_value;         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_int(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -80,7 +119,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::INT16)
 					{
 						int16 v = args[arg_i++].int16_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_int(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -91,7 +130,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::INT8)
 					{
 						int8 v = args[arg_i++].int8_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_int(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -102,7 +141,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::INT32)
 					{
 						int32 v = args[arg_i++].int32_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_int(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -122,7 +161,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::UINT64)
 					{
 						uint64 v = args[arg_i++].uint64_value;         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_uint(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -133,7 +172,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::UINT16)
 					{
 						uint16 v = args[arg_i++].uint16_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_uint(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -144,7 +183,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::UINT8)
 					{
 						uint8 v = args[arg_i++].uint8_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_uint(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -155,7 +194,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::UINT32)
 					{
 						uint32 v = args[arg_i++].uint32_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v));
+						target_i += write_uint(target_buffer, buffer_limit, target_i, v);
 					}
 					else
 						valid_format = false;
@@ -169,12 +208,13 @@ namespace CString
 			{
 				if (args[arg_i].type != PrintArg::Type::CHAR_PTR)
 				{
+					target_buffer[target_i] = 0;
 					SHMERROR("print_s: Provided arguments do not match format!");
 					return -1;
 				}
 
 				const char* v = args[arg_i++].char_ptr;         //Fetch String argument
-				target_i += append(target_buffer, buffer_limit, v);
+				target_i += write_chars(target_buffer, buffer_limit, target_i, v, length(v));
 
 				break;
 			}
@@ -182,23 +222,30 @@ namespace CString
 			{
 				if (args[arg_i].type != PrintArg::Type::CHAR)
 				{
+					target_buffer[target_i] = 0;
 					SHMERROR("print_s: Provided arguments do not match format!");
 					return -1;
 				}
 
 				char v = args[arg_i++].char_value[0];         //Fetch Character argument
-				target_i += append(target_buffer, buffer_limit, v);
+				target_i += write_chars(target_buffer, buffer_limit, target_i, &v, 1);
 
 				break;
 			}
 			case('f'):
 			{				
+				// NOTE: %f2 for fixed decimals, %fr for the shortest round trip output.
 				int32 decimals = 2;
 				if (*(c + 1) >= '0' && *(c + 1) <= '9')
 				{
 					c++;
 					decimals = (int32)(*c - '0');
 				}
+				else if (*(c + 1) == 'r')
+				{
+					c++;
+					decimals = format_float_shortest;
+				}
 
 				switch (arg_size)
 				{
@@ -207,7 +254,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::FLOAT64)
 					{
 						float64 v = args[arg_i++].float64_value;         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v, decimals));
+						target_i += write_float(target_buffer, buffer_limit, target_i, v, decimals);
 					}
 					else
 						valid_format = false;
@@ -218,7 +265,7 @@ namespace CString
 					if (args[arg_i].type == PrintArg::Type::FLOAT32)
 					{
 						float32 v = args[arg_i++].float32_value[0];         //Fetch Integer argument
-						target_i += append(target_buffer, buffer_limit, to_string(v, decimals));
+						target_i += write_float(target_buffer, buffer_limit, target_i, v, decimals);
 					}
 					else
 						valid_format = false;
@@ -232,11 +279,13 @@ namespace CString
 
 			if (!valid_format)
 			{
+				target_buffer[target_i] = 0;
 				SHMERROR("print_s: Provided arguments do not match format!");
 				return -1;
 			}
 		}
 
+		target_buffer[target_i] = 0;
 		return (int32)target_i;
 
 	}	
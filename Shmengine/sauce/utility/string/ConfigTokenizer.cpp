@@ -0,0 +1,118 @@
+#include "../ConfigTokenizer.hpp"
+
+#include "core/Logging.hpp"
+#include "utility/CString.hpp"
+
+ConfigTokenizer::ConfigTokenizer(char* buffer, uint32 size, const char* source_name) : cursor(buffer), end(buffer + size), line_number(0), source_name(source_name)
+{
+}
+
+bool8 ConfigTokenizer::next(ConfigToken* out_token)
+{
+	while (cursor < end && *cursor)
+	{
+		char* line_start = cursor;
+		char* line_end = line_start;
+		while (line_end < end && *line_end && *line_end != '\n')
+			line_end++;
+
+		cursor = (line_end < end && *line_end == '\n') ? line_end + 1 : end;
+		line_number++;
+
+		while (line_start < line_end && CString::is_whitespace(*line_start))
+			line_start++;
+		while (line_end > line_start && CString::is_whitespace(line_end[-1]))
+			line_end--;
+
+		if (line_start == line_end || *line_start == '#')
+			continue;
+
+		*line_end = 0;
+		out_token->line_number = line_number;
+
+		if (*line_start == '[')
+		{
+			out_token->type = ConfigToken::Type::Section;
+			out_token->name = line_start;
+			out_token->value = line_end;
+			return true;
+		}
+
+		char* equal_sign = line_start;
+		while (*equal_sign && *equal_sign != '=')
+			equal_sign++;
+
+		if (!*equal_sign)
+		{
+			SHMWARNV("Potential formatting issue found in file '%s': '=' token not found. Skipping line %u.", source_name, line_number);
+			continue;
+		}
+
+		char* key_end = equal_sign;
+		while (key_end > line_start && CString::is_whitespace(key_end[-1]))
+			key_end--;
+		*key_end = 0;
+
+		char* value_start = equal_sign + 1;
+		while (value_start < line_end && CString::is_whitespace(*value_start))
+			value_start++;
+
+		out_token->type = ConfigToken::Type::Property;
+		out_token->name = line_start;
+		out_token->value = value_start;
+		return true;
+	}
+
+	return false;
+}
+
+char* ConfigTokenizer::split_next(char** cursor, char delimiter)
+{
+	char* item = *cursor;
+	if (!item)
+		return 0;
+
+	while (CString::is_whitespace(*item))
+		item++;
+
+	char* item_end = item;
+	while (*item_end && *item_end != delimiter)
+		item_end++;
+
+	*cursor = *item_end ? item_end + 1 : 0;
+
+	while (item_end > item && CString::is_whitespace(item_end[-1]))
+		item_end--;
+	*item_end = 0;
+
+	return item;
+}
+
+uint32 ConfigTokenizer::count_sections(const char* buffer, uint32 size, const char* section_header)
+{
+	uint32 header_length = CString::length(section_header);
+	const char* read = buffer;
+	const char* buffer_end = buffer + size;
+	uint32 count = 0;
+
+	while (read < buffer_end && *read)
+	{
+		while (read < buffer_end && (*read == ' ' || *read == '\t'))
+			read++;
+
+		uint32 remaining = (uint32)(buffer_end - read);
+		if (remaining >= header_length && CString::nequal_i(read, section_header, header_length))
+		{
+			const char* after = read + header_length;
+			if (after == buffer_end || !*after || CString::is_whitespace(*after))
+				count++;
+		}
+
+		while (read < buffer_end && *read && *read != '\n')
+			read++;
+		if (read < buffer_end && *read == '\n')
+			read++;
+	}
+
+	return count;
+}
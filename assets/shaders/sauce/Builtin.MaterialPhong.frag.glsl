@@ -69,7 +69,10 @@ void main()
     TBN = mat3(tangent, bitangent, normal);
 
     // Update the normal to use a sample from the normal map.
-    vec3 localNormal = 2.0 * texture(samplers[SAMP_NORMAL], in_dto.texcoord).rgb - 1.0;
+    // Normal maps only store x and y (BC5), z gets reconstructed from the unit length.
+    vec3 localNormal;
+    localNormal.xy = 2.0 * texture(samplers[SAMP_NORMAL], in_dto.texcoord).rg - 1.0;
+    localNormal.z = sqrt(max(1.0 - dot(localNormal.xy, localNormal.xy), 0.0));
     normal = normalize(TBN * localNormal);
 
     if(in_mode == 0 || in_mode == 1) 
@@ -14,6 +14,8 @@ layout(set = 0, binding = 0) uniform global_uniform_object
 struct UIMaterialProperties
 {
     vec4 diffuse_color;
+    float distance_field;
+    vec3 padding;
 };
 
 layout(set = 1, binding = 0) uniform instance_uniform_object
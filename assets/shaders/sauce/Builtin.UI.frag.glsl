@@ -8,5 +8,15 @@ layout(location = 0) out vec4 out_color;
 
 void main()
 {
-    out_color = instance_ubo.properties.diffuse_color * texture(samplers[SAMP_DIFFUSE], in_dto.tex_coord);
+    vec4 sampled = texture(samplers[SAMP_DIFFUSE], in_dto.tex_coord);
+    if (instance_ubo.properties.distance_field != 0.0)
+    {
+        // Glyph edge sits at 0.5, smoothing over one screen pixel keeps it crisp at any scale.
+        float smoothing = max(fwidth(sampled.r) * 0.5, 0.0001);
+        float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, sampled.r);
+        out_color = vec4(instance_ubo.properties.diffuse_color.rgb, instance_ubo.properties.diffuse_color.a * alpha);
+        return;
+    }
+
+    out_color = instance_ubo.properties.diffuse_color * sampled;
 }
\ No newline at end of file
@@ -62,6 +62,7 @@ project  (engine_name)
     {
         "Winmm.lib",
         "user32.lib",     
+        "Synchronization.lib",
         workspace_dir .. "/vendor/Optick/lib/x64/release/OptickCore.lib",   
     } 
 
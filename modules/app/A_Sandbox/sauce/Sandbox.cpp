@@ -57,9 +57,14 @@ bool8 application_init(Application* app_inst)
 	app_state->world_camera->set_position({ 10.5f, 5.0f, 9.5f });
 	app_state->allocation_count = 0;
 
-	if (!FontSystem::load_font("Noto Serif 21px", "NotoSerif_21", 21) ||
-		!FontSystem::load_font("Roboto Mono 21px", "RobotoMono_21", 21) ||
-		!FontSystem::load_font("Martian Mono", "MartianMono", 21))
+	FontSystem::FontLoadRequest font_requests[] =
+	{
+		{ "Noto Serif 21px", "NotoSerif_21", 21, false },
+		{ "Roboto Mono 21px", "RobotoMono_21", 21, false },
+		{ "Martian Mono", "MartianMono", 21, false },
+		{ "Martian Mono SDF", "MartianMono", 0, true }
+	};
+	if (!FontSystem::load_fonts(sizeof(font_requests) / sizeof(font_requests[0]), font_requests))
 	{
 		SHMERROR("Failed to load default fonts.");
 		return false;
@@ -67,14 +72,15 @@ bool8 application_init(Application* app_inst)
 
 	app_state->debug_console.init();
 
+	// NOTE: The debug overlay uses the distance field font, so it stays sharp when drawn at other sizes.
 	UITextConfig ui_text_config = {};
-	ui_text_config.font_name = "Martian Mono";
+	ui_text_config.font_name = "Martian Mono SDF";
 	ui_text_config.font_size = 21;
 	ui_text_config.text_content = "Some täest text,\n\tyo!";
 
 	if (!ui_text_init(&ui_text_config, &app_state->debug_info_text))
 	{
-		SHMERROR("Failed to load basic ui truetype text.");
+		SHMERROR("Failed to load basic ui distance field text.");
 		return false;
 	}
 	ui_text_set_position(&app_state->debug_info_text, { 500, 550, 0 });
@@ -241,10 +247,14 @@ bool8 application_update(FrameData* frame_data)
 	Math::Vec3f up = app_state->world_camera->get_up();
 	app_state->camera_frustum = Math::frustum_create(app_state->world_camera->get_position(), fwd, right, up, (float32)app_state->width / (float32)app_state->height, Math::deg_to_rad(45.0f), 0.1f, 1000.0f);
 
+	Renderer::TextureStreamingStats streaming_stats;
+	Renderer::texture_get_streaming_stats(&streaming_stats);
+
 	char ui_text_buffer[512];
-	CString::safe_print_s<uint32, uint32, int32, int32, float32, float32, float32, float32, float32, float32, float64, float64, float64>
-		(ui_text_buffer, 512, "Object Hovered ID: %u\nWorld geometry count: %u\nMouse Pos : [%i, %i]\tCamera Pos : [%f3, %f3, %f3]\nCamera Rot : [%f3, %f3, %f3]\n\nLast frametime: %lf4 ms\nLogic: %lf4 / Render: %lf4",
-			app_state->hovered_object_id, frame_data->drawn_geometry_count, mouse_pos.x, mouse_pos.y, pos.x, pos.y, pos.z, rot.x, rot.y, rot.z, last_frametime * 1000.0, last_logictime * 1000.0, last_rendertime * 1000.0);
+	CString::safe_print_s<uint32, uint32, int32, int32, float32, float32, float32, float32, float32, float32, float64, float64, float64, float64, float64, uint32>
+		(ui_text_buffer, 512, "Object Hovered ID: %u\nWorld geometry count: %u\nMouse Pos : [%i, %i]\tCamera Pos : [%f3, %f3, %f3]\nCamera Rot : [%f3, %f3, %f3]\n\nLast frametime: %lf4 ms\nLogic: %lf4 / Render: %lf4\nTextures: %lf1 / %lf1 MiB, %u pending",
+			app_state->hovered_object_id, frame_data->drawn_geometry_count, mouse_pos.x, mouse_pos.y, pos.x, pos.y, pos.z, rot.x, rot.y, rot.z, last_frametime * 1000.0, last_logictime * 1000.0, last_rendertime * 1000.0,
+			(float64)streaming_stats.resident_size / (float64)mebibytes(1), (float64)streaming_stats.residency_budget / (float64)mebibytes(1), streaming_stats.pending_request_count);
 
 	ui_text_set_text(&app_state->debug_info_text, ui_text_buffer);
 
@@ -3,16 +3,86 @@
 #include <core/Engine.hpp>
 #include <core/Logging.hpp>
 #include <core/Memory.hpp>
+#include <core/Clock.hpp>
+#include <containers/Buffer.hpp>
+#include <utility/Utility.hpp>
 #include <utility/String.hpp>
+#include <utility/ConfigTokenizer.hpp>
 #include <utility/math/Transform.hpp>
 #include <platform/FileSystem.hpp>
 #include <renderer/RendererTypes.hpp>
 #include <resources/loaders/MeshLoader.hpp>
+#include <resources/loaders/GenericLoader.hpp>
+#include <systems/CookSystem.hpp>
+
+// NOTE: Strings of all records live in one table behind the records. Offset 0 always points to an empty string.
+struct ShmenebFileHeader
+{
+    uint32 magic;
+    uint16 version;
+    uint16 reserved;
+    uint32 strings_offset;
+    uint32 strings_size;
+    uint32 name_offset;
+    uint32 description_offset;
+
+    uint32 max_meshes_count;
+    uint32 max_p_lights_count;
+    uint32 max_terrains_count;
+
+    uint32 skyboxes_count;
+    uint32 skyboxes_offset;
+    uint32 meshes_count;
+    uint32 meshes_offset;
+    uint32 dir_lights_count;
+    uint32 dir_lights_offset;
+    uint32 point_lights_count;
+    uint32 point_lights_offset;
+    uint32 terrains_count;
+    uint32 terrains_offset;
+    uint64 source_hash;
+};
+
+struct ShmenebSkyboxRecord
+{
+    uint32 name_offset;
+    uint32 cubemap_name_offset;
+};
+
+struct ShmenebMeshRecord
+{
+    uint32 type;
+    uint32 name_offset;
+    uint32 parent_name_offset;
+    uint32 resource_name_offset;
+    uint32 material_name_offset;
+    Math::Vec3f dim;
+    Math::Vec2f tiling;
+    Math::Vec3f position;
+    Math::Quat rotation;
+    Math::Vec3f scale;
+};
+
+struct ShmenebTerrainRecord
+{
+    uint32 name_offset;
+    uint32 resource_name_offset;
+    Math::Vec3f position;
+    Math::Quat rotation;
+    Math::Vec3f scale;
+};
+
+static const uint32 shmeneb_magic = 0x424E4553; // "SENB"
+static const uint16 shmeneb_file_version = 2;
 
 namespace ResourceSystem
 {
     static const char* loader_type_path = "scenes/";
 
+    static bool8 load_shmene_file(const char* name, const char* full_filepath, SceneResourceData* out_resource);
+    static bool8 write_shmeneb_file(const char* full_filepath, const SceneResourceData* resource, uint64 source_hash);
+    static bool8 load_shmeneb_file(const char* full_filepath, const uint64* source_hash, SceneResourceData* out_resource);
+
 #define PARSE_VALUE(s, v) if (!CString::parse(s, v)) \
     { \
         SHMERRORV("Failed parsing value for %s on line %u", s, line_number); \
@@ -24,10 +94,46 @@ namespace ResourceSystem
     {
 
         const char* format = "%s%s%s%s";
-        char full_filepath[Constants::max_filepath_length];
+        char shmeneb_filepath[Constants::max_filepath_length];
+        char shmene_filepath[Constants::max_filepath_length];
 
         CString::safe_print_s<const char*, const char*, const char*, const char*>
-            (full_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, name, ".shmene");
+            (shmeneb_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, name, ".shmeneb");
+        CString::safe_print_s<const char*, const char*, const char*, const char*>
+            (shmene_filepath, Constants::max_filepath_length, format, Engine::get_assets_base_path(), loader_type_path, name, ".shmene");
+
+        // NOTE: Load times of both paths get logged to compare the binary format against parsing the text file.
+        Clock load_clock;
+        clock_start(&load_clock);
+
+        // NOTE: Binary files only get used while they match the text they were built from. Builds shipping without the text take them as they are.
+        uint64 source_hash = 0;
+        bool8 has_source = generic_loader_get_source_hash(shmene_filepath, &source_hash);
+
+        if (CookSystem::is_cooked(shmeneb_filepath) || FileSystem::file_exists(shmeneb_filepath))
+        {
+            if (load_shmeneb_file(shmeneb_filepath, has_source ? &source_hash : 0, out_resource))
+            {
+                clock_update(&load_clock);
+                SHMINFOV("Loaded scene '%s' from binary file in %lf3 ms.", name, load_clock.elapsed * 1000.0);
+                return true;
+            }
+        }
+
+        if (!load_shmene_file(name, shmene_filepath, out_resource))
+            return false;
+
+        clock_update(&load_clock);
+        SHMINFOV("Loaded scene '%s' from text file in %lf3 ms.", name, load_clock.elapsed * 1000.0);
+
+        // NOTE: Failing to write the binary file only costs parsing the text again on the next load.
+        write_shmeneb_file(shmeneb_filepath, out_resource, source_hash);
+        return true;
+
+    }
+
+    static bool8 load_shmene_file(const char* name, const char* full_filepath, SceneResourceData* out_resource)
+    {
 
         FileSystem::FileHandle f;
         if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
@@ -57,49 +163,17 @@ namespace ResourceSystem
         };
 
         ParserScope scope = ParserScope::Scene;
-        // Read each line of the file.
-        String line(512);
-        uint64 line_length = 0;       
-
-        String var_name;
-        String value;
-
         bool8 success = true;
 
-        uint32 dir_lights_count = 0;
-        uint32 point_lights_count = 0;
-        uint32 meshes_count = 0;
-        uint32 skyboxes_count = 0;
-        uint32 terrains_count = 0;
+        char* content = file_content.c_str_vulnerable();
+        content[bytes_read] = 0;
 
-        uint32 line_number = 1;
-        const char* continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
-        {
-            line.trim();
-            line_length = line.len();
-            if (line_length < 1 || line[0] == '#')
-            {
-                line_number++;
-                continue;
-            }
-
-            if (line[0] == '[')
-            {
-                if (line.equal_i("[Skybox]"))
-                    skyboxes_count++;
-                else if (line.equal_i("[Mesh]"))
-                    meshes_count++;
-                else if (line.equal_i("[PrimitiveCube]"))
-                    meshes_count++;
-                else if (line.equal_i("[DirectionalLight]"))
-                    dir_lights_count++;
-                else if (line.equal_i("[PointLight]"))
-                    point_lights_count++;
-                else if (line.equal_i("[Terrain]"))
-                    terrains_count++;
-            }
-        }
+        // NOTE: Section counts are gathered before tokenizing, since the tokenizer terminates lines in place.
+        uint32 skyboxes_count = ConfigTokenizer::count_sections(content, bytes_read, "[Skybox]");
+        uint32 meshes_count = ConfigTokenizer::count_sections(content, bytes_read, "[Mesh]") + ConfigTokenizer::count_sections(content, bytes_read, "[PrimitiveCube]");
+        uint32 dir_lights_count = ConfigTokenizer::count_sections(content, bytes_read, "[DirectionalLight]");
+        uint32 point_lights_count = ConfigTokenizer::count_sections(content, bytes_read, "[PointLight]");
+        uint32 terrains_count = ConfigTokenizer::count_sections(content, bytes_read, "[Terrain]");
 
         out_resource->skyboxes.init(skyboxes_count, 0, AllocationTag::Resource);
         out_resource->meshes.init(meshes_count, 0, AllocationTag::Resource);
@@ -115,58 +189,47 @@ namespace ResourceSystem
 
         out_resource->transform = Math::transform_create();
 
-        line_number = 1;
-        continue_ptr = 0;
-        while (FileSystem::read_line(file_content.c_str(), line, &continue_ptr))
+        ConfigTokenizer tokenizer(content, bytes_read, full_filepath);
+        ConfigToken token;
+        while (tokenizer.next(&token))
         {
-            // Trim the string.
-            line.trim();
-
-            // Get the trimmed length.
-            line_length = line.len();
+            uint32 line_number = token.line_number;
 
-            // Skip blank lines and comments.
-            if (line_length < 1 || line[0] == '#')
-            {
-                line_number++;
-                continue;
-            }
-
-            if (line[0] == '[')
+            if (token.type == ConfigToken::Type::Section)
             {
                 if (scope == ParserScope::Scene)
                 {
-                    if (line.equal_i("[Skybox]"))
+                    if (CString::equal_i(token.name, "[Skybox]"))
                     {
                         scope = ParserScope::Skybox;
                         skybox_i++;
                     }                        
-                    else if (line.equal_i("[Mesh]"))
+                    else if (CString::equal_i(token.name, "[Mesh]"))
                     {
                         scope = ParserScope::Mesh;
                         mesh_i++;
                         out_resource->meshes[mesh_i].transform = Math::transform_create();
                         out_resource->meshes[mesh_i].type = SceneMeshType::Resource;
                     }
-                    else if (line.equal_i("[PrimitiveCube]"))
+                    else if (CString::equal_i(token.name, "[PrimitiveCube]"))
                     {
                         scope = ParserScope::PrimitiveCube;
                         mesh_i++;
                         out_resource->meshes[mesh_i].transform = Math::transform_create();
                         out_resource->meshes[mesh_i].type = SceneMeshType::Cube;
                     }
-                    else if (line.equal_i("[DirectionalLight]"))
+                    else if (CString::equal_i(token.name, "[DirectionalLight]"))
                     {
                         scope = ParserScope::DirectionalLight;
                         dir_light_i++;
 
                     }
-                    else if (line.equal_i("[PointLight]"))
+                    else if (CString::equal_i(token.name, "[PointLight]"))
                     {
                         scope = ParserScope::PointLight;
                         point_light_i++;
                     }
-                    else if (line.equal_i("[Terrain]"))
+                    else if (CString::equal_i(token.name, "[Terrain]"))
                     {
                         scope = ParserScope::Terrain;
                         terrain_i++;
@@ -181,7 +244,7 @@ namespace ResourceSystem
                 }
                 else
                 {
-                    if (line.equal_i("[/]"))
+                    if (CString::equal_i(token.name, "[/]"))
                     {
                         scope = ParserScope::Scene;
                     }                     
@@ -193,113 +256,99 @@ namespace ResourceSystem
                     }
                 }
 
-                line_number++;
                 continue;
             }
 
-            int32 equal_index = line.index_of('=');
-            if (equal_index == -1) {
-                SHMWARNV("Potential formatting issue found in file '%s': '=' token not found. Skipping line %ui.", full_filepath, line_number);
-                line_number++;
-                continue;
-            }
-
-            mid(var_name, line.c_str(), 0, equal_index);
-            var_name.trim();
-
-            mid(value, line.c_str(), equal_index + 1);
-            value.trim();
-
             if (scope == ParserScope::Scene)
             {
                 // Process the variable.
-                if (var_name.equal_i("parser_version"))
+                if (CString::equal_i(token.name, "parser_version"))
                 {
                     // TODO: version
                 }
-                else if (var_name.equal_i("name"))
+                else if (CString::equal_i(token.name, "name"))
                 {
-                    out_resource->name = value;
+                    out_resource->name = token.value;
                 }
-                else if (var_name.equal_i("description"))
+                else if (CString::equal_i(token.name, "description"))
                 {
-                    out_resource->description = value;
+                    out_resource->description = token.value;
                 }
-                else if (var_name.equal_i("max_meshes_count"))
+                else if (CString::equal_i(token.name, "max_meshes_count"))
                 {
-                    PARSE_VALUE(value.c_str(), &out_resource->max_meshes_count);
+                    PARSE_VALUE(token.value, &out_resource->max_meshes_count);
                 }
-                else if (var_name.equal_i("max_terrains_count"))
+                else if (CString::equal_i(token.name, "max_terrains_count"))
                 {
-                    PARSE_VALUE(value.c_str(), &out_resource->max_terrains_count);
+                    PARSE_VALUE(token.value, &out_resource->max_terrains_count);
                 }
-                else if (var_name.equal_i("max_p_lights_count"))
+                else if (CString::equal_i(token.name, "max_p_lights_count"))
                 {
-                    PARSE_VALUE(value.c_str(), &out_resource->max_p_lights_count);
+                    PARSE_VALUE(token.value, &out_resource->max_p_lights_count);
                 }
             }
             else if (scope == ParserScope::Skybox)
             {
                 SceneSkyboxResourceData* skybox = &out_resource->skyboxes[skybox_i];
 
-                if (var_name.equal_i("name"))
+                if (CString::equal_i(token.name, "name"))
                 {
-                    skybox->name = value;
+                    skybox->name = token.value;
                 }
-                else if (var_name.equal_i("cubemap_name"))
+                else if (CString::equal_i(token.name, "cubemap_name"))
                 {
-                    skybox->cubemap_name = value;
+                    skybox->cubemap_name = token.value;
                 }
             }
             else if (scope == ParserScope::Mesh || scope == ParserScope::PrimitiveCube)
             {
                 SceneMeshResourceData* mesh = &out_resource->meshes[mesh_i];
 
-                if (var_name.equal_i("name"))
+                if (CString::equal_i(token.name, "name"))
                 {
-                    mesh->name = value;
+                    mesh->name = token.value;
                 }
-                else if (var_name.equal_i("parent_name"))
+                else if (CString::equal_i(token.name, "parent_name"))
                 {
-                    mesh->parent_name = value;
+                    mesh->parent_name = token.value;
                 }
-                else if (var_name.equal_i("position"))
+                else if (CString::equal_i(token.name, "position"))
                 {
                     Math::Vec3f position;
-                    PARSE_VALUE(value.c_str(), &position);
+                    PARSE_VALUE(token.value, &position);
                     Math::transform_translate(mesh->transform, position);
                 }
-                else if (var_name.equal_i("rotation"))
+                else if (CString::equal_i(token.name, "rotation"))
                 {
                     Math::Vec4f rotation;
-                    PARSE_VALUE(value.c_str(), &rotation);
+                    PARSE_VALUE(token.value, &rotation);
                     Math::transform_rotate(mesh->transform, rotation);
                 }
-                else if (var_name.equal_i("scale"))
+                else if (CString::equal_i(token.name, "scale"))
                 {
                     Math::Vec3f scalar;
-                    PARSE_VALUE(value.c_str(), &scalar);
+                    PARSE_VALUE(token.value, &scalar);
                     Math::transform_scale(mesh->transform, scalar);
                 }
 
                 if (scope == ParserScope::Mesh)
                 {
-                    if (var_name.equal_i("resource_name"))
-                        mesh->resource_name = value;
+                    if (CString::equal_i(token.name, "resource_name"))
+                        mesh->resource_name = token.value;
                 }
                 else
                 {
-                    if (var_name.equal_i("dim"))
+                    if (CString::equal_i(token.name, "dim"))
                     {
-                        PARSE_VALUE(value.c_str(), &mesh->cube_data.dim);
+                        PARSE_VALUE(token.value, &mesh->cube_data.dim);
                     }
-                    else if (var_name.equal_i("tiling"))
+                    else if (CString::equal_i(token.name, "tiling"))
                     {
-                        PARSE_VALUE(value.c_str(), &mesh->cube_data.tiling);
+                        PARSE_VALUE(token.value, &mesh->cube_data.tiling);
                     }
-                    else if (var_name.equal_i("material_name"))
+                    else if (CString::equal_i(token.name, "material_name"))
                     {
-                        CString::copy(value.c_str(), mesh->cube_data.material_name, Constants::max_material_name_length);
+                        CString::copy(token.value, mesh->cube_data.material_name, Constants::max_material_name_length);
                     }
                 }
             }
@@ -307,73 +356,72 @@ namespace ResourceSystem
             {
                 DirectionalLight* dir_light = &out_resource->dir_lights[dir_light_i];
 
-                if (var_name.equal_i("color"))
+                if (CString::equal_i(token.name, "color"))
                 {
-                    PARSE_VALUE(value.c_str(), &dir_light->color);
+                    PARSE_VALUE(token.value, &dir_light->color);
                 }
-                else if (var_name.equal_i("direction"))
+                else if (CString::equal_i(token.name, "direction"))
                 {
-                    PARSE_VALUE(value.c_str(), &dir_light->direction);
+                    PARSE_VALUE(token.value, &dir_light->direction);
                 }
             }
             else if (scope == ParserScope::PointLight)
             {
                 PointLight* point_light = &out_resource->point_lights[point_light_i];
 
-                if (var_name.equal_i("color"))
+                if (CString::equal_i(token.name, "color"))
                 {
-                    PARSE_VALUE(value.c_str(), &point_light->color);
+                    PARSE_VALUE(token.value, &point_light->color);
                 }
-                else if (var_name.equal_i("position"))
+                else if (CString::equal_i(token.name, "position"))
                 {
-                    PARSE_VALUE(value.c_str(), &point_light->position);
+                    PARSE_VALUE(token.value, &point_light->position);
                 }
-                else if (var_name.equal_i("constant_f"))
+                else if (CString::equal_i(token.name, "constant_f"))
                 {
-                    PARSE_VALUE(value.c_str(), &point_light->constant_f);
+                    PARSE_VALUE(token.value, &point_light->constant_f);
                 }
-                else if (var_name.equal_i("linear"))
+                else if (CString::equal_i(token.name, "linear"))
                 {
-                    PARSE_VALUE(value.c_str(), &point_light->linear);
+                    PARSE_VALUE(token.value, &point_light->linear);
                 }
-                else if (var_name.equal_i("quadratic"))
+                else if (CString::equal_i(token.name, "quadratic"))
                 {
-                    PARSE_VALUE(value.c_str(), &point_light->quadratic);
+                    PARSE_VALUE(token.value, &point_light->quadratic);
                 }
             }    
             else if (scope == ParserScope::Terrain)
             {
                 SceneTerrainResourceData* terrain = &out_resource->terrains[terrain_i];
 
-                if (var_name.equal_i("name"))
+                if (CString::equal_i(token.name, "name"))
                 {
-                    terrain->name = value;
+                    terrain->name = token.value;
                 }
-                else if (var_name.equal_i("resource_name"))
+                else if (CString::equal_i(token.name, "resource_name"))
                 {
-                    terrain->resource_name = value;
+                    terrain->resource_name = token.value;
                 }
-                else if (var_name.equal_i("position"))
+                else if (CString::equal_i(token.name, "position"))
                 {
                     Math::Vec3f position;
-                    PARSE_VALUE(value.c_str(), &position);
+                    PARSE_VALUE(token.value, &position);
                     Math::transform_translate(terrain->xform, position);
                 }
-                else if (var_name.equal_i("rotation"))
+                else if (CString::equal_i(token.name, "rotation"))
                 {
                     Math::Vec4f rotation;
-                    PARSE_VALUE(value.c_str(), &rotation);
+                    PARSE_VALUE(token.value, &rotation);
                     Math::transform_rotate(terrain->xform, rotation);
                 }
-                else if (var_name.equal_i("scale"))
+                else if (CString::equal_i(token.name, "scale"))
                 {
                     Math::Vec3f scalar;
-                    PARSE_VALUE(value.c_str(), &scalar);
+                    PARSE_VALUE(token.value, &scalar);
                     Math::transform_scale(terrain->xform, scalar);
                 }
             }
 
-            line_number++;
         }
 
         FileSystem::file_close(&f);
@@ -391,6 +439,272 @@ namespace ResourceSystem
 
     }
 
+    static uint32 _push_string(char* strings, uint32* strings_size, const String& s)
+    {
+        if (s.is_empty())
+            return 0;
+
+        uint32 offset = *strings_size;
+        uint32 length = CString::length(s.c_str());
+        Memory::copy_memory(s.c_str(), &strings[offset], length + 1);
+        *strings_size += length + 1;
+        return offset;
+    }
+
+    static uint32 _push_string(char* strings, uint32* strings_size, const char* s)
+    {
+        uint32 length = CString::length(s);
+        if (!length)
+            return 0;
+
+        uint32 offset = *strings_size;
+        Memory::copy_memory(s, &strings[offset], length + 1);
+        *strings_size += length + 1;
+        return offset;
+    }
+
+    static uint32 _string_size(const String& s)
+    {
+        return s.is_empty() ? 0 : CString::length(s.c_str()) + 1;
+    }
+
+    static bool8 write_shmeneb_file(const char* full_filepath, const SceneResourceData* resource, uint64 source_hash)
+    {
+
+        ShmenebFileHeader header = {};
+        header.magic = shmeneb_magic;
+        header.version = shmeneb_file_version;
+        header.max_meshes_count = resource->max_meshes_count;
+        header.max_p_lights_count = resource->max_p_lights_count;
+        header.max_terrains_count = resource->max_terrains_count;
+        header.source_hash = source_hash;
+
+        header.skyboxes_count = resource->skyboxes.capacity;
+        header.meshes_count = resource->meshes.capacity;
+        header.dir_lights_count = resource->dir_lights.capacity;
+        header.point_lights_count = resource->point_lights.capacity;
+        header.terrains_count = resource->terrains.capacity;
+
+        header.skyboxes_offset = (uint32)get_aligned_pow2(sizeof(ShmenebFileHeader), 16);
+        header.meshes_offset = (uint32)get_aligned_pow2(header.skyboxes_offset + header.skyboxes_count * sizeof(ShmenebSkyboxRecord), 16);
+        header.dir_lights_offset = (uint32)get_aligned_pow2(header.meshes_offset + header.meshes_count * sizeof(ShmenebMeshRecord), 16);
+        header.point_lights_offset = (uint32)get_aligned_pow2(header.dir_lights_offset + header.dir_lights_count * sizeof(DirectionalLight), 16);
+        header.terrains_offset = (uint32)get_aligned_pow2(header.point_lights_offset + header.point_lights_count * sizeof(PointLight), 16);
+        header.strings_offset = header.terrains_offset + header.terrains_count * sizeof(ShmenebTerrainRecord);
+
+        uint32 max_strings_size = 1 + _string_size(resource->name) + _string_size(resource->description);
+        for (uint32 i = 0; i < resource->skyboxes.capacity; i++)
+            max_strings_size += _string_size(resource->skyboxes[i].name) + _string_size(resource->skyboxes[i].cubemap_name);
+        for (uint32 i = 0; i < resource->meshes.capacity; i++)
+        {
+            const SceneMeshResourceData* mesh = &resource->meshes[i];
+            max_strings_size += _string_size(mesh->name) + _string_size(mesh->parent_name);
+            max_strings_size += mesh->type == SceneMeshType::Resource ? _string_size(mesh->resource_name) : Constants::max_material_name_length;
+        }
+        for (uint32 i = 0; i < resource->terrains.capacity; i++)
+            max_strings_size += _string_size(resource->terrains[i].name) + _string_size(resource->terrains[i].resource_name);
+
+        Buffer file_data(header.strings_offset + max_strings_size, 0, AllocationTag::Resource);
+        uint8* data = (uint8*)file_data.data;
+        char* strings = (char*)(data + header.strings_offset);
+        strings[0] = 0;
+        header.strings_size = 1;
+
+        header.name_offset = _push_string(strings, &header.strings_size, resource->name);
+        header.description_offset = _push_string(strings, &header.strings_size, resource->description);
+
+        ShmenebSkyboxRecord* skyboxes = (ShmenebSkyboxRecord*)(data + header.skyboxes_offset);
+        for (uint32 i = 0; i < header.skyboxes_count; i++)
+        {
+            skyboxes[i].name_offset = _push_string(strings, &header.strings_size, resource->skyboxes[i].name);
+            skyboxes[i].cubemap_name_offset = _push_string(strings, &header.strings_size, resource->skyboxes[i].cubemap_name);
+        }
+
+        ShmenebMeshRecord* meshes = (ShmenebMeshRecord*)(data + header.meshes_offset);
+        for (uint32 i = 0; i < header.meshes_count; i++)
+        {
+            const SceneMeshResourceData* mesh = &resource->meshes[i];
+            ShmenebMeshRecord* record = &meshes[i];
+
+            record->type = (uint32)mesh->type;
+            record->name_offset = _push_string(strings, &header.strings_size, mesh->name);
+            record->parent_name_offset = _push_string(strings, &header.strings_size, mesh->parent_name);
+            switch (mesh->type)
+            {
+            case SceneMeshType::Resource:
+            {
+                record->resource_name_offset = _push_string(strings, &header.strings_size, mesh->resource_name);
+                break;
+            }
+            case SceneMeshType::Cube:
+            {
+                record->material_name_offset = _push_string(strings, &header.strings_size, mesh->cube_data.material_name);
+                record->dim = mesh->cube_data.dim;
+                record->tiling = mesh->cube_data.tiling;
+                break;
+            }
+            }
+            record->position = mesh->transform.position;
+            record->rotation = mesh->transform.rotation;
+            record->scale = mesh->transform.scale;
+        }
+
+        if (header.dir_lights_count)
+            Memory::copy_memory(resource->dir_lights.data, data + header.dir_lights_offset, header.dir_lights_count * sizeof(DirectionalLight));
+        if (header.point_lights_count)
+            Memory::copy_memory(resource->point_lights.data, data + header.point_lights_offset, header.point_lights_count * sizeof(PointLight));
+
+        ShmenebTerrainRecord* terrains = (ShmenebTerrainRecord*)(data + header.terrains_offset);
+        for (uint32 i = 0; i < header.terrains_count; i++)
+        {
+            terrains[i].name_offset = _push_string(strings, &header.strings_size, resource->terrains[i].name);
+            terrains[i].resource_name_offset = _push_string(strings, &header.strings_size, resource->terrains[i].resource_name);
+            terrains[i].position = resource->terrains[i].xform.position;
+            terrains[i].rotation = resource->terrains[i].xform.rotation;
+            terrains[i].scale = resource->terrains[i].xform.scale;
+        }
+
+        Memory::copy_memory(&header, data, sizeof(header));
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FILE_MODE_WRITE, &f))
+        {
+            SHMERRORV("Error opening scene file for writing: '%s'", full_filepath);
+            file_data.free_data();
+            return false;
+        }
+        SHMDEBUGV("Writing .shmeneb file '%s'...", full_filepath);
+
+        uint32 file_size = header.strings_offset + header.strings_size;
+        uint32 bytes_written = 0;
+        bool8 res = FileSystem::write(&f, file_size, data, &bytes_written) && bytes_written == file_size;
+
+        FileSystem::file_close(&f);
+        file_data.free_data();
+        return res;
+
+    }
+
+    static bool8 load_shmeneb_file(const char* full_filepath, const uint64* source_hash, SceneResourceData* out_resource)
+    {
+
+        FileSystem::FileHandle f;
+        if (!FileSystem::file_open(full_filepath, FileMode::FILE_MODE_READ, &f))
+            return false;
+
+        uint32 file_size = FileSystem::get_file_size32(&f);
+        uint32 bytes_read = 0;
+        Buffer file_data(file_size ? file_size : 1, 0, AllocationTag::Resource);
+        bool8 read = FileSystem::read_all_bytes(&f, file_data.data, file_size, &bytes_read) && bytes_read == file_size;
+        FileSystem::file_close(&f);
+
+        const uint8* data = (const uint8*)file_data.data;
+        const ShmenebFileHeader* header = (const ShmenebFileHeader*)data;
+        bool8 valid = read && file_size >= sizeof(ShmenebFileHeader) &&
+            header->magic == shmeneb_magic &&
+            header->version == shmeneb_file_version &&
+            header->skyboxes_offset + (uint64)header->skyboxes_count * sizeof(ShmenebSkyboxRecord) <= file_size &&
+            header->meshes_offset + (uint64)header->meshes_count * sizeof(ShmenebMeshRecord) <= file_size &&
+            header->dir_lights_offset + (uint64)header->dir_lights_count * sizeof(DirectionalLight) <= file_size &&
+            header->point_lights_offset + (uint64)header->point_lights_count * sizeof(PointLight) <= file_size &&
+            header->terrains_offset + (uint64)header->terrains_count * sizeof(ShmenebTerrainRecord) <= file_size &&
+            header->strings_size && (uint64)header->strings_offset + header->strings_size == file_size &&
+            header->name_offset && header->name_offset < header->strings_size &&
+            data[file_size - 1] == 0;
+
+        if (!valid)
+        {
+            SHMWARNV("Failed to load binary scene '%s'. Falling back to the text file.", full_filepath);
+            file_data.free_data();
+            return false;
+        }
+
+        if (source_hash && header->source_hash != *source_hash)
+        {
+            SHMDEBUGV("Binary scene '%s' is outdated. Falling back to the text file.", full_filepath);
+            file_data.free_data();
+            return false;
+        }
+
+        const char* strings = (const char*)(data + header->strings_offset);
+        uint32 strings_size = header->strings_size;
+        // NOTE: Offsets out of range resolve to the empty string at offset 0 instead of reading past the table.
+#define SHMENEB_STRING(offset) (&strings[(offset) < strings_size ? (offset) : 0])
+
+        out_resource->name = SHMENEB_STRING(header->name_offset);
+        if (header->description_offset)
+            out_resource->description = SHMENEB_STRING(header->description_offset);
+        out_resource->max_meshes_count = header->max_meshes_count;
+        out_resource->max_p_lights_count = header->max_p_lights_count;
+        out_resource->max_terrains_count = header->max_terrains_count;
+        out_resource->transform = Math::transform_create();
+
+        out_resource->skyboxes.init(header->skyboxes_count, 0, AllocationTag::Resource);
+        out_resource->meshes.init(header->meshes_count, 0, AllocationTag::Resource);
+        out_resource->terrains.init(header->terrains_count, 0, AllocationTag::Resource);
+        out_resource->dir_lights.init(header->dir_lights_count, 0, AllocationTag::Resource);
+        out_resource->point_lights.init(header->point_lights_count, 0, AllocationTag::Resource);
+
+        const ShmenebSkyboxRecord* skyboxes = (const ShmenebSkyboxRecord*)(data + header->skyboxes_offset);
+        for (uint32 i = 0; i < header->skyboxes_count; i++)
+        {
+            out_resource->skyboxes[i].name = SHMENEB_STRING(skyboxes[i].name_offset);
+            out_resource->skyboxes[i].cubemap_name = SHMENEB_STRING(skyboxes[i].cubemap_name_offset);
+        }
+
+        const ShmenebMeshRecord* meshes = (const ShmenebMeshRecord*)(data + header->meshes_offset);
+        for (uint32 i = 0; i < header->meshes_count; i++)
+        {
+            SceneMeshResourceData* mesh = &out_resource->meshes[i];
+            const ShmenebMeshRecord* record = &meshes[i];
+
+            mesh->type = (SceneMeshType)record->type;
+            if (record->name_offset)
+                mesh->name = SHMENEB_STRING(record->name_offset);
+            if (record->parent_name_offset)
+                mesh->parent_name = SHMENEB_STRING(record->parent_name_offset);
+            switch (mesh->type)
+            {
+            case SceneMeshType::Resource:
+            {
+                if (record->resource_name_offset)
+                    mesh->resource_name = SHMENEB_STRING(record->resource_name_offset);
+                break;
+            }
+            case SceneMeshType::Cube:
+            {
+                CString::copy(SHMENEB_STRING(record->material_name_offset), mesh->cube_data.material_name, Constants::max_material_name_length);
+                mesh->cube_data.dim = record->dim;
+                mesh->cube_data.tiling = record->tiling;
+                break;
+            }
+            }
+            mesh->transform = Math::transform_from_position_rotation_scale(record->position, record->rotation, record->scale);
+        }
+
+        if (header->dir_lights_count)
+            Memory::copy_memory(data + header->dir_lights_offset, out_resource->dir_lights.data, header->dir_lights_count * sizeof(DirectionalLight));
+        if (header->point_lights_count)
+            Memory::copy_memory(data + header->point_lights_offset, out_resource->point_lights.data, header->point_lights_count * sizeof(PointLight));
+
+        const ShmenebTerrainRecord* terrains = (const ShmenebTerrainRecord*)(data + header->terrains_offset);
+        for (uint32 i = 0; i < header->terrains_count; i++)
+        {
+            SceneTerrainResourceData* terrain = &out_resource->terrains[i];
+            if (terrains[i].name_offset)
+                terrain->name = SHMENEB_STRING(terrains[i].name_offset);
+            if (terrains[i].resource_name_offset)
+                terrain->resource_name = SHMENEB_STRING(terrains[i].resource_name_offset);
+            terrain->xform = Math::transform_from_position_rotation_scale(terrains[i].position, terrains[i].rotation, terrains[i].scale);
+        }
+
+#undef SHMENEB_STRING
+
+        file_data.free_data();
+        return true;
+
+    }
+
     void scene_loader_unload(SceneResourceData* resource)
     {
         for (uint32 i = 0; i < resource->skyboxes.capacity; i++)
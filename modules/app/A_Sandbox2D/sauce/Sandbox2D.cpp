@@ -58,9 +58,14 @@ bool8 application_init(Application* app_inst)
 
 	app_state->allocation_count = 0;
 
-	if (!FontSystem::load_font("Noto Serif 21px", "NotoSerif_21", 21) || 
-		!FontSystem::load_font("Roboto Mono 21px", "RobotoMono_21", 21) || 
-		!FontSystem::load_font("Martian Mono", "MartianMono", 21))
+	FontSystem::FontLoadRequest font_requests[] =
+	{
+		{ "Noto Serif 21px", "NotoSerif_21", 21, false },
+		{ "Roboto Mono 21px", "RobotoMono_21", 21, false },
+		{ "Martian Mono", "MartianMono", 21, false },
+		{ "Martian Mono SDF", "MartianMono", 0, true }
+	};
+	if (!FontSystem::load_fonts(sizeof(font_requests) / sizeof(font_requests[0]), font_requests))
 	{
 		SHMERROR("Failed to load default fonts.");
 		return false;
@@ -68,14 +73,15 @@ bool8 application_init(Application* app_inst)
 
 	app_state->debug_console.init();
 
+	// NOTE: The debug overlay uses the distance field font, so it stays sharp when drawn at other sizes.
 	UITextConfig ui_text_config = {};
-	ui_text_config.font_name = "Martian Mono";
+	ui_text_config.font_name = "Martian Mono SDF";
 	ui_text_config.font_size = 21;
 	ui_text_config.text_content = "Some test text,\n\tyo!";
 
 	if (!ui_text_init(&ui_text_config, &app_state->debug_info_text))
 	{
-		SHMERROR("Failed to load basic ui truetype text.");
+		SHMERROR("Failed to load basic ui distance field text.");
 		return false;
 	}
 	ui_text_set_position(&app_state->debug_info_text, { 500, 550, 0 });
@@ -33,9 +33,12 @@ namespace Renderer::Vulkan
 		out_module->texture_init = Vulkan::vk_texture_init;
 		out_module->texture_resize = Vulkan::vk_texture_resize;
 		out_module->texture_write_data = Vulkan::vk_texture_write_data;
+		out_module->texture_write_data_batch = Vulkan::vk_texture_write_data_batch;
+		out_module->texture_write_region = Vulkan::vk_texture_write_region;
 		out_module->texture_read_data = Vulkan::vk_texture_read_data;
 		out_module->texture_read_pixel = Vulkan::vk_texture_read_pixel;
 		out_module->texture_destroy = Vulkan::vk_texture_destroy;
+		out_module->texture_destroy_deferred = Vulkan::vk_texture_destroy_deferred;
 
 		out_module->shader_init = Vulkan::vk_shader_init;
 		out_module->shader_destroy = Vulkan::vk_shader_destroy;
@@ -35,6 +35,7 @@ namespace Renderer::Vulkan
 	static int32 find_memory_index(uint32 type_filter, uint32 property_flags);
 	static void process_task(TaskInfo task);
 	static void create_vulkan_allocator(VkAllocationCallbacks*& callbacks);
+	static void destroy_retired_images(bool8 all);
 
 	VulkanContext* context = 0;
 
@@ -235,6 +236,8 @@ namespace Renderer::Vulkan
 		}
 
 		context->end_of_frame_task_queue.init(100, 0, AllocationTag::Renderer);
+		context->submitted_frame_count = 0;
+		context->retired_images.init(16, 0, AllocationTag::Renderer);
 
 		CString::copy(context->device.properties.deviceName, out_device_properties->device_name, RendererConfig::max_device_name_length);
 		out_device_properties->required_ubo_offset_alignment = context->device.properties.limits.minUniformBufferOffsetAlignment;
@@ -247,6 +250,9 @@ namespace Renderer::Vulkan
 	{		
 		vkDeviceWaitIdle(context->device.logical_device);
 
+		destroy_retired_images(true);
+		context->retired_images.free_data();
+
 		SHMDEBUG("Destroying vulkan semaphores and fences...");
 		for (uint32 i = 0; i < context->swapchain.max_frames_in_flight; i++)
 		{
@@ -358,6 +364,8 @@ namespace Renderer::Vulkan
 			SHMERRORV("In-flight fence wait failure! Error: %s", vk_result_string(res, true));
 			return false;
 		}
+
+		destroy_retired_images(false);
 		
 		if (!vk_swapchain_acquire_next_image_index(
 			&context->swapchain, UINT64_MAX, context->image_available_semaphores[context->bound_sync_object_index], 0, &context->bound_framebuffer_index))
@@ -415,6 +423,7 @@ namespace Renderer::Vulkan
 			return false;
 		}
 
+		context->submitted_frame_count++;
 		vk_command_buffer_update_submitted(cmd);
 
 		vk_swapchain_present(
@@ -465,13 +474,38 @@ namespace Renderer::Vulkan
 		vk_set_scissor(context->scissor_rect);
 	}
 
+	static VkFormat texture_format_to_vk_format(TextureFormat format, VkFormat default_format)
+	{
+		// NOTE: Color textures are sampled as UNORM everywhere, so cooked sRGB data keeps going through the same path.
+		switch (format)
+		{
+		case TextureFormat::BC1:
+			return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case TextureFormat::BC3:
+			return VK_FORMAT_BC3_UNORM_BLOCK;
+		case TextureFormat::BC5:
+			return VK_FORMAT_BC5_UNORM_BLOCK;
+		case TextureFormat::BC7:
+			return VK_FORMAT_BC7_UNORM_BLOCK;
+		default:
+			return default_format;
+		}
+	}
+
 	bool8 vk_texture_init(Texture* texture)
 	{
 		VkFormat image_format;
 		if (texture->flags & TextureFlags::IsDepth)
 			image_format = context->device.depth_format;
 		else
-			image_format = VK_FORMAT_R8G8B8A8_UNORM;
+			image_format = texture_format_to_vk_format(texture->format, VK_FORMAT_R8G8B8A8_UNORM);
+
+		bool8 is_compressed = !(texture->flags & TextureFlags::IsDepth) && texture->format != TextureFormat::RGBA8;
+		if (is_compressed && !context->device.features.textureCompressionBC)
+		{
+			SHMERRORV("Failed to create texture '%s': Device does not support BC compressed textures.", texture->name);
+			return false;
+		}
 
 		texture->internal_data.init(sizeof(VulkanImage), 0, AllocationTag::Texture);
 		VulkanImage* image = (VulkanImage*)texture->internal_data.data;
@@ -484,6 +518,11 @@ namespace Renderer::Vulkan
 			usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 			aspect = VK_IMAGE_ASPECT_DEPTH_BIT;
 		}
+		else if (is_compressed)
+		{
+			usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			aspect = VK_IMAGE_ASPECT_COLOR_BIT;
+		}
 		else
 		{
 			usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
@@ -494,6 +533,7 @@ namespace Renderer::Vulkan
 			texture->type,
 			texture->width,
 			texture->height,
+			texture->mip_levels,
 			image_format,
 			VK_IMAGE_TILING_OPTIMAL,
 			usage,
@@ -537,19 +577,73 @@ namespace Renderer::Vulkan
 
 	bool8 vk_texture_write_data(Texture* t, uint32 offset, uint32 size, const uint8* pixels)
 	{
-		VkFormat image_format = channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM);
+		VkFormat image_format = texture_format_to_vk_format(t->format, channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM));
 		return vk_image_write_data((VulkanImage*)t->internal_data.data, image_format, t->type, offset, size, pixels);
 	}
 
+	bool8 vk_texture_write_region(Texture* t, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels)
+	{
+		VkFormat image_format = texture_format_to_vk_format(t->format, channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM));
+		return vk_image_write_region((VulkanImage*)t->internal_data.data, image_format, x, y, width, height, pixels);
+	}
+
+	bool8 vk_texture_write_data_batch(uint32 texture_count, Texture** textures, const uint32* sizes, const uint8** pixels)
+	{
+		// NOTE: Offsets stay aligned to the largest texel block, so compressed images can be copied from anywhere in the staging buffer.
+		const uint64 staging_alignment = 16;
+		uint64 staging_size = 0;
+		for (uint32 i = 0; i < texture_count; i++)
+			staging_size += (sizes[i] + staging_alignment - 1) & ~(staging_alignment - 1);
+
+		VulkanBuffer staging;
+		if (!vk_buffer_create_internal(&staging, RenderBufferType::STAGING, staging_size, "texture_batch_staging_buffer")) 
+		{
+			SHMERROR("Failed to create staging buffer.");
+			return false;
+		}
+		vk_buffer_bind_internal(&staging, 0);
+
+		uint8* mapped_staging_data = (uint8*)vk_buffer_map_memory_internal(&staging, 0, staging_size);
+		for (uint64 offset = 0, i = 0; i < texture_count; i++)
+		{
+			Memory::copy_memory(pixels[i], mapped_staging_data + offset, sizes[i]);
+			offset += (sizes[i] + staging_alignment - 1) & ~(staging_alignment - 1);
+		}
+		vk_buffer_unmap_memory_internal(&staging);
+
+		VulkanCommandBuffer temp_buffer;
+		VulkanCommandPool pool = context->device.graphics_command_pool;
+		VkQueue queue = context->device.graphics_queue;
+
+		vk_command_buffer_reserve_and_begin_single_use(pool, &temp_buffer);
+		for (uint64 offset = 0, i = 0; i < texture_count; i++)
+		{
+			Texture* t = textures[i];
+			VulkanImage* image = (VulkanImage*)t->internal_data.data;
+			VkFormat image_format = texture_format_to_vk_format(t->format, channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM));
+
+			vk_image_transition_layout(t->type, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+			vk_image_copy_from_buffer(t->type, image, image_format, staging.handle, offset, &temp_buffer);
+			vk_image_transition_layout(t->type, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			offset += (sizes[i] + staging_alignment - 1) & ~(staging_alignment - 1);
+		}
+		vk_command_buffer_end_single_use(pool, &temp_buffer, queue);
+
+		vk_buffer_unbind_internal(&staging);
+		vk_buffer_destroy_internal(&staging);
+
+		return true;
+	}
+
 	bool8 vk_texture_read_data(Texture* t, uint32 offset, uint32 size, void* out_memory)
 	{
-		VkFormat image_format = channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM);
+		VkFormat image_format = texture_format_to_vk_format(t->format, channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM));
 		return vk_image_read_data((VulkanImage*)t->internal_data.data, image_format, t->type, offset, size, out_memory);
 	}
 
 	bool8 vk_texture_read_pixel(Texture* t, uint32 x, uint32 y, uint32* out_rgba)
 	{
-		VkFormat image_format = channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM);
+		VkFormat image_format = texture_format_to_vk_format(t->format, channel_count_to_format(t->channel_count, VK_FORMAT_R8G8B8A8_UNORM));
 		return vk_image_read_pixel((VulkanImage*)t->internal_data.data, image_format, t->type, x, y, out_rgba);
 	}
 
@@ -564,6 +658,19 @@ namespace Renderer::Vulkan
 		texture->internal_data.free_data();
 	}
 
+	void vk_texture_destroy_deferred(Texture* texture)
+	{
+		VulkanImage* image = (VulkanImage*)texture->internal_data.data;
+		if (image)
+		{
+			VulkanRetiredImage* retired = &context->retired_images[context->retired_images.emplace()];
+			retired->image = *image;
+			retired->retire_frame = context->submitted_frame_count;
+		}
+
+		texture->internal_data.free_data();
+	}
+
 	Texture* vk_get_color_attachment(uint32 index)
 	{
 		if (index >= context->swapchain.render_textures.capacity) {
@@ -599,6 +706,24 @@ namespace Renderer::Vulkan
 		return context->is_multithreaded;
 	}
 
+	static void destroy_retired_images(bool8 all)
+	{
+		// NOTE: Once the fence of the current sync object signaled, every frame submitted max_frames_in_flight frames ago or earlier has finished executing.
+		for (uint32 i = 0; i < context->retired_images.count;)
+		{
+			VulkanRetiredImage* retired = &context->retired_images[i];
+			if (!all && context->submitted_frame_count < retired->retire_frame + context->swapchain.max_frames_in_flight)
+			{
+				i++;
+				continue;
+			}
+
+			vk_image_destroy(&retired->image);
+			context->retired_images[i] = context->retired_images[context->retired_images.count - 1];
+			context->retired_images.pop();
+		}
+	}
+
 	static int32 find_memory_index(uint32 type_filter, uint32 property_flags)
 	{
 		VkPhysicalDeviceMemoryProperties memory_properties;
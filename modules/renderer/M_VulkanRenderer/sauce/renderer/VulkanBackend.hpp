@@ -41,9 +41,12 @@ namespace Renderer::Vulkan
 	bool8 vk_texture_init(Texture* texture);
 	void vk_texture_resize(Texture* texture, uint32 width, uint32 height);
 	bool8 vk_texture_write_data(Texture* texture, uint32 offset, uint32 size, const uint8* pixels);
+	bool8 vk_texture_write_data_batch(uint32 texture_count, Texture** textures, const uint32* sizes, const uint8** pixels);
+	bool8 vk_texture_write_region(Texture* texture, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels);
 	bool8 vk_texture_read_data(Texture* t, uint32 offset, uint32 size, void* out_memory);
 	bool8 vk_texture_read_pixel(Texture* t, uint32 x, uint32 y, uint32* out_rgba);
 	void vk_texture_destroy(Texture* texture);
+	void vk_texture_destroy_deferred(Texture* texture);
 
 	bool8 vk_shader_init(ShaderConfig* config, Shader* shader);
 	void vk_shader_destroy(Shader* shader);
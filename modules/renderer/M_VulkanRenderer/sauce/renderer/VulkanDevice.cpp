@@ -80,6 +80,8 @@ namespace Renderer::Vulkan
 		// TODO: should be config driven
 		VkPhysicalDeviceFeatures device_features = {};
 		device_features.samplerAnisotropy = VK_TRUE;
+		// NOTE: Cooked textures may be block compressed, the backend refuses to create those if the device lacks support.
+		device_features.textureCompressionBC = context->device.features.textureCompressionBC;
 
 		VkDeviceCreateInfo device_create_info = { VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
 		device_create_info.queueCreateInfoCount = index_count;
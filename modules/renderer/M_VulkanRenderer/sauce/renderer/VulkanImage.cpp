@@ -11,6 +11,7 @@ namespace Renderer::Vulkan
 		TextureType type,
 		uint32 width,
 		uint32 height,
+		uint32 mip_levels,
 		VkFormat format,
 		VkImageTiling tiling,
 		VkImageUsageFlags usage,
@@ -22,6 +23,7 @@ namespace Renderer::Vulkan
 
 		out_image->width = width;
 		out_image->height = height;
+		out_image->mip_levels = mip_levels;
 		out_image->memory_flags = memory_flags;
 		out_image->layout = VK_IMAGE_LAYOUT_UNDEFINED;
 
@@ -39,7 +41,7 @@ namespace Renderer::Vulkan
 		image_create_info.extent.width = out_image->width;
 		image_create_info.extent.height = out_image->height;
 		image_create_info.extent.depth = 1;	// TODO: make configurable
-		image_create_info.mipLevels = 4;	// TODO: make configurable
+		image_create_info.mipLevels = out_image->mip_levels;
 		image_create_info.arrayLayers = type == TextureType::Cube ? 6 : 1;	// TODO: make configurable
 		image_create_info.format = format;
 		image_create_info.tiling = tiling;
@@ -98,7 +100,7 @@ namespace Renderer::Vulkan
 
 		// TODO: make configurable
 		view_create_info.subresourceRange.baseMipLevel = 0;
-		view_create_info.subresourceRange.levelCount = 1;
+		view_create_info.subresourceRange.levelCount = image->mip_levels;
 		view_create_info.subresourceRange.baseArrayLayer = 0;
 		view_create_info.subresourceRange.layerCount = type == TextureType::Cube ? 6 : 1;
 
@@ -115,7 +117,7 @@ namespace Renderer::Vulkan
 		barrier.image = image->handle;
 		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
 		barrier.subresourceRange.baseMipLevel = 0;
-		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.levelCount = image->mip_levels;
 		barrier.subresourceRange.baseArrayLayer = 0;
 		barrier.subresourceRange.layerCount = type == TextureType::Cube ? 6 : 1;
 
@@ -201,23 +203,58 @@ namespace Renderer::Vulkan
 		vkCmdPipelineBarrier(command_buffer->handle, source_stage, dest_stage, 0, 0, 0, 0, 0, 1, &barrier);
 	}
 
-	void vk_image_copy_from_buffer(TextureType type, VulkanImage* image, VkBuffer buffer, VulkanCommandBuffer* command_buffer)
+	static uint32 get_mip_layer_size(VkFormat format, uint32 width, uint32 height)
 	{
-		VkBufferImageCopy region = {};
-		region.bufferOffset = 0;
-		region.bufferRowLength = 0;
-		region.bufferImageHeight = 0;
+		uint32 blocks_x = (width + 3) / 4;
+		uint32 blocks_y = (height + 3) / 4;
 
-		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		region.imageSubresource.mipLevel = 0;
-		region.imageSubresource.baseArrayLayer = 0;
-		region.imageSubresource.layerCount = type == TextureType::Cube ? 6 : 1;
+		switch (format)
+		{
+		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+			return blocks_x * blocks_y * 8;
+		case VK_FORMAT_BC3_UNORM_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC5_UNORM_BLOCK:
+		case VK_FORMAT_BC7_UNORM_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			return blocks_x * blocks_y * 16;
+		default:
+			return width * height * 4;
+		}
+	}
 
-		region.imageExtent.width = image->width;
-		region.imageExtent.height = image->height;
-		region.imageExtent.depth = 1;
+	void vk_image_copy_from_buffer(TextureType type, VulkanImage* image, VkFormat format, VkBuffer buffer, uint64 buffer_offset, VulkanCommandBuffer* command_buffer)
+	{
+		// NOTE: Buffer holds the mip levels back to back, each level containing all of its layers.
+		const uint32 max_mip_levels = 16;
+		VkBufferImageCopy regions[max_mip_levels] = {};
+		uint32 layer_count = type == TextureType::Cube ? 6 : 1;
+		uint32 region_count = SHMIN(image->mip_levels, max_mip_levels);
+
+		for (uint32 mip = 0; mip < region_count; mip++)
+		{
+			VkBufferImageCopy* region = &regions[mip];
+			uint32 mip_width = SHMAX(image->width >> mip, 1);
+			uint32 mip_height = SHMAX(image->height >> mip, 1);
+
+			region->bufferOffset = buffer_offset;
+			region->bufferRowLength = 0;
+			region->bufferImageHeight = 0;
+
+			region->imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			region->imageSubresource.mipLevel = mip;
+			region->imageSubresource.baseArrayLayer = 0;
+			region->imageSubresource.layerCount = layer_count;
+
+			region->imageExtent.width = mip_width;
+			region->imageExtent.height = mip_height;
+			region->imageExtent.depth = 1;
+
+			buffer_offset += (uint64)get_mip_layer_size(format, mip_width, mip_height) * layer_count;
+		}
 
-		vkCmdCopyBufferToImage(command_buffer->handle, buffer, image->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		vkCmdCopyBufferToImage(command_buffer->handle, buffer, image->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, region_count, regions);
 	}
 
 	void vk_image_destroy(VulkanImage* image)
@@ -300,7 +337,7 @@ namespace Renderer::Vulkan
 
 		vk_command_buffer_reserve_and_begin_single_use(pool, &temp_buffer);
 		vk_image_transition_layout(texture_type, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-		vk_image_copy_from_buffer(texture_type, image, staging.handle, &temp_buffer);
+		vk_image_copy_from_buffer(texture_type, image, image_format, staging.handle, 0, &temp_buffer);
 		vk_image_transition_layout(texture_type, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		vk_command_buffer_end_single_use(pool, &temp_buffer, queue);
 
@@ -311,6 +348,50 @@ namespace Renderer::Vulkan
 
 	}
 
+	bool8 vk_image_write_region(VulkanImage* image, VkFormat image_format, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels)
+	{
+		uint32 size = get_mip_layer_size(image_format, width, height);
+
+		VulkanBuffer staging;
+		if (!vk_buffer_create_internal(&staging, RenderBufferType::STAGING, size, "texture_write_region_staging_buffer")) {
+			SHMERROR("Failed to create staging buffer.");
+			return false;
+		}
+		vk_buffer_bind_internal(&staging, 0);
+
+		void* mapped_staging_data = vk_buffer_map_memory_internal(&staging, 0, size);
+		Memory::copy_memory(pixels, mapped_staging_data, size);
+		vk_buffer_unmap_memory_internal(&staging);
+
+		VulkanCommandBuffer temp_buffer;
+		VulkanCommandPool pool = context->device.graphics_command_pool;
+		VkQueue queue = context->device.graphics_queue;
+
+		VkBufferImageCopy region = {};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+
+		region.imageOffset = { (int32)x, (int32)y, 0 };
+		region.imageExtent = { width, height, 1 };
+
+		vk_command_buffer_reserve_and_begin_single_use(pool, &temp_buffer);
+		vk_image_transition_layout(TextureType::Plane, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		vkCmdCopyBufferToImage(temp_buffer.handle, staging.handle, image->handle, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+		vk_image_transition_layout(TextureType::Plane, &temp_buffer, image, image_format, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		vk_command_buffer_end_single_use(pool, &temp_buffer, queue);
+
+		vk_buffer_unbind_internal(&staging);
+		vk_buffer_destroy_internal(&staging);
+
+		return true;
+	}
+
 	bool8 vk_image_read_data(VulkanImage* image, VkFormat image_format, TextureType texture_type, uint32 offset, uint32 size, void* out_memory)
 	{
 
@@ -50,6 +50,7 @@ namespace Renderer::Vulkan
 		TextureType type,
 		uint32 width,
 		uint32 height,
+		uint32 mip_levels,
 		VkFormat format,
 		VkImageTiling tiling,
 		VkImageUsageFlags usage,
@@ -61,10 +62,11 @@ namespace Renderer::Vulkan
 	void vk_image_destroy(VulkanImage* image);
 	void vk_image_view_create(TextureType type, VkFormat format, VulkanImage* image, VkImageAspectFlags aspect_flags);
 	void vk_image_transition_layout(TextureType type, VulkanCommandBuffer* command_buffer, VulkanImage* image, VkFormat format, VkImageLayout new_layout);
-	void vk_image_copy_from_buffer(TextureType type, VulkanImage* image, VkBuffer buffer, VulkanCommandBuffer* command_buffer);
+	void vk_image_copy_from_buffer(TextureType type, VulkanImage* image, VkFormat format, VkBuffer buffer, uint64 buffer_offset, VulkanCommandBuffer* command_buffer);
 	void vk_image_copy_to_buffer(TextureType type, VulkanImage* image, VkBuffer buffer, VulkanCommandBuffer* command_buffer);
 	void vk_image_copy_pixel_to_buffer(TextureType type, VulkanImage* image, VkBuffer buffer, uint32 x, uint32 y, VulkanCommandBuffer* command_buffer);
 	bool8 vk_image_write_data(VulkanImage* image, VkFormat image_format, TextureType texture_type, uint32 offset, uint32 size, const uint8* pixels);
+	bool8 vk_image_write_region(VulkanImage* image, VkFormat image_format, uint32 x, uint32 y, uint32 width, uint32 height, const uint8* pixels);
 	bool8 vk_image_read_data(VulkanImage* image, VkFormat image_format, TextureType texture_type, uint32 offset, uint32 size, void* out_memory);
 	bool8 vk_image_read_pixel(VulkanImage* image, VkFormat image_format, TextureType texture_type, uint32 x, uint32 y, uint32* out_rgba);
 	
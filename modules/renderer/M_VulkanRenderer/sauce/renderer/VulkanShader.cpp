@@ -14,7 +14,7 @@ namespace Renderer::Vulkan
 {
 	extern VulkanContext* context;
 
-	static bool8 _create_shader_module(VulkanShader* shader, const char* filename, VkShaderStageFlagBits stage_flags, VulkanShaderStage* shader_stage);
+	static bool8 _create_shader_module(VulkanShader* shader, const ShaderStageConfig* stage_config, VkShaderStageFlagBits stage_flags, VulkanShaderStage* shader_stage);
 
 	static VkShaderStageFlagBits _convert_shader_stage(ShaderStage::Value stage);
 	static VkSamplerAddressMode _convert_repeat_type(TextureRepeat::Value repeat);
@@ -65,7 +65,7 @@ namespace Renderer::Vulkan
 		for (uint32 i = 0; i < v_shader->stage_count; ++i)
 		{
 			VkShaderStageFlagBits stage_flags = _convert_shader_stage(config->stages[i].stage);
-			if (!_create_shader_module(v_shader, config->stages[i].filename, stage_flags, &v_shader->stages[i]))
+			if (!_create_shader_module(v_shader, &config->stages[i], stage_flags, &v_shader->stages[i]))
 			{
 				SHMERRORV("Unable to create %s shader module for '%s'. Shader will be destroyed.", config->stages[i].filename, shader->name.c_str());
 				return false;
@@ -642,7 +642,7 @@ namespace Renderer::Vulkan
 		sampler_info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
 		sampler_info.mipLodBias = 0.0f;
 		sampler_info.minLod = 0.0f;
-		sampler_info.maxLod = 0.0f;
+		sampler_info.maxLod = VK_LOD_CLAMP_NONE;
 
 		VkResult result = vkCreateSampler(context->device.logical_device, &sampler_info, context->allocator_callbacks, (VkSampler*)&out_sampler->internal_data);
 		if (!vk_result_is_success(VK_SUCCESS)) {
@@ -660,20 +660,20 @@ namespace Renderer::Vulkan
 		sampler->internal_data = 0;
 	}
 
-	static bool8 _create_shader_module(VulkanShader* shader, const char* filename, VkShaderStageFlagBits stage_flags, VulkanShaderStage* shader_stage)
+	static bool8 _create_shader_module(VulkanShader* shader, const ShaderStageConfig* stage_config, VkShaderStageFlagBits stage_flags, VulkanShaderStage* shader_stage)
 	{
-		// Read the resource.
+		// Read the resource, unless the cooked shader already brought the code along.
 		Buffer data = {};
-		if (!ResourceSystem::generic_loader_load(filename, &data))
+		if (!stage_config->code && !ResourceSystem::generic_loader_load(stage_config->filename, &data))
 		{
-			SHMERRORV("Unable to read shader module file: %s.", filename);
+			SHMERRORV("Unable to read shader module file: %s.", stage_config->filename);
 			return false;
 		}
 
 		VkShaderModuleCreateInfo module_create_info = {};
 		module_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		module_create_info.codeSize = data.size;
-		module_create_info.pCode = (uint32*)data.data;
+		module_create_info.codeSize = stage_config->code ? stage_config->code_size : data.size;
+		module_create_info.pCode = stage_config->code ? (const uint32*)stage_config->code : (uint32*)data.data;
 
 		VK_CHECK(vkCreateShaderModule(
 			context->device.logical_device,
@@ -157,6 +157,7 @@ namespace Renderer::Vulkan
 			image->handle = swapchain_images[i];
 			image->width = swapchain_extent.width;
 			image->height = swapchain_extent.height;
+			image->mip_levels = 1;
 			VK_DEBUG_SET_OBJECT_NAME(context, VK_OBJECT_TYPE_IMAGE, image->handle, out_swapchain->render_textures[i].name);
 		}
 
@@ -199,6 +200,7 @@ namespace Renderer::Vulkan
 					TextureType::Plane,
 					swapchain_extent.width,
 					swapchain_extent.height,
+					1,
 					context->device.depth_format,
 					VK_IMAGE_TILING_OPTIMAL,
 					VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
@@ -6,6 +6,7 @@
 #include <core/Mutex.hpp>
 #include <platform/Platform.hpp>
 #include <containers/Sarray.hpp>
+#include <containers/Darray.hpp>
 #include <containers/Buffer.hpp>
 #include <containers/RingQueue.hpp>
 #include <utility/Math.hpp>
@@ -83,10 +84,17 @@ namespace Renderer::Vulkan
 		VkImageLayout layout;
 		uint32 width;
 		uint32 height;
+		uint32 mip_levels;
 		VkMemoryRequirements memory_requirements;
 		VkMemoryPropertyFlags memory_flags;
 	};
 
+	struct VulkanRetiredImage
+	{
+		VulkanImage image;
+		uint64 retire_frame;
+	};
+
 	enum class VulkanRenderpassState
 	{
 		NOT_ALLOCATED = 0,
@@ -283,6 +291,9 @@ namespace Renderer::Vulkan
 
 		RingQueue<TaskInfo> end_of_frame_task_queue;
 
+		uint64 submitted_frame_count;
+		Darray<VulkanRetiredImage> retired_images;
+
 		bool8 config_changed;
 		bool8 recreating_swapchain;
 		bool8 is_multithreaded;